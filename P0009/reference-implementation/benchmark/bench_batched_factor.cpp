@@ -0,0 +1,154 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Throughput of batched Cholesky and LU factor-plus-solve on batches of
+// small double matrices with one right-hand side each, in millions of
+// problems per second: a loop of single-matrix calls, the batched calls
+// on dynamic extents, and the batched calls on static extents, which
+// instantiate the kernels for the order.  Every run first restores the
+// matrices, which is counted too.
+// Usage: bench_batched_factor
+
+#include<experimental/linalg>
+#include<algorithm>
+#include<chrono>
+#include<cstdio>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 0.5);
+  return best;
+}
+
+template<ptrdiff_t N>
+void run() {
+  typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent,dynamic_extent>,layout_right> dynamic_t;
+  typedef basic_mdspan<double,extents<dynamic_extent,N,N>,layout_right> static_t;
+  typedef mdspan<double,dynamic_extent,dynamic_extent> rhs_t;
+  const ptrdiff_t batch = (ptrdiff_t(1) << 20) / (N*N);
+
+  // symmetric, diagonally dominant, so both factorizations apply
+  std::vector<double> a0(batch*N*N), a(batch*N*N), b0(batch*N), b(batch*N);
+  for(ptrdiff_t p=0; p<batch; p++)
+  for(ptrdiff_t i=0; i<N; i++) {
+    b0[p*N+i] = double((p+i)%7) - 3.0;
+    for(ptrdiff_t j=0; j<N; j++)
+      a0[(p*N+i)*N+j] = i == j ? 2.0*N : double((p+i+j)%5)/5.0 - 0.4;
+  }
+  std::vector<ptrdiff_t> piv_data(batch*N), info_data(batch);
+  mdspan<ptrdiff_t,dynamic_extent,dynamic_extent> piv(piv_data.data(),batch,N);
+  mdspan<ptrdiff_t,dynamic_extent> info(info_data.data(),batch);
+  dynamic_t A(a.data(),batch,N,N);
+  static_t As(a.data(),batch);
+  rhs_t B(b.data(),batch,N);
+  auto restore = [&]{
+    std::copy(a0.begin(),a0.end(),a.begin());
+    std::copy(b0.begin(),b0.end(),b.begin());
+  };
+
+  const double mp = 1e-6*double(batch);
+  const double chol_loop = seconds_per_call([&]{
+    restore();
+    for(ptrdiff_t p=0; p<batch; p++) {
+      linalg::cholesky_factor(subspan(A,p,all,all),linalg::lower_triangle);
+      linalg::cholesky_solve(subspan(A,p,all,all),linalg::lower_triangle,subspan(B,p,all));
+    }
+  });
+  const double chol_dynamic = seconds_per_call([&]{
+    restore();
+    linalg::cholesky_factor(A,linalg::lower_triangle,info);
+    linalg::cholesky_solve(A,linalg::lower_triangle,B);
+  });
+  const double chol_static = seconds_per_call([&]{
+    restore();
+    linalg::cholesky_factor(As,linalg::lower_triangle,info);
+    linalg::cholesky_solve(As,linalg::lower_triangle,B);
+  });
+  const double lu_loop = seconds_per_call([&]{
+    restore();
+    for(ptrdiff_t p=0; p<batch; p++) {
+      linalg::lu_factor(subspan(A,p,all,all),subspan(piv,p,all));
+      linalg::lu_solve(subspan(A,p,all,all),subspan(piv,p,all),subspan(B,p,all));
+    }
+  });
+  const double lu_dynamic = seconds_per_call([&]{
+    restore();
+    linalg::lu_factor(A,piv,info);
+    linalg::lu_solve(A,piv,B);
+  });
+  const double lu_static = seconds_per_call([&]{
+    restore();
+    linalg::lu_factor(As,piv,info);
+    linalg::lu_solve(As,piv,B);
+  });
+  std::printf("%4td %8td %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",N,batch,
+              mp/chol_loop,mp/chol_dynamic,mp/chol_static,mp/lu_loop,mp/lu_dynamic,mp/lu_static);
+}
+
+}
+
+int main() {
+  std::printf("%4s %8s %10s %10s %10s %10s %10s %10s\n","n","batch","chol loop","chol batch","chol static",
+              "lu loop","lu batch","lu static");
+  run<3>();
+  run<4>();
+  run<8>();
+  run<16>();
+  return 0;
+}
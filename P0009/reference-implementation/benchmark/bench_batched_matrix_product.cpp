@@ -0,0 +1,137 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Compares batched linalg::matrix_product over a rank-3 C against a loop
+// of single matrix_product calls on the same problems, for batches of
+// small square double matrices, with A per problem and broadcast, and
+// with all three batches in layout_batch_interleaved<8>, which vectorizes
+// across problems.
+// Usage: bench_batched_matrix_product [n ...]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent,dynamic_extent>,layout_right> batch_t;
+typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent>,layout_right> matrix_t;
+typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent,dynamic_extent>,linalg::layout_batch_interleaved<8>> interleaved_t;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {8, 16, 32, 64};
+
+  const size_t num_threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+  linalg::thread_pool_policy exec(num_threads);
+
+  std::printf("%6s %8s %12s %12s %12s %12s %12s %10s\n","n","batch","loop GF/s","batched GF/s",
+              "bcast A GF/s","parallel GF/s","interl. GF/s","max err");
+  for(ptrdiff_t n : sizes) {
+    const ptrdiff_t batch = (ptrdiff_t(1) << 24) / (n*n*n) + 1;
+    std::vector<double> a(batch*n*n), b(batch*n*n), c0(batch*n*n), c1(batch*n*n);
+    for(ptrdiff_t i=0; i<batch*n*n; i++) {
+      a[i] = double(i%17)/17.0 - 0.5;
+      b[i] = double(i%13)/13.0 - 0.5;
+    }
+    batch_t A(a.data(),batch,n,n), B(b.data(),batch,n,n), C0(c0.data(),batch,n,n), C1(c1.data(),batch,n,n);
+    matrix_t A0(a.data(),n,n);
+
+    const double flops = 2.0*double(batch)*double(n)*double(n)*double(n);
+    const double t_loop = seconds_per_call([&]{
+      for(ptrdiff_t p=0; p<batch; p++)
+        linalg::matrix_product(subspan(A,p,all,all),subspan(B,p,all,all),subspan(C0,p,all,all));
+    });
+    const double t_batched = seconds_per_call([&]{ linalg::matrix_product(A,B,C1); });
+    const double t_bcast = seconds_per_call([&]{ linalg::matrix_product(A0,B,C1); });
+    linalg::matrix_product(A,B,C1);
+
+    double max_err = 0.0;
+    for(ptrdiff_t i=0; i<batch*n*n; i++) {
+      const double err = c0[i] > c1[i] ? c0[i]-c1[i] : c1[i]-c0[i];
+      if(err > max_err) max_err = err;
+    }
+    const double t_par = seconds_per_call([&]{ linalg::matrix_product(exec,A,B,C1); });
+
+    const interleaved_t::mapping_type map(A.extents());
+    std::vector<double> ai(map.required_span_size()), bi(map.required_span_size()), ci(map.required_span_size());
+    interleaved_t Ai(ai.data(),map), Bi(bi.data(),map), Ci(ci.data(),map);
+    linalg::copy(A,Ai);
+    linalg::copy(B,Bi);
+    const double t_interleaved = seconds_per_call([&]{ linalg::matrix_product(Ai,Bi,Ci); });
+    linalg::copy(Ci,C1);
+    for(ptrdiff_t i=0; i<batch*n*n; i++) {
+      const double err = c0[i] > c1[i] ? c0[i]-c1[i] : c1[i]-c0[i];
+      if(err > max_err) max_err = err;
+    }
+
+    std::printf("%6td %8td %12.2f %12.2f %12.2f %12.2f %12.2f %10.2e\n",n,batch,flops/t_loop*1e-9,
+                flops/t_batched*1e-9,flops/t_bcast*1e-9,flops/t_par*1e-9,flops/t_interleaved*1e-9,max_err);
+  }
+  return 0;
+}
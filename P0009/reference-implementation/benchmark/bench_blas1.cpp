@@ -0,0 +1,139 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Memory throughput of the linalg vector kernels on contiguous and
+// stride-two double vectors, and of the batched dot and two-norm on
+// batches of short vectors against a loop of unbatched calls.
+// Usage: bench_blas1 [n]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+volatile double sink;
+volatile double one = 1.0;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 0.5);
+  return best;
+}
+
+template<class X, class Y, class Z>
+void run(const char* label, X x, Y y, Z z) {
+  const double n = double(x.extent(0));
+  const double gb = 1e-9*sizeof(double)*n;
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"dot",
+    2*gb/seconds_per_call([&]{ sink = linalg::dot(x,y); }));
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"two_norm",
+    gb/seconds_per_call([&]{ sink = linalg::vector_two_norm(x); }));
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"two_norm bd",
+    gb/seconds_per_call([&]{ sink = linalg::vector_two_norm(linalg::bounded_values,x); }));
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"abs_sum",
+    gb/seconds_per_call([&]{ sink = linalg::vector_abs_sum(x); }));
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"idx_abs_max",
+    gb/seconds_per_call([&]{ sink = double(linalg::vector_idx_abs_max(x)); }));
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"scale",
+    2*gb/seconds_per_call([&]{ linalg::scale(double(one),z); }));
+  std::printf("%-10s %-12s %8.2f GB/s\n",label,"add",
+    3*gb/seconds_per_call([&]{ linalg::add(x,y,z); }));
+}
+
+// dot and two-norm of each row of the len-column layout_right batches
+// x and y, batched and one row at a time.
+void run_batched(ptrdiff_t len, double* x_data, double* y_data, double* out_data, ptrdiff_t n) {
+  const ptrdiff_t batch = n/len;
+  const double gb = 1e-9*sizeof(double)*double(batch*len);
+  mdspan<double,dynamic_extent,dynamic_extent> x(x_data,batch,len), y(y_data,batch,len);
+  mdspan<double,dynamic_extent> out(out_data,batch);
+  char label[32];
+  std::snprintf(label,sizeof(label),"batch x %td",len);
+  std::printf("%-10s %-12s %8.2f GB/s %8.2f GB/s looped\n",label,"dot",
+    2*gb/seconds_per_call([&]{ linalg::dot(x,y,out); }),
+    2*gb/seconds_per_call([&]{
+      for(ptrdiff_t b=0; b<batch; b++) out(b) = linalg::dot(subspan(x,b,all),subspan(y,b,all));
+    }));
+  std::printf("%-10s %-12s %8.2f GB/s %8.2f GB/s looped\n",label,"two_norm",
+    gb/seconds_per_call([&]{ linalg::vector_two_norm(x,out); }),
+    gb/seconds_per_call([&]{
+      for(ptrdiff_t b=0; b<batch; b++) out(b) = linalg::vector_two_norm(subspan(x,b,all));
+    }));
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  const ptrdiff_t n = argc > 1 ? std::atol(argv[1]) : (1 << 22);
+  std::vector<double> x_data(2*n), y_data(2*n), z_data(2*n);
+  for(ptrdiff_t k=0; k<2*n; k++) {
+    x_data[k] = double(k%101)/101.0 - 0.5;
+    y_data[k] = double(k%37)/37.0 - 0.5;
+  }
+  mdspan<double,dynamic_extent> x(x_data.data(),2*n), y(y_data.data(),2*n), z(z_data.data(),2*n);
+
+  std::pair<ptrdiff_t,ptrdiff_t> head(0,n);
+  run("contiguous", subspan(x,head), subspan(y,head), subspan(z,head));
+
+  strided_slice<ptrdiff_t,ptrdiff_t,ptrdiff_t> every_other{0,2*n,2};
+  run("stride 2", subspan(x,every_other), subspan(y,every_other), subspan(z,every_other));
+
+  for(ptrdiff_t len : {3, 8, 16, 32, 256})
+    run_batched(len, x_data.data(), y_data.data(), z_data.data(), n);
+  return 0;
+}
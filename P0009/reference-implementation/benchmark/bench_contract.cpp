@@ -0,0 +1,115 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// linalg::contract of A(i,k,l) with B(l,k,j) into C(i,j), against a naive
+// loop nest and against matrix_product on A and B reshaped by hand to
+// n x s*s and s*s x n.  In "ikl,lkj->ij" B's summed modes are in the
+// opposite order from A's, so contract packs B; in "ikl,klj->ij" both
+// fuse in place and contract is one matrix_product.
+// Usage: bench_contract [n ...]   (i and j extents; k and l are 16)
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef extents<dynamic_extent,dynamic_extent> extents_2;
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> extents_3;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {64, 256, 1024};
+  const ptrdiff_t s = 16;
+
+  std::printf("%8s %12s %12s %12s %12s\n","n","naive GF/s","packed GF/s","fused GF/s","gemm GF/s");
+  for(ptrdiff_t n : sizes) {
+    std::vector<double> a(n*s*s), b(s*s*n), c(n*n);
+    for(size_t i=0; i<a.size(); i++) a[i] = std::sin(double(i));
+    for(size_t i=0; i<b.size(); i++) b[i] = std::cos(double(i));
+    const basic_mdspan<double,extents_3,layout_right> A(a.data(),n,s,s), B(b.data(),s,s,n);
+    const basic_mdspan<double,extents_2,layout_right> A2(a.data(),n,s*s), B2(b.data(),s*s,n), C(c.data(),n,n);
+    const double flops = 2.0*double(n)*double(n)*double(s*s);
+
+    const double t_naive = seconds_per_call([&]{
+      for(ptrdiff_t i=0; i<n; i++)
+      for(ptrdiff_t j=0; j<n; j++) {
+        double sum = 0.0;
+        for(ptrdiff_t k=0; k<s; k++)
+        for(ptrdiff_t l=0; l<s; l++) sum += A(i,k,l) * B(l,k,j);
+        C(i,j) = sum;
+      }
+    });
+    const double t_packed = seconds_per_call([&]{ linalg::contract("ikl,lkj->ij",A,B,C); });
+    const double t_fused = seconds_per_call([&]{ linalg::contract("ikl,klj->ij",A,B,C); });
+    const double t_gemm = seconds_per_call([&]{ linalg::matrix_product(A2,B2,C); });
+    std::printf("%8td %12.2f %12.2f %12.2f %12.2f\n",n,flops/t_naive*1e-9,flops/t_packed*1e-9,
+                flops/t_fused*1e-9,flops/t_gemm*1e-9);
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+
+// K sequences of plane rotations applied to the rows of an n x n
+// layout_right matrix: one rotation at a time with givens_rotation_apply
+// on two rows, and givens_rotation_sequence_apply.  A rotation costs six
+// flops per entry of a row.
+// Usage: bench_givens [n ...]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef extents<dynamic_extent,dynamic_extent> extents_2;
+typedef basic_mdspan<double,extents_2,layout_right> matrix_type;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+void run(ptrdiff_t n, ptrdiff_t K) {
+  std::vector<double> a_data(n*n), c_data(K*(n-1)), s_data(K*(n-1));
+  for(ptrdiff_t i=0; i<n*n; i++) a_data[i] = double(i % 17) - 8.0;
+  // Rotations through small angles keep the entries bounded over repeats.
+  for(ptrdiff_t i=0; i<K*(n-1); i++) {
+    const double theta = 1e-3*double(i % 13);
+    c_data[i] = std::cos(theta);
+    s_data[i] = std::sin(theta);
+  }
+  matrix_type a(a_data.data(),n,n), c(c_data.data(),K,n-1), s(s_data.data(),K,n-1);
+
+  const double t_naive = seconds_per_call([&]{
+    for(ptrdiff_t k=0; k<K; k++)
+      for(ptrdiff_t j=0; j<n-1; j++)
+        linalg::givens_rotation_apply(subspan(a,j,all),subspan(a,j+1,all),c(k,j),s(k,j));
+  });
+  const double t_sequence = seconds_per_call([&]{
+    linalg::givens_rotation_sequence_apply(linalg::left_side,c,s,a);
+  });
+
+  const double flops = 6.0*double(K)*double(n-1)*double(n);
+  std::printf("%6td %6td   %8.2f   %8.2f\n",n,K,flops/t_naive*1e-9,flops/t_sequence*1e-9);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {256, 1024, 2048};
+  const ptrdiff_t K = 64;
+
+  std::printf("%6s %6s   %8s   %8s\n","n","K","naive","sequence");
+  std::printf("%6s %6s   %8s   %8s\n","","","Gflop/s","Gflop/s");
+  for(ptrdiff_t n : sizes) run(n,K);
+  return 0;
+}
@@ -0,0 +1,115 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Compares linalg::matrix_product against a naive triple loop for square
+// double matrices, and times matrix_product( scaled( alpha, A ), transposed( B ), C ),
+// which should run as fast as the plain product.
+// Usage: bench_matrix_product [n ...]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent>,layout_left> matrix_t;
+
+void naive_matrix_product(matrix_t A, matrix_t B, matrix_t C) {
+  for(ptrdiff_t j=0; j<C.extent(1); j++)
+  for(ptrdiff_t i=0; i<C.extent(0); i++) {
+    double sum = 0.0;
+    for(ptrdiff_t k=0; k<A.extent(1); k++) sum += A(i,k)*B(k,j);
+    C(i,j) = sum;
+  }
+}
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {64, 128, 256, 512, 1024};
+
+  std::printf("%8s %12s %12s %12s %10s\n","n","naive GF/s","blocked GF/s","scaled A B^T","max err");
+  for(ptrdiff_t n : sizes) {
+    std::vector<double> a(n*n), b(n*n), c0(n*n), c1(n*n), c2(n*n);
+    for(ptrdiff_t i=0; i<n*n; i++) {
+      a[i] = double(i%17)/17.0 - 0.5;
+      b[i] = double(i%13)/13.0 - 0.5;
+    }
+    matrix_t A(a.data(),n,n), B(b.data(),n,n), C0(c0.data(),n,n), C1(c1.data(),n,n), C2(c2.data(),n,n);
+
+    const double flops = 2.0*double(n)*double(n)*double(n);
+    const double t_naive = seconds_per_call([&]{ naive_matrix_product(A,B,C0); });
+    const double t_blocked = seconds_per_call([&]{ linalg::matrix_product(A,B,C1); });
+    const double t_fused = seconds_per_call([&]{ linalg::matrix_product(linalg::scaled(2.0,A),linalg::transposed(B),C2); });
+
+    double max_err = 0.0;
+    for(ptrdiff_t i=0; i<n*n; i++) {
+      const double err = c0[i] > c1[i] ? c0[i]-c1[i] : c1[i]-c0[i];
+      if(err > max_err) max_err = err;
+    }
+    std::printf("%8td %12.2f %12.2f %12.2f %10.2e\n",n,flops/t_naive*1e-9,flops/t_blocked*1e-9,flops/t_fused*1e-9,max_err);
+  }
+  return 0;
+}
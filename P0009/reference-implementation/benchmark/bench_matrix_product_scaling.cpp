@@ -0,0 +1,99 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Strong scaling of the multithreaded linalg::matrix_product for one
+// square double matrix size, from one thread up to all hardware threads.
+// Usage: bench_matrix_product_scaling [n [max_threads]]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  const ptrdiff_t n = argc > 1 ? std::atol(argv[1]) : 2048;
+  size_t max_threads = argc > 2 ? std::atol(argv[2]) : std::thread::hardware_concurrency();
+  if(max_threads < 1) max_threads = 1;
+
+  std::vector<double> a(n*n), b(n*n), c(n*n);
+  for(ptrdiff_t i=0; i<n*n; i++) {
+    a[i] = double(i%17)/17.0 - 0.5;
+    b[i] = double(i%13)/13.0 - 0.5;
+  }
+  typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent>,layout_left> matrix_t;
+  matrix_t A(a.data(),n,n), B(b.data(),n,n), C(c.data(),n,n);
+
+  const double flops = 2.0*double(n)*double(n)*double(n);
+  std::printf("n = %td\n%8s %10s %10s %10s\n",n,"threads","GF/s","speedup","efficiency");
+  double t_one = 0.0;
+  for(size_t p=1; p<=max_threads; p = (p == max_threads || 2*p <= max_threads) ? 2*p : max_threads) {
+    const double t = seconds_per_call([&]{ linalg::matrix_product(linalg::thread_pool_policy(p),A,B,C); });
+    if(p == 1) t_one = t;
+    std::printf("%8zu %10.2f %10.2f %10.2f\n",p,flops/t*1e-9,t_one/t,t_one/t/double(p));
+  }
+  return 0;
+}
@@ -0,0 +1,109 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+// Memory throughput of the multithreaded linalg::matrix_vector_product
+// for square, tall-skinny and short-wide double matrices stored by rows
+// and by columns, from one thread up to all hardware threads.
+// Usage: bench_matrix_vector_product [entries [max_threads]]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 0.5);
+  return best;
+}
+
+template<class Layout>
+void run(const char* label, const ptrdiff_t m, const ptrdiff_t n, const size_t max_threads) {
+  std::vector<double> a(m*n), x(n), y(m);
+  for(ptrdiff_t k=0; k<m*n; k++) a[k] = double(k%23)/23.0;
+  for(ptrdiff_t j=0; j<n; j++) x[j] = 1.0;
+  basic_mdspan<double,extents<dynamic_extent,dynamic_extent>,Layout> A(a.data(),m,n);
+  mdspan<double,dynamic_extent> X(x.data(),n), Y(y.data(),m);
+
+  const double gb = 1e-9*sizeof(double)*double(m*n + m + n);
+  for(size_t p=1; p<=max_threads; p = (p == max_threads || 2*p <= max_threads) ? 2*p : max_threads) {
+    const double t = seconds_per_call([&]{ linalg::matrix_vector_product(linalg::thread_pool_policy(p),A,X,Y); });
+    std::printf("%-8s %8td x %-8td %8zu %10.2f\n",label,m,n,p,gb/t);
+  }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  const ptrdiff_t entries = argc > 1 ? std::atol(argv[1]) : (1 << 24);
+  size_t max_threads = argc > 2 ? std::atol(argv[2]) : std::thread::hardware_concurrency();
+  if(max_threads < 1) max_threads = 1;
+
+  ptrdiff_t square = 1;
+  while(4*square*square <= entries) square *= 2;
+  std::printf("%-8s %19s %8s %10s\n","layout","m x n","threads","GB/s");
+  for(int layout=0; layout<2; layout++) {
+    const ptrdiff_t shapes[3][2] = {{square,square},{entries/8,8},{8,entries/8}};
+    for(const auto& shape : shapes) {
+      if(layout == 0) run<layout_right>("right",shape[0],shape[1],max_threads);
+      else run<layout_left>("left",shape[0],shape[1],max_threads);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Compares float storage with double accumulation against all-float and
+// all-double, for linalg::dot over long vectors and linalg::matrix_product
+// over square matrices.  The error column is the largest difference from
+// the all-double result.
+// Usage: bench_mixed_precision [n ...]   (matrix sizes)
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+template<class T>
+using matrix_t = basic_mdspan<T,extents<dynamic_extent,dynamic_extent>,layout_right>;
+template<class T>
+using vector_t = basic_mdspan<T,extents<dynamic_extent>,layout_right>;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+double value(ptrdiff_t i, int seed) {
+  return std::sin(double(i)*0.37 + seed) * (1.0 + double(i % 7) * 1e-3);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {128, 256, 512, 1024};
+
+  std::printf("%8s %10s %12s %12s %12s %12s %12s\n","dot n","","float GB/s","f/d GB/s","double GB/s",
+              "float err","f/d err");
+  for(ptrdiff_t n : {ptrdiff_t(1) << 16, ptrdiff_t(1) << 22}) {
+    std::vector<float> xf(n), yf(n);
+    std::vector<double> xd(n), yd(n);
+    for(ptrdiff_t i=0; i<n; i++) {
+      xf[i] = float(value(i,1)); yf[i] = float(value(i,2));
+      xd[i] = xf[i]; yd[i] = yf[i];
+    }
+    const vector_t<float> x_f(xf.data(),n), y_f(yf.data(),n);
+    const vector_t<double> x_d(xd.data(),n), y_d(yd.data(),n);
+    volatile double sink = 0.0;
+    float r_f = 0.0f; double r_fd = 0.0, r_d = 0.0;
+    const double t_f = seconds_per_call([&]{ r_f = linalg::dot(x_f,y_f,0.0f); sink = r_f; });
+    const double t_fd = seconds_per_call([&]{ r_fd = linalg::dot(x_f,y_f,0.0); sink = r_fd; });
+    const double t_d = seconds_per_call([&]{ r_d = linalg::dot(x_d,y_d,0.0); sink = r_d; });
+    (void) sink;
+    std::printf("%8td %10s %12.2f %12.2f %12.2f %12.2e %12.2e\n",n,"",8.0*n/t_f*1e-9,8.0*n/t_fd*1e-9,
+                16.0*n/t_d*1e-9,std::abs(r_f-r_d),std::abs(r_fd-r_d));
+  }
+
+  std::printf("\n%8s %10s %12s %12s %12s %12s %12s\n","gemm n","","float GF/s","f/d GF/s","double GF/s",
+              "float err","f/d err");
+  for(ptrdiff_t n : sizes) {
+    std::vector<float> af(n*n), bf(n*n), cf(n*n), cfd(n*n);
+    std::vector<double> ad(n*n), bd(n*n), cd(n*n);
+    for(ptrdiff_t i=0; i<n*n; i++) {
+      af[i] = float(value(i,3)); bf[i] = float(value(i,4));
+      ad[i] = af[i]; bd[i] = bf[i];
+    }
+    const matrix_t<float> A_f(af.data(),n,n), B_f(bf.data(),n,n), C_f(cf.data(),n,n), C_fd(cfd.data(),n,n);
+    const matrix_t<double> A_d(ad.data(),n,n), B_d(bd.data(),n,n), C_d(cd.data(),n,n);
+    const double flops = 2.0*double(n)*double(n)*double(n);
+    const double t_f = seconds_per_call([&]{ linalg::matrix_product(A_f,B_f,C_f); });
+    const double t_fd = seconds_per_call([&]{ linalg::matrix_product(linalg::accumulator<double>,A_f,B_f,C_fd); });
+    const double t_d = seconds_per_call([&]{ linalg::matrix_product(A_d,B_d,C_d); });
+
+    double err_f = 0.0, err_fd = 0.0;
+    for(ptrdiff_t i=0; i<n*n; i++) {
+      err_f = std::max(err_f,std::abs(double(cf[i])-cd[i]));
+      err_fd = std::max(err_fd,std::abs(double(cfd[i])-cd[i]));
+    }
+    std::printf("%8td %10s %12.2f %12.2f %12.2f %12.2e %12.2e\n",n,"",flops/t_f*1e-9,flops/t_fd*1e-9,
+                flops/t_d*1e-9,err_f,err_fd);
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Times many independent small matrix_product calls on fully static
+// extents, which take the unrolled kernels, against the same calls on
+// dynamic extents, which take the general blocked path.
+// Usage: bench_small_static
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+template<ptrdiff_t N>
+void run() {
+  typedef basic_mdspan<double,extents<N,N>,layout_left> static_t;
+  typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent>,layout_left> dynamic_t;
+  const ptrdiff_t count = (1<<20)/(N*N);
+  std::vector<double> a(count*N*N), b(count*N*N), c0(count*N*N), c1(count*N*N);
+  for(size_t i=0; i<a.size(); i++) {
+    a[i] = double(i%17)/17.0 - 0.5;
+    b[i] = double(i%13)/13.0 - 0.5;
+  }
+
+  const double flops = 2.0*double(N)*double(N)*double(N)*double(count);
+  const double t_static = seconds_per_call([&]{
+    for(ptrdiff_t p=0; p<count; p++)
+      linalg::matrix_product(static_t(a.data()+p*N*N),static_t(b.data()+p*N*N),static_t(c0.data()+p*N*N));
+  });
+  const double t_dynamic = seconds_per_call([&]{
+    for(ptrdiff_t p=0; p<count; p++)
+      linalg::matrix_product(dynamic_t(a.data()+p*N*N,N,N),dynamic_t(b.data()+p*N*N,N,N),dynamic_t(c1.data()+p*N*N,N,N));
+  });
+
+  double max_err = 0.0;
+  for(size_t i=0; i<c0.size(); i++) {
+    const double err = c0[i] > c1[i] ? c0[i]-c1[i] : c1[i]-c0[i];
+    if(err > max_err) max_err = err;
+  }
+  std::printf("%8td %12.2f %12.2f %10.2e\n",N,flops/t_static*1e-9,flops/t_dynamic*1e-9,max_err);
+}
+
+}
+
+int main() {
+  std::printf("%8s %12s %12s %10s\n","n","static GF/s","dynamic GF/s","max err");
+  run<2>();
+  run<3>();
+  run<4>();
+  run<8>();
+  run<16>();
+  return 0;
+}
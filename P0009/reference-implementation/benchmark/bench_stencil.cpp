@@ -0,0 +1,150 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// 7- and 27-point stencils on n^3 grids, stepped `steps` times: a naive
+// loop nest over a layout_right grid, stencil_apply once per step on a
+// layout_halo grid, and stencil_sweep, which blocks the steps in time.
+// Effective GB/s counts one read and one write of the grid per step, so
+// the temporal blocking can exceed the memory bandwidth.
+// Usage: bench_stencil [n ...]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<memory>
+#include<utility>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> extents_3;
+typedef basic_mdspan<double,extents_3,linalg::layout_halo<1>> halo_grid;
+typedef basic_mdspan<double,extents_3,layout_right> right_grid;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+struct aligned_free { void operator()(double * p) const { std::free(p); } };
+
+// A grid of span entries aligned to 64 bytes, zeroed.
+std::unique_ptr<double[],aligned_free> allocate(ptrdiff_t span) {
+  const size_t bytes = ((size_t(span)*sizeof(double) + 63) / 64) * 64;
+  double * p = static_cast<double*>(std::aligned_alloc(64, bytes));
+  for(ptrdiff_t i=0; i<span; i++) p[i] = 0.0;
+  return std::unique_ptr<double[],aligned_free>(p);
+}
+
+template<class Stencil>
+void run(const char * name, const Stencil & s, ptrdiff_t n, ptrdiff_t steps) {
+  // layout_right grids of (n+2)^3 whose interiors are stepped.
+  const ptrdiff_t m = n + 2;
+  auto a = allocate(m*m*m), b = allocate(m*m*m);
+  right_grid x(a.get(),m,m,m), y(b.get(),m,m,m);
+  for(ptrdiff_t i=0; i<m*m*m; i++) a[i] = b[i] = double(i % 17);
+
+  const double t_naive = seconds_per_call([&]{
+    for(ptrdiff_t t=0; t<steps; t++) {
+      for(ptrdiff_t i=1; i<=n; i++)
+      for(ptrdiff_t j=1; j<=n; j++)
+      for(ptrdiff_t k=1; k<=n; k++) {
+        double sum = 0.0;
+        for(const auto & p : s.points) sum += p.weight * x(i+p.offset[0],j+p.offset[1],k+p.offset[2]);
+        y(i,j,k) = sum;
+      }
+      std::swap(x,y);
+    }
+  });
+
+  const linalg::layout_halo<1>::mapping<extents_3> map(extents_3(n,n,n));
+  auto c = allocate(map.required_span_size()), d = allocate(map.required_span_size());
+  halo_grid u(c.get(),map), v(d.get(),map);
+  for(ptrdiff_t i=0; i<map.required_span_size(); i++) c[i] = d[i] = double(i % 17);
+
+  const double t_apply = seconds_per_call([&]{
+    for(ptrdiff_t t=0; t<steps; t++) {
+      linalg::stencil_apply(s,u,v);
+      std::swap(u,v);
+    }
+  });
+  const double t_sweep = seconds_per_call([&]{ linalg::stencil_sweep(s,steps,u,v); });
+
+  const double cells = double(n)*double(n)*double(n)*double(steps);
+  const double bytes = 2.0*sizeof(double)*cells;
+  std::printf("%6s %6td %6td   %8.2f %8.0f   %8.2f %8.0f   %8.2f %8.0f\n",name,n,steps,
+              bytes/t_naive*1e-9,cells/t_naive*1e-6,bytes/t_apply*1e-9,cells/t_apply*1e-6,
+              bytes/t_sweep*1e-9,cells/t_sweep*1e-6);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {64, 128, 256};
+  const ptrdiff_t steps = 8;
+
+  std::printf("%6s %6s %6s   %17s   %17s   %17s\n","","n","steps","naive","stencil_apply","stencil_sweep");
+  std::printf("%6s %6s %6s   %8s %8s   %8s %8s   %8s %8s\n","","","","GB/s","Mcell/s","GB/s","Mcell/s","GB/s","Mcell/s");
+  for(ptrdiff_t n : sizes) {
+    run("7pt",linalg::seven_point_stencil(0.4,0.1),n,steps);
+    run("27pt",linalg::twenty_seven_point_stencil(0.2,0.05,0.025,0.0125),n,steps);
+  }
+  return 0;
+}
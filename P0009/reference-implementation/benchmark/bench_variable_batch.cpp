@@ -0,0 +1,133 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Compares linalg::variable_batch_matrix_product against a loop of single
+// matrix_product calls over the same problems, serial and on all cores,
+// for a batch of square double matrices whose sizes are skewed like a
+// real workload: mostly tiny, some medium and a few large.
+// Usage: bench_variable_batch [num_problems]
+
+#include<experimental/linalg>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<thread>
+#include<tuple>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef basic_mdspan<double,extents<dynamic_extent,dynamic_extent>,layout_right> matrix_t;
+typedef std::tuple<matrix_t,matrix_t,matrix_t> problem_t;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 1.0);
+  return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  const ptrdiff_t count = argc > 1 ? std::atol(argv[1]) : 20000;
+
+  const size_t num_threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+  linalg::thread_pool_policy exec(num_threads);
+
+  // One problem in 1000 is 256, one in 50 is 32 to 128, the rest 2 to 16.
+  std::vector<ptrdiff_t> sizes(count);
+  ptrdiff_t total = 0;
+  double flops = 0.0;
+  for(ptrdiff_t q=0; q<count; q++) {
+    sizes[q] = q % 1000 == 0 ? 256 : q % 50 == 0 ? 32 * (1 + q/50 % 4) : 2 + (q*7) % 15;
+    total += sizes[q]*sizes[q];
+    flops += 2.0*double(sizes[q])*double(sizes[q])*double(sizes[q]);
+  }
+
+  std::vector<double> a(total), b(total), c0(total), c1(total);
+  for(ptrdiff_t i=0; i<total; i++) {
+    a[i] = double(i%17)/17.0 - 0.5;
+    b[i] = double(i%13)/13.0 - 0.5;
+  }
+  std::vector<problem_t> problems0, problems1;
+  for(ptrdiff_t q=0, offset=0; q<count; offset += sizes[q]*sizes[q], q++) {
+    const ptrdiff_t n = sizes[q];
+    const matrix_t A(a.data()+offset,n,n), B(b.data()+offset,n,n);
+    problems0.emplace_back(A,B,matrix_t(c0.data()+offset,n,n));
+    problems1.emplace_back(A,B,matrix_t(c1.data()+offset,n,n));
+  }
+
+  const double t_loop = seconds_per_call([&]{
+    for(const problem_t& p : problems0) linalg::matrix_product(std::get<0>(p),std::get<1>(p),std::get<2>(p));
+  });
+  const double t_loop_par = seconds_per_call([&]{
+    for(const problem_t& p : problems0) linalg::matrix_product(exec,std::get<0>(p),std::get<1>(p),std::get<2>(p));
+  });
+  const double t_batch = seconds_per_call([&]{ linalg::variable_batch_matrix_product(problems1); });
+  const double t_batch_par = seconds_per_call([&]{ linalg::variable_batch_matrix_product(exec,problems1); });
+
+  double max_err = 0.0;
+  for(ptrdiff_t i=0; i<total; i++) {
+    const double err = c0[i] > c1[i] ? c0[i]-c1[i] : c1[i]-c0[i];
+    if(err > max_err) max_err = err;
+  }
+
+  std::printf("%8s %8s %12s %12s %12s %12s %10s\n","problems","threads","loop GF/s","loop par GF/s",
+              "batch GF/s","batch par GF/s","max err");
+  std::printf("%8td %8zu %12.2f %12.2f %12.2f %12.2f %10.2e\n",count,num_threads,flops/t_loop*1e-9,
+              flops/t_loop_par*1e-9,flops/t_batch*1e-9,flops/t_batch_par*1e-9,max_err);
+  return 0;
+}
@@ -0,0 +1,139 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Compares the generic kernels with the linalg entry points, which hand
+// BLAS-compatible double operands to the vendor BLAS when the build
+// enables one (CMake option MDSPAN_ENABLE_BLAS).
+// Usage: bench_vendor_blas [n ...]
+
+#include<experimental/linalg>
+#include<algorithm>
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<functional>
+#include<vector>
+
+using namespace std::experimental::fundamentals_v3;
+
+namespace {
+
+typedef extents<dynamic_extent,dynamic_extent> matrix_extents;
+typedef basic_mdspan<double,extents<dynamic_extent>> vector_t;
+
+template<class Kernel>
+double seconds_per_call(Kernel kernel) {
+  typedef std::chrono::steady_clock clock;
+  double best = 1e30;
+  int repeats = 0;
+  clock::time_point start = clock::now();
+  do {
+    clock::time_point t0 = clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed = clock::now() - t0;
+    if(elapsed.count() < best) best = elapsed.count();
+    repeats++;
+  } while(repeats < 3 || std::chrono::duration<double>(clock::now()-start).count() < 0.5);
+  return best;
+}
+
+template<class Generic, class Dispatched>
+void report(const char* kernel, const double flops, Generic generic, Dispatched dispatched) {
+  const double t_generic = seconds_per_call(generic);
+  const double t_dispatched = seconds_per_call(dispatched);
+  std::printf("  %-22s %12.2f %12.2f %8.2f\n",kernel,flops/t_generic*1e-9,flops/t_dispatched*1e-9,t_generic/t_dispatched);
+}
+
+template<class Layout>
+void run(const char* label, const ptrdiff_t n) {
+  typedef basic_mdspan<double,matrix_extents,Layout> matrix_t;
+  std::vector<double> a(n*n), b(n*n), b0(n*n), c(n*n), x(n), x0(n), y(n);
+  for(ptrdiff_t k=0; k<n*n; k++) {
+    a[k] = double(k%17)/17.0 - 0.5;
+    b0[k] = double(k%13)/13.0 - 0.5;
+  }
+  // Diagonally dominant, so that the solves stay well scaled.
+  for(ptrdiff_t i=0; i<n; i++) { a[i*n+i] = double(n); x0[i] = double(i%7) - 3.0; }
+  matrix_t A(a.data(),n,n), B(b.data(),n,n), C(c.data(),n,n);
+  vector_t X(x.data(),n), Y(y.data(),n);
+  std::copy(b0.begin(),b0.end(),b.begin());
+  const double nd = double(n);
+
+  std::printf("%s n = %td\n",label,n);
+  report("matrix_product",2.0*nd*nd*nd,
+    [&]{ linalg::detail::matrix_product_blocked<double>(A,B,C,linalg::detail::gemm_update::assign); },
+    [&]{ linalg::matrix_product(A,B,C); });
+  report("scaled(A) * B^T",2.0*nd*nd*nd,
+    [&]{ linalg::detail::matrix_product_blocked<double>(A,linalg::transposed(B),C,linalg::detail::gemm_update::assign,2.0); },
+    [&]{ linalg::matrix_product(linalg::scaled(2.0,A),linalg::transposed(B),C); });
+  report("matrix_vector_product",2.0*nd*nd,
+    [&]{ linalg::detail::matrix_vector_update(A,X,Y); },
+    [&]{ linalg::matrix_vector_product(A,X,Y,Y); });
+  report("trsm lower left",nd*nd*nd,
+    [&]{ std::copy(b0.begin(),b0.end(),b.begin());
+         linalg::detail::triangular_matrix_matrix_solve<true>(A,linalg::lower_triangle,linalg::explicit_diagonal,B,std::divides<>()); },
+    [&]{ std::copy(b0.begin(),b0.end(),b.begin());
+         linalg::triangular_matrix_matrix_left_solve(A,linalg::lower_triangle,linalg::explicit_diagonal,B); });
+  report("trsv upper",nd*nd,
+    [&]{ std::copy(x0.begin(),x0.end(),x.begin());
+         linalg::detail::triangular_solve_in_place(A,linalg::upper_triangle,linalg::explicit_diagonal,X,std::divides<>()); },
+    [&]{ std::copy(x0.begin(),x0.end(),x.begin());
+         linalg::triangular_matrix_vector_solve(A,linalg::upper_triangle,linalg::explicit_diagonal,X); });
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<ptrdiff_t> sizes;
+  for(int i=1; i<argc; i++) sizes.push_back(std::atol(argv[i]));
+  if(sizes.empty()) sizes = {128, 512, 1024};
+
+  std::printf("vendor BLAS %s\n",linalg::detail::vendor_blas_enabled ? "enabled" : "disabled");
+  std::printf("  %-22s %12s %12s %8s\n","kernel","generic GF/s","entry GF/s","speedup");
+  for(ptrdiff_t n : sizes) {
+    run<layout_left>("layout_left",n);
+    run<layout_right>("layout_right",n);
+  }
+  return 0;
+}
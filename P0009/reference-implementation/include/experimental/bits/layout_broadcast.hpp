@@ -0,0 +1,228 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+// Strided layout which permits zero strides.  A dimension with stride zero
+// is a broadcast dimension: all of its indices map to the same offsets,
+// so the mapping is not unique.
+class layout_broadcast ;
+
+}}}
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+class layout_broadcast {
+public:
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    using stride_t = array<ptrdiff_t,Extents::rank()> ;
+
+    Extents   m_extents ;
+    stride_t  m_stride ;
+    int       m_contig ;
+    int       m_unique ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_broadcast ;
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    mapping( const Extents & ext, const stride_t & str ) noexcept
+      : m_extents(ext), m_stride(str), m_contig(1), m_unique(1)
+      {
+        // Broadcast dimensions neither add to the span nor leave holes
+        // in it, so contiguity is decided by the remaining dimensions.
+        int p[ Extents::rank() ? Extents::rank() : 1 ];
+        size_t n = 0 ;
+
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
+
+          if ( m_stride[i] == 0 ) {
+            if ( m_extents.extent(i) > 1 ) { m_unique = 0 ; }
+            continue ;
+          }
+
+          int j = n ;
+
+          while ( j && m_stride[i] < m_stride[ p[j-1] ] )
+           { p[j] = p[j-1] ; --j ; }
+
+          p[j] = i ;
+          ++n ;
+        }
+
+        if ( n && m_stride[ p[0] ] != 1 ) { m_contig = 0 ; }
+
+        for ( size_t i = 1 ; i < n ; ++i ) {
+          const int j = p[i-1];
+          const int k = p[i];
+          const index_type prev = m_stride[j] * m_extents.extent(j);
+          if ( m_stride[k] != prev ) { m_contig = 0 ; }
+        }
+      }
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+  private:
+
+    // i0 * S0 + i1 * S1 + i2 * S2 + ...
+
+    constexpr index_type
+    offset(size_t) const noexcept
+      { return 0 ; }
+
+    template<class... IndexType >
+    constexpr index_type
+    offset( const size_t K, const index_type i, IndexType... indices ) const noexcept
+      { return i * m_stride[K] + offset(K+1,indices...); }
+
+  public:
+
+    index_type required_span_size() const noexcept
+      {
+        index_type size = 1 ;
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
+          if ( m_extents.extent(i) == 0 ) return 0 ;
+          size += m_stride[i] * ( m_extents.extent(i) - 1 );
+        }
+        return size ;
+      }
+
+    template<class ... Indices >
+    constexpr
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    operator()( Indices ... indices ) const noexcept
+      { return offset(0, indices... ); }
+
+    static constexpr bool is_always_unique()     noexcept { return false ; }
+    static constexpr bool is_always_contiguous() noexcept { return false ; }
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+
+    constexpr bool is_unique()     const noexcept { return m_unique ; }
+    constexpr bool is_contiguous() const noexcept { return m_contig ; }
+    constexpr bool is_strided()    const noexcept { return true ; }
+
+    constexpr index_type stride(size_t r) const noexcept
+      { return m_stride[r]; }
+
+    // [mdspan.submdspan.mapping]
+
+    // Slicing never creates new broadcast dimensions, but must keep
+    // the existing ones, so the result stays a layout_broadcast.
+    template<class ... SliceSpecifiers>
+    friend auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      {
+        auto sub = detail::submdspan_mapping_impl<layout_stride>( src, slices... );
+        typedef typename decltype(sub.mapping)::extents_type sub_extents_type;
+        typedef layout_broadcast::mapping<sub_extents_type> sub_mapping_type;
+
+        array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
+        for ( size_t r = 0 ; r < sub_extents_type::rank() ; ++r )
+          sub_strides[r] = sub.mapping.stride(r);
+
+        return submdspan_mapping_result<sub_mapping_type>{
+          sub_mapping_type(sub.mapping.extents(),sub_strides), sub.offset };
+      }
+
+  }; // class mapping
+
+}; // class layout_broadcast
+
+//--------------------------------------------------------------------------
+
+// View the rank-1 x as a num_rows by x.extent(0) matrix, every row of which is x.
+template<class ElementType, ptrdiff_t E0, class LayoutPolicy, class AccessorPolicy>
+basic_mdspan<ElementType, extents<dynamic_extent,E0>, layout_broadcast, AccessorPolicy>
+  broadcast_rows( const basic_mdspan<ElementType, extents<E0>, LayoutPolicy, AccessorPolicy>& x,
+                  const ptrdiff_t num_rows ) noexcept
+  {
+    typedef extents<dynamic_extent,E0> sub_extents_type;
+    typedef layout_broadcast::mapping<sub_extents_type> mapping_type;
+    sub_extents_type ext;
+    if constexpr ( E0 == dynamic_extent ) ext = sub_extents_type( num_rows, x.extent(0) );
+    else ext = sub_extents_type( num_rows );
+    const mapping_type map( ext, array<ptrdiff_t,2>{{ 0, x.stride(0) }} );
+    return basic_mdspan<ElementType,sub_extents_type,layout_broadcast,AccessorPolicy>( x.data(), map, x.accessor() );
+  }
+
+// View the rank-1 x as a x.extent(0) by num_cols matrix, every column of which is x.
+template<class ElementType, ptrdiff_t E0, class LayoutPolicy, class AccessorPolicy>
+basic_mdspan<ElementType, extents<E0,dynamic_extent>, layout_broadcast, AccessorPolicy>
+  broadcast_columns( const basic_mdspan<ElementType, extents<E0>, LayoutPolicy, AccessorPolicy>& x,
+                     const ptrdiff_t num_cols ) noexcept
+  {
+    typedef extents<E0,dynamic_extent> sub_extents_type;
+    typedef layout_broadcast::mapping<sub_extents_type> mapping_type;
+    sub_extents_type ext;
+    if constexpr ( E0 == dynamic_extent ) ext = sub_extents_type( x.extent(0), num_cols );
+    else ext = sub_extents_type( num_cols );
+    const mapping_type map( ext, array<ptrdiff_t,2>{{ x.stride(0), 0 }} );
+    return basic_mdspan<ElementType,sub_extents_type,layout_broadcast,AccessorPolicy>( x.data(), map, x.accessor() );
+  }
+
+}}} // experimental::fundamentals_v3
@@ -0,0 +1,323 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+// [mdspan.layout.leftpadded], [mdspan.layout.rightpadded] of P2642:
+// layout_left (layout_right) whose stride of the second (second to last)
+// dimension is padded to a multiple of PaddingValue, which may be
+// dynamic_extent.  The innermost dimension always has unit stride, so
+// submatrices of layout_left or layout_right views are in these layouts.
+template<ptrdiff_t PaddingValue = dynamic_extent>
+class layout_left_padded ;
+
+template<ptrdiff_t PaddingValue = dynamic_extent>
+class layout_right_padded ;
+
+namespace detail {
+
+// The least multiple of x not smaller than y, or y if x is zero.
+constexpr ptrdiff_t least_multiple_at_least( const ptrdiff_t x, const ptrdiff_t y ) noexcept {
+  return x == 0 ? y : x * ( ( y + x - 1 ) / x );
+}
+
+// The padded stride if PaddingValue and the static extent of the
+// innermost dimension are both known, else dynamic_extent.
+constexpr ptrdiff_t static_padding_stride( const ptrdiff_t padding_value, const ptrdiff_t static_extent ) noexcept {
+  return padding_value == dynamic_extent || static_extent == dynamic_extent ? ptrdiff_t( dynamic_extent )
+                                                                             : least_multiple_at_least( padding_value, static_extent );
+}
+
+template<class Layout>
+struct is_layout_left_padded : false_type {};
+
+template<ptrdiff_t PaddingValue>
+struct is_layout_left_padded<layout_left_padded<PaddingValue>> : true_type {};
+
+template<class Layout>
+struct is_layout_right_padded : false_type {};
+
+template<ptrdiff_t PaddingValue>
+struct is_layout_right_padded<layout_right_padded<PaddingValue>> : true_type {};
+
+}
+
+}}}
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+template<ptrdiff_t PaddingValue>
+class layout_left_padded {
+public:
+
+  static_assert( PaddingValue == dynamic_extent || PaddingValue > 0, "" );
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    // Dimension 0 has unit stride, dimension 1 the padded stride.
+    static constexpr size_t padded_rank = Extents::rank() > 1 ? 1 : 0 ;
+
+    Extents   m_extents {} ;
+    ptrdiff_t m_padded_stride = 0 ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_left_padded ;
+
+    static constexpr ptrdiff_t padding_value = PaddingValue ;
+
+    // Stride of dimension 1 if it is known at compile time, else dynamic_extent.
+    static constexpr ptrdiff_t static_padding_stride =
+      detail::static_padding_stride( PaddingValue, Extents::rank() > 1 ? Extents::static_extent(0) : 1 );
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    // Pads to PaddingValue; not at all if it is dynamic_extent.
+    constexpr mapping( const Extents & ext ) noexcept
+      : m_extents( ext )
+      , m_padded_stride( Extents::rank() < 2 ? 0 : PaddingValue == dynamic_extent ? ext.extent(0)
+                         : detail::least_multiple_at_least( PaddingValue, ext.extent(0) ) )
+      {}
+
+    // Requires padding == PaddingValue unless PaddingValue is dynamic_extent.
+    constexpr mapping( const Extents & ext, const index_type padding ) noexcept
+      : m_extents( ext )
+      , m_padded_stride( Extents::rank() > 1 ? detail::least_multiple_at_least( padding, ext.extent(0) ) : 0 )
+      {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+  private:
+
+    // i0 + S1 * ( i1 + N1 * ( i2 + N2 * ( ... ) ) )
+
+    static constexpr index_type
+    offset( size_t ) noexcept
+      { return 0 ; }
+
+    template<class ... IndexType >
+    constexpr index_type
+    offset( const size_t r, index_type i, IndexType... indices ) const noexcept
+      { return i + ( r == 0 ? m_padded_stride : m_extents.extent(r) ) * offset( r+1, indices... ); }
+
+  public:
+
+    constexpr index_type required_span_size() const noexcept {
+      if constexpr ( Extents::rank() < 2 ) return Extents::rank() == 0 ? 1 : m_extents.extent(0) ;
+      else {
+        index_type size = m_padded_stride ;
+        for ( size_t r = 1 ; r < Extents::rank() ; ++r ) size *= m_extents.extent(r);
+        return size ;
+      }
+    }
+
+    template<class ... Indices >
+    constexpr
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    operator()( Indices ... indices ) const noexcept
+      { return offset( 0, indices... ); }
+
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept
+      { return Extents::rank() < 2 || ( static_padding_stride != dynamic_extent &&
+                                        static_padding_stride == Extents::static_extent(0) ); }
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept
+      { return Extents::rank() < 2 || m_padded_stride == m_extents.extent(0) ; }
+    constexpr bool is_strided()    const noexcept { return true ; }
+
+    constexpr index_type stride( const size_t R ) const noexcept {
+      if ( R == 0 ) return 1 ;
+      index_type stride_ = m_padded_stride ;
+      for ( size_t r = padded_rank ; r < R ; ++r ) stride_ *= m_extents.extent(r);
+      return stride_ ;
+    }
+
+    // [mdspan.submdspan.mapping]
+
+    template<class ... SliceSpecifiers>
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      { return detail::submdspan_mapping_impl<layout_left_padded>( src, slices... ); }
+
+  }; // class mapping
+
+}; // class layout_left_padded
+
+template<ptrdiff_t PaddingValue>
+class layout_right_padded {
+public:
+
+  static_assert( PaddingValue == dynamic_extent || PaddingValue > 0, "" );
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    // Dimension rank-1 has unit stride, dimension rank-2 the padded stride.
+    static constexpr size_t last = Extents::rank() > 0 ? Extents::rank() - 1 : 0 ;
+    static constexpr size_t padded_rank = last > 0 ? last - 1 : 0 ;
+
+    Extents   m_extents {} ;
+    ptrdiff_t m_padded_stride = 0 ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_right_padded ;
+
+    static constexpr ptrdiff_t padding_value = PaddingValue ;
+
+    // Stride of dimension rank-2 if it is known at compile time, else dynamic_extent.
+    static constexpr ptrdiff_t static_padding_stride =
+      detail::static_padding_stride( PaddingValue, Extents::rank() > 1 ? Extents::static_extent(last) : 1 );
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    // Pads to PaddingValue; not at all if it is dynamic_extent.
+    constexpr mapping( const Extents & ext ) noexcept
+      : m_extents( ext )
+      , m_padded_stride( Extents::rank() < 2 ? 0 : PaddingValue == dynamic_extent ? ext.extent(last)
+                         : detail::least_multiple_at_least( PaddingValue, ext.extent(last) ) )
+      {}
+
+    // Requires padding == PaddingValue unless PaddingValue is dynamic_extent.
+    constexpr mapping( const Extents & ext, const index_type padding ) noexcept
+      : m_extents( ext )
+      , m_padded_stride( Extents::rank() > 1 ? detail::least_multiple_at_least( padding, ext.extent(last) ) : 0 )
+      {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+  private:
+
+    // ( ( i0 * N1 + i1 ) * ... + i_{rank-2} ) * S_{rank-2} + i_{rank-1}
+
+    static constexpr index_type
+    offset( const size_t , const ptrdiff_t sum )
+      { return sum; }
+
+    template<class ... Indices >
+    constexpr index_type
+    offset( const size_t r, ptrdiff_t sum, const index_type i, Indices... indices ) const noexcept
+      { return offset( r+1, sum * ( r == last ? m_padded_stride : m_extents.extent(r) ) + i, indices... ); }
+
+  public:
+
+    constexpr index_type required_span_size() const noexcept {
+      if constexpr ( Extents::rank() < 2 ) return Extents::rank() == 0 ? 1 : m_extents.extent(0) ;
+      else {
+        index_type size = m_padded_stride ;
+        for ( size_t r = 0 ; r < last ; ++r ) size *= m_extents.extent(r);
+        return size ;
+      }
+    }
+
+    template<class ... Indices >
+    constexpr
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    operator()( Indices ... indices ) const noexcept
+      { return offset( 0, 0, indices... ); }
+
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept
+      { return Extents::rank() < 2 || ( static_padding_stride != dynamic_extent &&
+                                        static_padding_stride == Extents::static_extent(last) ); }
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept
+      { return Extents::rank() < 2 || m_padded_stride == m_extents.extent(last) ; }
+    constexpr bool is_strided()    const noexcept { return true ; }
+
+    constexpr index_type stride( const size_t R ) const noexcept {
+      if ( R == last ) return 1 ;
+      index_type stride_ = m_padded_stride ;
+      for ( size_t r = padded_rank ; r > R ; --r ) stride_ *= m_extents.extent(r);
+      return stride_ ;
+    }
+
+    // [mdspan.submdspan.mapping]
+
+    template<class ... SliceSpecifiers>
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      { return detail::submdspan_mapping_impl<layout_right_padded>( src, slices... ); }
+
+  }; // class mapping
+
+}; // class layout_right_padded
+
+}}} // experimental::fundamentals_v3
@@ -53,6 +53,12 @@ class layout_right ;
 class layout_left ;
 class layout_stride ;
 
+namespace detail {
+  // [mdspan.submdspan.mapping], defined in subspan.hpp
+  template<class Layout, class Mapping, class ... SliceSpecifiers>
+  constexpr auto submdspan_mapping_impl( const Mapping & src, SliceSpecifiers ... slices );
+}
+
 }}}
 
 //--------------------------------------------------------------------------
@@ -76,6 +82,7 @@ public:
 
     using index_type = ptrdiff_t ;
     using extents_type = Extents ;
+    using layout_type = layout_right ;
 
     constexpr mapping() noexcept = default ;
 
@@ -137,6 +144,12 @@ public:
       return stride_;
     }
 
+    // [mdspan.submdspan.mapping]
+
+    template<class ... SliceSpecifiers>
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      { return detail::submdspan_mapping_impl<layout_right>( src, slices... ); }
+
   }; // class mapping
 
 }; // class layout_right
@@ -161,6 +174,7 @@ public:
 
     using index_type = ptrdiff_t ;
     using extents_type = Extents ;
+    using layout_type = layout_left ;
 
     constexpr mapping() noexcept = default ;
 
@@ -220,6 +234,12 @@ public:
       return stride_;
     }
 
+    // [mdspan.submdspan.mapping]
+
+    template<class ... SliceSpecifiers>
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      { return detail::submdspan_mapping_impl<layout_left>( src, slices... ); }
+
   }; // class mapping
 
 }; // class layout_left
@@ -250,6 +270,7 @@ public:
 
     using index_type = ptrdiff_t ;
     using extents_type = Extents ;
+    using layout_type = layout_stride ;
 
     constexpr mapping() noexcept = default ;
 
@@ -330,6 +351,12 @@ public:
     constexpr index_type stride(size_t r) const noexcept
       { return m_stride[r]; }
 
+    // [mdspan.submdspan.mapping]
+
+    template<class ... SliceSpecifiers>
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      { return detail::submdspan_mapping_impl<layout_stride>( src, slices... ); }
+
   }; // class mapping
 
 }; // class layout_stride
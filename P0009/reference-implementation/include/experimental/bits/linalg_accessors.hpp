@@ -0,0 +1,217 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.scaled.accessor_scaled]
+template<class ScalingFactor, class NestedAccessor>
+class scaled_accessor ;
+
+// [linalg.scaled.scaled]
+template<class ScalingFactor, class ElementType, class Extents, class Layout, class Accessor>
+auto scaled( ScalingFactor scaling_factor, const basic_mdspan<ElementType,Extents,Layout,Accessor> & a );
+
+// [linalg.conj.accessor_conjugate]
+template<class NestedAccessor>
+class conjugated_accessor ;
+
+// [linalg.conj.conjugated]
+template<class ElementType, class Extents, class Layout, class Accessor>
+auto conjugated( const basic_mdspan<ElementType,Extents,Layout,Accessor> & a );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Read-only accessor whose access( p, i ) is the scaling factor times
+// the nested accessor's access( p, i ).
+template<class ScalingFactor, class NestedAccessor>
+class scaled_accessor {
+public:
+  using element_type  = add_const_t<decltype( declval<ScalingFactor>() * declval<typename NestedAccessor::element_type>() )>;
+  using pointer       = typename NestedAccessor::pointer;
+  using offset_policy = scaled_accessor<ScalingFactor,typename NestedAccessor::offset_policy>;
+  using reference     = remove_const_t<element_type>;
+
+  constexpr scaled_accessor() = default ;
+
+  constexpr scaled_accessor( const ScalingFactor & s, const NestedAccessor & a )
+    : m_scaling_factor( s ), m_nested_accessor( a ) {}
+
+  template<class OtherNestedAccessor>
+  constexpr scaled_accessor( const scaled_accessor<ScalingFactor,OtherNestedAccessor> & other )
+    : m_scaling_factor( other.scaling_factor() ), m_nested_accessor( other.nested_accessor() ) {}
+
+  constexpr typename offset_policy::pointer
+    offset( pointer p , ptrdiff_t i ) const noexcept
+      { return m_nested_accessor.offset( p, i ); }
+
+  constexpr reference access( pointer p , ptrdiff_t i ) const noexcept
+    { return m_scaling_factor * typename NestedAccessor::element_type( m_nested_accessor.access( p, i ) ); }
+
+  constexpr auto decay( pointer p ) const noexcept
+    { return m_nested_accessor.decay( p ); }
+
+  constexpr const ScalingFactor & scaling_factor() const noexcept { return m_scaling_factor ; }
+
+  constexpr const NestedAccessor & nested_accessor() const noexcept { return m_nested_accessor ; }
+
+private:
+  ScalingFactor  m_scaling_factor ;
+  NestedAccessor m_nested_accessor ;
+};
+
+// Read-only accessor whose access( p, i ) is the complex conjugate of the
+// nested accessor's access( p, i ); real elements are returned as they are.
+template<class NestedAccessor>
+class conjugated_accessor {
+public:
+  using element_type  = add_const_t<decltype( detail::conj_if_needed( declval<typename NestedAccessor::element_type>() ) )>;
+  using pointer       = typename NestedAccessor::pointer;
+  using offset_policy = conjugated_accessor<typename NestedAccessor::offset_policy>;
+  using reference     = remove_const_t<element_type>;
+
+  constexpr conjugated_accessor() = default ;
+
+  constexpr conjugated_accessor( const NestedAccessor & a )
+    : m_nested_accessor( a ) {}
+
+  template<class OtherNestedAccessor>
+  constexpr conjugated_accessor( const conjugated_accessor<OtherNestedAccessor> & other )
+    : m_nested_accessor( other.nested_accessor() ) {}
+
+  constexpr typename offset_policy::pointer
+    offset( pointer p , ptrdiff_t i ) const noexcept
+      { return m_nested_accessor.offset( p, i ); }
+
+  constexpr reference access( pointer p , ptrdiff_t i ) const noexcept
+    { return detail::conj_if_needed( typename NestedAccessor::element_type( m_nested_accessor.access( p, i ) ) ); }
+
+  constexpr auto decay( pointer p ) const noexcept
+    { return m_nested_accessor.decay( p ); }
+
+  constexpr const NestedAccessor & nested_accessor() const noexcept { return m_nested_accessor ; }
+
+private:
+  NestedAccessor m_nested_accessor ;
+};
+
+template<class ScalingFactor, class ElementType, class Extents, class Layout, class Accessor>
+auto scaled( ScalingFactor scaling_factor, const basic_mdspan<ElementType,Extents,Layout,Accessor> & a ) {
+  typedef scaled_accessor<ScalingFactor,Accessor> accessor_type;
+  return basic_mdspan<typename accessor_type::element_type,Extents,Layout,accessor_type>(
+    a.data(), a.mapping(), accessor_type( scaling_factor, a.accessor() ) );
+}
+
+// Conjugating twice gives back the original view, and conjugating real
+// elements does nothing, so neither wraps the accessor.
+template<class ElementType, class Extents, class Layout, class Accessor>
+auto conjugated( const basic_mdspan<ElementType,Extents,Layout,Accessor> & a ) {
+  if constexpr ( ! detail::is_complex<remove_cv_t<ElementType>>::value ) {
+    return a ;
+  }
+  else {
+    typedef conjugated_accessor<Accessor> accessor_type;
+    return basic_mdspan<typename accessor_type::element_type,Extents,Layout,accessor_type>(
+      a.data(), a.mapping(), accessor_type( a.accessor() ) );
+  }
+}
+
+template<class ElementType, class Extents, class Layout, class NestedAccessor>
+auto conjugated( const basic_mdspan<ElementType,Extents,Layout,conjugated_accessor<NestedAccessor>> & a ) {
+  return basic_mdspan<typename NestedAccessor::element_type,Extents,Layout,NestedAccessor>(
+    a.data(), a.mapping(), a.accessor().nested_accessor() );
+}
+
+namespace detail {
+
+// Identity scaling factor: multiplying by it is free.
+struct no_scaling {};
+
+template<class T>
+constexpr T operator*( no_scaling, const T & t ) { return t ; }
+
+template<class T>
+constexpr T operator*( const T & t, no_scaling ) { return t ; }
+
+constexpr no_scaling operator*( no_scaling, no_scaling ) noexcept { return {} ; }
+
+// Split x into the product of the factors of the scaled() views wrapping
+// it and the unscaled view underneath, so that kernels read the stored
+// elements and apply the scaling once per result.
+template<class MDSpan>
+constexpr no_scaling scaling_factor_of( const MDSpan & ) noexcept { return {} ; }
+
+template<class ElementType, class Extents, class Layout, class ScalingFactor, class NestedAccessor>
+constexpr auto scaling_factor_of( const basic_mdspan<ElementType,Extents,Layout,scaled_accessor<ScalingFactor,NestedAccessor>> & x ) {
+  const basic_mdspan<typename NestedAccessor::element_type,Extents,Layout,NestedAccessor>
+    nested( x.data(), x.mapping(), x.accessor().nested_accessor() );
+  return x.accessor().scaling_factor() * scaling_factor_of( nested );
+}
+
+template<class MDSpan>
+constexpr const MDSpan & unscaled( const MDSpan & x ) noexcept { return x ; }
+
+template<class ElementType, class Extents, class Layout, class ScalingFactor, class NestedAccessor>
+constexpr auto unscaled( const basic_mdspan<ElementType,Extents,Layout,scaled_accessor<ScalingFactor,NestedAccessor>> & x ) {
+  const basic_mdspan<typename NestedAccessor::element_type,Extents,Layout,NestedAccessor>
+    nested( x.data(), x.mapping(), x.accessor().nested_accessor() );
+  return unscaled( nested );
+}
+
+} // namespace detail
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,804 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// Problem b of a batched argument whose problems have rank ProblemRank:
+// the slice at leftmost index b if the argument has the batch extent, or
+// the argument itself, broadcast to the whole batch, if it does not.
+template<size_t ProblemRank, class MDSpan>
+auto batch_problem( const MDSpan & x, const ptrdiff_t b ) {
+  if constexpr ( MDSpan::rank() == ProblemRank ) return x ;
+  else if constexpr ( ProblemRank == 1 ) return subspan( x, b, all );
+  else return subspan( x, b, all, all );
+}
+
+// Whether every problem of a batched argument is the same: it lacks the
+// batch extent, or its batch stride is zero (e.g. a layout_broadcast view).
+template<size_t ProblemRank, class MDSpan>
+bool is_batch_broadcast( const MDSpan & x ) {
+  if constexpr ( MDSpan::rank() == ProblemRank ) return true ;
+  else if constexpr ( MDSpan::is_always_strided() ) return x.extent(0) < 2 || x.stride(0) == 0 ;
+  else return x.extent(0) < 2 ;
+}
+
+// Number of entries of one problem of a batch.
+template<class MDSpan>
+ptrdiff_t batch_problem_size( const MDSpan & x ) {
+  ptrdiff_t size = 1 ;
+  for ( size_t r = 1 ; r < MDSpan::rank() ; ++r ) size *= x.extent(r);
+  return size ;
+}
+
+// Multiply-adds below which a batch runs on the calling thread alone,
+// per thread that would otherwise be woken: about one packed GEMM block.
+inline constexpr ptrdiff_t batch_parallel_grain = ptrdiff_t(1) << 17 ;
+
+// Call f(begin,end) on contiguous ranges of [0,n) on up to num_threads
+// threads, each range covering whole units of work, or once on [0,n) if
+// work multiply-adds are too few to share.  Ranges never overlap, so the
+// calls need not synchronize.
+template<class F>
+void batch_parallel_for( const ptrdiff_t n, const ptrdiff_t work, const size_t num_threads, F && f ) {
+  ptrdiff_t p = ptrdiff_t( num_threads ) < n ? ptrdiff_t( num_threads ) : n ;
+  if ( p > 1 && work < p * batch_parallel_grain ) p = 1 ;
+  if ( p < 2 ) {
+    f( ptrdiff_t(0), n );
+    return ;
+  }
+  thread_pool::instance().run( size_t( p ), [&]( const size_t rank, const size_t size, team_barrier & ) {
+    f( partition_begin( n, 1, ptrdiff_t( size ), ptrdiff_t( rank ) ),
+       partition_begin( n, 1, ptrdiff_t( size ), ptrdiff_t( rank )+1 ) );
+  });
+}
+
+// Problems per group when the batched algorithms interleave problems in
+// a buffer of their own: one cache line of elements.
+template<class T>
+constexpr ptrdiff_t interleave_lanes() noexcept {
+  return ptrdiff_t( sizeof(T) ) < 64 ? 64 / ptrdiff_t( sizeof(T) ) : 1 ;
+}
+
+// Whether x is a batch in layout_batch_interleaved over plain memory.
+template<class MDSpan>
+struct is_plain_interleaved
+  : integral_constant<bool, is_layout_batch_interleaved<typename MDSpan::layout_type>::value &&
+                            is_same<typename MDSpan::accessor_type,accessor_basic<typename MDSpan::element_type>>::value> {};
+
+// Whether all arguments are plain batch-interleaved with the same width.
+template<class First, class ... Rest>
+struct is_same_interleaved
+  : integral_constant<bool, is_plain_interleaved<First>::value &&
+                            ( ( is_plain_interleaved<Rest>::value &&
+                                is_same<typename Rest::layout_type,typename First::layout_type>::value ) && ... )> {};
+
+// Whether y = x converts between a plain layout_right batch and a plain
+// batch-interleaved one, in either direction.
+template<class InObj, class OutObj>
+struct is_interleave_conversion
+  : integral_constant<bool, InObj::rank() == OutObj::rank() &&
+                            ( ( is_same<typename InObj::layout_type,layout_right>::value &&
+                                is_same<typename InObj::accessor_type,accessor_basic<typename InObj::element_type>>::value &&
+                                is_plain_interleaved<OutObj>::value ) ||
+                              ( is_plain_interleaved<InObj>::value &&
+                                is_same<typename OutObj::layout_type,layout_right>::value &&
+                                is_same<typename OutObj::accessor_type,accessor_basic<typename OutObj::element_type>>::value ) )> {};
+
+// y = x, one group of W problems at a time: the interleaved side is
+// walked in storage order, the layout_right side as W parallel streams.
+template<class InObj, class OutObj>
+void interleave_copy( const InObj & x, const OutObj & y ) {
+  constexpr bool to_interleaved = is_layout_batch_interleaved<typename OutObj::layout_type>::value ;
+  typedef conditional_t<to_interleaved,OutObj,InObj> interleaved_type;
+  constexpr ptrdiff_t W = interleaved_type::layout_type::vector_width ;
+  const ptrdiff_t batch = y.extent(0);
+  const ptrdiff_t size = batch_problem_size( y );
+  const auto px = x.data();
+  const auto py = y.data();
+
+  for ( ptrdiff_t g = 0 ; g*W < batch ; ++g ) {
+    const ptrdiff_t lanes = W < batch-g*W ? W : batch-g*W ;
+    for ( ptrdiff_t e = 0 ; e < size ; ++e )
+      for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) {
+        if constexpr ( to_interleaved ) py[(g*size+e)*W+l] = px[(g*W+l)*size+e];
+        else py[(g*W+l)*size+e] = px[(g*size+e)*W+l];
+      }
+  }
+}
+
+template<class InObj, class OutObj>
+void batched_copy( const InObj & x, const OutObj & y ) {
+  if constexpr ( is_interleave_conversion<InObj,OutObj>::value ) {
+    interleave_copy( x, y );
+  }
+  else {
+    constexpr size_t problem_rank = OutObj::rank() - 1 ;
+    for ( ptrdiff_t b = 0 ; b < y.extent(0) ; ++b )
+      copy( batch_problem<problem_rank>( x, b ), batch_problem<problem_rank>( y, b ) );
+  }
+}
+
+//--------------------------------------------------------------------------
+// [linalg.algs.blas1.dot] batched, and the batched norms
+
+// Vectors at most this long are reduced across the batch rather than one
+// at a time: their own length is too short to fill the reduction lanes.
+inline constexpr ptrdiff_t batch_short_vector = 8 ;
+
+// Width of a batch-interleaved layout, or zero for any other layout.
+template<class Layout>
+constexpr ptrdiff_t batch_interleaved_width() noexcept {
+  if constexpr ( is_layout_batch_interleaved<Layout>::value ) return Layout::vector_width ;
+  else return 0 ;
+}
+
+// Whether entry k of problem b0+l of a batch of vectors (or of one vector
+// broadcast to the batch) is at a fixed offset plus l and k times fixed
+// strides, for every block of L problems starting at a multiple of L.
+template<ptrdiff_t L, class InObj>
+struct is_plain_batch_block
+  : integral_constant<bool, is_same<typename InObj::accessor_type,accessor_basic<typename InObj::element_type>>::value &&
+                            ( InObj::is_always_strided() ||
+                              ( batch_interleaved_width<typename InObj::layout_type>() > 0 &&
+                                batch_interleaved_width<typename InObj::layout_type>() % L == 0 ) )> {};
+
+// Reader f(l,k) of entry k of problem b0+l of x, through a raw pointer
+// when x is plain strided or batch-interleaved memory, else through x.
+template<ptrdiff_t L, class InObj>
+auto batch_block_reader( const InObj & x, const ptrdiff_t b0 ) {
+  constexpr size_t rank = InObj::rank() ;
+  if constexpr ( is_plain_batch_block<L,InObj>::value ) {
+    const auto p = x.data();
+    const ptrdiff_t n = x.extent( rank - 1 );
+    ptrdiff_t base = 0, lane_stride = 0, stride = 0 ;
+    if constexpr ( rank == 1 ) {
+      if ( n > 0 ) { base = x.mapping()(0); stride = x.stride(0); }
+    }
+    else if constexpr ( InObj::is_always_strided() ) {
+      if ( n > 0 ) { base = x.mapping()(b0,0); lane_stride = x.stride(0); stride = x.stride(1); }
+    }
+    else {
+      if ( n > 0 ) { base = x.mapping()(b0,0); lane_stride = 1; stride = InObj::layout_type::vector_width; }
+    }
+    return [=]( const ptrdiff_t l, const ptrdiff_t k ) -> decltype(auto) { return p[base + l*lane_stride + k*stride]; };
+  }
+  else if constexpr ( rank == 1 ) {
+    return [&x]( const ptrdiff_t, const ptrdiff_t k ) -> decltype(auto) { return x(k); };
+  }
+  else {
+    return [&x,b0]( const ptrdiff_t l, const ptrdiff_t k ) -> decltype(auto) { return x(b0+l,k); };
+  }
+}
+
+// Problems per block of a reduction across the batch: the width of the
+// first batch-interleaved argument, so that a block is one group, else
+// the reduction lanes of the result type.
+template<class Sum, class ... InObjs>
+constexpr ptrdiff_t batch_reduction_lanes() noexcept {
+  const ptrdiff_t widths[] = { batch_interleaved_width<typename InObjs::layout_type>()... };
+  for ( const ptrdiff_t w : widths ) if ( w > 0 ) return w ;
+  return reduction_lanes<Sum> ;
+}
+
+// Whether to reduce x across the batch: its vectors are short, or the
+// same entry of consecutive problems is adjacent in memory (interleaved
+// or layout_left batches), so that vectorizing across problems reads
+// whole cache lines.
+template<class InObj>
+bool is_batch_reduction_across( const InObj & x ) {
+  if constexpr ( InObj::rank() == 1 ) return x.extent(0) <= batch_short_vector ;
+  else if constexpr ( is_layout_batch_interleaved<typename InObj::layout_type>::value ) return true ;
+  else if constexpr ( InObj::is_always_strided() )
+    return x.extent(1) <= batch_short_vector || ( x.extent(0) > 1 && x.stride(0) == 1 );
+  else return x.extent(1) <= batch_short_vector ;
+}
+
+// sum[l] = f(l,0) + ... + f(l,n-1) for the lanes l < lanes <= L of a
+// block of problems.  The lanes are innermost, so a full block
+// vectorizes across problems.
+template<ptrdiff_t L, class Sum, class F>
+void lane_sums( const ptrdiff_t lanes, const ptrdiff_t n, F && f, Sum (&sum)[L] ) {
+  for ( ptrdiff_t l = 0 ; l < L ; ++l ) sum[l] = Sum{};
+  if ( lanes == L ) {
+    for ( ptrdiff_t k = 0 ; k < n ; ++k )
+      for ( ptrdiff_t l = 0 ; l < L ; ++l ) sum[l] += f(l,k);
+  }
+  else {
+    for ( ptrdiff_t k = 0 ; k < n ; ++k )
+      for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) sum[l] += f(l,k);
+  }
+}
+
+// out(b) = dot (or dotc) of problem b of x and y.  Short vectors are
+// reduced a block of problems at a time, long ones one problem at a time
+// by the unbatched kernels.
+template<bool Conjugate, class InVec1, class InVec2, class OutVec>
+void batched_dot( const InVec1 & x_in, const InVec2 & y_in, const OutVec & out ) {
+  static_assert( InVec1::rank() <= 2 && InVec2::rank() <= 2 && OutVec::rank() == 1, "" );
+  typedef typename OutVec::value_type sum_type;
+  const ptrdiff_t batch = out.extent(0);
+  const ptrdiff_t n = x_in.extent( InVec1::rank() - 1 );
+
+  auto reduce_across = [&]( const auto & x, const auto & y, const auto alpha ) {
+    constexpr ptrdiff_t L = batch_reduction_lanes<sum_type,decay_t<decltype(x)>,decay_t<decltype(y)>>();
+    for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += L ) {
+      const ptrdiff_t lanes = L < batch-b0 ? L : batch-b0 ;
+      const auto fx = batch_block_reader<L>( x, b0 );
+      const auto fy = batch_block_reader<L>( y, b0 );
+      sum_type sum[L] ;
+      lane_sums( lanes, n, [&]( const ptrdiff_t l, const ptrdiff_t k ) {
+        if constexpr ( Conjugate ) return product_as<sum_type>( conj_if_needed( fx(l,k) ), fy(l,k) );
+        else return product_as<sum_type>( fx(l,k), fy(l,k) );
+      }, sum );
+      for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) out(b0+l) = sum_type( alpha * sum[l] );
+    }
+  };
+
+  if ( is_batch_reduction_across( x_in ) || is_batch_reduction_across( y_in ) ) {
+    // dotc would need the conjugate of x's factor, so it leaves scaling to the accessors.
+    if constexpr ( Conjugate ) reduce_across( x_in, y_in, no_scaling{} );
+    else reduce_across( unscaled( x_in ), unscaled( y_in ), scaling_factor_of( x_in ) * scaling_factor_of( y_in ) );
+  }
+  else {
+    for ( ptrdiff_t b = 0 ; b < batch ; ++b ) {
+      if constexpr ( Conjugate ) out(b) = dotc( batch_problem<1>( x_in, b ), batch_problem<1>( y_in, b ), sum_type{} );
+      else out(b) = dot( batch_problem<1>( x_in, b ), batch_problem<1>( y_in, b ), sum_type{} );
+    }
+  }
+}
+
+// out(b) = the two-norm of problem b of x.  Across the batch, one pass
+// sums the unscaled squares and finds the largest magnitude of each
+// problem; the few problems whose sums may have overflowed or underflowed
+// (is_unscaled_norm_accurate) are redone with scaling, unless Bounded.
+template<bool Bounded, class InVec, class OutVec>
+void batched_vector_two_norm( const InVec & x, const OutVec & out ) {
+  static_assert( InVec::rank() == 2 && OutVec::rank() == 1, "" );
+  typedef typename OutVec::value_type real_type;
+  const ptrdiff_t batch = out.extent(0);
+  const ptrdiff_t n = x.extent(1);
+
+  if ( is_batch_reduction_across( x ) ) {
+    using std::sqrt;
+    constexpr ptrdiff_t L = batch_reduction_lanes<real_type,InVec>();
+    const real_type count = real_type( n ) * ( is_complex<typename InVec::value_type>::value ? real_type(2) : real_type(1) );
+    for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += L ) {
+      const ptrdiff_t lanes = L < batch-b0 ? L : batch-b0 ;
+      const auto f = batch_block_reader<L>( x, b0 );
+      real_type sum[L], amax[L] ;
+      for ( ptrdiff_t l = 0 ; l < L ; ++l ) { sum[l] = real_type{}; amax[l] = real_type{}; }
+      auto update = [&]( const ptrdiff_t l, const ptrdiff_t k ) {
+        for_each_component( f(l,k), [&]( const auto c ) {
+          const real_type a = abs_if_needed( real_type(c) );
+          sum[l] += a * a ;
+          amax[l] = amax[l] < a ? a : amax[l] ;
+        });
+      };
+      if ( lanes == L ) {
+        for ( ptrdiff_t k = 0 ; k < n ; ++k )
+          for ( ptrdiff_t l = 0 ; l < L ; ++l ) update( l, k );
+      }
+      else {
+        for ( ptrdiff_t k = 0 ; k < n ; ++k )
+          for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) update( l, k );
+      }
+      for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) {
+        if ( Bounded || is_unscaled_norm_accurate( sum[l], amax[l], count ) ) out(b0+l) = sqrt( sum[l] );
+        else out(b0+l) = vector_two_norm( batch_problem<1>( x, b0+l ), real_type{} );
+      }
+    }
+  }
+  else {
+    for ( ptrdiff_t b = 0 ; b < batch ; ++b ) {
+      if constexpr ( Bounded ) out(b) = vector_two_norm( bounded_values, batch_problem<1>( x, b ), real_type{} );
+      else out(b) = vector_two_norm( batch_problem<1>( x, b ), real_type{} );
+    }
+  }
+}
+
+// out(b) = the sum of the absolute values of problem b of x.
+template<class InVec, class OutVec>
+void batched_vector_abs_sum( const InVec & x, const OutVec & out ) {
+  static_assert( InVec::rank() == 2 && OutVec::rank() == 1, "" );
+  typedef typename OutVec::value_type sum_type;
+  const ptrdiff_t batch = out.extent(0);
+  const ptrdiff_t n = x.extent(1);
+
+  if ( is_batch_reduction_across( x ) ) {
+    constexpr ptrdiff_t L = batch_reduction_lanes<sum_type,InVec>();
+    for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += L ) {
+      const ptrdiff_t lanes = L < batch-b0 ? L : batch-b0 ;
+      const auto f = batch_block_reader<L>( x, b0 );
+      sum_type sum[L] ;
+      lane_sums( lanes, n, [&]( const ptrdiff_t l, const ptrdiff_t k ) { return sum_type( abs_sum_if_needed( f(l,k) ) ); }, sum );
+      for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) out(b0+l) = sum[l];
+    }
+  }
+  else {
+    for ( ptrdiff_t b = 0 ; b < batch ; ++b )
+      out(b) = vector_abs_sum( batch_problem<1>( x, b ), sum_type{} );
+  }
+}
+
+//--------------------------------------------------------------------------
+// [linalg.algs.blas3.gemm] batched
+
+// C(b,:,:) = alpha A(b,:,:) B(b,:,:), or += if update is add, for the
+// problems b in [b_begin,b_end).  One workspace serves the whole range.
+// Problems that fit in a single cache block skip the blocked loops and go
+// straight to the macro-kernel, and a broadcast operand is packed once
+// for the range instead of once per problem.
+template<class Accum, class InMat1, class InMat2, class OutMat, class Scale>
+void batched_matrix_product_range( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                                   const gemm_update update, const Scale alpha,
+                                   const ptrdiff_t b_begin, const ptrdiff_t b_end ) {
+  typedef gemm_blocking<Accum> blocking;
+  typedef typename InMat1::value_type a_value_type;
+
+  const ptrdiff_t m = C.extent(1);
+  const ptrdiff_t n = C.extent(2);
+  const ptrdiff_t k = A.extent( InMat1::rank() - 1 );
+
+  gemm_workspace<a_value_type,Accum,blocking> work(
+    blocking::mc < m ? blocking::mc : m, blocking::kc < k ? blocking::kc : k, blocking::nc < n ? blocking::nc : n );
+
+  if ( m <= blocking::mc && n <= blocking::nc && k <= blocking::kc ) {
+    const bool a_bcast = is_batch_broadcast<2>( A );
+    const bool b_bcast = is_batch_broadcast<2>( B );
+    for ( ptrdiff_t b = b_begin ; b < b_end ; ++b ) {
+      if ( b == b_begin || ! a_bcast )
+        pack_a<blocking::mr>( batch_problem<2>( A, b ), 0, m, 0, k, work.a_buf.data() );
+      if ( b == b_begin || ! b_bcast )
+        pack_b<blocking::nr>( batch_problem<2>( B, b ), 0, k, 0, n, work.b_buf.data() );
+      gemm_macro_kernel<Accum,blocking>( m, n, k, work.a_buf.data(), work.b_buf.data(),
+                                         batch_problem<2>( C, b ), 0, 0, update, alpha );
+    }
+  }
+  else {
+    for ( ptrdiff_t b = b_begin ; b < b_end ; ++b )
+      matrix_product_blocked<Accum>( batch_problem<2>( A, b ), batch_problem<2>( B, b ),
+                                     batch_problem<2>( C, b ), update, alpha, work );
+  }
+}
+
+// acc(j,l) = sum over p of a(p,l) b(p,j,l), for JB columns j of one row
+// of a group of W interleaved problems.  a steps by a_step and b by
+// b_step entries per p; the JB x W accumulator stays in registers.
+template<ptrdiff_t JB, ptrdiff_t W, class Accum, class TA, class TB>
+inline void interleaved_gemm_tile( const ptrdiff_t k, const TA * __restrict a, const ptrdiff_t a_step,
+                                   const TB * __restrict b, const ptrdiff_t b_step, Accum (&acc)[JB][W] ) {
+  for ( ptrdiff_t j = 0 ; j < JB ; ++j )
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) acc[j][l] = Accum{};
+
+  for ( ptrdiff_t p = 0 ; p < k ; ++p, a += a_step, b += b_step )
+    for ( ptrdiff_t j = 0 ; j < JB ; ++j )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) acc[j][l] += Accum( a[l] ) * Accum( b[j*W+l] );
+}
+
+// C = alpha A B, or +=, for the groups [g_begin,g_end) of batch-interleaved
+// A, B and C of width W.  Every loop runs over the W lanes innermost, so
+// it vectorizes across problems however small they are; columns of C are
+// taken four at a time to reuse each lane vector of A.  The padding lanes
+// of a last partial group are computed too, from whatever they hold, and
+// never read back.
+template<class Accum, class InMat1, class InMat2, class OutMat, class Scale>
+void interleaved_matrix_product( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                                 const gemm_update update, const Scale alpha,
+                                 const ptrdiff_t g_begin, const ptrdiff_t g_end ) {
+  constexpr ptrdiff_t W = OutMat::layout_type::vector_width ;
+  constexpr ptrdiff_t JB = 4 ;
+  const ptrdiff_t m = C.extent(1);
+  const ptrdiff_t n = C.extent(2);
+  const ptrdiff_t k = A.extent(2);
+  Accum acc[JB][W];
+  Accum acc1[1][W];
+
+  const auto store = [&]( auto * c, const Accum * sum ) {
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+      const Accum p = Accum( alpha * sum[l] );
+      c[l] = update == gemm_update::assign ? p : Accum( c[l] ) + p ;
+    }
+  };
+
+  for ( ptrdiff_t g = g_begin ; g < g_end ; ++g ) {
+    const auto a = A.data() + g*m*k*W ;
+    const auto b = B.data() + g*k*n*W ;
+    const auto c = C.data() + g*m*n*W ;
+    for ( ptrdiff_t i = 0 ; i < m ; ++i ) {
+      ptrdiff_t j = 0 ;
+      for ( ; j + JB <= n ; j += JB ) {
+        interleaved_gemm_tile( k, a + i*k*W, W, b + j*W, n*W, acc );
+        for ( ptrdiff_t jj = 0 ; jj < JB ; ++jj ) store( c + (i*n+j+jj)*W, acc[jj] );
+      }
+      for ( ; j < n ; ++j ) {
+        interleaved_gemm_tile( k, a + i*k*W, W, b + j*W, n*W, acc1 );
+        store( c + (i*n+j)*W, acc1[0] );
+      }
+    }
+  }
+}
+
+// matrix_product for a rank-3 C.  The arguments are checked, unwrapped
+// and sized once for the batch, not once per problem.  The threads split
+// the batch into contiguous ranges of problems (or of interleaved groups),
+// so they never share an output and never synchronize.
+template<class Accum, class InMat1, class InMat2, class OutMat>
+void batched_matrix_product_dispatch( const InMat1 & A_in, const InMat2 & B_in, const OutMat & C,
+                                      const bool accumulate, const size_t num_threads ) {
+  static_assert( OutMat::rank() == 3, "" );
+  static_assert( InMat1::rank() == 2 || InMat1::rank() == 3, "" );
+  static_assert( InMat2::rank() == 2 || InMat2::rank() == 3, "" );
+
+  const auto alpha = scaling_factor_of( A_in ) * scaling_factor_of( B_in );
+  const auto A = unscaled( A_in );
+  const auto B = unscaled( B_in );
+  typedef remove_const_t<decltype(A)> a_type;
+  typedef remove_const_t<decltype(B)> b_type;
+  const gemm_update update = accumulate ? gemm_update::add : gemm_update::assign ;
+
+  const ptrdiff_t batch = C.extent(0);
+  const ptrdiff_t m = C.extent(1);
+  const ptrdiff_t n = C.extent(2);
+  const ptrdiff_t k = A.extent( InMat1::rank() - 1 );
+
+  if constexpr ( is_same_interleaved<OutMat,a_type,b_type>::value ) {
+    batch_parallel_for( C.mapping().num_groups(), batch * m * n * k, num_threads,
+      [&]( const ptrdiff_t g_begin, const ptrdiff_t g_end ) {
+        interleaved_matrix_product<Accum>( A, B, C, update, alpha, g_begin, g_end );
+      });
+  }
+  else {
+    batch_parallel_for( batch, batch * m * n * k, num_threads,
+      [&]( const ptrdiff_t b_begin, const ptrdiff_t b_end ) {
+        batched_matrix_product_range<Accum>( A, B, C, update, alpha, b_begin, b_end );
+      });
+  }
+}
+
+//--------------------------------------------------------------------------
+// [linalg.algs.blas3.gemm] variable-size batch
+
+// Problems with no extent larger than this are tiny.  Tiny problems of the
+// same shape are multiplied interleave_lanes at a time, across problems.
+inline constexpr ptrdiff_t variable_batch_tiny = 16 ;
+
+// A unit of scheduled work: problems order[first,first+count), all of the
+// same shape if count > 1, with multiply-adds work.
+struct variable_batch_task {
+  ptrdiff_t work ;
+  ptrdiff_t first ;
+  ptrdiff_t count ;
+};
+
+// C = A B for the count tiny problems problems[order[l]], l < count, all
+// of shape m x n x k.  They are copied into interleaved buffers, given the
+// width W of a group, multiplied by interleaved_matrix_product, and C is
+// copied back.  The copies run over the W lanes innermost so that each
+// lane vector is written whole; the unused lanes repeat the first problem.
+template<class Accum, ptrdiff_t W, class ProblemIterator, class AValue, class BValue, class CValue>
+void variable_batch_tiny_product( const ProblemIterator problems, const ptrdiff_t * order, const ptrdiff_t count,
+                                  const ptrdiff_t m, const ptrdiff_t n, const ptrdiff_t k,
+                                  vector<AValue> & a, vector<BValue> & b, vector<CValue> & c ) {
+  typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> batch_extents;
+  typedef layout_batch_interleaved<W> interleaved;
+  typedef remove_reference_t<decltype( *problems )> problem_type;
+  const problem_type * lane[W];
+  for ( ptrdiff_t l = 0 ; l < W ; ++l ) lane[l] = & problems[order[l < count ? l : 0]];
+  a.resize( m*k*W );
+  b.resize( k*n*W );
+  c.resize( m*n*W );
+  for ( ptrdiff_t i = 0 ; i < m ; ++i )
+    for ( ptrdiff_t p = 0 ; p < k ; ++p )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) a[(i*k+p)*W+l] = get<0>( *lane[l] )(i,p);
+  for ( ptrdiff_t p = 0 ; p < k ; ++p )
+    for ( ptrdiff_t j = 0 ; j < n ; ++j )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) b[(p*n+j)*W+l] = get<1>( *lane[l] )(p,j);
+
+  const basic_mdspan<AValue,batch_extents,interleaved> Ai( a.data(), W, m, k );
+  const basic_mdspan<BValue,batch_extents,interleaved> Bi( b.data(), W, k, n );
+  const basic_mdspan<CValue,batch_extents,interleaved> Ci( c.data(), W, m, n );
+  interleaved_matrix_product<Accum>( Ai, Bi, Ci, gemm_update::assign, no_scaling{}, 0, 1 );
+
+  for ( ptrdiff_t i = 0 ; i < m ; ++i )
+    for ( ptrdiff_t j = 0 ; j < n ; ++j )
+      for ( ptrdiff_t l = 0 ; l < count ; ++l ) get<2>( *lane[l] )(i,j) = c[(i*n+j)*W+l];
+}
+
+// C = A B for the count problems (A, B, C) at the random-access iterator
+// problems, tuples of rank-2 mdspans of any sizes.  The problems are split
+// into tasks: each group of up to W tiny problems of the same shape is one
+// task, and every other problem is a task of its own.  A problem with at
+// least a thread's share of all the work is run first, by itself, on all
+// the threads as matrix_product would.  The other tasks are taken largest
+// first from a shared counter, so that the threads finish close together
+// however uneven the sizes are.  Each thread keeps one workspace for all
+// its tasks.
+template<class ProblemIterator>
+void variable_batch_matrix_product( const ProblemIterator problems, const ptrdiff_t count, const size_t num_threads ) {
+  typedef decay_t<decltype( *problems )> problem_type;
+  typedef remove_cv_t<remove_reference_t<tuple_element_t<0,problem_type>>> a_mdspan;
+  typedef remove_cv_t<remove_reference_t<tuple_element_t<1,problem_type>>> b_mdspan;
+  typedef remove_cv_t<remove_reference_t<tuple_element_t<2,problem_type>>> c_mdspan;
+  static_assert( a_mdspan::rank() == 2 && b_mdspan::rank() == 2 && c_mdspan::rank() == 2, "" );
+  typedef typename c_mdspan::value_type accum_type;
+  typedef typename a_mdspan::value_type a_value_type;
+  typedef typename b_mdspan::value_type b_value_type;
+  typedef gemm_blocking<accum_type> blocking;
+  typedef decay_t<decltype( unscaled( declval<a_mdspan>() ) )> a_unscaled;
+  typedef gemm_workspace<typename a_unscaled::value_type,accum_type,blocking> workspace_type;
+  constexpr ptrdiff_t W = interleave_lanes<accum_type>() ;
+
+  constexpr ptrdiff_t T = variable_batch_tiny ;
+  constexpr ptrdiff_t not_tiny = T * T * T ;
+  auto shape = [&]( const ptrdiff_t q ) {
+    const auto & [A, B, C] = problems[q];
+    (void) B;
+    return array<ptrdiff_t,3>{ C.extent(0), C.extent(1), A.extent(1) };
+  };
+
+  // Counting sort of the problems by shape: tiny problems first, those of
+  // the same shape adjacent, then all the others.
+  vector<ptrdiff_t> key( count );
+  vector<ptrdiff_t> order( count );
+  vector<ptrdiff_t> offset( not_tiny + 2, 0 );
+  for ( ptrdiff_t q = 0 ; q < count ; ++q ) {
+    const array<ptrdiff_t,3> s = shape( q );
+    const bool tiny = 0 < s[0] && s[0] <= T && 0 < s[1] && s[1] <= T && 0 < s[2] && s[2] <= T ;
+    key[q] = tiny ? ( ( s[0] - 1 ) * T + s[1] - 1 ) * T + s[2] - 1 : not_tiny ;
+    ++offset[key[q]+1];
+  }
+  for ( ptrdiff_t i = 0 ; i <= not_tiny ; ++i ) offset[i+1] += offset[i];
+  for ( ptrdiff_t q = 0 ; q < count ; ++q ) order[offset[key[q]]++] = q ;
+
+  vector<variable_batch_task> tasks ;
+  ptrdiff_t total = 0 ;
+  ptrdiff_t m_max = 0, n_max = 0, k_max = 0 ;
+  for ( ptrdiff_t first = 0 ; first < count ; ) {
+    const array<ptrdiff_t,3> s = shape( order[first] );
+    ptrdiff_t last = first + 1 ;
+    if ( key[order[first]] != not_tiny )
+      while ( last < count && last - first < W && key[order[last]] == key[order[first]] ) ++last ;
+    else {
+      m_max = s[0] > m_max ? s[0] : m_max ;
+      n_max = s[1] > n_max ? s[1] : n_max ;
+      k_max = s[2] > k_max ? s[2] : k_max ;
+    }
+    tasks.push_back( { ( last - first ) * s[0] * s[1] * ( s[2] > 0 ? s[2] : 1 ), first, last - first } );
+    total += tasks.back().work ;
+    first = last ;
+  }
+
+  ptrdiff_t p = ptrdiff_t( num_threads ) ;
+  if ( p > 1 && total < p * batch_parallel_grain ) p = 1 ;
+
+  auto run_problem = [&]( const ptrdiff_t q, workspace_type & work ) {
+    const auto & [A, B, C] = problems[q];
+    matrix_product_blocked<accum_type>( unscaled( A ), unscaled( B ), C, gemm_update::assign,
+                                        scaling_factor_of( A ) * scaling_factor_of( B ), work );
+  };
+
+  // The largest problems, each on all the threads.
+  if ( p > 1 ) {
+    auto is_big = [&]( const variable_batch_task & t ) { return t.count == 1 && t.work * p >= total ; };
+    for ( const variable_batch_task & t : tasks )
+      if ( is_big( t ) ) {
+        const auto & [A, B, C] = problems[order[t.first]];
+        matrix_product_dispatch<accum_type>( A, B, C, false, size_t( p ) );
+      }
+    tasks.erase( remove_if( tasks.begin(), tasks.end(), is_big ), tasks.end() );
+  }
+
+  stable_sort( tasks.begin(), tasks.end(), []( const variable_batch_task & s, const variable_batch_task & t ) {
+    return s.work > t.work ;
+  });
+
+  if ( p > ptrdiff_t( tasks.size() ) ) p = ptrdiff_t( tasks.size() );
+  atomic<size_t> next( 0 );
+  thread_pool::instance().run( size_t( p > 1 ? p : 1 ), [&]( size_t, size_t, team_barrier & ) {
+    workspace_type work( blocking::mc < m_max ? blocking::mc : m_max,
+                         blocking::kc < k_max ? blocking::kc : k_max,
+                         blocking::nc < n_max ? blocking::nc : n_max );
+    vector<a_value_type> a ;
+    vector<b_value_type> b ;
+    vector<accum_type> c ;
+    for ( size_t i = next++ ; i < tasks.size() ; i = next++ ) {
+      const variable_batch_task & t = tasks[i];
+      if ( key[order[t.first]] != not_tiny ) {
+        const array<ptrdiff_t,3> s = shape( order[t.first] );
+        variable_batch_tiny_product<accum_type,W>( problems, order.data() + t.first, t.count, s[0], s[1], s[2], a, b, c );
+      }
+      else {
+        run_problem( order[t.first], work );
+      }
+    }
+  });
+}
+
+//--------------------------------------------------------------------------
+// [linalg.algs.blas2.gemv] batched
+
+// y += alpha A x for the groups [g_begin,g_end) of batch-interleaved A, x
+// and y of width W, vectorized across the W problems of each group.
+template<class InMat, class InVec, class OutVec, class Scale>
+void interleaved_matrix_vector_update( const InMat & A, const InVec & x, const OutVec & y, const Scale alpha,
+                                       const ptrdiff_t g_begin, const ptrdiff_t g_end ) {
+  typedef typename OutVec::value_type sum_type;
+  constexpr ptrdiff_t W = OutVec::layout_type::vector_width ;
+  const ptrdiff_t m = A.extent(1);
+  const ptrdiff_t n = A.extent(2);
+
+  for ( ptrdiff_t g = g_begin ; g < g_end ; ++g ) {
+    const auto a  = A.data() + g*m*n*W ;
+    const auto xg = x.data() + g*n*W ;
+    const auto yg = y.data() + g*m*W ;
+    for ( ptrdiff_t i = 0 ; i < m ; ++i ) {
+      sum_type sum[W] = {};
+      for ( ptrdiff_t j = 0 ; j < n ; ++j )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l ) sum[l] += a[(i*n+j)*W+l] * xg[j*W+l];
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) yg[i*W+l] += alpha * sum[l];
+    }
+  }
+}
+
+// y += A x for a rank-2 y, the batched matrix_vector_product entry points.
+template<class InMat, class InVec, class OutVec>
+void batched_matrix_vector_update_dispatch( const InMat & A_in, const InVec & x_in, const OutVec & y,
+                                            const size_t num_threads ) {
+  static_assert( OutVec::rank() == 2, "" );
+  static_assert( InMat::rank() == 2 || InMat::rank() == 3, "" );
+  static_assert( InVec::rank() == 1 || InVec::rank() == 2, "" );
+
+  const auto alpha = scaling_factor_of( A_in ) * scaling_factor_of( x_in );
+  const auto A = unscaled( A_in );
+  const auto x = unscaled( x_in );
+  typedef remove_const_t<decltype(A)> a_type;
+  typedef remove_const_t<decltype(x)> x_type;
+
+  const ptrdiff_t batch = y.extent(0);
+  const ptrdiff_t work = batch * A.extent( InMat::rank() - 2 ) * A.extent( InMat::rank() - 1 );
+
+  if constexpr ( is_same_interleaved<OutVec,a_type,x_type>::value ) {
+    batch_parallel_for( y.mapping().num_groups(), work, num_threads,
+      [&]( const ptrdiff_t g_begin, const ptrdiff_t g_end ) {
+        interleaved_matrix_vector_update( A, x, y, alpha, g_begin, g_end );
+      });
+  }
+  else {
+    batch_parallel_for( batch, work, num_threads,
+      [&]( const ptrdiff_t b_begin, const ptrdiff_t b_end ) {
+        for ( ptrdiff_t b = b_begin ; b < b_end ; ++b )
+          matrix_vector_update( batch_problem<2>( A, b ), batch_problem<1>( x, b ), batch_problem<1>( y, b ), alpha );
+      });
+  }
+}
+
+//--------------------------------------------------------------------------
+// [linalg.algs.blas3.trsm] batched
+
+// Solve A X = B (Left) or X A = B (!Left) in place in B for every problem
+// of batch-interleaved A and B of width W, by substitution vectorized
+// across the W problems of each group.  A left solve updates whole rows
+// of B, which are contiguous; a right solve works row by row of B.
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void interleaved_triangular_matrix_matrix_solve( const InMat & A, Triangle, DiagonalStorage,
+                                                 const InOutMat & B, BinaryDivideOp divide ) {
+  constexpr ptrdiff_t W = InOutMat::layout_type::vector_width ;
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+  constexpr bool explicit_diag = is_same<DiagonalStorage,explicit_diagonal_t>::value;
+  const ptrdiff_t m = B.extent(1);
+  const ptrdiff_t n = B.extent(2);
+  const ptrdiff_t na = A.extent(1);
+
+  for ( ptrdiff_t g = 0 ; g < B.mapping().num_groups() ; ++g ) {
+    const auto a = A.data() + g*na*na*W ;
+    const auto b = B.data() + g*m*n*W ;
+
+    if constexpr ( Left ) {
+      for ( ptrdiff_t step = 0 ; step < m ; ++step ) {
+        const ptrdiff_t i = lower ? step : m-1-step ;
+        const auto bi = b + i*n*W ;
+        const ptrdiff_t k_begin = lower ? 0 : i+1 ;
+        const ptrdiff_t k_end   = lower ? i : m ;
+        for ( ptrdiff_t k = k_begin ; k < k_end ; ++k ) {
+          const auto aik = a + (i*m+k)*W ;
+          const auto bk  = b + k*n*W ;
+          for ( ptrdiff_t j = 0 ; j < n ; ++j )
+            for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[j*W+l] -= aik[l] * bk[j*W+l];
+        }
+        if constexpr ( explicit_diag ) {
+          const auto aii = a + (i*m+i)*W ;
+          for ( ptrdiff_t j = 0 ; j < n ; ++j )
+            for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[j*W+l] = divide( bi[j*W+l], aii[l] );
+        }
+      }
+    }
+    else {
+      for ( ptrdiff_t i = 0 ; i < m ; ++i ) {
+        const auto xi = b + i*n*W ;
+        for ( ptrdiff_t step = 0 ; step < n ; ++step ) {
+          const ptrdiff_t j = lower ? n-1-step : step ;
+          const ptrdiff_t k_begin = lower ? j+1 : 0 ;
+          const ptrdiff_t k_end   = lower ? n : j ;
+          for ( ptrdiff_t k = k_begin ; k < k_end ; ++k ) {
+            const auto akj = a + (k*n+j)*W ;
+            for ( ptrdiff_t l = 0 ; l < W ; ++l ) xi[j*W+l] -= xi[k*W+l] * akj[l];
+          }
+          if constexpr ( explicit_diag ) {
+            const auto ajj = a + (j*n+j)*W ;
+            for ( ptrdiff_t l = 0 ; l < W ; ++l ) xi[j*W+l] = divide( xi[j*W+l], ajj[l] );
+          }
+        }
+      }
+    }
+  }
+}
+
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void batched_triangular_matrix_matrix_solve( const InMat & A, Triangle t, DiagonalStorage d,
+                                             const InOutMat & B, BinaryDivideOp divide ) {
+  static_assert( InOutMat::rank() == 3, "" );
+  static_assert( InMat::rank() == 2 || InMat::rank() == 3, "" );
+
+  if constexpr ( is_same_interleaved<InOutMat,InMat>::value ) {
+    interleaved_triangular_matrix_matrix_solve<Left>( A, t, d, B, divide );
+  }
+  else {
+    for ( ptrdiff_t b = 0 ; b < B.extent(0) ; ++b )
+      triangular_matrix_matrix_solve_dispatch<Left>( batch_problem<2>( A, b ), t, d, batch_problem<2>( B, b ), divide );
+  }
+}
+
+} // namespace detail
+
+}}}} // experimental::fundamentals_v3::linalg
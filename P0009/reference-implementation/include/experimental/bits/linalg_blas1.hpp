@@ -0,0 +1,763 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <cmath>
+#include <complex>
+#include <cstddef> // std::ptrdiff_t
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.algs.blas1.givens.lartg]
+template<class Real>
+void givens_rotation_setup( const Real a, const Real b,
+                            Real & c, Real & s, Real & r );
+
+template<class Real>
+void givens_rotation_setup( const complex<Real> & a, const complex<Real> & b,
+                            Real & c, complex<Real> & s, complex<Real> & r );
+
+// [linalg.algs.blas1.givens.rot]
+template<class InOutVec1, class InOutVec2, class Real>
+void givens_rotation_apply( InOutVec1 x, InOutVec2 y, const Real c, const Real s );
+
+template<class InOutVec1, class InOutVec2, class Real>
+void givens_rotation_apply( InOutVec1 x, InOutVec2 y, const Real c, const complex<Real> s );
+
+// [linalg.algs.blas1.scal]
+template<class Scalar, class InOutObj>
+void scale( Scalar alpha, InOutObj x );
+
+// [linalg.algs.blas1.copy]
+// A rank-3 y, or an x without y's leftmost batch extent, makes a batched
+// copy; see linalg_batched.hpp.
+template<class InVec, class OutVec>
+void copy( InVec x, OutVec y );
+
+// [linalg.algs.blas1.add]
+template<class InVec1, class InVec2, class OutVec>
+void add( InVec1 x, InVec2 y, OutVec z );
+
+// Not part of P1673: z(i...) = x(i...) * y(i...)
+template<class InVec1, class InVec2, class OutVec>
+void elementwise_multiply( InVec1 x, InVec2 y, OutVec z );
+
+// [linalg.algs.blas1.dot.dotu]
+// The products are summed in Scalar, and elements of a narrower type
+// are widened before they are multiplied, so float vectors with a
+// double init give the double dot product.
+//
+// Batched reductions, as in P2901: if v1 or v2 is a rank-2 batch of
+// vectors (the other may be one vector broadcast to the batch), init is
+// instead a rank-1 mdspan that receives the result for each problem,
+// and is returned.  The same holds for dotc, vector_two_norm and
+// vector_abs_sum; see linalg_batched.hpp.
+template<class InVec1, class InVec2, class Scalar>
+Scalar dot( InVec1 v1, InVec2 v2, Scalar init );
+
+template<class InVec1, class InVec2>
+auto dot( InVec1 v1, InVec2 v2 );
+
+// [linalg.algs.blas1.dot.dotc]
+template<class InVec1, class InVec2, class Scalar>
+Scalar dotc( InVec1 v1, InVec2 v2, Scalar init );
+
+template<class InVec1, class InVec2>
+auto dotc( InVec1 v1, InVec2 v2 );
+
+// [linalg.algs.blas1.ssq]
+template<class Scalar>
+struct sum_of_squares_result {
+  Scalar scaling_factor;
+  Scalar scaled_sum_of_squares;
+};
+
+template<class InVec, class Scalar>
+sum_of_squares_result<Scalar> vector_sum_of_squares( InVec v, sum_of_squares_result<Scalar> init );
+
+// [linalg.algs.blas1.nrm2]
+template<class InVec, class Scalar>
+Scalar vector_two_norm( InVec v, Scalar init );
+
+template<class InVec>
+auto vector_two_norm( InVec v );
+
+// Not part of P1673: the caller promises that squaring v's elements
+// neither overflows nor underflows, so the norm needs no scaling.
+template<class InVec, class Scalar>
+Scalar vector_two_norm( bounded_values_t, InVec v, Scalar init );
+
+template<class InVec>
+auto vector_two_norm( bounded_values_t, InVec v );
+
+// [linalg.algs.blas1.asum]
+template<class InVec, class Scalar>
+Scalar vector_abs_sum( InVec v, Scalar init );
+
+template<class InVec>
+auto vector_abs_sum( InVec v );
+
+// [linalg.algs.blas1.iamax]
+template<class InVec>
+typename InVec::index_type vector_idx_abs_max( InVec v );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// True if dimension r of x is a broadcast dimension (stride zero).
+template<class MDSpan>
+constexpr bool is_broadcast_dim( const MDSpan & x, const size_t r ) noexcept {
+  if constexpr ( MDSpan::is_always_strided() )
+    return x.extent(r) > 1 && x.stride(r) == 0;
+  else
+    return false;
+}
+
+// True if the rows of a rank-2 x (rather than its columns) should be
+// the inner loop, i.e. x is stored row by row.
+template<class MDSpan>
+constexpr bool prefer_row_lines( const MDSpan & x ) noexcept {
+  if constexpr ( MDSpan::is_always_strided() )
+    return x.stride(1) <= x.stride(0);
+  else
+    return true;
+}
+
+// out(k) = in(k) for k in [0,n).  A broadcast input is read once.
+template<class Out, class In>
+void copy_line( const ptrdiff_t n, Out out, In in, const bool in_bcast ) {
+  if ( in_bcast ) {
+    const auto a = in(0);
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) out(k) = a;
+  }
+  else {
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) out(k) = in(k);
+  }
+}
+
+// out(k) = op(in0(k),in1(k)) for k in [0,n).  Broadcast inputs are read
+// once and kept in a register for the whole line.
+template<class Op, class Out, class In0, class In1>
+void binary_line( const ptrdiff_t n, Op op, Out out,
+                  In0 in0, const bool in0_bcast, In1 in1, const bool in1_bcast ) {
+  if ( in0_bcast && in1_bcast ) {
+    const auto c = op( in0(0), in1(0) );
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) out(k) = c;
+  }
+  else if ( in0_bcast ) {
+    const auto a = in0(0);
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) out(k) = op( a, in1(k) );
+  }
+  else if ( in1_bcast ) {
+    const auto b = in1(0);
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) out(k) = op( in0(k), b );
+  }
+  else {
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) out(k) = op( in0(k), in1(k) );
+  }
+}
+
+// Rank-1 and rank-2 element-wise drivers.  The inner loop runs along the
+// output's stride-one dimension.  An input broadcast along the inner
+// dimension is held in a register; one broadcast along the outer dimension
+// is the same short line every time and so stays in cache.
+
+template<class In, class Out>
+void elementwise_copy( const In & x, const Out & y ) {
+  static_assert( In::rank() == Out::rank(), "" );
+  static_assert( Out::rank() == 1 || Out::rank() == 2, "" );
+
+  if constexpr ( Out::rank() == 1 ) {
+    copy_line( y.extent(0),
+      [&]( ptrdiff_t k ) -> typename Out::reference { return y(k); },
+      [&]( ptrdiff_t k ) { return x(k); }, is_broadcast_dim(x,0) );
+  }
+  else if ( prefer_row_lines(y) ) {
+    const bool bcast = is_broadcast_dim(x,1);
+    for ( ptrdiff_t i = 0 ; i < y.extent(0) ; ++i )
+      copy_line( y.extent(1),
+        [&]( ptrdiff_t j ) -> typename Out::reference { return y(i,j); },
+        [&]( ptrdiff_t j ) { return x(i,j); }, bcast );
+  }
+  else {
+    const bool bcast = is_broadcast_dim(x,0);
+    for ( ptrdiff_t j = 0 ; j < y.extent(1) ; ++j )
+      copy_line( y.extent(0),
+        [&]( ptrdiff_t i ) -> typename Out::reference { return y(i,j); },
+        [&]( ptrdiff_t i ) { return x(i,j); }, bcast );
+  }
+}
+
+template<class Op, class In0, class In1, class Out>
+void elementwise_binary( Op op, const In0 & x, const In1 & y, const Out & z ) {
+  static_assert( In0::rank() == Out::rank() && In1::rank() == Out::rank(), "" );
+  static_assert( Out::rank() == 1 || Out::rank() == 2, "" );
+
+  if constexpr ( Out::rank() == 1 ) {
+    binary_line( z.extent(0), op,
+      [&]( ptrdiff_t k ) -> typename Out::reference { return z(k); },
+      [&]( ptrdiff_t k ) { return x(k); }, is_broadcast_dim(x,0),
+      [&]( ptrdiff_t k ) { return y(k); }, is_broadcast_dim(y,0) );
+  }
+  else if ( prefer_row_lines(z) ) {
+    const bool x_bcast = is_broadcast_dim(x,1);
+    const bool y_bcast = is_broadcast_dim(y,1);
+    for ( ptrdiff_t i = 0 ; i < z.extent(0) ; ++i )
+      binary_line( z.extent(1), op,
+        [&]( ptrdiff_t j ) -> typename Out::reference { return z(i,j); },
+        [&]( ptrdiff_t j ) { return x(i,j); }, x_bcast,
+        [&]( ptrdiff_t j ) { return y(i,j); }, y_bcast );
+  }
+  else {
+    const bool x_bcast = is_broadcast_dim(x,0);
+    const bool y_bcast = is_broadcast_dim(y,0);
+    for ( ptrdiff_t j = 0 ; j < z.extent(1) ; ++j )
+      binary_line( z.extent(0), op,
+        [&]( ptrdiff_t i ) -> typename Out::reference { return z(i,j); },
+        [&]( ptrdiff_t i ) { return x(i,j); }, x_bcast,
+        [&]( ptrdiff_t i ) { return y(i,j); }, y_bcast );
+  }
+}
+
+// Pointer to x(0) if x is a rank-1 view of plain memory with unit
+// stride, else nullptr.  Kernels use it to take a contiguous fast path
+// whose loops the compiler vectorizes; other views go through x(k).
+template<class InVec>
+typename InVec::element_type * unit_stride_data( const InVec & x ) noexcept {
+  typedef typename InVec::element_type element_type;
+  if constexpr ( InVec::rank() == 1 && InVec::is_always_strided() &&
+                 is_same_v<typename InVec::accessor_type,accessor_basic<element_type>> ) {
+    if ( x.extent(0) == 0 ) return x.data();
+    if ( x.stride(0) == 1 ) return x.data() + x.mapping()(0);
+  }
+  return nullptr;
+}
+
+// Calls kernel(f) with f(k) reading x(k): through a raw pointer when x
+// has unit stride, else through x itself.
+template<class InVec, class Kernel>
+decltype(auto) with_vector_reader( const InVec & x, Kernel && kernel ) {
+  if ( auto p = unit_stride_data(x) )
+    return kernel( [p]( const ptrdiff_t k ) -> decltype(auto) { return p[k]; } );
+  else
+    return kernel( [&x]( const ptrdiff_t k ) -> decltype(auto) { return x(k); } );
+}
+
+// Number of independent partial sums used by the reductions: two cache
+// lines' worth, so that consecutive additions do not wait on each other
+// and the compiler can keep the partial sums in whole SIMD registers.
+template<class T>
+constexpr ptrdiff_t reduction_lanes_for() {
+  ptrdiff_t lanes = 2 ;
+  while ( 2 * lanes * ptrdiff_t( sizeof(T) ) <= 128 ) lanes *= 2 ;
+  return lanes ;
+}
+
+template<class T>
+inline constexpr ptrdiff_t reduction_lanes = reduction_lanes_for<T>();
+
+// init + f(0) + ... + f(n-1), summed in reduction_lanes<T> interleaved
+// partial sums.  The order of the additions therefore differs from a
+// plain left-to-right loop.
+template<class T, class F>
+T unrolled_sum( const ptrdiff_t n, const T & init, F && f ) {
+  constexpr ptrdiff_t L = reduction_lanes<T> ;
+  if ( n < L ) {
+    T sum = init ;
+    for ( ptrdiff_t k = 0 ; k < n ; ++k ) sum += f(k);
+    return sum ;
+  }
+
+  T acc[L] ;
+  for ( ptrdiff_t l = 0 ; l < L ; ++l ) acc[l] = T{};
+
+  ptrdiff_t k = 0 ;
+  for ( ; k + L <= n ; k += L )
+    for ( ptrdiff_t l = 0 ; l < L ; ++l ) acc[l] += f(k+l);
+  for ( ; k < n ; ++k ) acc[k % L] += f(k);
+
+  for ( ptrdiff_t w = L/2 ; w > 0 ; w /= 2 )
+    for ( ptrdiff_t l = 0 ; l < w ; ++l ) acc[l] += acc[l+w];
+  return init + acc[0];
+}
+
+// |Re t| + |Im t| for complex t, as in the BLAS; |t| otherwise.
+template<class T>
+constexpr auto abs_sum_if_needed( const T & t ) {
+  if constexpr ( is_complex<T>::value ) return abs_if_needed( real(t) ) + abs_if_needed( imag(t) );
+  else return abs_if_needed( t );
+}
+
+// Index of the first k with the largest abs_sum_if_needed(f(k)).  Each
+// block is reduced to its maximum magnitude first, with a loop free of
+// data-dependent branches; only a block that beats the running maximum
+// is scanned again for the index.
+template<class F>
+ptrdiff_t idx_abs_max( const ptrdiff_t n, F && f ) {
+  typedef decltype( abs_sum_if_needed( f(0) ) ) magnitude_type;
+  constexpr ptrdiff_t block = 256 ;
+  constexpr ptrdiff_t L = reduction_lanes<magnitude_type> ;
+
+  ptrdiff_t best = 0 ;
+  magnitude_type best_value = abs_sum_if_needed( f(0) );
+  for ( ptrdiff_t k0 = 0 ; k0 < n ; k0 += block ) {
+    const ptrdiff_t k1 = block < n-k0 ? k0+block : n ;
+    magnitude_type lane_max[L] ;
+    for ( ptrdiff_t l = 0 ; l < L ; ++l ) lane_max[l] = magnitude_type{};
+    ptrdiff_t k = k0 ;
+    for ( ; k + L <= k1 ; k += L )
+      for ( ptrdiff_t l = 0 ; l < L ; ++l ) {
+        const magnitude_type a = abs_sum_if_needed( f(k+l) );
+        lane_max[l] = lane_max[l] < a ? a : lane_max[l];
+      }
+    for ( ; k < k1 ; ++k ) {
+      const magnitude_type a = abs_sum_if_needed( f(k) );
+      lane_max[0] = lane_max[0] < a ? a : lane_max[0];
+    }
+    magnitude_type block_max = lane_max[0] ;
+    for ( ptrdiff_t l = 1 ; l < L ; ++l ) block_max = block_max < lane_max[l] ? lane_max[l] : block_max ;
+
+    if ( best_value < block_max ) {
+      for ( k = k0 ; k < k1 ; ++k )
+        if ( best_value < abs_sum_if_needed( f(k) ) ) { best = k ; best_value = abs_sum_if_needed( f(k) ); }
+    }
+  }
+  return best ;
+}
+
+// Calls f on the real components of t: t itself, or its real and
+// imaginary parts.
+template<class T, class F>
+void for_each_component( const T & t, F && f ) {
+  if constexpr ( is_complex<T>::value ) { f( real(t) ); f( imag(t) ); }
+  else f( t );
+}
+
+// One pass computing init + the sum of the squares of the components of
+// f(0) ... f(n-1), each multiplied by scale, along with their largest
+// unscaled magnitude.  Both reductions use interleaved lanes.
+template<class Real, class F>
+void sum_of_squares_and_max( const ptrdiff_t n, F && f, const Real scale,
+                             Real & sum, Real & amax ) {
+  constexpr ptrdiff_t L = reduction_lanes<Real> ;
+  Real acc[L], mx[L] ;
+  for ( ptrdiff_t l = 0 ; l < L ; ++l ) { acc[l] = Real{}; mx[l] = Real{}; }
+
+  auto update = [&]( const ptrdiff_t l, const ptrdiff_t k ) {
+    for_each_component( f(k), [&]( const auto c ) {
+      const Real a = abs_if_needed( Real(c) );
+      const Real b = a * scale ;
+      acc[l] += b * b ;
+      mx[l] = mx[l] < a ? a : mx[l] ;
+    });
+  };
+  ptrdiff_t k = 0 ;
+  for ( ; k + L <= n ; k += L )
+    for ( ptrdiff_t l = 0 ; l < L ; ++l ) update( l, k+l );
+  for ( ; k < n ; ++k ) update( k % L, k );
+
+  for ( ptrdiff_t w = L/2 ; w > 0 ; w /= 2 )
+    for ( ptrdiff_t l = 0 ; l < w ; ++l ) {
+      acc[l] += acc[l+w];
+      mx[l] = mx[l] < mx[l+w] ? mx[l+w] : mx[l] ;
+    }
+  sum += acc[0] ;
+  amax = amax < mx[0] ? mx[0] : amax ;
+}
+
+// Whether sqrt(sum) is accurate as the two-norm of count real components
+// whose unscaled squares add up to sum and whose largest magnitude is
+// amax: some component is Inf or NaN, or all are zero, or amax shows that
+// no square could have overflowed and that squares lost to underflow are
+// below rounding error.
+template<class Real>
+bool is_unscaled_norm_accurate( const Real sum, const Real amax, const Real count ) {
+  if constexpr ( is_floating_point<Real>::value ) {
+    using std::sqrt;
+    typedef numeric_limits<Real> limits ;
+    if ( ! ( amax < limits::infinity() ) || sum != sum ) return true ;
+    if ( amax == Real(0) ) return true ;
+    const Real small = sqrt( limits::min() / limits::epsilon() );
+    const Real big = sqrt( limits::max() / count );
+    return small <= amax && amax <= big ;
+  }
+  else {
+    return true ;
+  }
+}
+
+// sqrt(init^2 + sum of |components of f(k)|^2) without spurious
+// overflow or underflow.  The first pass sums the unscaled squares and
+// finds the largest magnitude.  If is_unscaled_norm_accurate, that sum
+// is the answer.  Otherwise a second pass scales every component by the
+// power of two that brings the largest one into [1,2), which is exact,
+// and the result is scaled back.
+template<class Real, class F>
+Real two_norm( const ptrdiff_t n, F && f, const Real init ) {
+  using std::sqrt;
+  const Real abs_init = abs_if_needed( init );
+  Real sum = abs_init * abs_init ;
+  Real amax = abs_init ;
+  sum_of_squares_and_max( n, f, Real(1), sum, amax );
+
+  // Components per vector, counting init; complex values have two.
+  const Real count = Real( n + 1 ) * ( is_complex<decay_t<decltype(f(0))>>::value ? Real(2) : Real(1) );
+  if ( is_unscaled_norm_accurate( sum, amax, count ) ) return sqrt( sum );
+
+  if constexpr ( is_floating_point<Real>::value ) {
+    typedef numeric_limits<Real> limits ;
+    using std::ilogb;
+    using std::ldexp;
+    int e = ilogb( amax );
+    if ( e < 1 - limits::max_exponent ) e = 1 - limits::max_exponent ;
+    const Real scale = ldexp( Real(1), -e );
+    const Real scaled_init = abs_init * scale ;
+    Real scaled_sum = scaled_init * scaled_init ;
+    Real unused = Real(0);
+    sum_of_squares_and_max( n, f, scale, scaled_sum, unused );
+    return ldexp( sqrt( scaled_sum ), e );
+  }
+  else {
+    return sqrt( sum );
+  }
+}
+
+// Batched copy, defined in linalg_batched.hpp.
+template<class InObj, class OutObj>
+void batched_copy( const InObj & x, const OutObj & y );
+
+// Batched reductions, defined in linalg_batched.hpp: one result per
+// problem of a rank-2 batch of vectors, written to a rank-1 out.
+template<bool Conjugate, class InVec1, class InVec2, class OutVec>
+void batched_dot( const InVec1 & x, const InVec2 & y, const OutVec & out );
+
+template<bool Bounded, class InVec, class OutVec>
+void batched_vector_two_norm( const InVec & x, const OutVec & out );
+
+template<class InVec, class OutVec>
+void batched_vector_abs_sum( const InVec & x, const OutVec & out );
+
+template<class InObj, class OutObj>
+constexpr bool is_batched_copy() noexcept {
+  return OutObj::rank() == 3 || InObj::rank() < OutObj::rank() ||
+         is_layout_batch_interleaved<typename InObj::layout_type>::value ||
+         is_layout_batch_interleaved<typename OutObj::layout_type>::value ;
+}
+
+} // namespace detail
+
+template<class Scalar, class InOutObj>
+void scale( Scalar alpha, InOutObj x ) {
+  static_assert( InOutObj::rank() == 1 || InOutObj::rank() == 2, "" );
+  if constexpr ( InOutObj::rank() == 1 ) {
+    if ( auto p = detail::unit_stride_data(x) ) {
+      for ( ptrdiff_t k = 0 ; k < x.extent(0) ; ++k ) p[k] *= alpha;
+    }
+    else {
+      for ( ptrdiff_t k = 0 ; k < x.extent(0) ; ++k ) x(k) *= alpha;
+    }
+  }
+  else if ( detail::prefer_row_lines(x) ) {
+    for ( ptrdiff_t i = 0 ; i < x.extent(0) ; ++i )
+      for ( ptrdiff_t j = 0 ; j < x.extent(1) ; ++j ) x(i,j) *= alpha;
+  }
+  else {
+    for ( ptrdiff_t j = 0 ; j < x.extent(1) ; ++j )
+      for ( ptrdiff_t i = 0 ; i < x.extent(0) ; ++i ) x(i,j) *= alpha;
+  }
+}
+
+template<class InVec, class OutVec>
+void copy( InVec x, OutVec y ) {
+  if constexpr ( detail::is_batched_copy<InVec,OutVec>() ) detail::batched_copy( x, y );
+  else detail::elementwise_copy( x, y );
+}
+
+template<class InVec1, class InVec2, class OutVec>
+void add( InVec1 x, InVec2 y, OutVec z ) {
+  if constexpr ( OutVec::rank() == 1 ) {
+    auto px = detail::unit_stride_data(x);
+    auto py = detail::unit_stride_data(y);
+    auto pz = detail::unit_stride_data(z);
+    if ( px && py && pz ) {
+      for ( ptrdiff_t k = 0 ; k < z.extent(0) ; ++k ) pz[k] = px[k] + py[k];
+      return ;
+    }
+  }
+  detail::elementwise_binary( []( const auto a, const auto b ) { return a + b; }, x, y, z );
+}
+
+template<class InVec1, class InVec2, class OutVec>
+void elementwise_multiply( InVec1 x, InVec2 y, OutVec z ) {
+  detail::elementwise_binary( []( const auto a, const auto b ) { return a * b; }, x, y, z );
+}
+
+template<class InVec1, class InVec2, class Scalar>
+Scalar dot( InVec1 v1, InVec2 v2, Scalar init ) {
+  if constexpr ( InVec1::rank() == 2 || InVec2::rank() == 2 ) {
+    detail::batched_dot<false>( v1, v2, init );
+    return init;
+  }
+  else {
+    if ( detail::vendor_dot( detail::unscaled( v1 ), detail::unscaled( v2 ),
+                             detail::scaling_factor_of( v1 ) * detail::scaling_factor_of( v2 ), init ) )
+      return init;
+    const ptrdiff_t n = v1.extent(0);
+    return detail::with_vector_reader( v1, [&]( auto x ) {
+      return detail::with_vector_reader( v2, [&]( auto y ) {
+        return detail::unrolled_sum( n, init, [&]( const ptrdiff_t k ) { return detail::product_as<Scalar>( x(k), y(k) ); } );
+      });
+    });
+  }
+}
+
+template<class InVec1, class InVec2>
+auto dot( InVec1 v1, InVec2 v2 ) {
+  typedef decltype( declval<typename InVec1::value_type>() * declval<typename InVec2::value_type>() ) scalar_type;
+  return dot( v1, v2, scalar_type{} );
+}
+
+template<class InVec1, class InVec2, class Scalar>
+Scalar dotc( InVec1 v1, InVec2 v2, Scalar init ) {
+  if constexpr ( InVec1::rank() == 2 || InVec2::rank() == 2 ) {
+    detail::batched_dot<true>( v1, v2, init );
+    return init;
+  }
+  else {
+    // vendor_dot only takes real vectors, for which dotc is dot.
+    if ( detail::vendor_dot( detail::unscaled( v1 ), detail::unscaled( v2 ),
+                             detail::scaling_factor_of( v1 ) * detail::scaling_factor_of( v2 ), init ) )
+      return init;
+    const ptrdiff_t n = v1.extent(0);
+    return detail::with_vector_reader( v1, [&]( auto x ) {
+      return detail::with_vector_reader( v2, [&]( auto y ) {
+        return detail::unrolled_sum( n, init, [&]( const ptrdiff_t k ) {
+          return detail::product_as<Scalar>( detail::conj_if_needed( x(k) ), y(k) );
+        });
+      });
+    });
+  }
+}
+
+template<class InVec1, class InVec2>
+auto dotc( InVec1 v1, InVec2 v2 ) {
+  typedef decltype( detail::conj_if_needed( declval<typename InVec1::value_type>() ) * declval<typename InVec2::value_type>() ) scalar_type;
+  return dotc( v1, v2, scalar_type{} );
+}
+
+template<class InVec, class Scalar>
+sum_of_squares_result<Scalar> vector_sum_of_squares( InVec v, sum_of_squares_result<Scalar> init ) {
+  Scalar amax = Scalar{};
+  Scalar unused = Scalar{};
+  detail::with_vector_reader( v, [&]( auto x ) {
+    detail::sum_of_squares_and_max( v.extent(0), x, Scalar(0), unused, amax );
+  });
+  const Scalar t = init.scaling_factor < amax ? amax : init.scaling_factor ;
+  if ( t == Scalar(0) ) return init ;
+
+  // scaling_factor^2 * scaled_sum_of_squares is preserved, as in LAPACK's xLASSQ
+  const Scalar r = init.scaling_factor / t ;
+  Scalar sum = init.scaled_sum_of_squares * r * r ;
+  detail::with_vector_reader( v, [&]( auto x ) {
+    detail::sum_of_squares_and_max( v.extent(0), x, Scalar(1) / t, sum, unused );
+  });
+  return { t, sum };
+}
+
+template<class InVec, class Scalar>
+Scalar vector_two_norm( InVec v, Scalar init ) {
+  if constexpr ( InVec::rank() == 2 ) {
+    detail::batched_vector_two_norm<false>( v, init );
+    return init;
+  }
+  else {
+    return detail::with_vector_reader( v, [&]( auto x ) { return detail::two_norm( v.extent(0), x, init ); } );
+  }
+}
+
+template<class InVec>
+auto vector_two_norm( InVec v ) {
+  typedef decltype( detail::abs_if_needed( declval<typename InVec::value_type>() ) ) scalar_type;
+  return vector_two_norm( v, scalar_type{} );
+}
+
+template<class InVec, class Scalar>
+Scalar vector_two_norm( bounded_values_t, InVec v, Scalar init ) {
+  if constexpr ( InVec::rank() == 2 ) {
+    detail::batched_vector_two_norm<true>( v, init );
+    return init;
+  }
+  else {
+    using std::sqrt;
+    const Scalar abs_init = detail::abs_if_needed( init );
+    Scalar sum = abs_init * abs_init ;
+    Scalar unused = Scalar{};
+    detail::with_vector_reader( v, [&]( auto x ) {
+      detail::sum_of_squares_and_max( v.extent(0), x, Scalar(1), sum, unused );
+    });
+    return sqrt( sum );
+  }
+}
+
+template<class InVec>
+auto vector_two_norm( bounded_values_t, InVec v ) {
+  typedef decltype( detail::abs_if_needed( declval<typename InVec::value_type>() ) ) scalar_type;
+  return vector_two_norm( bounded_values, v, scalar_type{} );
+}
+
+template<class InVec, class Scalar>
+Scalar vector_abs_sum( InVec v, Scalar init ) {
+  if constexpr ( InVec::rank() == 2 ) {
+    detail::batched_vector_abs_sum( v, init );
+    return init;
+  }
+  else {
+    return detail::with_vector_reader( v, [&]( auto x ) {
+      return detail::unrolled_sum( v.extent(0), init, [&]( const ptrdiff_t k ) {
+        return Scalar( detail::abs_sum_if_needed( x(k) ) );
+      });
+    });
+  }
+}
+
+template<class InVec>
+auto vector_abs_sum( InVec v ) {
+  return vector_abs_sum( v, typename InVec::value_type{} );
+}
+
+template<class Real>
+void givens_rotation_setup( const Real a, const Real b,
+                            Real & c, Real & s, Real & r ) {
+  using std::abs;
+  if ( b == Real(0) ) { c = Real(1); s = Real(0); r = a; }
+  else if ( a == Real(0) ) { c = Real(0); s = copysign( Real(1), b ); r = abs(b); }
+  else {
+    // hypot neither overflows nor underflows where a*a + b*b would.
+    const Real d = hypot( a, b );
+    c = abs(a) / d;
+    r = copysign( d, a );
+    s = b / r;
+  }
+}
+
+template<class Real>
+void givens_rotation_setup( const complex<Real> & a, const complex<Real> & b,
+                            Real & c, complex<Real> & s, complex<Real> & r ) {
+  if ( b == complex<Real>() ) { c = Real(1); s = complex<Real>(); r = a; }
+  else if ( a == complex<Real>() ) {
+    const Real fb = abs(b);
+    c = Real(0); s = conj(b) / fb; r = complex<Real>( fb );
+  }
+  else {
+    // r keeps the phase of a, so that c is real and nonnegative.
+    const Real fa = abs(a);
+    const Real d  = hypot( fa, abs(b) );
+    const complex<Real> phase = a / fa;
+    c = fa / d;
+    s = phase * conj( b / d );
+    r = phase * d;
+  }
+}
+
+namespace detail {
+
+// [ x ; y ] := [ c s ; -conj(s) c ] [ x ; y ]
+template<class InOutVec1, class InOutVec2, class Real, class Scalar>
+void givens_rotation_apply_impl( InOutVec1 x, InOutVec2 y, const Real c, const Scalar s ) {
+  static_assert( InOutVec1::rank() == 1 && InOutVec2::rank() == 1, "" );
+  const auto sc = conj_if_needed( s );
+  auto p = unit_stride_data(x);
+  auto q = unit_stride_data(y);
+  if ( p && q ) {
+    for ( ptrdiff_t k = 0 ; k < x.extent(0) ; ++k ) {
+      const auto xk = p[k];
+      const auto yk = q[k];
+      p[k] = c * xk + s * yk;
+      q[k] = c * yk - sc * xk;
+    }
+  }
+  else {
+    for ( ptrdiff_t k = 0 ; k < x.extent(0) ; ++k ) {
+      const typename InOutVec1::value_type xk = x(k);
+      const typename InOutVec2::value_type yk = y(k);
+      x(k) = c * xk + s * yk;
+      y(k) = c * yk - sc * xk;
+    }
+  }
+}
+
+} // namespace detail
+
+template<class InOutVec1, class InOutVec2, class Real>
+void givens_rotation_apply( InOutVec1 x, InOutVec2 y, const Real c, const Real s ) {
+  detail::givens_rotation_apply_impl( x, y, c, s );
+}
+
+template<class InOutVec1, class InOutVec2, class Real>
+void givens_rotation_apply( InOutVec1 x, InOutVec2 y, const Real c, const complex<Real> s ) {
+  detail::givens_rotation_apply_impl( x, y, c, s );
+}
+
+template<class InVec>
+typename InVec::index_type vector_idx_abs_max( InVec v ) {
+  if ( v.extent(0) == 0 ) return numeric_limits<typename InVec::index_type>::max();
+  return detail::with_vector_reader( v, [&]( auto x ) { return detail::idx_abs_max( v.extent(0), x ); } );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
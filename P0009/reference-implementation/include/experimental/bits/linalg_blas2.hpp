@@ -0,0 +1,548 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.algs.blas2.gemv]
+// A rank-2 y holds a batch of products: its leftmost extent indexes the
+// problems, and a rank-2 A or a rank-1 x or y stands for every problem.
+template<class InMat, class InVec, class OutVec>
+void matrix_vector_product( InMat A, InVec x, OutVec y );
+
+template<class InMat, class InVec1, class InVec2, class OutVec>
+typename enable_if<!detail::is_linalg_execution_policy_v<InMat>>::type
+matrix_vector_product( InMat A, InVec1 x, InVec2 y, OutVec z );
+
+template<class ExecutionPolicy, class InMat, class InVec, class OutVec>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_vector_product( ExecutionPolicy && exec, InMat A, InVec x, OutVec y );
+
+template<class ExecutionPolicy, class InMat, class InVec1, class InVec2, class OutVec>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_vector_product( ExecutionPolicy && exec, InMat A, InVec1 x, InVec2 y, OutVec z );
+
+// [linalg.algs.blas2.symv]
+template<class InMat, class Triangle, class InVec, class OutVec>
+void symmetric_matrix_vector_product( InMat A, Triangle t, InVec x, OutVec y );
+
+template<class InMat, class Triangle, class InVec1, class InVec2, class OutVec>
+void symmetric_matrix_vector_product( InMat A, Triangle t, InVec1 x, InVec2 y, OutVec z );
+
+// [linalg.algs.blas2.hemv]
+template<class InMat, class Triangle, class InVec, class OutVec>
+void hermitian_matrix_vector_product( InMat A, Triangle t, InVec x, OutVec y );
+
+template<class InMat, class Triangle, class InVec1, class InVec2, class OutVec>
+void hermitian_matrix_vector_product( InMat A, Triangle t, InVec1 x, InVec2 y, OutVec z );
+
+// [linalg.algs.blas2.trsv]
+template<class InMat, class Triangle, class DiagonalStorage, class InVec, class OutVec, class BinaryDivideOp>
+void triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InVec b, OutVec x, BinaryDivideOp divide );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InVec, class OutVec>
+typename enable_if<detail::is_mdspan<OutVec>::value>::type
+triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InVec b, OutVec x );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+typename enable_if<!detail::is_mdspan<BinaryDivideOp>::value>::type
+triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InOutVec b, BinaryDivideOp divide );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec>
+void triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InOutVec b );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// True if the columns of A, rather than its rows, should be the inner loop.
+template<class InMat>
+constexpr bool is_column_oriented( const InMat & A ) noexcept {
+  typedef typename InMat::layout_type layout_type;
+  if constexpr ( is_layout_blas_packed<layout_type>::value )
+    return is_same<typename layout_type::storage_order_type,column_major_t>::value;
+  else if constexpr ( is_layout_banded<layout_type>::value )
+    return true;
+  else if constexpr ( is_layout_transpose<layout_type>::value )
+    return ! is_column_oriented( transposed( A ) );
+  else if constexpr ( InMat::is_always_strided() )
+    return A.stride(0) <= A.stride(1);
+  else
+    return false;
+}
+
+template<class InMat, class Triangle>
+constexpr void check_packed_triangle() {
+  typedef typename InMat::layout_type layout_type;
+  if constexpr ( is_layout_blas_packed<layout_type>::value )
+    static_assert( is_same<typename layout_type::triangle_type,Triangle>::value,
+                   "Triangle must match the triangle stored by layout_blas_packed" );
+}
+
+// True if A is packed plain memory that the packed kernels below can
+// stream through with a raw pointer.
+template<class InMat>
+struct is_streamable_packed
+  : integral_constant<bool, is_layout_blas_packed<typename InMat::layout_type>::value &&
+                            is_same<typename InMat::accessor_type,accessor_basic<typename InMat::element_type>>::value> {};
+
+// Walks the lines of a packed n x n triangle in storage order, or in
+// reverse, keeping the offset of the current line incrementally.  Line
+// p holds the stored entries q in [q_begin(p),q_end(p)) of row or column
+// p, contiguously; the diagonal entry is its first or its last.
+template<class Layout>
+struct packed_lines {
+  static constexpr bool short_first = Layout::template mapping<extents<dynamic_extent,dynamic_extent>>::is_short_lines_first();
+
+  ptrdiff_t n ;
+
+  constexpr ptrdiff_t q_begin( const ptrdiff_t p ) const noexcept { return short_first ? 0 : p ; }
+  constexpr ptrdiff_t q_end( const ptrdiff_t p ) const noexcept { return short_first ? p+1 : n ; }
+  constexpr ptrdiff_t length( const ptrdiff_t p ) const noexcept { return short_first ? p+1 : n-p ; }
+  constexpr ptrdiff_t diagonal( const ptrdiff_t p ) const noexcept { return short_first ? p : 0 ; }
+  constexpr ptrdiff_t size() const noexcept { return n * ( n + 1 ) / 2 ; }
+};
+
+// symmetric_matrix_vector_update for packed A, streaming the packed
+// storage once from front to back.
+template<bool Conj, class InMat, class InVec, class OutVec>
+void packed_symmetric_matrix_vector_update( const InMat & A, const InVec & x, const OutVec & y ) {
+  typedef typename OutVec::value_type sum_type;
+  typedef packed_lines<typename InMat::layout_type> lines_type;
+  const lines_type lines{ A.extent(0) };
+  const bool column_lines = is_column_oriented(A);
+  const auto * a = A.data();
+
+  for ( ptrdiff_t p = 0 ; p < lines.n ; a += lines.length(p), ++p ) {
+    const ptrdiff_t q0 = lines.q_begin(p);
+    const ptrdiff_t d = lines.diagonal(p);
+    const auto xp = x(p);
+    sum_type sum = ( Conj ? real_if_needed( a[d] ) : a[d] ) * xp;
+    // the off-diagonal entries of the line are a[k] for k != d
+    const ptrdiff_t k_begin = lines_type::short_first ? 0 : 1 ;
+    const ptrdiff_t k_end   = lines_type::short_first ? d : lines.length(p);
+    if ( column_lines ) {
+      for ( ptrdiff_t k = k_begin ; k < k_end ; ++k ) {
+        y(q0+k) += a[k] * xp;
+        sum += ( Conj ? conj_if_needed(a[k]) : a[k] ) * x(q0+k);
+      }
+    }
+    else {
+      for ( ptrdiff_t k = k_begin ; k < k_end ; ++k ) {
+        sum += a[k] * x(q0+k);
+        y(q0+k) += ( Conj ? conj_if_needed(a[k]) : a[k] ) * xp;
+      }
+    }
+    y(p) += sum;
+  }
+}
+
+// triangular_solve_in_place for packed A.  Lower triangles are solved
+// forward and upper ones backward, which visits the packed lines in
+// storage order or exactly in reverse; columns are eliminated as axpys
+// and rows reduced as dot products over contiguous storage.
+template<class InMat, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+void packed_triangular_solve_in_place( const InMat & A, DiagonalStorage, const InOutVec & x, BinaryDivideOp divide ) {
+  typedef typename InOutVec::value_type sum_type;
+  typedef typename InMat::layout_type layout_type;
+  typedef packed_lines<layout_type> lines_type;
+  constexpr bool forward = is_same<typename layout_type::triangle_type,lower_triangle_t>::value;
+  constexpr bool explicit_diag = is_same<DiagonalStorage,explicit_diagonal_t>::value;
+  const lines_type lines{ A.extent(0) };
+  const bool column_lines = is_column_oriented(A);
+  const auto * base = A.data();
+  ptrdiff_t offset = forward ? 0 : lines.size();
+
+  for ( ptrdiff_t step = 0 ; step < lines.n ; ++step ) {
+    const ptrdiff_t p = forward ? step : lines.n-1-step ;
+    if ( ! forward ) offset -= lines.length(p);
+    const auto * a = base + offset ;
+    const ptrdiff_t q0 = lines.q_begin(p);
+    const ptrdiff_t d = lines.diagonal(p);
+    const ptrdiff_t k_begin = lines_type::short_first ? 0 : 1 ;
+    const ptrdiff_t k_end   = lines_type::short_first ? d : lines.length(p);
+
+    if ( column_lines ) {
+      if constexpr ( explicit_diag ) x(p) = divide( x(p), a[d] );
+      const auto xp = x(p);
+      for ( ptrdiff_t k = k_begin ; k < k_end ; ++k ) x(q0+k) -= a[k] * xp;
+    }
+    else {
+      const sum_type sum = x(p) - unrolled_sum( k_end-k_begin, sum_type{},
+        [&]( const ptrdiff_t k ) { return sum_type( a[k_begin+k] * x(q0+k_begin+k) ); } );
+      if constexpr ( explicit_diag ) x(p) = divide( sum, a[d] );
+      else x(p) = sum;
+    }
+    if ( forward ) offset += lines.length(p);
+  }
+}
+
+// y += A x for symmetric (Hermitian if Conj) A, reading only the Triangle
+// of A; every stored element is read exactly once.  The outer loop runs
+// over the lines of A along its storage order; each stored off-diagonal
+// element a contributes both to the current line's sum and, through its
+// mirror image, to one other entry of y.
+template<bool Conj, class InMat, class Triangle, class InVec, class OutVec>
+void symmetric_matrix_vector_update( const InMat & A, Triangle, const InVec & x, const OutVec & y ) {
+  if constexpr ( is_streamable_packed<InMat>::value ) {
+    packed_symmetric_matrix_vector_update<Conj>( A, x, y );
+    return ;
+  }
+  typedef typename OutVec::value_type sum_type;
+  const ptrdiff_t n = A.extent(0);
+  const bool column_lines = is_column_oriented(A);
+  // Along a column of the lower triangle, or a row of the upper,
+  // the stored off-diagonal entries are those past the diagonal.
+  const bool after_diagonal = column_lines == is_same<Triangle,lower_triangle_t>::value;
+
+  for ( ptrdiff_t p = 0 ; p < n ; ++p ) {
+    const ptrdiff_t q_begin = after_diagonal ? p+1 : 0 ;
+    const ptrdiff_t q_end   = after_diagonal ? n : p ;
+    const auto xp = x(p);
+    sum_type sum = ( Conj ? real_if_needed( A(p,p) ) : A(p,p) ) * xp;
+
+    if ( column_lines ) {
+      for ( ptrdiff_t q = q_begin ; q < q_end ; ++q ) {
+        const auto a = A(q,p);
+        y(q) += a * xp;
+        sum += ( Conj ? conj_if_needed(a) : a ) * x(q);
+      }
+    }
+    else {
+      for ( ptrdiff_t q = q_begin ; q < q_end ; ++q ) {
+        const auto a = A(p,q);
+        sum += a * x(q);
+        y(q) += ( Conj ? conj_if_needed(a) : a ) * xp;
+      }
+    }
+    y(p) += sum;
+  }
+}
+
+// y(i) += alpha A(i,j_begin:j_end) x(j_begin:j_end) for i in [i_begin,i_end),
+// touching only the band of A.  Column-oriented matrices are swept as a
+// sequence of axpys, row-oriented ones as a sequence of dots; either way
+// the inner loop runs along A's stride-one dimension, and alpha is
+// applied once per axpy or per dot.
+template<class InMat, class InVec, class OutVec, class Scale>
+void matrix_vector_update_block( const InMat & A, const InVec & x, const OutVec & y,
+                                 const ptrdiff_t i_begin, const ptrdiff_t i_end,
+                                 const ptrdiff_t j_begin, const ptrdiff_t j_end,
+                                 const Scale alpha ) {
+  typedef typename OutVec::value_type sum_type;
+  const ptrdiff_t kl = lower_bandwidth(A);
+  const ptrdiff_t ku = upper_bandwidth(A);
+
+  if ( is_column_oriented(A) ) {
+    for ( ptrdiff_t j = j_begin ; j < j_end ; ++j ) {
+      const auto xj = alpha * x(j);
+      const ptrdiff_t i0 = j-ku > i_begin ? j-ku : i_begin ;
+      const ptrdiff_t i1 = j+kl+1 < i_end ? j+kl+1 : i_end ;
+      for ( ptrdiff_t i = i0 ; i < i1 ; ++i )
+        y(i) += A(i,j) * xj;
+    }
+  }
+  else {
+    for ( ptrdiff_t i = i_begin ; i < i_end ; ++i ) {
+      const ptrdiff_t j0 = i-kl > j_begin ? i-kl : j_begin ;
+      const ptrdiff_t j1 = i+ku+1 < j_end ? i+ku+1 : j_end ;
+      if ( j0 < j1 )
+        y(i) += sum_type( alpha * unrolled_sum( j1-j0, sum_type{}, [&]( const ptrdiff_t k ) { return sum_type( A(i,j0+k) * x(j0+k) ); } ) );
+    }
+  }
+}
+
+// y += alpha A x, touching only the band of A.
+template<class InMat, class InVec, class OutVec, class Scale = no_scaling>
+void matrix_vector_update( const InMat & A, const InVec & x, const OutVec & y, const Scale alpha = Scale{} ) {
+  matrix_vector_update_block( A, x, y, 0, A.extent(0), 0, A.extent(1), alpha );
+}
+
+// Multithreaded matrix_vector_update.  Threads normally own contiguous
+// blocks of rows of y, so no two of them write the same entry.  When the
+// rows are too few for that (a short, wide matrix stored by columns, or
+// fewer rows than threads), each thread instead takes a block of columns,
+// accumulates into a private copy of y, and the copies are summed by
+// row blocks after a barrier.
+template<class InMat, class InVec, class OutVec, class Scale>
+void matrix_vector_update_parallel( const InMat & A, const InVec & x, const OutVec & y,
+                                    const Scale alpha, const size_t num_threads ) {
+  typedef typename OutVec::value_type sum_type;
+  const ptrdiff_t m = A.extent(0);
+  const ptrdiff_t n = A.extent(1);
+
+  // Not worth waking the pool for less than this many entries of A per thread.
+  constexpr ptrdiff_t grain = 16384 ;
+  ptrdiff_t p = ptrdiff_t( num_threads );
+  if ( m * n < p * grain ) p = m * n / grain ;
+  if ( p < 2 ) {
+    matrix_vector_update( A, x, y, alpha );
+    return ;
+  }
+
+  // Row blocks are multiples of a cache line of y, so that threads do not
+  // write to the same line.
+  constexpr ptrdiff_t row_grain = 64 / sizeof(sum_type) > 0 ? 64 / sizeof(sum_type) : 1 ;
+  const bool split_columns = is_column_oriented(A) ? n > m : m < p * row_grain ;
+
+  if ( ! split_columns ) {
+    thread_pool::instance().run( size_t( p ), [&]( const size_t rank, const size_t size, team_barrier & ) {
+      const ptrdiff_t i_begin = partition_begin( m, row_grain, ptrdiff_t( size ), ptrdiff_t( rank ) );
+      const ptrdiff_t i_end   = partition_begin( m, row_grain, ptrdiff_t( size ), ptrdiff_t( rank )+1 );
+      matrix_vector_update_block( A, x, y, i_begin, i_end, 0, n, alpha );
+    });
+    return ;
+  }
+
+  // Sized here rather than by each thread, which could fail to allocate
+  // and leave the others waiting at the barrier.
+  vector<vector<sum_type>> partial( static_cast<size_t>( p ), vector<sum_type>( size_t( m ) ) );
+  thread_pool::instance().run( size_t( p ), [&]( const size_t rank, const size_t size, team_barrier & barrier ) {
+    const ptrdiff_t j_begin = partition_begin( n, 1, ptrdiff_t( size ), ptrdiff_t( rank ) );
+    const ptrdiff_t j_end   = partition_begin( n, 1, ptrdiff_t( size ), ptrdiff_t( rank )+1 );
+    basic_mdspan<sum_type,extents<dynamic_extent>> y_partial( partial[rank].data(), m );
+    matrix_vector_update_block( A, x, y_partial, 0, m, j_begin, j_end, alpha );
+    barrier.arrive_and_wait();
+
+    const ptrdiff_t i_begin = partition_begin( m, row_grain, ptrdiff_t( size ), ptrdiff_t( rank ) );
+    const ptrdiff_t i_end   = partition_begin( m, row_grain, ptrdiff_t( size ), ptrdiff_t( rank )+1 );
+    for ( ptrdiff_t i = i_begin ; i < i_end ; ++i ) {
+      sum_type sum = partial[0][i];
+      for ( size_t t = 1 ; t < size ; ++t ) sum += partial[t][i];
+      y(i) += sum;
+    }
+  });
+}
+
+// Batched matrix_vector_product for a rank-2 y, defined in linalg_batched.hpp.
+template<class InMat, class InVec, class OutVec>
+void batched_matrix_vector_update_dispatch( const InMat & A, const InVec & x, const OutVec & y,
+                                            const size_t num_threads );
+
+// y += A x for the matrix_vector_product entry points.  scaled() wrappers
+// are peeled off A and x and their factors applied by the kernels.  The
+// update goes to the vendor BLAS if it can take it, else to the kernels
+// above, on num_threads threads.  A rank-2 y is a batch of products, and
+// small fully static operands take the unrolled kernels.
+template<class InMat, class InVec, class OutVec>
+void matrix_vector_update_dispatch( const InMat & A, const InVec & x, const OutVec & y, const size_t num_threads ) {
+  if constexpr ( OutVec::rank() == 2 ) {
+    batched_matrix_vector_update_dispatch( A, x, y, num_threads );
+  }
+  else if constexpr ( is_small_static<InMat,InVec,OutVec>::value ) {
+    small_matrix_vector_update( A, x, y );
+  }
+  else {
+    const auto alpha = scaling_factor_of( A ) * scaling_factor_of( x );
+    if ( vendor_matrix_vector_update( unscaled( A ), unscaled( x ), y, alpha ) ) return ;
+    if ( num_threads > 1 )
+      matrix_vector_update_parallel( unscaled( A ), unscaled( x ), y, alpha, num_threads );
+    else
+      matrix_vector_update( unscaled( A ), unscaled( x ), y, alpha );
+  }
+}
+
+// Overwrite x with the solution of T x = x, where T is the Triangle of A,
+// touching only the band of A.  Column-oriented matrices eliminate each
+// finished x(j) from the rest of x; row-oriented ones compute each x(i)
+// as a dot product with the finished part of x.
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+void triangular_solve_in_place( const InMat & A, Triangle, DiagonalStorage,
+                                const InOutVec & x, BinaryDivideOp divide ) {
+  if constexpr ( is_streamable_packed<InMat>::value ) {
+    packed_triangular_solve_in_place( A, DiagonalStorage(), x, divide );
+    return ;
+  }
+  typedef typename InOutVec::value_type sum_type;
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+  constexpr bool explicit_diag = is_same<DiagonalStorage,explicit_diagonal_t>::value;
+  const ptrdiff_t n = A.extent(0);
+  const ptrdiff_t k = lower ? lower_bandwidth(A) : upper_bandwidth(A);
+
+  if ( is_column_oriented(A) ) {
+    for ( ptrdiff_t step = 0 ; step < n ; ++step ) {
+      const ptrdiff_t j = lower ? step : n-1-step ;
+      if constexpr ( explicit_diag ) x(j) = divide( x(j), A(j,j) );
+      const auto xj = x(j);
+      const ptrdiff_t i_begin = lower ? j+1 : ( j-k > 0 ? j-k : 0 );
+      const ptrdiff_t i_end   = lower ? ( j+k+1 < n ? j+k+1 : n ) : j ;
+      for ( ptrdiff_t i = i_begin ; i < i_end ; ++i )
+        x(i) -= A(i,j) * xj;
+    }
+  }
+  else {
+    for ( ptrdiff_t step = 0 ; step < n ; ++step ) {
+      const ptrdiff_t i = lower ? step : n-1-step ;
+      sum_type sum = x(i);
+      const ptrdiff_t j_begin = lower ? ( i-k > 0 ? i-k : 0 ) : i+1 ;
+      const ptrdiff_t j_end   = lower ? i : ( i+k+1 < n ? i+k+1 : n );
+      for ( ptrdiff_t j = j_begin ; j < j_end ; ++j )
+        sum -= A(i,j) * x(j);
+      if constexpr ( explicit_diag ) x(i) = divide( sum, A(i,i) );
+      else x(i) = sum;
+    }
+  }
+}
+
+// Solve T x = x for the triangular_matrix_vector_solve entry points:
+// small fully static operands take the unrolled kernel, others the vendor
+// BLAS if it can take them, else the kernel above.
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+void triangular_solve_in_place_dispatch( const InMat & A, Triangle t, DiagonalStorage d,
+                                         const InOutVec & x, BinaryDivideOp divide ) {
+  if constexpr ( is_small_static_solve<InMat,InOutVec>::value )
+    small_triangular_solve_in_place( A, t, d, x, divide );
+  else if ( ! vendor_triangular_solve_in_place( A, t, d, x, divide ) )
+    triangular_solve_in_place( A, t, d, x, divide );
+}
+
+template<class OutVec>
+void set_zero( const OutVec & y ) {
+  if constexpr ( OutVec::rank() == 1 ) {
+    for ( ptrdiff_t i = 0 ; i < y.extent(0) ; ++i )
+      y(i) = typename OutVec::value_type{};
+  }
+  else {
+    for ( ptrdiff_t i = 0 ; i < y.extent(0) ; ++i )
+      for ( ptrdiff_t j = 0 ; j < y.extent(1) ; ++j )
+        y(i,j) = typename OutVec::value_type{};
+  }
+}
+
+} // namespace detail
+
+template<class InMat, class InVec, class OutVec>
+void matrix_vector_product( InMat A, InVec x, OutVec y ) {
+  detail::set_zero( y );
+  detail::matrix_vector_update_dispatch( A, x, y, 1 );
+}
+
+template<class InMat, class InVec1, class InVec2, class OutVec>
+typename enable_if<!detail::is_linalg_execution_policy_v<InMat>>::type
+matrix_vector_product( InMat A, InVec1 x, InVec2 y, OutVec z ) {
+  copy( y, z );
+  detail::matrix_vector_update_dispatch( A, x, z, 1 );
+}
+
+template<class ExecutionPolicy, class InMat, class InVec, class OutVec>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_vector_product( ExecutionPolicy && exec, InMat A, InVec x, OutVec y ) {
+  detail::set_zero( y );
+  detail::matrix_vector_update_dispatch( A, x, y, detail::execution_policy_threads( exec ) );
+}
+
+template<class ExecutionPolicy, class InMat, class InVec1, class InVec2, class OutVec>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_vector_product( ExecutionPolicy && exec, InMat A, InVec1 x, InVec2 y, OutVec z ) {
+  copy( y, z );
+  detail::matrix_vector_update_dispatch( A, x, z, detail::execution_policy_threads( exec ) );
+}
+
+template<class InMat, class Triangle, class InVec, class OutVec>
+void symmetric_matrix_vector_product( InMat A, Triangle t, InVec x, OutVec y ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  detail::set_zero( y );
+  detail::symmetric_matrix_vector_update<false>( A, t, x, y );
+}
+
+template<class InMat, class Triangle, class InVec1, class InVec2, class OutVec>
+void symmetric_matrix_vector_product( InMat A, Triangle t, InVec1 x, InVec2 y, OutVec z ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  copy( y, z );
+  detail::symmetric_matrix_vector_update<false>( A, t, x, z );
+}
+
+template<class InMat, class Triangle, class InVec, class OutVec>
+void hermitian_matrix_vector_product( InMat A, Triangle t, InVec x, OutVec y ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  detail::set_zero( y );
+  detail::symmetric_matrix_vector_update<true>( A, t, x, y );
+}
+
+template<class InMat, class Triangle, class InVec1, class InVec2, class OutVec>
+void hermitian_matrix_vector_product( InMat A, Triangle t, InVec1 x, InVec2 y, OutVec z ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  copy( y, z );
+  detail::symmetric_matrix_vector_update<true>( A, t, x, z );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InVec, class OutVec, class BinaryDivideOp>
+void triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InVec b, OutVec x, BinaryDivideOp divide ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  copy( b, x );
+  detail::triangular_solve_in_place_dispatch( A, t, d, x, divide );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InVec, class OutVec>
+typename enable_if<detail::is_mdspan<OutVec>::value>::type
+triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InVec b, OutVec x ) {
+  triangular_matrix_vector_solve( A, t, d, b, x, divides<>() );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+typename enable_if<!detail::is_mdspan<BinaryDivideOp>::value>::type
+triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InOutVec b, BinaryDivideOp divide ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  detail::triangular_solve_in_place_dispatch( A, t, d, b, divide );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec>
+void triangular_matrix_vector_solve( InMat A, Triangle t, DiagonalStorage d, InOutVec b ) {
+  triangular_matrix_vector_solve( A, t, d, b, divides<>() );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
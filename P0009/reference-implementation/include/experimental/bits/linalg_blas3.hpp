@@ -0,0 +1,1028 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.algs.blas3.gemm]
+// A rank-3 C holds a batch of products: its leftmost extent indexes the
+// problems, and a rank-2 A, B or E stands for every problem of the batch.
+template<class InMat1, class InMat2, class OutMat>
+void matrix_product( InMat1 A, InMat2 B, OutMat C );
+
+template<class InMat1, class InMat2, class InMat3, class OutMat>
+typename enable_if<!detail::is_linalg_execution_policy_v<InMat1>>::type
+matrix_product( InMat1 A, InMat2 B, InMat3 E, OutMat C );
+
+template<class ExecutionPolicy, class InMat1, class InMat2, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, InMat1 A, InMat2 B, OutMat C );
+
+template<class ExecutionPolicy, class InMat1, class InMat2, class InMat3, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, InMat1 A, InMat2 B, InMat3 E, OutMat C );
+
+// Not part of P1673: as above, but the products are summed in Accumulator
+// instead of C's value type, as P1673's "Accumulate into output value
+// type" allows for.  A and B are read in their own types and widened in
+// registers.
+template<class Accumulator, class InMat1, class InMat2, class OutMat>
+void matrix_product( accumulator_t<Accumulator>, InMat1 A, InMat2 B, OutMat C );
+
+template<class Accumulator, class InMat1, class InMat2, class InMat3, class OutMat>
+void matrix_product( accumulator_t<Accumulator>, InMat1 A, InMat2 B, InMat3 E, OutMat C );
+
+template<class ExecutionPolicy, class Accumulator, class InMat1, class InMat2, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, accumulator_t<Accumulator>, InMat1 A, InMat2 B, OutMat C );
+
+template<class ExecutionPolicy, class Accumulator, class InMat1, class InMat2, class InMat3, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, accumulator_t<Accumulator>, InMat1 A, InMat2 B, InMat3 E, OutMat C );
+
+// Not part of P1673: C = A B for every (A, B, C) in problems, a range of
+// tuples of rank-2 mdspans whose extents vary from problem to problem
+// (a variable-size batch, as in P2901).
+template<class ProblemRange>
+void variable_batch_matrix_product( ProblemRange && problems );
+
+template<class ExecutionPolicy, class ProblemRange>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+variable_batch_matrix_product( ExecutionPolicy && exec, ProblemRange && problems );
+
+// [linalg.algs.blas3.rankk]
+template<class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<!detail::is_linalg_execution_policy_v<Scalar>>::type
+symmetric_matrix_rank_k_update( Scalar alpha, InMat A, InOutMat C, Triangle t );
+
+template<class InMat, class InOutMat, class Triangle>
+void symmetric_matrix_rank_k_update( InMat A, InOutMat C, Triangle t );
+
+template<class ExecutionPolicy, class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+symmetric_matrix_rank_k_update( ExecutionPolicy && exec, Scalar alpha, InMat A, InOutMat C, Triangle t );
+
+template<class ExecutionPolicy, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+symmetric_matrix_rank_k_update( ExecutionPolicy && exec, InMat A, InOutMat C, Triangle t );
+
+template<class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<!detail::is_linalg_execution_policy_v<Scalar>>::type
+hermitian_matrix_rank_k_update( Scalar alpha, InMat A, InOutMat C, Triangle t );
+
+template<class InMat, class InOutMat, class Triangle>
+void hermitian_matrix_rank_k_update( InMat A, InOutMat C, Triangle t );
+
+template<class ExecutionPolicy, class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+hermitian_matrix_rank_k_update( ExecutionPolicy && exec, Scalar alpha, InMat A, InOutMat C, Triangle t );
+
+template<class ExecutionPolicy, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+hermitian_matrix_rank_k_update( ExecutionPolicy && exec, InMat A, InOutMat C, Triangle t );
+
+// [linalg.algs.blas3.trsm]
+// A rank-3 B (and X) holds a batch of solves, and a rank-2 A stands for
+// every problem of the batch.
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_left_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X, BinaryDivideOp divide );
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat>
+typename enable_if<detail::is_mdspan<OutMat>::value>::type
+triangular_matrix_matrix_left_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+typename enable_if<!detail::is_mdspan<BinaryDivideOp>::value>::type
+triangular_matrix_matrix_left_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B, BinaryDivideOp divide );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat>
+void triangular_matrix_matrix_left_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B );
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_right_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X, BinaryDivideOp divide );
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat>
+typename enable_if<detail::is_mdspan<OutMat>::value>::type
+triangular_matrix_matrix_right_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+typename enable_if<!detail::is_mdspan<BinaryDivideOp>::value>::type
+triangular_matrix_matrix_right_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B, BinaryDivideOp divide );
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat>
+void triangular_matrix_matrix_right_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// Block sizes of the packed matrix product, by accumulator type.
+// mr x nr is the register block of the micro-kernel: mr contiguous
+// entries of a packed column of A times nr entries of a packed row
+// of B.  The kc x nr panel of B should stay in L1, the mc x kc block
+// of A in L2 and the kc x nc block of B in L3.
+template<class T>
+struct gemm_blocking {
+  static constexpr ptrdiff_t mr = 4 ;
+  static constexpr ptrdiff_t nr = 4 ;
+  static constexpr ptrdiff_t mc = 64 ;
+  static constexpr ptrdiff_t kc = 256 ;
+  static constexpr ptrdiff_t nc = 2048 ;
+};
+
+template<>
+struct gemm_blocking<double> {
+  static constexpr ptrdiff_t mr = 8 ;
+  static constexpr ptrdiff_t nr = 4 ;
+  static constexpr ptrdiff_t mc = 96 ;
+  static constexpr ptrdiff_t kc = 256 ;
+  static constexpr ptrdiff_t nc = 2048 ;
+};
+
+template<>
+struct gemm_blocking<float> {
+  static constexpr ptrdiff_t mr = 16 ;
+  static constexpr ptrdiff_t nr = 4 ;
+  static constexpr ptrdiff_t mc = 128 ;
+  static constexpr ptrdiff_t kc = 384 ;
+  static constexpr ptrdiff_t nc = 2048 ;
+};
+
+// Copy A(i0:i0+mc,k0:k0+kc) into row panels of MR rows; within a panel
+// the MR entries of each column are contiguous.  Rows past mc are zero,
+// so the micro-kernel never checks bounds.  A is read along its
+// storage order, whatever its layout.
+template<ptrdiff_t MR, class InMat, class T>
+void pack_a( const InMat & A, const ptrdiff_t i0, const ptrdiff_t mc,
+             const ptrdiff_t k0, const ptrdiff_t kc, T * buf ) {
+  const bool column_major = is_column_oriented(A);
+  for ( ptrdiff_t ip = 0 ; ip < mc ; ip += MR, buf += MR*kc ) {
+    const ptrdiff_t mr = MR < mc-ip ? MR : mc-ip ;
+    if ( column_major ) {
+      for ( ptrdiff_t k = 0 ; k < kc ; ++k ) {
+        for ( ptrdiff_t i = 0 ; i < mr ; ++i ) buf[k*MR+i] = A(i0+ip+i,k0+k);
+        for ( ptrdiff_t i = mr ; i < MR ; ++i ) buf[k*MR+i] = T{};
+      }
+    }
+    else {
+      for ( ptrdiff_t i = 0 ; i < mr ; ++i )
+        for ( ptrdiff_t k = 0 ; k < kc ; ++k ) buf[k*MR+i] = A(i0+ip+i,k0+k);
+      for ( ptrdiff_t i = mr ; i < MR ; ++i )
+        for ( ptrdiff_t k = 0 ; k < kc ; ++k ) buf[k*MR+i] = T{};
+    }
+  }
+}
+
+// Copy B(k0:k0+kc,j0:j0+nc) into column panels of NR columns; within a
+// panel the NR entries of each row are contiguous.  Columns past nc are zero.
+template<ptrdiff_t NR, class InMat, class T>
+void pack_b( const InMat & B, const ptrdiff_t k0, const ptrdiff_t kc,
+             const ptrdiff_t j0, const ptrdiff_t nc, T * buf ) {
+  const bool column_major = is_column_oriented(B);
+  for ( ptrdiff_t jp = 0 ; jp < nc ; jp += NR, buf += NR*kc ) {
+    const ptrdiff_t nr = NR < nc-jp ? NR : nc-jp ;
+    if ( column_major ) {
+      for ( ptrdiff_t j = 0 ; j < nr ; ++j )
+        for ( ptrdiff_t k = 0 ; k < kc ; ++k ) buf[k*NR+j] = B(k0+k,j0+jp+j);
+      for ( ptrdiff_t j = nr ; j < NR ; ++j )
+        for ( ptrdiff_t k = 0 ; k < kc ; ++k ) buf[k*NR+j] = T{};
+    }
+    else {
+      for ( ptrdiff_t k = 0 ; k < kc ; ++k ) {
+        for ( ptrdiff_t j = 0 ; j < nr ; ++j ) buf[k*NR+j] = B(k0+k,j0+jp+j);
+        for ( ptrdiff_t j = nr ; j < NR ; ++j ) buf[k*NR+j] = T{};
+      }
+    }
+  }
+}
+
+// acc = (packed MR x kc panel of A) * (packed kc x NR panel of B).
+// The fixed-size accumulator lives in registers; the loop over i is
+// along contiguous entries of the A panel and vectorizes.  An A panel
+// narrower than Accum is widened in registers as it is loaded.
+template<ptrdiff_t MR, ptrdiff_t NR, class Accum, class TA, class TB>
+inline void gemm_micro_kernel( const ptrdiff_t kc, const TA * __restrict a,
+                               const TB * __restrict b, Accum (&acc)[NR][MR] ) {
+  for ( ptrdiff_t j = 0 ; j < NR ; ++j )
+    for ( ptrdiff_t i = 0 ; i < MR ; ++i ) acc[j][i] = Accum{};
+
+  for ( ptrdiff_t p = 0 ; p < kc ; ++p, a += MR, b += NR ) {
+    for ( ptrdiff_t j = 0 ; j < NR ; ++j ) {
+      const Accum bj = b[j];
+      for ( ptrdiff_t i = 0 ; i < MR ; ++i ) acc[j][i] += Accum(a[i]) * bj;
+    }
+  }
+}
+
+// Workspace for the packed panels of A and B, sized for one block each.
+// The algorithms pack B in the accumulator type: each of its entries is
+// broadcast across a register, and widening it once while packing costs
+// far less than widening it at every broadcast.  c_buf holds the partial
+// sums of one macro-tile of C when they must stay in the accumulator
+// type, and is sized on first use.
+template<class TA, class TB, class Blocking>
+struct gemm_workspace {
+  vector<TA> a_buf ;
+  vector<TB> b_buf ;
+  vector<TB> c_buf ;
+
+  gemm_workspace( const ptrdiff_t mc, const ptrdiff_t kc, const ptrdiff_t nc )
+    : a_buf( ( ( mc + Blocking::mr - 1 ) / Blocking::mr ) * Blocking::mr * kc )
+    , b_buf( ( ( nc + Blocking::nr - 1 ) / Blocking::nr ) * Blocking::nr * kc )
+    {}
+};
+
+// How the product P of a matrix multiply is combined with C.
+enum class gemm_update { assign, add, subtract };
+
+// Update of C for the kc step starting at pc: only the first step of an
+// assignment overwrites C, every later one accumulates.
+constexpr gemm_update gemm_step_update( const gemm_update update, const ptrdiff_t pc ) noexcept {
+  return update == gemm_update::assign && pc != 0 ? gemm_update::add : update ;
+}
+
+// C(ic:ic+mc,jc:jc+nc) =, += or -= alpha * packed A block * packed B block.
+// alpha multiplies each finished register block, not each product.
+template<class Accum, class Blocking, class TA, class TB, class OutMat, class Scale>
+void gemm_macro_kernel( const ptrdiff_t mc, const ptrdiff_t nc, const ptrdiff_t kc,
+                        const TA * a_buf, const TB * b_buf,
+                        const OutMat & C, const ptrdiff_t ic, const ptrdiff_t jc,
+                        const gemm_update update, const Scale alpha ) {
+  constexpr ptrdiff_t MR = Blocking::mr ;
+  constexpr ptrdiff_t NR = Blocking::nr ;
+  Accum acc[NR][MR];
+
+  for ( ptrdiff_t jr = 0 ; jr < nc ; jr += NR ) {
+    const ptrdiff_t nr = NR < nc-jr ? NR : nc-jr ;
+    for ( ptrdiff_t ir = 0 ; ir < mc ; ir += MR ) {
+      const ptrdiff_t mr = MR < mc-ir ? MR : mc-ir ;
+      gemm_micro_kernel<MR,NR>( kc, a_buf + ir*kc, b_buf + jr*kc, acc );
+      for ( ptrdiff_t j = 0 ; j < nr ; ++j )
+        for ( ptrdiff_t i = 0 ; i < mr ; ++i ) {
+          auto && c = C(ic+ir+i,jc+jr+j);
+          const Accum p = Accum( alpha * acc[j][i] );
+          if ( update == gemm_update::assign ) c = p;
+          else if ( update == gemm_update::add ) c = Accum( c ) + p;
+          else c = Accum( c ) - p;
+        }
+    }
+  }
+}
+
+// Column-major view of an m x n macro-tile of partial sums.
+template<class T>
+basic_mdspan<T,extents<dynamic_extent,dynamic_extent>,layout_left>
+gemm_tile( T * buf, const ptrdiff_t m, const ptrdiff_t n ) {
+  return basic_mdspan<T,extents<dynamic_extent,dynamic_extent>,layout_left>( buf, m, n );
+}
+
+// C(ic:ic+mc,jc:jc+nc) =, += or -= the finished macro-tile T, rounded
+// to C's value type once.
+template<class Tile, class OutMat>
+void gemm_store_tile( const Tile & T, const OutMat & C, const ptrdiff_t ic, const ptrdiff_t jc,
+                      const gemm_update update ) {
+  typedef typename Tile::value_type Accum;
+  for ( ptrdiff_t j = 0 ; j < T.extent(1) ; ++j )
+    for ( ptrdiff_t i = 0 ; i < T.extent(0) ; ++i ) {
+      auto && c = C(ic+i,jc+j);
+      if ( update == gemm_update::assign ) c = T(i,j);
+      else if ( update == gemm_update::add ) c = Accum( c ) + T(i,j);
+      else c = Accum( c ) - T(i,j);
+    }
+}
+
+// True if the partial sums of C must not be kept in C between kc steps:
+// rounding them to a value type narrower than Accum at every step would
+// lose what the wider accumulator is for.
+template<class Accum, class OutMat>
+bool gemm_keeps_tile( const ptrdiff_t k ) {
+  return ! is_same<Accum,typename OutMat::value_type>::value && k > gemm_blocking<Accum>::kc ;
+}
+
+// C = alpha A B, C += alpha A B or C -= alpha A B, for any layouts of
+// A, B and C: the loops over C are blocked for the caches and both
+// operands are packed into contiguous panels for the register-blocked
+// micro-kernel.  Packing reads A and B along their storage order, so a
+// transposed operand costs nothing extra.  The workspace holds one
+// min(mc,m) x min(kc,k) block of A and one min(kc,k) x min(nc,n) block
+// of B, and may be reused across calls.  If gemm_keeps_tile, each
+// macro-tile of C is instead summed over all of k in work.c_buf and
+// stored once; B is then packed again for every block row of C, which
+// costs about 1/mc of the multiply.
+template<class Accum, class InMat1, class InMat2, class OutMat, class Scale, class Workspace>
+void matrix_product_blocked( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                             const gemm_update update, const Scale alpha, Workspace & work ) {
+  typedef gemm_blocking<Accum> blocking;
+
+  const ptrdiff_t m = C.extent(0);
+  const ptrdiff_t n = C.extent(1);
+  const ptrdiff_t k = A.extent(1);
+
+  if ( k == 0 ) {
+    if ( update == gemm_update::assign )
+      for ( ptrdiff_t j = 0 ; j < n ; ++j )
+        for ( ptrdiff_t i = 0 ; i < m ; ++i ) C(i,j) = typename OutMat::value_type{};
+    return ;
+  }
+
+  // Rows of C covered by one pass over k.
+  const bool keep_tile = gemm_keeps_tile<Accum,OutMat>( k );
+  const ptrdiff_t rows = keep_tile ? blocking::mc : m ;
+  if ( keep_tile ) {
+    const size_t c_size = size_t( ( blocking::mc < m ? blocking::mc : m ) * ( blocking::nc < n ? blocking::nc : n ) );
+    if ( work.c_buf.size() < c_size ) work.c_buf.resize( c_size );
+  }
+
+  for ( ptrdiff_t jc = 0 ; jc < n ; jc += blocking::nc ) {
+    const ptrdiff_t nc = blocking::nc < n-jc ? blocking::nc : n-jc ;
+    for ( ptrdiff_t ib = 0 ; ib < m ; ib += rows ) {
+      const ptrdiff_t ib_end = rows < m-ib ? ib+rows : m ;
+      for ( ptrdiff_t pc = 0 ; pc < k ; pc += blocking::kc ) {
+        const ptrdiff_t kc = blocking::kc < k-pc ? blocking::kc : k-pc ;
+        pack_b<blocking::nr>( B, pc, kc, jc, nc, work.b_buf.data() );
+        for ( ptrdiff_t ic = ib ; ic < ib_end ; ic += blocking::mc ) {
+          const ptrdiff_t mc = blocking::mc < ib_end-ic ? blocking::mc : ib_end-ic ;
+          pack_a<blocking::mr>( A, ic, mc, pc, kc, work.a_buf.data() );
+          if ( keep_tile )
+            gemm_macro_kernel<Accum,blocking>( mc, nc, kc, work.a_buf.data(), work.b_buf.data(),
+                                               gemm_tile( work.c_buf.data(), mc, nc ), 0, 0,
+                                               gemm_step_update( gemm_update::assign, pc ), alpha );
+          else
+            gemm_macro_kernel<Accum,blocking>( mc, nc, kc, work.a_buf.data(), work.b_buf.data(),
+                                               C, ic, jc, gemm_step_update( update, pc ), alpha );
+        }
+      }
+      if ( keep_tile ) gemm_store_tile( gemm_tile( work.c_buf.data(), ib_end-ib, nc ), C, ib, jc, update );
+    }
+  }
+}
+
+template<class Accum, class InMat1, class InMat2, class OutMat, class Scale = no_scaling>
+void matrix_product_blocked( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                             const gemm_update update, const Scale alpha = Scale{} ) {
+  typedef gemm_blocking<Accum> blocking;
+  typedef typename InMat1::value_type a_value_type;
+
+  const ptrdiff_t m = C.extent(0);
+  const ptrdiff_t n = C.extent(1);
+  const ptrdiff_t k = A.extent(1);
+
+  gemm_workspace<a_value_type,Accum,blocking> work(
+    blocking::mc < m ? blocking::mc : m, blocking::kc < k ? blocking::kc : k, blocking::nc < n ? blocking::nc : n );
+  matrix_product_blocked<Accum>( A, B, C, update, alpha, work );
+}
+
+// Choose a tm x tn grid of threads over the m x n output block that
+// minimizes the largest tile, counted in whole micro-kernel blocks.
+// Ties go to fewer column groups, since each of them repacks A.
+template<class Blocking>
+void gemm_thread_grid( const ptrdiff_t m, const ptrdiff_t n, const ptrdiff_t p,
+                       ptrdiff_t & tm, ptrdiff_t & tn ) {
+  const ptrdiff_t mb = ( m + Blocking::mr - 1 ) / Blocking::mr ;
+  const ptrdiff_t nb = ( n + Blocking::nr - 1 ) / Blocking::nr ;
+  ptrdiff_t best = -1 ;
+  for ( ptrdiff_t cols = 1 ; cols <= p ; ++cols ) {
+    if ( p % cols ) continue ;
+    const ptrdiff_t rows = p / cols ;
+    const ptrdiff_t tile = ( ( mb + rows - 1 ) / rows ) * Blocking::mr
+                         * ( ( nb + cols - 1 ) / cols ) * Blocking::nr ;
+    if ( best < 0 || tile < best ) { best = tile ; tm = rows ; tn = cols ; }
+  }
+}
+
+// Multithreaded matrix_product_blocked.  The threads form a 2-D grid
+// over each nc-wide block of C.  For every kc-deep step they pack the
+// shared B panel together, each thread its own range of nr-panels,
+// then each multiplies its tile using a private packed A block.  Both
+// buffers are first touched by the threads that use them, so on a
+// first-touch NUMA system their pages land near those threads.  If
+// gemm_keeps_tile, each thread covers its rows one block row at a time
+// and sums that macro-tile over all of k in a private buffer.
+template<class Accum, class InMat1, class InMat2, class OutMat, class Scale>
+void matrix_product_parallel( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                              const gemm_update update, const Scale alpha, const size_t num_threads ) {
+  typedef gemm_blocking<Accum> blocking;
+  typedef typename InMat1::value_type a_value_type;
+  constexpr ptrdiff_t MR = blocking::mr ;
+  constexpr ptrdiff_t NR = blocking::nr ;
+
+  const ptrdiff_t m = C.extent(0);
+  const ptrdiff_t n = C.extent(1);
+  const ptrdiff_t k = A.extent(1);
+  const ptrdiff_t nc_max = blocking::nc < n ? blocking::nc : n ;
+  const ptrdiff_t kc_max = blocking::kc < k ? blocking::kc : k ;
+
+  // Not worth waking the pool for less than one block per thread.
+  const ptrdiff_t tiles = ( ( m + MR - 1 ) / MR ) * ( ( nc_max + NR - 1 ) / NR );
+  ptrdiff_t p = ptrdiff_t( num_threads ) < tiles ? ptrdiff_t( num_threads ) : tiles ;
+  if ( p > 1 && m * n * k < p * blocking::mc * NR * kc_max ) p = 1 ;
+  if ( p < 2 || k == 0 ) {
+    matrix_product_blocked<Accum>( A, B, C, update, alpha );
+    return ;
+  }
+
+  ptrdiff_t tm = p , tn = 1 ;
+  gemm_thread_grid<blocking>( m, nc_max, p, tm, tn );
+
+  // Left uninitialized so that the packing threads touch it first.
+  // The A panels of every thread are allocated here as well: a thread
+  // that failed to allocate inside the job would leave the others
+  // waiting at the barrier.
+  const ptrdiff_t mc_max = blocking::mc < m ? blocking::mc : m ;
+  const ptrdiff_t a_size = ( ( mc_max + MR - 1 ) / MR ) * MR * kc_max ;
+  unique_ptr<Accum[]> b_buf( new Accum[ ( ( nc_max + NR - 1 ) / NR ) * NR * kc_max ] );
+  unique_ptr<a_value_type[]> a_bufs( new a_value_type[ p * a_size ] );
+
+  // Rows of C each thread covers in one pass over k; every thread makes
+  // as many passes as the first, which has the most rows.
+  const bool keep_tile = gemm_keeps_tile<Accum,OutMat>( k );
+  const ptrdiff_t rows = keep_tile ? blocking::mc : m ;
+  const ptrdiff_t passes = ( partition_begin( m, MR, tm, 1 ) + rows - 1 ) / rows ;
+  const ptrdiff_t c_size = keep_tile ? mc_max * partition_begin( nc_max, NR, tn, 1 ) : 0 ;
+  unique_ptr<Accum[]> c_bufs( new Accum[ p * c_size ] );
+
+  thread_pool::instance().run( size_t( p ), [&]( const size_t rank, const size_t size, team_barrier & barrier ) {
+    // Nested in another run(), this is a team of one, not the tm x tn grid.
+    if ( size != size_t( p ) ) {
+      matrix_product_blocked<Accum>( A, B, C, update, alpha );
+      return ;
+    }
+    const ptrdiff_t rm = ptrdiff_t( rank ) % tm ;
+    const ptrdiff_t rn = ptrdiff_t( rank ) / tm ;
+    const ptrdiff_t i_begin = partition_begin( m, MR, tm, rm );
+    const ptrdiff_t i_end   = partition_begin( m, MR, tm, rm+1 );
+    a_value_type * const a_buf = a_bufs.get() + ptrdiff_t( rank ) * a_size ;
+    Accum * const c_buf = c_bufs.get() + ptrdiff_t( rank ) * c_size ;
+
+    for ( ptrdiff_t jc = 0 ; jc < n ; jc += blocking::nc ) {
+      const ptrdiff_t nc = blocking::nc < n-jc ? blocking::nc : n-jc ;
+      const ptrdiff_t panels = ( nc + NR - 1 ) / NR ;
+      const ptrdiff_t q_begin = partition_begin( panels, 1, ptrdiff_t( size ), ptrdiff_t( rank ) );
+      const ptrdiff_t q_end   = partition_begin( panels, 1, ptrdiff_t( size ), ptrdiff_t( rank )+1 );
+      const ptrdiff_t j_begin = partition_begin( nc, NR, tn, rn );
+      const ptrdiff_t j_end   = partition_begin( nc, NR, tn, rn+1 );
+
+      for ( ptrdiff_t pass = 0 ; pass < passes ; ++pass ) {
+        const ptrdiff_t ib     = rows*pass < i_end-i_begin ? i_begin + rows*pass : i_end ;
+        const ptrdiff_t ib_end = rows < i_end-ib ? ib+rows : i_end ;
+
+        for ( ptrdiff_t pc = 0 ; pc < k ; pc += blocking::kc ) {
+          const ptrdiff_t kc = blocking::kc < k-pc ? blocking::kc : k-pc ;
+          if ( q_begin < q_end ) {
+            const ptrdiff_t q_cols = ( q_end*NR < nc ? q_end*NR : nc ) - q_begin*NR ;
+            pack_b<NR>( B, pc, kc, jc + q_begin*NR, q_cols, b_buf.get() + q_begin*NR*kc );
+          }
+          barrier.arrive_and_wait();
+
+          if ( j_begin < j_end ) {
+            for ( ptrdiff_t ic = ib ; ic < ib_end ; ic += blocking::mc ) {
+              const ptrdiff_t mc = blocking::mc < ib_end-ic ? blocking::mc : ib_end-ic ;
+              pack_a<MR>( A, ic, mc, pc, kc, a_buf );
+              if ( keep_tile )
+                gemm_macro_kernel<Accum,blocking>( mc, j_end-j_begin, kc, a_buf, b_buf.get() + j_begin*kc,
+                                                   gemm_tile( c_buf, mc, j_end-j_begin ), 0, 0,
+                                                   gemm_step_update( gemm_update::assign, pc ), alpha );
+              else
+                gemm_macro_kernel<Accum,blocking>( mc, j_end-j_begin, kc, a_buf, b_buf.get() + j_begin*kc,
+                                                   C, ic, jc+j_begin, gemm_step_update( update, pc ), alpha );
+            }
+          }
+          barrier.arrive_and_wait();
+        }
+        if ( keep_tile && ib < ib_end && j_begin < j_end )
+          gemm_store_tile( gemm_tile( c_buf, ib_end-ib, j_end-j_begin ), C, ib, jc+j_begin, update );
+      }
+    }
+  });
+}
+
+// Batched matrix_product for a rank-3 C, defined in linalg_batched.hpp.
+template<class Accum, class InMat1, class InMat2, class OutMat>
+void batched_matrix_product_dispatch( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                                      const bool accumulate, const size_t num_threads );
+
+// variable_batch_matrix_product over count problems at a random-access
+// iterator, defined in linalg_batched.hpp.
+template<class ProblemIterator>
+void variable_batch_matrix_product( const ProblemIterator problems, const ptrdiff_t count, const size_t num_threads );
+
+// Calls variable_batch_matrix_product in place if the range is random
+// access, else on a copy of it.
+template<class ProblemRange>
+void variable_batch_matrix_product_range( ProblemRange && problems, const size_t num_threads ) {
+  typedef decltype( begin( problems ) ) iterator;
+  if constexpr ( is_base_of_v<random_access_iterator_tag,typename iterator_traits<iterator>::iterator_category> ) {
+    variable_batch_matrix_product( begin( problems ), ptrdiff_t( end( problems ) - begin( problems ) ), num_threads );
+  }
+  else {
+    const vector<typename iterator_traits<iterator>::value_type> copy( begin( problems ), end( problems ) );
+    variable_batch_matrix_product( copy.begin(), ptrdiff_t( copy.size() ), num_threads );
+  }
+}
+
+// C = A B, or C += A B if accumulate, for the matrix_product entry points.
+// scaled() wrappers are peeled off A and B and their factors applied by
+// the kernels.  The product goes to the vendor BLAS if it can take it,
+// else to the packed kernels, on num_threads threads.  A rank-3 C is a
+// batch of products, and small fully static operands take the unrolled
+// kernels of linalg_small.hpp.
+template<class Accum, class InMat1, class InMat2, class OutMat>
+void matrix_product_dispatch( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                              const bool accumulate, const size_t num_threads ) {
+  if constexpr ( OutMat::rank() == 3 ) {
+    batched_matrix_product_dispatch<Accum>( A, B, C, accumulate, num_threads );
+  }
+  else if constexpr ( is_small_static<InMat1,InMat2,OutMat>::value ) {
+    small_matrix_product<Accum>( A, B, C, accumulate );
+  }
+  else {
+    const auto alpha = scaling_factor_of( A ) * scaling_factor_of( B );
+    // The BLAS sums in C's value type, so a wider Accum must stay here.
+    if constexpr ( is_same<Accum,typename OutMat::value_type>::value )
+      if ( vendor_matrix_product( unscaled( A ), unscaled( B ), C, accumulate, alpha ) ) return ;
+    const gemm_update update = accumulate ? gemm_update::add : gemm_update::assign ;
+    if ( num_threads > 1 )
+      matrix_product_parallel<Accum>( unscaled( A ), unscaled( B ), C, update, alpha, num_threads );
+    else
+      matrix_product_blocked<Accum>( unscaled( A ), unscaled( B ), C, update, alpha );
+  }
+}
+
+// C(ic:ic+mc,jc:jc+nc) += alpha * packed A block * packed B block, on
+// and below (Lower) or on and above the diagonal of C only.  Register
+// blocks entirely outside the triangle are skipped and those crossing the
+// diagonal are masked, so at most one block row per block column does
+// wasted work.  A Hermitian update adds only the real part on the diagonal.
+template<class Accum, class Blocking, bool Lower, bool Hermitian, class TA, class TB, class InOutMat, class Scale>
+void rank_k_macro_kernel( const ptrdiff_t mc, const ptrdiff_t nc, const ptrdiff_t kc,
+                          const TA * a_buf, const TB * b_buf,
+                          const InOutMat & C, const ptrdiff_t ic, const ptrdiff_t jc,
+                          const Scale alpha ) {
+  constexpr ptrdiff_t MR = Blocking::mr ;
+  constexpr ptrdiff_t NR = Blocking::nr ;
+  Accum acc[NR][MR];
+
+  for ( ptrdiff_t jr = 0 ; jr < nc ; jr += NR ) {
+    const ptrdiff_t nr = NR < nc-jr ? NR : nc-jr ;
+    const ptrdiff_t j0 = jc + jr ;
+    for ( ptrdiff_t ir = 0 ; ir < mc ; ir += MR ) {
+      const ptrdiff_t mr = MR < mc-ir ? MR : mc-ir ;
+      const ptrdiff_t i0 = ic + ir ;
+      if ( Lower ? i0+mr-1 < j0 : i0 > j0+nr-1 ) continue ;
+      const bool inside = Lower ? i0 >= j0+nr-1 : i0+mr-1 <= j0 ;
+      gemm_micro_kernel<MR,NR>( kc, a_buf + ir*kc, b_buf + jr*kc, acc );
+      for ( ptrdiff_t j = 0 ; j < nr ; ++j )
+        for ( ptrdiff_t i = 0 ; i < mr ; ++i ) {
+          if ( ! inside && ( Lower ? i0+i < j0+j : i0+i > j0+j ) ) continue ;
+          auto && c = C(i0+i,j0+j);
+          const Accum p = Accum( alpha * acc[j][i] );
+          if ( Hermitian && i0+i == j0+j ) c = Accum( c ) + real_if_needed( p );
+          else c = Accum( c ) + p;
+        }
+    }
+  }
+}
+
+// C(i,j) += alpha A(i,:) B(:,j) for the rows i in [i_begin,i_end) of C and
+// the columns j in its Lower or upper triangle, where B is the (conjugate)
+// transpose of A.  The packed matrix_product loops, restricted to the
+// column blocks and row blocks that meet the triangle.
+template<class Accum, bool Lower, bool Hermitian, class InMat1, class InMat2, class InOutMat, class Scale>
+void rank_k_update_rows( const InMat1 & A, const InMat2 & B, const InOutMat & C, const Scale alpha,
+                         const ptrdiff_t i_begin, const ptrdiff_t i_end ) {
+  typedef gemm_blocking<Accum> blocking;
+  const ptrdiff_t n = C.extent(1);
+  const ptrdiff_t k = A.extent(1);
+  const ptrdiff_t j_begin = Lower ? 0 : i_begin ;
+  const ptrdiff_t j_end   = Lower ? i_end : n ;
+  if ( k == 0 || i_begin >= i_end ) return ;
+
+  gemm_workspace<typename InMat1::value_type,Accum,blocking> work(
+    blocking::mc < i_end-i_begin ? blocking::mc : i_end-i_begin, blocking::kc < k ? blocking::kc : k,
+    blocking::nc < j_end-j_begin ? blocking::nc : j_end-j_begin );
+
+  for ( ptrdiff_t jc = j_begin ; jc < j_end ; jc += blocking::nc ) {
+    const ptrdiff_t nc = blocking::nc < j_end-jc ? blocking::nc : j_end-jc ;
+    // Rows of this block column that meet the triangle
+    const ptrdiff_t r_begin = Lower && jc > i_begin ? jc : i_begin ;
+    const ptrdiff_t r_end   = ! Lower && jc+nc < i_end ? jc+nc : i_end ;
+    for ( ptrdiff_t pc = 0 ; pc < k ; pc += blocking::kc ) {
+      const ptrdiff_t kc = blocking::kc < k-pc ? blocking::kc : k-pc ;
+      pack_b<blocking::nr>( B, pc, kc, jc, nc, work.b_buf.data() );
+      for ( ptrdiff_t ic = r_begin ; ic < r_end ; ic += blocking::mc ) {
+        const ptrdiff_t mc = blocking::mc < r_end-ic ? blocking::mc : r_end-ic ;
+        pack_a<blocking::mr>( A, ic, mc, pc, kc, work.a_buf.data() );
+        rank_k_macro_kernel<Accum,blocking,Lower,Hermitian>( mc, nc, kc, work.a_buf.data(), work.b_buf.data(),
+                                                             C, ic, jc, alpha );
+      }
+    }
+  }
+}
+
+// Begin of the part-th of `parts` ranges of rows of an n x n triangle
+// holding nearly equal numbers of entries, in units of `grain` rows.
+// Row i of a lower triangle holds i+1 entries, so the first t/parts of
+// the entries end near row n sqrt(t/parts); an upper triangle is the
+// mirror image.
+inline ptrdiff_t triangle_partition_begin( const ptrdiff_t n, const ptrdiff_t grain,
+                                           const ptrdiff_t parts, const ptrdiff_t part, const bool lower ) {
+  if ( part <= 0 ) return 0 ;
+  if ( part >= parts ) return n ;
+  const double f = lower ? double( part ) / double( parts ) : double( parts - part ) / double( parts );
+  const double rows = double( n ) * sqrt( f );
+  ptrdiff_t begin = grain * ptrdiff_t( ( lower ? rows : double( n ) - rows ) / double( grain ) + 0.5 );
+  return begin < n ? begin : n ;
+}
+
+template<bool Hermitian, class InMat>
+auto rank_k_transpose( const InMat & A ) {
+  if constexpr ( Hermitian ) return conjugate_transposed( A );
+  else return transposed( A );
+}
+
+// C += alpha A A^T (or A A^H if Hermitian) on one triangle of C, on
+// num_threads threads.  Each thread owns a range of rows of C holding an
+// equal share of the triangle and packs the parts of A it needs itself,
+// so the threads never synchronize.
+template<bool Hermitian, class InMat, class InOutMat, class Triangle, class Scalar>
+void rank_k_update( const InMat & A_in, const InOutMat & C, Triangle, const Scalar alpha_in,
+                    const size_t num_threads ) {
+  typedef typename InOutMat::value_type accum_type;
+  typedef gemm_blocking<accum_type> blocking;
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+  const auto A = unscaled( A_in );
+  const auto s = scaling_factor_of( A_in );
+  const auto alpha = alpha_in * s * ( Hermitian ? conj_if_needed( s ) : s );
+  const auto B = rank_k_transpose<Hermitian>( A );
+  const ptrdiff_t n = C.extent(0);
+  const ptrdiff_t k = A.extent(1);
+
+  ptrdiff_t p = ptrdiff_t( num_threads );
+  if ( p > n / blocking::mr ) p = n / blocking::mr ;
+  if ( p > 1 && n * n * k < 2 * p * blocking::mc * blocking::nr * blocking::kc ) p = 1 ;
+  if ( p < 2 ) {
+    rank_k_update_rows<accum_type,lower,Hermitian>( A, B, C, alpha, 0, n );
+    return ;
+  }
+  thread_pool::instance().run( size_t( p ), [&]( const size_t rank, const size_t size, team_barrier & ) {
+    const ptrdiff_t i_begin = triangle_partition_begin( n, blocking::mr, ptrdiff_t( size ), ptrdiff_t( rank ), lower );
+    const ptrdiff_t i_end   = triangle_partition_begin( n, blocking::mr, ptrdiff_t( size ), ptrdiff_t( rank )+1, lower );
+    rank_k_update_rows<accum_type,lower,Hermitian>( A, B, C, alpha, i_begin, i_end );
+  });
+}
+
+// Order of diagonal blocks below which triangular_matrix_matrix_solve
+// stops recursing and solves directly.
+inline constexpr ptrdiff_t trsm_block = 64 ;
+
+// Solve A X = B (Left) or X A = B (!Left) in place in B by substitution,
+// touching only the band of A.  The elimination sweeps B's rows (for a
+// left solve) or columns (for a right solve) in the order the triangle
+// requires; the inner loop runs along B's stride-one dimension.
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_solve_direct( const InMat & A, Triangle, DiagonalStorage,
+                                            const InOutMat & B, BinaryDivideOp divide ) {
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+  constexpr bool explicit_diag = is_same<DiagonalStorage,explicit_diagonal_t>::value;
+  const ptrdiff_t n = A.extent(0);
+  const ptrdiff_t m = Left ? B.extent(1) : B.extent(0);   // number of systems
+  const ptrdiff_t kl = lower_bandwidth(A);
+  const ptrdiff_t ku = upper_bandwidth(A);
+  // Solving forward for a lower left or an upper right solve.
+  constexpr bool forward = Left == lower;
+
+  // B(k,s) for a left solve, B(s,k) for a right one: unknown k of system s
+  auto b = [&]( const ptrdiff_t k, const ptrdiff_t sys ) -> typename InOutMat::reference {
+    if constexpr ( Left ) return B(k,sys); else return B(sys,k);
+  };
+  // Coefficient of finished unknown k in the equation of unknown q
+  auto a = [&]( const ptrdiff_t q, const ptrdiff_t k ) {
+    if constexpr ( Left ) return A(q,k); else return A(k,q);
+  };
+  // The unknowns q that depend on k lie past k in the solve order,
+  // within the band of A.
+  const ptrdiff_t reach = Left == lower ? ( Left ? kl : ku ) : ( Left ? ku : kl );
+  // Systems are contiguous when B's stride-one dimension runs across them.
+  const bool systems_inner = Left ? ! is_column_oriented(B) : is_column_oriented(B);
+
+  for ( ptrdiff_t step = 0 ; step < n ; ++step ) {
+    const ptrdiff_t k = forward ? step : n-1-step ;
+    const ptrdiff_t q_begin = forward ? k+1 : ( k-reach > 0 ? k-reach : 0 );
+    const ptrdiff_t q_end   = forward ? ( k+reach+1 < n ? k+reach+1 : n ) : k ;
+    if ( systems_inner ) {
+      if constexpr ( explicit_diag ) {
+        const auto akk = A(k,k);
+        for ( ptrdiff_t sys = 0 ; sys < m ; ++sys ) b(k,sys) = divide( b(k,sys), akk );
+      }
+      for ( ptrdiff_t q = q_begin ; q < q_end ; ++q ) {
+        const auto aqk = a(q,k);
+        for ( ptrdiff_t sys = 0 ; sys < m ; ++sys ) b(q,sys) -= aqk * b(k,sys);
+      }
+    }
+    else {
+      for ( ptrdiff_t sys = 0 ; sys < m ; ++sys ) {
+        if constexpr ( explicit_diag ) b(k,sys) = divide( b(k,sys), A(k,k) );
+        const auto bk = b(k,sys);
+        for ( ptrdiff_t q = q_begin ; q < q_end ; ++q ) b(q,sys) -= a(q,k) * bk;
+      }
+    }
+  }
+}
+
+// Recursive blocked triangular solve, in place in B.  The triangle is
+// split in two halves; the half solved first is substituted into the
+// other part of B with one matrix product, so that nearly all the work
+// is done by the packed matrix_product kernel.  Diagonal blocks of at
+// most trsm_block rows, and A that cannot be subspanned (packed or
+// banded layouts), are solved directly.
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_solve( const InMat & A, Triangle t, DiagonalStorage d,
+                                     const InOutMat & B, BinaryDivideOp divide ) {
+  const ptrdiff_t n = A.extent(0);
+  if constexpr ( InMat::is_always_strided() && InOutMat::is_always_strided() ) {
+    if ( n > trsm_block ) {
+      constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+      // Keep the first block a multiple of the block size, so that the
+      // leaves are full blocks.
+      const ptrdiff_t n1 = ( ( n / 2 + trsm_block - 1 ) / trsm_block ) * trsm_block ;
+      const pair<ptrdiff_t,ptrdiff_t> r1( 0, n1 ), r2( n1, n );
+      const auto A11 = subspan( A, r1, r1 );
+      const auto A22 = subspan( A, r2, r2 );
+      const auto A21 = subspan( A, r2, r1 );
+      const auto A12 = subspan( A, r1, r2 );
+      typedef typename InOutMat::value_type accum_type;
+
+      if constexpr ( Left ) {
+        const auto B1 = subspan( B, r1, all );
+        const auto B2 = subspan( B, r2, all );
+        if constexpr ( lower ) {
+          triangular_matrix_matrix_solve<Left>( A11, t, d, B1, divide );
+          matrix_product_blocked<accum_type>( A21, B1, B2, gemm_update::subtract );
+          triangular_matrix_matrix_solve<Left>( A22, t, d, B2, divide );
+        }
+        else {
+          triangular_matrix_matrix_solve<Left>( A22, t, d, B2, divide );
+          matrix_product_blocked<accum_type>( A12, B2, B1, gemm_update::subtract );
+          triangular_matrix_matrix_solve<Left>( A11, t, d, B1, divide );
+        }
+      }
+      else {
+        const auto B1 = subspan( B, all, r1 );
+        const auto B2 = subspan( B, all, r2 );
+        if constexpr ( lower ) {
+          triangular_matrix_matrix_solve<Left>( A22, t, d, B2, divide );
+          matrix_product_blocked<accum_type>( B2, A21, B1, gemm_update::subtract );
+          triangular_matrix_matrix_solve<Left>( A11, t, d, B1, divide );
+        }
+        else {
+          triangular_matrix_matrix_solve<Left>( A11, t, d, B1, divide );
+          matrix_product_blocked<accum_type>( B1, A12, B2, gemm_update::subtract );
+          triangular_matrix_matrix_solve<Left>( A22, t, d, B2, divide );
+        }
+      }
+      return ;
+    }
+  }
+  triangular_matrix_matrix_solve_direct<Left>( A, t, d, B, divide );
+}
+
+// Batched solve for a rank-3 B, defined in linalg_batched.hpp.
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void batched_triangular_matrix_matrix_solve( const InMat & A, Triangle t, DiagonalStorage d,
+                                             const InOutMat & B, BinaryDivideOp divide );
+
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_solve_dispatch( const InMat & A, Triangle t, DiagonalStorage d,
+                                              const InOutMat & B, BinaryDivideOp divide ) {
+  if constexpr ( InOutMat::rank() == 3 )
+    batched_triangular_matrix_matrix_solve<Left>( A, t, d, B, divide );
+  else if constexpr ( is_small_static_solve<InMat,InOutMat>::value )
+    small_triangular_matrix_matrix_solve<Left>( A, t, d, B, divide );
+  else if ( ! vendor_triangular_matrix_matrix_solve<Left>( A, t, d, B, divide ) )
+    triangular_matrix_matrix_solve<Left>( A, t, d, B, divide );
+}
+
+} // namespace detail
+
+template<class InMat1, class InMat2, class OutMat>
+void matrix_product( InMat1 A, InMat2 B, OutMat C ) {
+  detail::matrix_product_dispatch<typename OutMat::value_type>( A, B, C, false, 1 );
+}
+
+template<class InMat1, class InMat2, class InMat3, class OutMat>
+typename enable_if<!detail::is_linalg_execution_policy_v<InMat1>>::type
+matrix_product( InMat1 A, InMat2 B, InMat3 E, OutMat C ) {
+  copy( E, C );
+  detail::matrix_product_dispatch<typename OutMat::value_type>( A, B, C, true, 1 );
+}
+
+template<class ExecutionPolicy, class InMat1, class InMat2, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, InMat1 A, InMat2 B, OutMat C ) {
+  detail::matrix_product_dispatch<typename OutMat::value_type>( A, B, C, false, detail::execution_policy_threads( exec ) );
+}
+
+template<class ExecutionPolicy, class InMat1, class InMat2, class InMat3, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, InMat1 A, InMat2 B, InMat3 E, OutMat C ) {
+  copy( E, C );
+  detail::matrix_product_dispatch<typename OutMat::value_type>( A, B, C, true, detail::execution_policy_threads( exec ) );
+}
+
+template<class Accumulator, class InMat1, class InMat2, class OutMat>
+void matrix_product( accumulator_t<Accumulator>, InMat1 A, InMat2 B, OutMat C ) {
+  detail::matrix_product_dispatch<Accumulator>( A, B, C, false, 1 );
+}
+
+template<class Accumulator, class InMat1, class InMat2, class InMat3, class OutMat>
+void matrix_product( accumulator_t<Accumulator>, InMat1 A, InMat2 B, InMat3 E, OutMat C ) {
+  copy( E, C );
+  detail::matrix_product_dispatch<Accumulator>( A, B, C, true, 1 );
+}
+
+template<class ExecutionPolicy, class Accumulator, class InMat1, class InMat2, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, accumulator_t<Accumulator>, InMat1 A, InMat2 B, OutMat C ) {
+  detail::matrix_product_dispatch<Accumulator>( A, B, C, false, detail::execution_policy_threads( exec ) );
+}
+
+template<class ExecutionPolicy, class Accumulator, class InMat1, class InMat2, class InMat3, class OutMat>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+matrix_product( ExecutionPolicy && exec, accumulator_t<Accumulator>, InMat1 A, InMat2 B, InMat3 E, OutMat C ) {
+  copy( E, C );
+  detail::matrix_product_dispatch<Accumulator>( A, B, C, true, detail::execution_policy_threads( exec ) );
+}
+
+template<class ProblemRange>
+void variable_batch_matrix_product( ProblemRange && problems ) {
+  detail::variable_batch_matrix_product_range( problems, 1 );
+}
+
+template<class ExecutionPolicy, class ProblemRange>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+variable_batch_matrix_product( ExecutionPolicy && exec, ProblemRange && problems ) {
+  detail::variable_batch_matrix_product_range( problems, detail::execution_policy_threads( exec ) );
+}
+
+template<class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<!detail::is_linalg_execution_policy_v<Scalar>>::type
+symmetric_matrix_rank_k_update( Scalar alpha, InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<false>( A, C, t, alpha, 1 );
+}
+
+template<class InMat, class InOutMat, class Triangle>
+void symmetric_matrix_rank_k_update( InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<false>( A, C, t, detail::no_scaling{}, 1 );
+}
+
+template<class ExecutionPolicy, class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+symmetric_matrix_rank_k_update( ExecutionPolicy && exec, Scalar alpha, InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<false>( A, C, t, alpha, detail::execution_policy_threads( exec ) );
+}
+
+template<class ExecutionPolicy, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+symmetric_matrix_rank_k_update( ExecutionPolicy && exec, InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<false>( A, C, t, detail::no_scaling{}, detail::execution_policy_threads( exec ) );
+}
+
+template<class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<!detail::is_linalg_execution_policy_v<Scalar>>::type
+hermitian_matrix_rank_k_update( Scalar alpha, InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<true>( A, C, t, alpha, 1 );
+}
+
+template<class InMat, class InOutMat, class Triangle>
+void hermitian_matrix_rank_k_update( InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<true>( A, C, t, detail::no_scaling{}, 1 );
+}
+
+template<class ExecutionPolicy, class Scalar, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+hermitian_matrix_rank_k_update( ExecutionPolicy && exec, Scalar alpha, InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<true>( A, C, t, alpha, detail::execution_policy_threads( exec ) );
+}
+
+template<class ExecutionPolicy, class InMat, class InOutMat, class Triangle>
+typename enable_if<detail::is_linalg_execution_policy_v<ExecutionPolicy>>::type
+hermitian_matrix_rank_k_update( ExecutionPolicy && exec, InMat A, InOutMat C, Triangle t ) {
+  detail::check_packed_triangle<InOutMat,Triangle>();
+  detail::rank_k_update<true>( A, C, t, detail::no_scaling{}, detail::execution_policy_threads( exec ) );
+}
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_left_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X, BinaryDivideOp divide ) {
+  detail::check_packed_triangle<InMat1,Triangle>();
+  copy( B, X );
+  detail::triangular_matrix_matrix_solve_dispatch<true>( A, t, d, X, divide );
+}
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat>
+typename enable_if<detail::is_mdspan<OutMat>::value>::type
+triangular_matrix_matrix_left_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X ) {
+  triangular_matrix_matrix_left_solve( A, t, d, B, X, divides<>() );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+typename enable_if<!detail::is_mdspan<BinaryDivideOp>::value>::type
+triangular_matrix_matrix_left_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B, BinaryDivideOp divide ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  detail::triangular_matrix_matrix_solve_dispatch<true>( A, t, d, B, divide );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat>
+void triangular_matrix_matrix_left_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B ) {
+  triangular_matrix_matrix_left_solve( A, t, d, B, divides<>() );
+}
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat, class BinaryDivideOp>
+void triangular_matrix_matrix_right_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X, BinaryDivideOp divide ) {
+  detail::check_packed_triangle<InMat1,Triangle>();
+  copy( B, X );
+  detail::triangular_matrix_matrix_solve_dispatch<false>( A, t, d, X, divide );
+}
+
+template<class InMat1, class Triangle, class DiagonalStorage, class InMat2, class OutMat>
+typename enable_if<detail::is_mdspan<OutMat>::value>::type
+triangular_matrix_matrix_right_solve( InMat1 A, Triangle t, DiagonalStorage d, InMat2 B, OutMat X ) {
+  triangular_matrix_matrix_right_solve( A, t, d, B, X, divides<>() );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+typename enable_if<!detail::is_mdspan<BinaryDivideOp>::value>::type
+triangular_matrix_matrix_right_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B, BinaryDivideOp divide ) {
+  detail::check_packed_triangle<InMat,Triangle>();
+  detail::triangular_matrix_matrix_solve_dispatch<false>( A, t, d, B, divide );
+}
+
+template<class InMat, class Triangle, class DiagonalStorage, class InOutMat>
+void triangular_matrix_matrix_right_solve( InMat A, Triangle t, DiagonalStorage d, InOutMat B ) {
+  triangular_matrix_matrix_right_solve( A, t, d, B, divides<>() );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,415 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: tensor contraction, as in numpy's einsum.  spec names
+// the extents (modes) of A, B and C with one character each, in order,
+// as "ikl,lkj->ij" for C(i,j) = sum over k and l of A(i,k,l) B(l,k,j).
+// A label of C that is in both A and B is a batch mode, and one that is
+// in only one of them a free mode; labels of A or B that are not in C are
+// summed over.  C is overwritten.
+//
+// Preconditions: the number of labels of each tensor is its rank, no
+// label repeats within a tensor, a label has the same extent wherever it
+// appears, C does not overlap A or B, and no two entries of C alias.
+// The first three are checked with assert, and without it a spec that
+// breaks them leaves C unchanged.  The output labels are required:
+// numpy's implicit form "ij,jk" is rejected the same way.
+template<class InTensor1, class InTensor2, class OutTensor>
+void contract( const char * spec, InTensor1 A, InTensor2 B, OutTensor C );
+
+template<class ExecutionPolicy, class InTensor1, class InTensor2, class OutTensor>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+contract( ExecutionPolicy && exec, const char * spec, InTensor1 A, InTensor2 B, OutTensor C );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// A contraction is a batched matrix product in disguise.  Every mode is
+// one of four kinds: batch (P), rows of C (M), columns of C (N) or summed
+// (K).  If the modes of each kind can be fused into a single extent in
+// every operand the contraction is
+//
+//   C(p,m,n) = sum over k of A(p,m,k) B(p,k,n)
+//
+// on layout_stride views of the operands as they lie, and goes to the
+// packed matrix_product kernels, which do their own cache blocking.  An
+// operand whose modes do not fuse is first copied into a row-major
+// temporary in that order (for C, computed there and copied back), which
+// is what the kernels' packing would read anyway.
+
+enum contract_kind { contract_batch , contract_rows , contract_cols , contract_sum };
+
+// A mode of the contraction: its extent and its stride in A, B and C,
+// zero in an operand that does not have it.
+struct contract_mode {
+  ptrdiff_t extent ;
+  ptrdiff_t stride[3] ;
+};
+
+// The labels of one tensor of the spec, [begin,end).
+struct contract_labels {
+  const char * begin ;
+  const char * end ;
+
+  ptrdiff_t find( const char label ) const noexcept
+    {
+      for ( const char * p = begin ; p != end ; ++p ) if ( *p == label ) return p - begin ;
+      return -1 ;
+    }
+};
+
+// Splits "ikl,lkj->ij" into the labels of A, B and C.  Returns false if
+// spec is not of that form: the output labels are required.
+inline bool contract_parse( const char * spec, contract_labels labels[3] ) noexcept {
+  const auto scan = [&spec]( contract_labels & l, const char * stop ) {
+    l.begin = spec ;
+    while ( *spec && ! strchr( ",->", *spec ) ) ++spec ;
+    l.end = spec ;
+    for ( ; *stop ; ++stop , ++spec ) if ( *spec != *stop ) return false ;
+    return true ;
+  };
+  return scan( labels[0], "," ) && scan( labels[1], "->" ) && scan( labels[2], "" ) && ! *spec ;
+}
+
+// Whether each tensor has as many labels as its rank, none twice, and a
+// label has the same extent wherever it appears.
+template<class InTensor1, class InTensor2, class OutTensor>
+bool contract_valid( const contract_labels labels[3], const InTensor1 & A, const InTensor2 & B, const OutTensor & C ) {
+  const ptrdiff_t rank[3] = { ptrdiff_t( InTensor1::rank() ), ptrdiff_t( InTensor2::rank() ), ptrdiff_t( OutTensor::rank() ) };
+  const auto extent = [&]( const int t, const ptrdiff_t r ) -> ptrdiff_t {
+    return t == 0 ? A.extent( r ) : t == 1 ? B.extent( r ) : C.extent( r );
+  };
+  for ( int t = 0 ; t < 3 ; ++t ) {
+    if ( labels[t].end - labels[t].begin != rank[t] ) return false ;
+    for ( const char * label = labels[t].begin ; label != labels[t].end ; ++label ) {
+      const ptrdiff_t r = label - labels[t].begin ;
+      if ( labels[t].find( *label ) != r ) return false ;
+      for ( int u = 0 ; u < t ; ++u ) {
+        const ptrdiff_t q = labels[u].find( *label );
+        if ( 0 <= q && extent( u, q ) != extent( t, r ) ) return false ;
+      }
+    }
+  }
+  return true ;
+}
+
+// The modes of kind P, M, N and K, each ordered outermost first: P, M and
+// N by their stride in C, and K by its stride in A, then in B.  Modes of
+// extent one are dropped.  Returns false if C is empty.
+template<class InTensor1, class InTensor2, class OutTensor>
+bool contract_modes( const contract_labels labels[3], const InTensor1 & A, const InTensor2 & B, const OutTensor & C,
+                     vector<contract_mode> modes[4] ) {
+  for ( int t = 0 ; t < 3 ; ++t ) {
+    for ( const char * label = labels[t].begin ; label != labels[t].end ; ++label ) {
+      // Each label once, where it first appears.
+      bool seen = false ;
+      for ( int u = 0 ; u < t ; ++u ) seen = seen || 0 <= labels[u].find( *label );
+      if ( seen ) continue ;
+
+      contract_mode mode = { 1 , { 0 , 0 , 0 } };
+      const ptrdiff_t r[3] = { labels[0].find( *label ), labels[1].find( *label ), labels[2].find( *label ) };
+      if ( 0 <= r[0] ) { mode.extent = A.extent( r[0] ); mode.stride[0] = A.stride( r[0] ); }
+      if ( 0 <= r[1] ) { mode.extent = B.extent( r[1] ); mode.stride[1] = B.stride( r[1] ); }
+      if ( 0 <= r[2] ) { mode.extent = C.extent( r[2] ); mode.stride[2] = C.stride( r[2] ); }
+
+      if ( mode.extent == 0 && 0 <= r[2] ) return false ;
+      if ( mode.extent == 1 ) continue ;
+
+      const contract_kind kind =
+        r[2] < 0 ? contract_sum :
+        ( 0 <= r[0] ) == ( 0 <= r[1] ) ? contract_batch :
+        0 <= r[0] ? contract_rows : contract_cols ;
+      modes[kind].push_back( mode );
+    }
+  }
+
+  for ( int kind = contract_batch ; kind <= contract_cols ; ++kind ) {
+    stable_sort( modes[kind].begin(), modes[kind].end(),
+                 []( const contract_mode & x, const contract_mode & y ) { return x.stride[2] > y.stride[2] ; } );
+  }
+  stable_sort( modes[contract_sum].begin(), modes[contract_sum].end(),
+               []( const contract_mode & x, const contract_mode & y )
+                 { return x.stride[0] != y.stride[0] ? x.stride[0] > y.stride[0] : x.stride[1] > y.stride[1] ; } );
+  return true ;
+}
+
+// The kinds of the (batch,row,column) extents of the matrix view of
+// operand t: A(p,m,k), B(p,k,n) and C(p,m,n).
+constexpr contract_kind contract_operand_kind( const int t, const int r ) noexcept {
+  return r == 0 ? contract_batch :
+         r == 1 ? ( t == 1 ? contract_sum : contract_rows ) :
+                  ( t == 0 ? contract_sum : contract_cols );
+}
+
+// Whether the modes fuse into one extent in operand t: each is its
+// inner neighbor's extent times stride apart.
+inline bool contract_fuses( const vector<contract_mode> & modes, const int t ) noexcept {
+  for ( size_t i = 1 ; i < modes.size() ; ++i ) {
+    if ( modes[i-1].stride[t] != modes[i].stride[t] * modes[i].extent ) return false ;
+  }
+  return true ;
+}
+
+// Calls f( x, y ) for every index of the rank modes, with x and y the
+// sums of the index times sx and sy.  The last mode is the inner loop.
+template<class F>
+void contract_for_each( const ptrdiff_t rank, const ptrdiff_t * extent,
+                        const ptrdiff_t * sx, const ptrdiff_t * sy, F && f ) {
+  if ( rank == 0 ) { f( ptrdiff_t( 0 ), ptrdiff_t( 0 ) ); return ; }
+  for ( ptrdiff_t r = 0 ; r < rank ; ++r ) if ( extent[r] == 0 ) return ;
+
+  const ptrdiff_t last = rank - 1 ;
+  vector<ptrdiff_t> index( rank, 0 );
+  ptrdiff_t x = 0 , y = 0 ;
+  while ( true ) {
+    for ( ptrdiff_t i = 0 ; i < extent[last] ; ++i ) f( x + i * sx[last], y + i * sy[last] );
+    ptrdiff_t r = last - 1 ;
+    for ( ; 0 <= r ; --r ) {
+      x += sx[r] ; y += sy[r] ;
+      if ( ++index[r] < extent[r] ) break ;
+      x -= sx[r] * extent[r] ; y -= sy[r] * extent[r] ; index[r] = 0 ;
+    }
+    if ( r < 0 ) return ;
+  }
+}
+
+// The modes of operand t in the order of its matrix view, each with its
+// stride in t and its stride in a row-major temporary of that order,
+// which is returned as the number of entries of the temporary.
+struct contract_layout {
+  vector<ptrdiff_t> extent ;
+  vector<ptrdiff_t> stride ;
+  vector<ptrdiff_t> packed ;
+};
+
+inline ptrdiff_t contract_operand_layout( const vector<contract_mode> modes[4], const int t, contract_layout & layout ) {
+  for ( int r = 0 ; r < 3 ; ++r ) {
+    for ( const contract_mode & mode : modes[ contract_operand_kind( t, r ) ] ) {
+      layout.extent.push_back( mode.extent );
+      layout.stride.push_back( mode.stride[t] );
+    }
+  }
+  layout.packed.resize( layout.extent.size() );
+  ptrdiff_t size = 1 ;
+  for ( size_t r = layout.extent.size() ; r-- ; ) {
+    layout.packed[r] = size ;
+    size *= layout.extent[r] ;
+  }
+  return size ;
+}
+
+// Pointer, accessor and (batch,row,column) strides of an operand's
+// matrix view.
+template<class Accessor>
+struct contract_operand {
+  typedef Accessor accessor_type ;
+  typename Accessor::pointer p ;
+  Accessor acc ;
+  ptrdiff_t stride[3] ;
+};
+
+template<class Accessor>
+contract_operand<Accessor> make_contract_operand( const typename Accessor::pointer p, const Accessor & acc,
+                                                  const vector<contract_mode> modes[4], const int t ) {
+  contract_operand<Accessor> x = { p , acc , { 0 , 0 , 0 } };
+  for ( int r = 0 ; r < 3 ; ++r ) {
+    const vector<contract_mode> & group = modes[ contract_operand_kind( t, r ) ];
+    x.stride[r] = group.empty() ? 0 : group.back().stride[t] ;
+  }
+  return x ;
+}
+
+// The offset of X(0,...,0) from X.data().
+template<class Mapping, size_t ... R>
+ptrdiff_t contract_origin( const Mapping & map, index_sequence<R...> ) {
+  return ptrdiff_t( map( ( void( R ) , ptrdiff_t( 0 ) )... ) );
+}
+
+// Whether all three extents of operand t's matrix view fuse.
+inline bool contract_operand_fuses( const vector<contract_mode> modes[4], const int t ) noexcept {
+  return contract_fuses( modes[ contract_operand_kind( t, 0 ) ], t ) &&
+         contract_fuses( modes[ contract_operand_kind( t, 1 ) ], t ) &&
+         contract_fuses( modes[ contract_operand_kind( t, 2 ) ], t );
+}
+
+// Operand t of a row-major temporary laid out as layout says.
+template<class Accessor>
+contract_operand<Accessor> make_packed_contract_operand( const typename Accessor::pointer p,
+                                                         const vector<contract_mode> modes[4], const int t,
+                                                         const contract_layout & layout ) {
+  vector<contract_mode> packed[4] = { modes[0], modes[1], modes[2], modes[3] };
+  size_t j = 0 ;
+  for ( int r = 0 ; r < 3 ; ++r ) {
+    for ( contract_mode & mode : packed[ contract_operand_kind( t, r ) ] ) mode.stride[t] = layout.packed[j++] ;
+  }
+  return make_contract_operand( p, Accessor(), packed, t );
+}
+
+// Calls next with the matrix view of input operand t: of the tensor as it
+// lies if its modes fuse, else of a row-major copy of it.
+template<class InTensor, class Next>
+void contract_with_input( const InTensor & X, const vector<contract_mode> modes[4], const int t, Next && next ) {
+  const auto p = X.accessor().offset( X.data(), contract_origin( X.mapping(), make_index_sequence<InTensor::rank()>() ) );
+  if ( contract_operand_fuses( modes, t ) ) {
+    next( make_contract_operand( p, X.accessor(), modes, t ) );
+    return ;
+  }
+
+  typedef typename InTensor::value_type value_type ;
+  contract_layout layout ;
+  vector<value_type> buf( contract_operand_layout( modes, t, layout ) );
+  contract_for_each( ptrdiff_t( layout.extent.size() ), layout.extent.data(), layout.stride.data(), layout.packed.data(),
+                     [&]( const ptrdiff_t x, const ptrdiff_t y ) { buf[y] = X.accessor().access( p, x ); } );
+  next( make_packed_contract_operand<accessor_basic<const value_type>>( buf.data(), modes, t, layout ) );
+}
+
+// Calls next with the matrix view of C: of C as it lies if its modes
+// fuse, else of a row-major temporary copied to C afterwards.
+template<class OutTensor, class Next>
+void contract_with_output( const OutTensor & C, const vector<contract_mode> modes[4], Next && next ) {
+  const auto p = C.accessor().offset( C.data(), contract_origin( C.mapping(), make_index_sequence<OutTensor::rank()>() ) );
+  if ( contract_operand_fuses( modes, 2 ) ) {
+    next( make_contract_operand( p, C.accessor(), modes, 2 ) );
+    return ;
+  }
+
+  typedef typename OutTensor::value_type value_type ;
+  contract_layout layout ;
+  vector<value_type> buf( contract_operand_layout( modes, 2, layout ) );
+  next( make_packed_contract_operand<accessor_basic<value_type>>( buf.data(), modes, 2, layout ) );
+  contract_for_each( ptrdiff_t( layout.extent.size() ), layout.extent.data(), layout.stride.data(), layout.packed.data(),
+                     [&]( const ptrdiff_t x, const ptrdiff_t y ) { C.accessor().access( p, x ) = buf[y] ; } );
+}
+
+template<class Accum, class AOp, class BOp, class COp>
+void contract_matrix_product( const AOp & a, const BOp & b, const COp & c,
+                              const ptrdiff_t p, const ptrdiff_t m, const ptrdiff_t n, const ptrdiff_t k,
+                              const size_t num_threads ) {
+  if ( p == 1 ) {
+    typedef extents<dynamic_extent,dynamic_extent> matrix_extents ;
+    auto view = []( const auto & x, const ptrdiff_t rows, const ptrdiff_t cols ) {
+      typedef typename decay_t<decltype( x )>::accessor_type accessor_type ;
+      typedef basic_mdspan<typename accessor_type::element_type,matrix_extents,layout_stride,accessor_type> view_type ;
+      return view_type( x.p, layout_stride::mapping<matrix_extents>( matrix_extents( rows, cols ), { x.stride[1], x.stride[2] } ), x.acc );
+    };
+    matrix_product_dispatch<Accum>( view( a, m, k ), view( b, k, n ), view( c, m, n ), false, num_threads );
+  }
+  else {
+    typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> batch_extents ;
+    auto view = [p]( const auto & x, const ptrdiff_t rows, const ptrdiff_t cols ) {
+      typedef typename decay_t<decltype( x )>::accessor_type accessor_type ;
+      typedef basic_mdspan<typename accessor_type::element_type,batch_extents,layout_stride,accessor_type> view_type ;
+      return view_type( x.p, layout_stride::mapping<batch_extents>( batch_extents( p, rows, cols ), { x.stride[0], x.stride[1], x.stride[2] } ), x.acc );
+    };
+    matrix_product_dispatch<Accum>( view( a, m, k ), view( b, k, n ), view( c, m, n ), false, num_threads );
+  }
+}
+
+template<class InTensor1, class InTensor2, class OutTensor>
+void contract_dispatch( const char * spec, const InTensor1 & A, const InTensor2 & B, const OutTensor & C,
+                        const size_t num_threads ) {
+  static_assert( InTensor1::is_always_strided() && InTensor2::is_always_strided() && OutTensor::is_always_strided(),
+                 "contract requires strided layouts" );
+
+  // The preconditions on spec cannot be checked before it is parsed, so
+  // a malformed one is caught here and C left alone.
+  contract_labels labels[3] ;
+  const bool valid = contract_parse( spec, labels ) && contract_valid( labels, A, B, C );
+  assert( valid && "malformed contract spec" );
+  if ( ! valid ) return ;
+
+  vector<contract_mode> modes[4] ;
+  if ( ! contract_modes( labels, A, B, C, modes ) ) return ;
+
+  ptrdiff_t extent[4] ;
+  for ( int kind = contract_batch ; kind <= contract_sum ; ++kind ) {
+    extent[kind] = 1 ;
+    for ( const contract_mode & mode : modes[kind] ) extent[kind] *= mode.extent ;
+  }
+
+  contract_with_output( C, modes, [&]( const auto & c ) {
+    contract_with_input( A, modes, 0, [&]( const auto & a ) {
+      contract_with_input( B, modes, 1, [&]( const auto & b ) {
+        contract_matrix_product<typename OutTensor::value_type>(
+          a, b, c, extent[contract_batch], extent[contract_rows], extent[contract_cols], extent[contract_sum], num_threads );
+      } );
+    } );
+  } );
+}
+
+} // namespace detail
+
+template<class InTensor1, class InTensor2, class OutTensor>
+void contract( const char * spec, InTensor1 A, InTensor2 B, OutTensor C ) {
+  detail::contract_dispatch( spec, A, B, C, 1 );
+}
+
+template<class ExecutionPolicy, class InTensor1, class InTensor2, class OutTensor>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+contract( ExecutionPolicy && exec, const char * spec, InTensor1 A, InTensor2 B, OutTensor C ) {
+  detail::contract_dispatch( spec, A, B, C, detail::execution_policy_threads( exec ) );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
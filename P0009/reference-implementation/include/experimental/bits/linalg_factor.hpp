@@ -0,0 +1,483 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: in-place Cholesky and LU factorizations of small
+// dense matrices, and the solves that use them.  A is one square matrix,
+// or a rank-3 batch of them whose leftmost extent is the batch extent, in
+// any layout.  With a batch, B is a batch of vectors (rank 2) or of
+// matrices (rank 3) of right-hand sides, and the results that LAPACK
+// returns as info go to a rank-1 info mdspan, one per problem.
+
+// A = L L^H (lower_triangle) or A = U^H U (upper_triangle), overwriting
+// that triangle of A with L or U; the other triangle is not accessed, as
+// in LAPACK's xPOTRF.  Returns 0, or k+1 if the leading minor of order
+// k+1 is not positive definite, in which case A is unspecified.
+template<class InOutMat, class Triangle>
+ptrdiff_t cholesky_factor( InOutMat A, Triangle t );
+
+template<class InOutMat, class Triangle, class OutInfo>
+void cholesky_factor( InOutMat A, Triangle t, OutInfo info );
+
+// Solve A X = B in place in B, where A holds the factor computed by
+// cholesky_factor with the same triangle.
+template<class InMat, class Triangle, class InOutObj>
+void cholesky_solve( InMat A, Triangle t, InOutObj B );
+
+// P A = L U with unit lower triangular L and upper triangular U
+// overwriting A.  Step k swaps rows k and piv(k) (piv(b,k) for a batch),
+// which are 0-based.  Returns 0, or k+1 if U(k,k) is exactly zero, in
+// which case the factorization is complete but U is singular, as in
+// LAPACK's xGETRF.
+template<class InOutMat, class OutPivots>
+ptrdiff_t lu_factor( InOutMat A, OutPivots piv );
+
+template<class InOutMat, class OutPivots, class OutInfo>
+void lu_factor( InOutMat A, OutPivots piv, OutInfo info );
+
+// Solve A X = B in place in B, where A and piv hold the factorization
+// computed by lu_factor.
+template<class InMat, class InPivots, class InOutObj>
+void lu_solve( InMat A, InPivots piv, InOutObj B );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// The factorizations work on groups of W problems copied into a local
+// buffer, interleaved as in layout_batch_interleaved: entry (i,j) of
+// problem l of the group is at ( i * n + j ) * W + l.  Every loop runs
+// over the W lanes innermost, so it vectorizes across problems however
+// small they are, and each problem is read and written once in whatever
+// layout it has.  A group has interleave_lanes problems; a single matrix
+// is a group of one.
+
+// The static order of the matrices of A when it is small enough for the
+// kernels to be instantiated for it, else dynamic_extent.
+template<class InMat>
+constexpr ptrdiff_t factor_static_order() noexcept {
+  constexpr size_t r = InMat::extents_type::rank() - 2 ;
+  constexpr ptrdiff_t m = InMat::static_extent(r);
+  constexpr ptrdiff_t n = InMat::static_extent(r+1);
+  return m == n && n != dynamic_extent && n <= small_static_max_extent ? n : dynamic_extent ;
+}
+
+// The real part of t, as a real number.
+template<class T>
+constexpr auto real_part( const T & t ) {
+  if constexpr ( is_complex<T>::value ) return real(t);
+  else return t ;
+}
+
+// Entry (i,j...) of problem b of x, which is a batch if Batched.
+template<bool Batched, class MDSpan, class ... Indices>
+decltype(auto) problem_element( const MDSpan & x, const ptrdiff_t b, const Indices ... i ) {
+  if constexpr ( Batched ) return x( b, i... );
+  else return x( i... );
+}
+
+// Number of right-hand sides in B, a vector or matrix per problem.
+template<bool Batched, class InOutObj>
+ptrdiff_t num_rhs( const InOutObj & B ) {
+  constexpr size_t rank = InOutObj::extents_type::rank() - ( Batched ? 1 : 0 );
+  if constexpr ( rank == 2 ) return B.extent( Batched ? 2 : 1 );
+  else return 1 ;
+}
+
+// Copy the lanes l < lanes of the problems of A starting at b0 into
+// buf.  Only the triangle t is read, a lower one as is and an upper one
+// conjugate transposed, so that buf holds a lower triangle either way.
+// The other lanes are set to the identity, which keeps them finite.
+template<bool Batched, ptrdiff_t W, class InMat, class Triangle, class T>
+void pack_factor_triangle( const InMat & A, Triangle, const ptrdiff_t b0, const ptrdiff_t lanes,
+                           const ptrdiff_t n, T * buf ) {
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value ;
+  for ( ptrdiff_t i = 0 ; i < n ; ++i )
+    for ( ptrdiff_t j = 0 ; j <= i ; ++j )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+        if ( l < lanes )
+          buf[(i*n+j)*W+l] = lower ? T( problem_element<Batched>( A, b0+l, i, j ) )
+                                   : T( conj_if_needed( problem_element<Batched>( A, b0+l, j, i ) ) );
+        else
+          buf[(i*n+j)*W+l] = T( i == j ? 1 : 0 );
+      }
+}
+
+template<bool Batched, ptrdiff_t W, class InOutMat, class Triangle, class T>
+void unpack_factor_triangle( const T * buf, const ptrdiff_t b0, const ptrdiff_t lanes,
+                             const ptrdiff_t n, const InOutMat & A, Triangle ) {
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value ;
+  for ( ptrdiff_t l = 0 ; l < lanes ; ++l )
+    for ( ptrdiff_t i = 0 ; i < n ; ++i )
+      for ( ptrdiff_t j = 0 ; j <= i ; ++j ) {
+        if ( lower ) problem_element<Batched>( A, b0+l, i, j ) = buf[(i*n+j)*W+l];
+        else problem_element<Batched>( A, b0+l, j, i ) = conj_if_needed( buf[(i*n+j)*W+l] );
+      }
+}
+
+// The same for the whole of a square A.
+template<bool Batched, ptrdiff_t W, class InMat, class T>
+void pack_factor_matrix( const InMat & A, const ptrdiff_t b0, const ptrdiff_t lanes,
+                         const ptrdiff_t n, T * buf ) {
+  for ( ptrdiff_t i = 0 ; i < n ; ++i )
+    for ( ptrdiff_t j = 0 ; j < n ; ++j )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l )
+        buf[(i*n+j)*W+l] = l < lanes ? T( problem_element<Batched>( A, b0+l, i, j ) ) : T( i == j ? 1 : 0 );
+}
+
+template<bool Batched, ptrdiff_t W, class InOutMat, class T>
+void unpack_factor_matrix( const T * buf, const ptrdiff_t b0, const ptrdiff_t lanes,
+                           const ptrdiff_t n, const InOutMat & A ) {
+  for ( ptrdiff_t l = 0 ; l < lanes ; ++l )
+    for ( ptrdiff_t i = 0 ; i < n ; ++i )
+      for ( ptrdiff_t j = 0 ; j < n ; ++j )
+        problem_element<Batched>( A, b0+l, i, j ) = buf[(i*n+j)*W+l];
+}
+
+// The right-hand sides of B as an n x nrhs matrix per problem, with
+// zeros in the other lanes.
+template<bool Batched, ptrdiff_t W, class InOutObj, class T>
+void pack_rhs( const InOutObj & B, const ptrdiff_t b0, const ptrdiff_t lanes,
+               const ptrdiff_t n, const ptrdiff_t nrhs, T * buf ) {
+  constexpr bool vector = InOutObj::extents_type::rank() == ( Batched ? 2 : 1 ) ;
+  for ( ptrdiff_t i = 0 ; i < n ; ++i )
+    for ( ptrdiff_t r = 0 ; r < nrhs ; ++r )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+        if ( l >= lanes ) buf[(i*nrhs+r)*W+l] = T{};
+        else if constexpr ( vector ) buf[(i*nrhs+r)*W+l] = T( problem_element<Batched>( B, b0+l, i ) );
+        else buf[(i*nrhs+r)*W+l] = T( problem_element<Batched>( B, b0+l, i, r ) );
+      }
+}
+
+template<bool Batched, ptrdiff_t W, class InOutObj, class T>
+void unpack_rhs( const T * buf, const ptrdiff_t b0, const ptrdiff_t lanes,
+                 const ptrdiff_t n, const ptrdiff_t nrhs, const InOutObj & B ) {
+  constexpr bool vector = InOutObj::extents_type::rank() == ( Batched ? 2 : 1 ) ;
+  for ( ptrdiff_t l = 0 ; l < lanes ; ++l )
+    for ( ptrdiff_t i = 0 ; i < n ; ++i )
+      for ( ptrdiff_t r = 0 ; r < nrhs ; ++r ) {
+        if constexpr ( vector ) problem_element<Batched>( B, b0+l, i ) = buf[(i*nrhs+r)*W+l];
+        else problem_element<Batched>( B, b0+l, i, r ) = buf[(i*nrhs+r)*W+l];
+      }
+}
+
+//--------------------------------------------------------------------------
+// Kernels on one group.  N is the order of the matrices if it is static,
+// in which case every loop bound is a constant, else dynamic_extent and
+// the order is n.
+
+// Right-looking Cholesky factorization of the lower triangles in a.
+// info[l] is set for the lanes whose pivot is not positive.
+template<ptrdiff_t N, ptrdiff_t W, class T>
+void cholesky_group( const ptrdiff_t n_dynamic, T * __restrict a, ptrdiff_t * info ) {
+  using std::sqrt;
+  typedef decltype( real_part( declval<T>() ) ) real_type;
+  const ptrdiff_t n = N == dynamic_extent ? n_dynamic : N ;
+  for ( ptrdiff_t k = 0 ; k < n ; ++k ) {
+    T * const akk = a + (k*n+k)*W ;
+    real_type inv[W] ;
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+      const real_type d = real_part( akk[l] );
+      if ( ! ( d > real_type(0) ) && info[l] == 0 ) info[l] = k+1 ;
+      const real_type root = sqrt( d );
+      akk[l] = T( root );
+      inv[l] = real_type(1) / root ;
+    }
+    for ( ptrdiff_t i = k+1 ; i < n ; ++i )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) a[(i*n+k)*W+l] *= inv[l];
+    for ( ptrdiff_t j = k+1 ; j < n ; ++j )
+      for ( ptrdiff_t i = j ; i < n ; ++i )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l )
+          a[(i*n+j)*W+l] -= a[(i*n+k)*W+l] * conj_if_needed( a[(j*n+k)*W+l] );
+  }
+}
+
+// Solve L L^H X = B for the lower triangular factors L in a and the
+// nrhs right-hand sides in b.
+template<ptrdiff_t N, ptrdiff_t W, class T>
+void cholesky_solve_group( const ptrdiff_t n_dynamic, const T * __restrict a,
+                           const ptrdiff_t nrhs, T * __restrict b ) {
+  const ptrdiff_t n = N == dynamic_extent ? n_dynamic : N ;
+  for ( ptrdiff_t r = 0 ; r < nrhs ; ++r ) {
+    // L Y = B
+    for ( ptrdiff_t i = 0 ; i < n ; ++i ) {
+      T * const bi = b + (i*nrhs+r)*W ;
+      for ( ptrdiff_t k = 0 ; k < i ; ++k )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] -= a[(i*n+k)*W+l] * b[(k*nrhs+r)*W+l];
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] /= a[(i*n+i)*W+l];
+    }
+    // L^H X = Y
+    for ( ptrdiff_t i = n-1 ; i >= 0 ; --i ) {
+      T * const bi = b + (i*nrhs+r)*W ;
+      for ( ptrdiff_t k = i+1 ; k < n ; ++k )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] -= conj_if_needed( a[(k*n+i)*W+l] ) * b[(k*nrhs+r)*W+l];
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] /= a[(i*n+i)*W+l];
+    }
+  }
+}
+
+// Right-looking LU factorization with partial pivoting of the matrices
+// in a.  The pivot search and the updates run across the lanes; only
+// the row swaps, which move O(n) entries per step, go lane by lane.
+template<ptrdiff_t N, ptrdiff_t W, class T>
+void lu_group( const ptrdiff_t n_dynamic, T * __restrict a, ptrdiff_t * __restrict piv, ptrdiff_t * info ) {
+  typedef decltype( abs_sum_if_needed( declval<T>() ) ) magnitude_type;
+  const ptrdiff_t n = N == dynamic_extent ? n_dynamic : N ;
+  for ( ptrdiff_t k = 0 ; k < n ; ++k ) {
+    magnitude_type best[W] ;
+    ptrdiff_t p[W] ;
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) { best[l] = abs_sum_if_needed( a[(k*n+k)*W+l] ); p[l] = k ; }
+    for ( ptrdiff_t i = k+1 ; i < n ; ++i )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+        const magnitude_type v = abs_sum_if_needed( a[(i*n+k)*W+l] );
+        p[l] = best[l] < v ? i : p[l] ;
+        best[l] = best[l] < v ? v : best[l] ;
+      }
+
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+      piv[k*W+l] = p[l] ;
+      if ( p[l] != k )
+        for ( ptrdiff_t j = 0 ; j < n ; ++j ) {
+          const T t = a[(k*n+j)*W+l] ;
+          a[(k*n+j)*W+l] = a[(p[l]*n+j)*W+l] ;
+          a[(p[l]*n+j)*W+l] = t ;
+        }
+    }
+
+    // A zero pivot means the rest of column k is zero too, so scaling it
+    // by zero instead of the inverse leaves it as it is.
+    T inv[W] ;
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+      const T d = a[(k*n+k)*W+l] ;
+      if ( d == T(0) && info[l] == 0 ) info[l] = k+1 ;
+      inv[l] = d == T(0) ? T(0) : T(1) / d ;
+    }
+    for ( ptrdiff_t i = k+1 ; i < n ; ++i ) {
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) a[(i*n+k)*W+l] *= inv[l];
+      for ( ptrdiff_t j = k+1 ; j < n ; ++j )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l ) a[(i*n+j)*W+l] -= a[(i*n+k)*W+l] * a[(k*n+j)*W+l];
+    }
+  }
+}
+
+// Solve P L U X = B for the factors in a and piv and the nrhs
+// right-hand sides in b.
+template<ptrdiff_t N, ptrdiff_t W, class T>
+void lu_solve_group( const ptrdiff_t n_dynamic, const T * __restrict a, const ptrdiff_t * __restrict piv,
+                     const ptrdiff_t nrhs, T * __restrict b ) {
+  const ptrdiff_t n = N == dynamic_extent ? n_dynamic : N ;
+  for ( ptrdiff_t k = 0 ; k < n ; ++k )
+    for ( ptrdiff_t l = 0 ; l < W ; ++l ) {
+      const ptrdiff_t p = piv[k*W+l] ;
+      if ( p != k )
+        for ( ptrdiff_t r = 0 ; r < nrhs ; ++r ) {
+          const T t = b[(k*nrhs+r)*W+l] ;
+          b[(k*nrhs+r)*W+l] = b[(p*nrhs+r)*W+l] ;
+          b[(p*nrhs+r)*W+l] = t ;
+        }
+    }
+  for ( ptrdiff_t r = 0 ; r < nrhs ; ++r ) {
+    // L Y = P^T B, L with unit diagonal
+    for ( ptrdiff_t i = 0 ; i < n ; ++i ) {
+      T * const bi = b + (i*nrhs+r)*W ;
+      for ( ptrdiff_t k = 0 ; k < i ; ++k )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] -= a[(i*n+k)*W+l] * b[(k*nrhs+r)*W+l];
+    }
+    // U X = Y
+    for ( ptrdiff_t i = n-1 ; i >= 0 ; --i ) {
+      T * const bi = b + (i*nrhs+r)*W ;
+      for ( ptrdiff_t k = i+1 ; k < n ; ++k )
+        for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] -= a[(i*n+k)*W+l] * b[(k*nrhs+r)*W+l];
+      for ( ptrdiff_t l = 0 ; l < W ; ++l ) bi[l] /= a[(i*n+i)*W+l];
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+// Drivers: one group of problems at a time, through a buffer allocated
+// once per call.
+
+template<class InMat>
+constexpr bool is_factor_batch() noexcept { return InMat::extents_type::rank() == 3 ; }
+
+template<class InMat>
+ptrdiff_t factor_batch_size( const InMat & A ) {
+  if constexpr ( is_factor_batch<InMat>() ) return A.extent(0);
+  else return 1 ;
+}
+
+template<class InOutMat, class Triangle, class Info>
+void cholesky_factor_groups( const InOutMat & A, Triangle t, Info && set_info ) {
+  typedef typename InOutMat::value_type value_type;
+  constexpr bool batched = is_factor_batch<InOutMat>() ;
+  constexpr ptrdiff_t W = batched ? interleave_lanes<value_type>() : 1 ;
+  constexpr ptrdiff_t N = factor_static_order<InOutMat>() ;
+  const ptrdiff_t batch = factor_batch_size( A );
+  const ptrdiff_t n = A.extent( batched ? 1 : 0 );
+
+  vector<value_type> buf( n*n*W );
+  for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += W ) {
+    const ptrdiff_t lanes = W < batch-b0 ? W : batch-b0 ;
+    ptrdiff_t info[W] = {};
+    pack_factor_triangle<batched,W>( A, t, b0, lanes, n, buf.data() );
+    cholesky_group<N,W>( n, buf.data(), info );
+    unpack_factor_triangle<batched,W>( buf.data(), b0, lanes, n, A, t );
+    for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) set_info( b0+l, info[l] );
+  }
+}
+
+template<class InOutMat, class OutPivots, class Info>
+void lu_factor_groups( const InOutMat & A, const OutPivots & piv, Info && set_info ) {
+  typedef typename InOutMat::value_type value_type;
+  constexpr bool batched = is_factor_batch<InOutMat>() ;
+  constexpr ptrdiff_t W = batched ? interleave_lanes<value_type>() : 1 ;
+  constexpr ptrdiff_t N = factor_static_order<InOutMat>() ;
+  const ptrdiff_t batch = factor_batch_size( A );
+  const ptrdiff_t n = A.extent( batched ? 1 : 0 );
+
+  vector<value_type> buf( n*n*W );
+  vector<ptrdiff_t> pbuf( n*W );
+  for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += W ) {
+    const ptrdiff_t lanes = W < batch-b0 ? W : batch-b0 ;
+    ptrdiff_t info[W] = {};
+    pack_factor_matrix<batched,W>( A, b0, lanes, n, buf.data() );
+    lu_group<N,W>( n, buf.data(), pbuf.data(), info );
+    unpack_factor_matrix<batched,W>( buf.data(), b0, lanes, n, A );
+    for ( ptrdiff_t l = 0 ; l < lanes ; ++l ) {
+      for ( ptrdiff_t k = 0 ; k < n ; ++k ) problem_element<batched>( piv, b0+l, k ) = pbuf[k*W+l];
+      set_info( b0+l, info[l] );
+    }
+  }
+}
+
+} // namespace detail
+
+template<class InOutMat, class Triangle>
+ptrdiff_t cholesky_factor( InOutMat A, Triangle t ) {
+  static_assert( InOutMat::rank() == 2, "" );
+  ptrdiff_t result = 0 ;
+  detail::cholesky_factor_groups( A, t, [&]( ptrdiff_t, const ptrdiff_t info ) { result = info ; } );
+  return result ;
+}
+
+template<class InOutMat, class Triangle, class OutInfo>
+void cholesky_factor( InOutMat A, Triangle t, OutInfo info ) {
+  static_assert( InOutMat::rank() == 3 && OutInfo::rank() == 1, "" );
+  detail::cholesky_factor_groups( A, t, [&]( const ptrdiff_t b, const ptrdiff_t i ) { info(b) = i ; } );
+}
+
+template<class InMat, class Triangle, class InOutObj>
+void cholesky_solve( InMat A, Triangle t, InOutObj B ) {
+  typedef typename InOutObj::value_type value_type;
+  constexpr bool batched = detail::is_factor_batch<InMat>() ;
+  constexpr ptrdiff_t W = batched ? detail::interleave_lanes<value_type>() : 1 ;
+  constexpr ptrdiff_t N = detail::factor_static_order<InMat>() ;
+  const ptrdiff_t batch = detail::factor_batch_size( A );
+  const ptrdiff_t n = A.extent( batched ? 1 : 0 );
+  const ptrdiff_t nrhs = detail::num_rhs<batched>( B );
+
+  vector<value_type> a( n*n*W ), b( n*nrhs*W );
+  for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += W ) {
+    const ptrdiff_t lanes = W < batch-b0 ? W : batch-b0 ;
+    detail::pack_factor_triangle<batched,W>( A, t, b0, lanes, n, a.data() );
+    detail::pack_rhs<batched,W>( B, b0, lanes, n, nrhs, b.data() );
+    detail::cholesky_solve_group<N,W>( n, a.data(), nrhs, b.data() );
+    detail::unpack_rhs<batched,W>( b.data(), b0, lanes, n, nrhs, B );
+  }
+}
+
+template<class InOutMat, class OutPivots>
+ptrdiff_t lu_factor( InOutMat A, OutPivots piv ) {
+  static_assert( InOutMat::rank() == 2 && OutPivots::rank() == 1, "" );
+  ptrdiff_t result = 0 ;
+  detail::lu_factor_groups( A, piv, [&]( ptrdiff_t, const ptrdiff_t info ) { result = info ; } );
+  return result ;
+}
+
+template<class InOutMat, class OutPivots, class OutInfo>
+void lu_factor( InOutMat A, OutPivots piv, OutInfo info ) {
+  static_assert( InOutMat::rank() == 3 && OutPivots::rank() == 2 && OutInfo::rank() == 1, "" );
+  detail::lu_factor_groups( A, piv, [&]( const ptrdiff_t b, const ptrdiff_t i ) { info(b) = i ; } );
+}
+
+template<class InMat, class InPivots, class InOutObj>
+void lu_solve( InMat A, InPivots piv, InOutObj B ) {
+  typedef typename InOutObj::value_type value_type;
+  constexpr bool batched = detail::is_factor_batch<InMat>() ;
+  constexpr ptrdiff_t W = batched ? detail::interleave_lanes<value_type>() : 1 ;
+  constexpr ptrdiff_t N = detail::factor_static_order<InMat>() ;
+  const ptrdiff_t batch = detail::factor_batch_size( A );
+  const ptrdiff_t n = A.extent( batched ? 1 : 0 );
+  const ptrdiff_t nrhs = detail::num_rhs<batched>( B );
+
+  vector<value_type> a( n*n*W ), b( n*nrhs*W );
+  vector<ptrdiff_t> p( n*W );
+  for ( ptrdiff_t b0 = 0 ; b0 < batch ; b0 += W ) {
+    const ptrdiff_t lanes = W < batch-b0 ? W : batch-b0 ;
+    detail::pack_factor_matrix<batched,W>( A, b0, lanes, n, a.data() );
+    detail::pack_rhs<batched,W>( B, b0, lanes, n, nrhs, b.data() );
+    for ( ptrdiff_t k = 0 ; k < n ; ++k )
+      for ( ptrdiff_t l = 0 ; l < W ; ++l )
+        p[k*W+l] = l < lanes ? ptrdiff_t( detail::problem_element<batched>( piv, b0+l, k ) ) : k ;
+    detail::lu_solve_group<N,W>( n, a.data(), p.data(), nrhs, b.data() );
+    detail::unpack_rhs<batched,W>( b.data(), b0, lanes, n, nrhs, B );
+  }
+}
+
+}}}} // experimental::fundamentals_v3::linalg
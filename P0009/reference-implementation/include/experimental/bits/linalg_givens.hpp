@@ -0,0 +1,288 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include <cstddef> // std::ptrdiff_t
+#include <type_traits>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: applies K sequences of plane rotations to A, as
+// LAPACK's xLASR does one.  Rotation (k,j), with cosine c(k,j) and sine
+// s(k,j), combines lines j and j+1 of A: with left_side the lines are
+// rows and A := G(k,j) A, that is
+//
+//   [ A(j,:) ; A(j+1,:) ] := [ c s ; -conj(s) c ] [ A(j,:) ; A(j+1,:) ]
+//
+// as givens_rotation_apply does, and with right_side the lines are
+// columns and A := A G(k,j)^H, which accumulates in A the rotations that
+// left_side applies to another matrix.  The rotations are applied in the
+// order k = 0, 1, ..., K-1 and within a sequence j = 0, 1, ..., so c and
+// s are K x (m-1) for the m rows (left_side) or columns (right_side) of
+// A.  A must not overlap c or s.
+//
+// Applied one at a time, each rotation loads and stores two lines for
+// six flops per entry.  Here A is packed a panel at a time, a few
+// entries of every line, as matrix_product packs its operands.  Tiles of
+// several rotations from several sequences are applied to each entry of
+// the panel while the lines they touch are in registers.  Rotations are
+// reordered only where they act on different lines, so the result is
+// that of applying them one at a time.
+template<class Side, class InMat1, class InMat2, class InOutMat>
+void givens_rotation_sequence_apply( Side side, InMat1 c, InMat2 s, InOutMat A );
+
+template<class ExecutionPolicy, class Side, class InMat1, class InMat2, class InOutMat>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+givens_rotation_sequence_apply( ExecutionPolicy && exec, Side side, InMat1 c, InMat2 s, InOutMat A );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// Block sizes of givens_rotation_sequence_apply, by value type.  A tile
+// is steps x sequences rotations: the rotations (k,j) of sequences
+// consecutive sequences k whose j + k are steps consecutive steps.  Its
+// sequences + steps lines are held in registers, for width entries at a
+// time; the tile must stay small enough for the compiler to unroll.
+template<class T>
+struct givens_blocking {
+  static constexpr ptrdiff_t sequences = 2 ;
+  static constexpr ptrdiff_t steps = 2 ;
+  static constexpr ptrdiff_t width = 8 ;
+};
+
+template<>
+struct givens_blocking<double> {
+  static constexpr ptrdiff_t sequences = 4 ;
+  static constexpr ptrdiff_t steps = 4 ;
+  static constexpr ptrdiff_t width = 32 ;
+};
+
+template<>
+struct givens_blocking<float> {
+  static constexpr ptrdiff_t sequences = 4 ;
+  static constexpr ptrdiff_t steps = 4 ;
+  static constexpr ptrdiff_t width = 64 ;
+};
+
+// [ x ; y ] := [ c s ; -conj(s) c ] [ x ; y ] for two lines of a panel.
+template<ptrdiff_t L, class T, class Real, class Scalar>
+inline void givens_rotate_lines( T * __restrict x, T * __restrict y, const Real c, const Scalar s ) {
+  const Scalar sc = conj_if_needed( s );
+  for ( ptrdiff_t q = 0 ; q < L ; ++q ) {
+    const T xq = x[q] ;
+    const T yq = y[q] ;
+    x[q] = c * xq + s * yq ;
+    y[q] = c * yq - sc * xq ;
+  }
+}
+
+// Applies the KB x S tile of rotations (k, t0+u-k), k < KB and u < S, in
+// the order of u then k, to the KB + S lines of w from line t0-KB+1 on,
+// L apart.  Each rotation acts on the lines u-k+KB-1 and u-k+KB of the
+// tile, all of which stay in x for an entry of the panel.
+template<ptrdiff_t KB, ptrdiff_t S, ptrdiff_t L, class T, class Real, class Scalar>
+inline void givens_tile( T * const w, const Real * const c, const Scalar * const s,
+                         const ptrdiff_t ld, const ptrdiff_t t0 ) {
+  Real cr[S][KB] ;
+  Scalar sr[S][KB], sc[S][KB] ;
+  for ( ptrdiff_t u = 0 ; u < S ; ++u )
+    for ( ptrdiff_t k = 0 ; k < KB ; ++k ) {
+      cr[u][k] = c[ k * ld + t0 + u - k ];
+      sr[u][k] = s[ k * ld + t0 + u - k ];
+      sc[u][k] = conj_if_needed( sr[u][k] );
+    }
+  for ( ptrdiff_t q = 0 ; q < L ; ++q ) {
+    T x[KB+S] ;
+    for ( ptrdiff_t i = 0 ; i < KB + S ; ++i ) x[i] = w[ i * L + q ];
+    for ( ptrdiff_t u = 0 ; u < S ; ++u )
+      for ( ptrdiff_t k = 0 ; k < KB ; ++k ) {
+        const ptrdiff_t r = u - k + KB - 1 ;
+        const T xr = x[r] ;
+        const T yr = x[r+1] ;
+        x[r]   = cr[u][k] * xr + sr[u][k] * yr ;
+        x[r+1] = cr[u][k] * yr - sc[u][k] * xr ;
+      }
+    for ( ptrdiff_t i = 0 ; i < KB + S ; ++i ) w[ i * L + q ] = x[i] ;
+  }
+}
+
+// Applies KB sequences, packed KB x ld in c and s, to the panel w of m
+// lines, L apart.  Rotation (k,j) is applied in step t = j + k after the
+// rotations of lower k in that step, and so after the rotations that
+// share a line with it and come before it: (k,j-1), (k-1,j) and
+// (k-1,j+1).  Steps KB-1 to m-2 have all KB rotations and are applied
+// S at a time by givens_tile; the steps before and after, a rotation at
+// a time.
+template<ptrdiff_t KB, class Blocking, class T, class Real, class Scalar>
+void givens_sequence_panel( T * const w, const ptrdiff_t m, const Real * const c,
+                            const Scalar * const s, const ptrdiff_t ld ) {
+  constexpr ptrdiff_t S = Blocking::steps ;
+  constexpr ptrdiff_t L = Blocking::width ;
+  const auto step = [&]( const ptrdiff_t t ) {
+    for ( ptrdiff_t k = 0 ; k < KB ; ++k ) {
+      const ptrdiff_t j = t - k ;
+      if ( 0 <= j && j < m - 1 )
+        givens_rotate_lines<L>( w + j * L, w + ( j + 1 ) * L, c[ k * ld + j ], s[ k * ld + j ] );
+    }
+  };
+  const ptrdiff_t steps = m + KB - 2 ;
+  ptrdiff_t t = 0 ;
+  for ( ; t < KB - 1 && t < steps ; ++t ) step( t );
+  for ( ; t + S <= m - 1 ; t += S ) givens_tile<KB,S,L>( w + ( t - KB + 1 ) * L, c, s, ld, t );
+  for ( ; t < steps ; ++t ) step( t );
+}
+
+template<class Side, class InMat1, class InMat2, class InOutMat>
+void givens_rotation_sequence_dispatch( Side, const InMat1 & c, const InMat2 & s, const InOutMat & A,
+                                        const size_t num_threads ) {
+  static_assert( InMat1::rank() == 2 && InMat2::rank() == 2 && InOutMat::rank() == 2, "" );
+  static_assert( is_same_v<Side,left_side_t> || is_same_v<Side,right_side_t>, "" );
+  typedef typename InOutMat::element_type T ;
+  typedef typename InMat1::value_type Real ;
+  typedef typename InMat2::value_type Scalar ;
+  constexpr bool left = is_same_v<Side,left_side_t> ;
+
+  const ptrdiff_t m = A.extent( left ? 0 : 1 );
+  const ptrdiff_t n = A.extent( left ? 1 : 0 );
+  const ptrdiff_t K = c.extent(0);
+  if ( m < 2 || n == 0 || K == 0 ) return ;
+
+  // Rotating columns by G^H is rotating rows by G with s conjugated.
+  const auto sine = [&]( const ptrdiff_t k, const ptrdiff_t j ) -> Scalar {
+    if constexpr ( left ) return s(k,j);
+    else return conj_if_needed( Scalar( s(k,j) ) );
+  };
+
+  if constexpr ( InOutMat::is_always_strided() &&
+                 is_same_v<typename InOutMat::accessor_type,accessor_basic<T>> ) {
+    T * const a = A.data() + A.mapping()(0,0);
+    const ptrdiff_t line_stride = A.stride( left ? 0 : 1 );
+    const ptrdiff_t stride = A.stride( left ? 1 : 0 );
+
+    typedef givens_blocking<T> blocking ;
+    constexpr ptrdiff_t KB = blocking::sequences ;
+    constexpr ptrdiff_t L = blocking::width ;
+    const ptrdiff_t ld = m - 1 ;
+
+    vector<Real> cp( K * ld );
+    vector<Scalar> sp( K * ld );
+    for ( ptrdiff_t k = 0 ; k < K ; ++k )
+      for ( ptrdiff_t j = 0 ; j < ld ; ++j ) {
+        cp[ k * ld + j ] = c(k,j);
+        sp[ k * ld + j ] = sine( k, j );
+      }
+
+    thread_pool::instance().run( num_threads, [&]( const size_t rank, const size_t size, team_barrier & ) {
+      const ptrdiff_t begin = partition_begin( n, L, ptrdiff_t( size ), ptrdiff_t( rank ) );
+      const ptrdiff_t end = partition_begin( n, L, ptrdiff_t( size ), ptrdiff_t( rank + 1 ) );
+      // A panel of L entries of every line; a last partial panel is
+      // padded with zeros, which the rotations keep zero.
+      vector<T> w( begin < end ? m * L : 0 );
+      for ( ptrdiff_t q0 = begin ; q0 < end ; q0 += L ) {
+        const ptrdiff_t len = end - q0 < L ? end - q0 : L ;
+        for ( ptrdiff_t i = 0 ; i < m ; ++i ) {
+          const T * const line = a + i * line_stride + q0 * stride ;
+          for ( ptrdiff_t q = 0 ; q < len ; ++q ) w[ i * L + q ] = line[ q * stride ];
+          for ( ptrdiff_t q = len ; q < L ; ++q ) w[ i * L + q ] = T{};
+        }
+        ptrdiff_t k = 0 ;
+        for ( ; K - k >= KB ; k += KB )
+          givens_sequence_panel<KB,blocking>( w.data(), m, cp.data() + k * ld, sp.data() + k * ld, ld );
+        for ( ; k < K ; ++k )
+          givens_sequence_panel<1,blocking>( w.data(), m, cp.data() + k * ld, sp.data() + k * ld, ld );
+        for ( ptrdiff_t i = 0 ; i < m ; ++i ) {
+          T * const line = a + i * line_stride + q0 * stride ;
+          for ( ptrdiff_t q = 0 ; q < len ; ++q ) line[ q * stride ] = w[ i * L + q ];
+        }
+      }
+    });
+  }
+  else {
+    const auto at = [&]( const ptrdiff_t j, const ptrdiff_t q ) -> decltype(auto) {
+      if constexpr ( left ) return A(j,q);
+      else return A(q,j);
+    };
+    for ( ptrdiff_t k = 0 ; k < K ; ++k )
+      for ( ptrdiff_t j = 0 ; j < m - 1 ; ++j ) {
+        const Real cs = c(k,j);
+        const Scalar sn = sine( k, j );
+        const Scalar sc = conj_if_needed( sn );
+        for ( ptrdiff_t q = 0 ; q < n ; ++q ) {
+          const typename InOutMat::value_type x = at( j, q );
+          const typename InOutMat::value_type y = at( j + 1, q );
+          at( j, q ) = cs * x + sn * y ;
+          at( j + 1, q ) = cs * y - sc * x ;
+        }
+      }
+  }
+}
+
+} // namespace detail
+
+template<class Side, class InMat1, class InMat2, class InOutMat>
+void givens_rotation_sequence_apply( Side side, InMat1 c, InMat2 s, InOutMat A ) {
+  detail::givens_rotation_sequence_dispatch( side, c, s, A, 1 );
+}
+
+template<class ExecutionPolicy, class Side, class InMat1, class InMat2, class InOutMat>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+givens_rotation_sequence_apply( ExecutionPolicy && exec, Side side, InMat1 c, InMat2 s, InOutMat A ) {
+  detail::givens_rotation_sequence_dispatch( side, c, s, A, detail::execution_policy_threads( exec ) );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
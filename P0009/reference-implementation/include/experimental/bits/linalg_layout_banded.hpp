@@ -0,0 +1,172 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: banded matrices in LAPACK band storage
+template<ptrdiff_t SubDiagonals, ptrdiff_t SuperDiagonals>
+class layout_banded ;
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Matrix with SubDiagonals (kl) nonzero diagonals below and SuperDiagonals
+// (ku) above the main diagonal, stored as in LAPACK's xGBMV/xGBSV: column j
+// of A is column j of a (kl+ku+1) x N column-major array AB, with A(i,j) in
+// AB(ku+i-j,j).  operator()(i,j) requires max(0,j-ku) <= i <= min(M-1,j+kl).
+template<ptrdiff_t SubDiagonals, ptrdiff_t SuperDiagonals>
+class layout_banded {
+public:
+
+  static_assert( SubDiagonals >= 0 && SuperDiagonals >= 0, "" );
+
+  static constexpr ptrdiff_t sub_diagonals = SubDiagonals ;
+  static constexpr ptrdiff_t super_diagonals = SuperDiagonals ;
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    static_assert( Extents::rank() == 2, "" );
+
+    Extents m_extents ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_banded ;
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    constexpr mapping( const Extents & ext ) noexcept
+      : m_extents( ext ) {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+    // LAPACK's LDAB
+    static constexpr index_type leading_dimension() noexcept
+      { return SubDiagonals + SuperDiagonals + 1 ; }
+
+    constexpr index_type required_span_size() const noexcept
+      { return leading_dimension() * m_extents.extent(1) ; }
+
+    // ( ku + i - j ) + j * LDAB
+    constexpr index_type operator()( const index_type i, const index_type j ) const noexcept
+      { return SuperDiagonals + i + j * ( SubDiagonals + SuperDiagonals ) ; }
+
+    // Uniqueness refers to the band, the domain of operator().
+    // The corners of AB above the first and below the last
+    // super- and subdiagonals are never referenced.
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept { return false ; }
+    static constexpr bool is_always_strided()    noexcept { return false ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept { return false ; }
+    constexpr bool is_strided()    const noexcept { return false ; }
+
+  }; // class mapping
+
+}; // class layout_banded
+
+namespace detail {
+
+template<class Layout>
+struct is_layout_banded : false_type {};
+
+template<ptrdiff_t SubDiagonals, ptrdiff_t SuperDiagonals>
+struct is_layout_banded<layout_banded<SubDiagonals,SuperDiagonals>> : true_type {};
+
+// Number of diagonals below (above) the main diagonal that may hold
+// nonzeros; algorithms never touch elements outside of them.  The
+// bands of a transpose are those of the nested matrix, swapped.
+template<class InMat>
+constexpr ptrdiff_t upper_bandwidth( const InMat & A ) noexcept ;
+
+template<class InMat>
+constexpr ptrdiff_t lower_bandwidth( const InMat & A ) noexcept {
+  typedef typename InMat::layout_type layout_type;
+  if constexpr ( is_layout_banded<layout_type>::value )
+    return layout_type::sub_diagonals ;
+  else if constexpr ( is_layout_transpose<layout_type>::value )
+    return upper_bandwidth( transposed( A ) );
+  else
+    return A.extent(0) > 0 ? A.extent(0) - 1 : 0 ;
+}
+
+template<class InMat>
+constexpr ptrdiff_t upper_bandwidth( const InMat & A ) noexcept {
+  typedef typename InMat::layout_type layout_type;
+  if constexpr ( is_layout_banded<layout_type>::value )
+    return layout_type::super_diagonals ;
+  else if constexpr ( is_layout_transpose<layout_type>::value )
+    return lower_bandwidth( transposed( A ) );
+  else
+    return A.extent(1) > 0 ? A.extent(1) - 1 : 0 ;
+}
+
+}
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,185 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: batches interleaved for vectorization across problems
+template<ptrdiff_t VectorWidth>
+class layout_batch_interleaved ;
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Batch of problems whose leftmost extent is the batch extent, stored in
+// groups of VectorWidth (W) consecutive problems.  Within a group the
+// problems are laid out row-major, and the W entries with the same
+// indices are contiguous, so a kernel working on one group fills a vector
+// register with the same entry of W problems:
+//
+//   X(b,i...) is at ( ( b / W ) * P + row_major(i...) ) * W + b % W
+//
+// where P is the number of entries of one problem.  A last partial group
+// is padded to W problems.  linalg::copy converts to and from any other
+// batch layout.  Slicing at one problem gives a layout_stride view of it.
+template<ptrdiff_t VectorWidth>
+class layout_batch_interleaved {
+public:
+
+  static_assert( VectorWidth > 0, "" );
+
+  static constexpr ptrdiff_t vector_width = VectorWidth ;
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    static_assert( Extents::rank() >= 2, "" );
+
+    Extents m_extents ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_batch_interleaved ;
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    constexpr mapping( const Extents & ext ) noexcept
+      : m_extents( ext ) {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+    // Number of entries of one problem.
+    constexpr index_type problem_size() const noexcept
+      {
+        index_type size = 1 ;
+        for ( size_t r = 1 ; r < Extents::rank() ; ++r ) size *= m_extents.extent(r);
+        return size ;
+      }
+
+    constexpr index_type num_groups() const noexcept
+      { return ( m_extents.extent(0) + VectorWidth - 1 ) / VectorWidth ; }
+
+    constexpr index_type required_span_size() const noexcept
+      { return num_groups() * VectorWidth * problem_size() ; }
+
+    template<class ... Indices>
+    constexpr
+    typename enable_if<sizeof...(Indices)+1 == Extents::rank(),index_type>::type
+    operator()( const index_type b, Indices ... indices ) const noexcept
+      {
+        const index_type i[] = { index_type( indices )... };
+        index_type e = 0 ;
+        for ( size_t r = 1 ; r < Extents::rank() ; ++r ) e = e * m_extents.extent(r) + i[r-1];
+        return ( ( b / VectorWidth ) * problem_size() + e ) * VectorWidth + b % VectorWidth ;
+      }
+
+    // Padding of a last partial group leaves holes in the span.
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept { return VectorWidth == 1 ; }
+    static constexpr bool is_always_strided()    noexcept { return false ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept { return m_extents.extent(0) % VectorWidth == 0 ; }
+    constexpr bool is_strided()    const noexcept { return false ; }
+
+    // [mdspan.submdspan.mapping]
+
+    // Within one problem the entries are W apart along the last extent,
+    // so with the batch index fixed the rest is strided.
+    template<class BatchIndex, class ... SliceSpecifiers>
+    friend auto submdspan_mapping( const mapping & src, const BatchIndex b, SliceSpecifiers ... slices )
+      {
+        static_assert( is_convertible<BatchIndex,index_type>::value,
+                       "layout_batch_interleaved can only be sliced at a single problem" );
+        array<index_type,Extents::rank()> strides ;
+        strides[0] = 0 ;
+        index_type stride = VectorWidth ;
+        for ( size_t r = Extents::rank() - 1 ; r > 0 ; --r ) {
+          strides[r] = stride ;
+          stride *= src.m_extents.extent(r);
+        }
+        auto sub = experimental::detail::submdspan_mapping_impl<layout_stride>(
+          layout_stride::mapping<Extents>( src.m_extents, strides ), index_type( b ), slices... );
+        sub.offset += size_t( ( index_type( b ) / VectorWidth ) * src.problem_size() * VectorWidth + index_type( b ) % VectorWidth );
+        return sub ;
+      }
+
+  }; // class mapping
+
+}; // class layout_batch_interleaved
+
+namespace detail {
+
+template<class Layout>
+struct is_layout_batch_interleaved : false_type {};
+
+template<ptrdiff_t VectorWidth>
+struct is_layout_batch_interleaved<layout_batch_interleaved<VectorWidth>> : true_type {};
+
+}
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,190 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include <array>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: grids surrounded by ghost cells, for stencils
+template<ptrdiff_t Halo, ptrdiff_t PaddingValue = 8>
+class layout_halo ;
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Row-major grid whose extents are those of its interior, surrounded by
+// Halo ghost cells on every side: operator() takes indices from -Halo to
+// extent(r)+Halo-1, so that a stencil of radius up to Halo reads the
+// ghost cells of a boundary point without special cases.  As in P2642's
+// layout_right_padded, rows are padded to a multiple of PaddingValue
+// elements, and each row is shifted so that its first interior element
+// is at a multiple of PaddingValue from the start of the span; with an
+// aligned allocation every interior row then starts aligned.  Slicing
+// gives a layout_stride view.
+template<ptrdiff_t Halo, ptrdiff_t PaddingValue>
+class layout_halo {
+public:
+
+  static_assert( Halo >= 0 && PaddingValue > 0, "" );
+
+  static constexpr ptrdiff_t halo = Halo ;
+  static constexpr ptrdiff_t padding_value = PaddingValue ;
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    static_assert( Extents::rank() >= 1, "" );
+
+    using stride_t = array<ptrdiff_t,Extents::rank()> ;
+
+    Extents   m_extents ;
+    stride_t  m_stride ;
+    ptrdiff_t m_origin ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_halo ;
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    mapping( const Extents & ext ) noexcept
+      : m_extents( ext ), m_stride(), m_origin( 0 )
+      {
+        constexpr size_t last = Extents::rank() - 1 ;
+        // Elements before the first ghost cell of a row, so that the
+        // first interior element is aligned.
+        const ptrdiff_t lead = ( PaddingValue - Halo % PaddingValue ) % PaddingValue ;
+        m_stride[last] = 1 ;
+        if constexpr ( 0 < last ) {
+          const ptrdiff_t row = lead + 2 * Halo + ext.extent( last );
+          m_stride[last-1] = ( ( row + PaddingValue - 1 ) / PaddingValue ) * PaddingValue ;
+          for ( size_t r = last - 1 ; 0 < r ; --r ) m_stride[r-1] = m_stride[r] * ( ext.extent( r ) + 2 * Halo );
+        }
+        m_origin = lead ;
+        for ( size_t r = 0 ; r <= last ; ++r ) m_origin += Halo * m_stride[r] ;
+      }
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+    // Offset of the first interior element, operator()(0,...,0).
+    constexpr index_type origin() const noexcept { return m_origin ; }
+
+    constexpr index_type required_span_size() const noexcept
+      {
+        constexpr size_t last = Extents::rank() - 1 ;
+        return 0 < last ? ( m_extents.extent(0) + 2 * Halo ) * m_stride[0]
+                        : ( ( m_origin + m_extents.extent(0) + Halo + PaddingValue - 1 ) / PaddingValue ) * PaddingValue ;
+      }
+
+    template<class ... Indices>
+    constexpr
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    operator()( Indices ... indices ) const noexcept
+      {
+        const index_type i[] = { index_type( indices )... };
+        index_type e = m_origin ;
+        for ( size_t r = 0 ; r < Extents::rank() ; ++r ) e += i[r] * m_stride[r] ;
+        return e ;
+      }
+
+    constexpr index_type stride( const size_t r ) const noexcept { return m_stride[r] ; }
+
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+    static constexpr bool is_always_contiguous() noexcept { return false ; }
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+
+    constexpr bool is_unique()     const noexcept { return true ; }
+    constexpr bool is_contiguous() const noexcept { return false ; }
+    constexpr bool is_strided()    const noexcept { return true ; }
+
+    // [mdspan.submdspan.mapping]
+
+    template<class ... SliceSpecifiers>
+    friend auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+      {
+        auto sub = experimental::detail::submdspan_mapping_impl<layout_stride>(
+          layout_stride::mapping<Extents>( src.m_extents, src.m_stride ), slices... );
+        sub.offset += size_t( src.m_origin );
+        return sub ;
+      }
+
+  }; // class mapping
+
+}; // class layout_halo
+
+namespace detail {
+
+template<class Layout>
+struct is_layout_halo : false_type {};
+
+template<ptrdiff_t Halo, ptrdiff_t PaddingValue>
+struct is_layout_halo<layout_halo<Halo,PaddingValue>> : true_type {};
+
+}
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,157 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.layout.packed]
+template<class Triangle, class StorageOrder>
+class layout_blas_packed ;
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Square matrix storing only one triangle, packed contiguously as in the
+// BLAS' SP, HP and TP formats.  (i,j) and (j,i) map to the same offset,
+// so the mapping is not unique unless the matrix is at most 1 x 1.
+template<class Triangle, class StorageOrder>
+class layout_blas_packed {
+public:
+  using triangle_type = Triangle ;
+  using storage_order_type = StorageOrder ;
+
+  static_assert( is_same<Triangle,upper_triangle_t>::value ||
+                 is_same<Triangle,lower_triangle_t>::value, "" );
+  static_assert( is_same<StorageOrder,column_major_t>::value ||
+                 is_same<StorageOrder,row_major_t>::value, "" );
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    static_assert( Extents::rank() == 2, "" );
+
+    Extents m_extents ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_blas_packed ;
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    constexpr mapping( const Extents & ext ) noexcept
+      : m_extents( ext ) {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+    // Column-major upper and row-major lower store the triangle i <= j
+    // line by line with line j holding j+1 entries; the other two store
+    // line i with N-i entries.
+    static constexpr bool is_short_lines_first() noexcept {
+      return is_same<StorageOrder,column_major_t>::value == is_same<Triangle,upper_triangle_t>::value ;
+    }
+
+    constexpr index_type required_span_size() const noexcept {
+      const index_type N = m_extents.extent(0);
+      return N * ( N + 1 ) / 2 ;
+    }
+
+    constexpr index_type operator()( const index_type ind0, const index_type ind1 ) const noexcept {
+      const index_type i = ind0 < ind1 ? ind0 : ind1 ;
+      const index_type j = ind0 < ind1 ? ind1 : ind0 ;
+      if ( is_short_lines_first() ) return i + j * ( j + 1 ) / 2 ;
+      const index_type N = m_extents.extent(0);
+      return j + N * i - i * ( i + 1 ) / 2 ;
+    }
+
+    static constexpr bool is_always_unique() noexcept {
+      return ( Extents::static_extent(0) != dynamic_extent && Extents::static_extent(0) < 2 ) ||
+             ( Extents::static_extent(1) != dynamic_extent && Extents::static_extent(1) < 2 ) ;
+    }
+    static constexpr bool is_always_contiguous() noexcept { return true ; }
+    static constexpr bool is_always_strided()    noexcept { return is_always_unique() ; }
+
+    constexpr bool is_unique()     const noexcept { return m_extents.extent(0) < 2 ; }
+    constexpr bool is_contiguous() const noexcept { return true ; }
+    constexpr bool is_strided()    const noexcept { return m_extents.extent(0) < 2 ; }
+
+    // Only meaningful if is_strided()
+    constexpr index_type stride(size_t) const noexcept { return 1 ; }
+
+  }; // class mapping
+
+}; // class layout_blas_packed
+
+namespace detail {
+
+template<class Layout>
+struct is_layout_blas_packed : false_type {};
+
+template<class Triangle, class StorageOrder>
+struct is_layout_blas_packed<layout_blas_packed<Triangle,StorageOrder>> : true_type {};
+
+}
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,277 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.transp.layout_transpose]
+template<class Layout>
+class layout_transpose ;
+
+// [linalg.transp.transposed]
+template<class ElementType, class Extents, class Layout, class Accessor>
+auto transposed( const basic_mdspan<ElementType,Extents,Layout,Accessor> & a );
+
+// [linalg.conj_transp]
+template<class ElementType, class Extents, class Layout, class Accessor>
+auto conjugate_transposed( const basic_mdspan<ElementType,Extents,Layout,Accessor> & a );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+template<class Extents>
+struct transpose_extents ;
+
+template<ptrdiff_t E0, ptrdiff_t E1>
+struct transpose_extents<extents<E0,E1>> {
+  using type = extents<E1,E0> ;
+
+  static constexpr type apply( const extents<E0,E1> & e ) noexcept {
+    array<ptrdiff_t,type::rank_dynamic()> dynamic_extents{};
+    size_t d = 0 ;
+    if ( E1 == dynamic_extent ) dynamic_extents[d++] = e.extent(1);
+    if ( E0 == dynamic_extent ) dynamic_extents[d++] = e.extent(0);
+    return type( dynamic_extents );
+  }
+};
+
+template<class Extents>
+using transpose_extents_t = typename transpose_extents<Extents>::type ;
+
+} // namespace detail
+
+// The mapping of the transpose of a rank-2 Layout: (i,j) maps where the
+// nested mapping maps (j,i).
+template<class Layout>
+class layout_transpose {
+public:
+  using nested_layout_type = Layout ;
+
+  template<class Extents>
+  class mapping {
+  private:
+
+    static_assert( Extents::rank() == 2, "" );
+
+    using nested_mapping_type = typename Layout::template mapping<detail::transpose_extents_t<Extents>> ;
+
+    nested_mapping_type m_nested ;
+    Extents             m_extents ;
+
+  public:
+
+    using index_type = ptrdiff_t ;
+    using extents_type = Extents ;
+    using layout_type = layout_transpose ;
+
+    constexpr mapping() noexcept = default ;
+
+    constexpr mapping( mapping && ) noexcept = default ;
+
+    constexpr mapping( const mapping & ) noexcept = default ;
+
+    mapping & operator = ( mapping && ) noexcept = default ;
+
+    mapping & operator = ( const mapping & ) noexcept = default ;
+
+    constexpr explicit mapping( const nested_mapping_type & nested ) noexcept
+      : m_nested( nested )
+      , m_extents( detail::transpose_extents<typename nested_mapping_type::extents_type>::apply( nested.extents() ) ) {}
+
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+
+    constexpr const nested_mapping_type & nested_mapping() const noexcept { return m_nested ; }
+
+    constexpr index_type required_span_size() const noexcept
+      { return m_nested.required_span_size(); }
+
+    constexpr index_type operator()( const index_type i, const index_type j ) const noexcept
+      { return m_nested( j, i ); }
+
+    static constexpr bool is_always_unique()     noexcept { return nested_mapping_type::is_always_unique(); }
+    static constexpr bool is_always_contiguous() noexcept { return nested_mapping_type::is_always_contiguous(); }
+    static constexpr bool is_always_strided()    noexcept { return nested_mapping_type::is_always_strided(); }
+
+    constexpr bool is_unique()     const noexcept { return m_nested.is_unique(); }
+    constexpr bool is_contiguous() const noexcept { return m_nested.is_contiguous(); }
+    constexpr bool is_strided()    const noexcept { return m_nested.is_strided(); }
+
+    // Only meaningful if is_strided()
+    constexpr index_type stride( size_t r ) const noexcept
+      { return m_nested.stride( 1 - r ); }
+
+  }; // class mapping
+
+}; // class layout_transpose
+
+namespace detail {
+
+template<class Layout>
+struct is_layout_transpose : false_type {};
+
+template<class Layout>
+struct is_layout_transpose<layout_transpose<Layout>> : true_type {};
+
+// Layout of the transpose of a matrix with layout Layout, and its mapping.
+// The transpose of a layout the library knows is again such a layout, so
+// that algorithms see its storage order directly; any other layout is
+// wrapped in layout_transpose.
+template<class Layout>
+struct transpose_layout {
+  using type = layout_transpose<Layout> ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept {
+    return typename type::template mapping<transpose_extents_t<typename Mapping::extents_type>>( m );
+  }
+};
+
+template<class Layout>
+struct transpose_layout<layout_transpose<Layout>> {
+  using type = Layout ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept { return m.nested_mapping(); }
+};
+
+template<>
+struct transpose_layout<layout_left> {
+  using type = layout_right ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept {
+    typedef transpose_extents<typename Mapping::extents_type> transpose_type;
+    return typename type::template mapping<typename transpose_type::type>( transpose_type::apply( m.extents() ) );
+  }
+};
+
+template<>
+struct transpose_layout<layout_right> {
+  using type = layout_left ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept {
+    typedef transpose_extents<typename Mapping::extents_type> transpose_type;
+    return typename type::template mapping<typename transpose_type::type>( transpose_type::apply( m.extents() ) );
+  }
+};
+
+template<>
+struct transpose_layout<layout_stride> {
+  using type = layout_stride ;
+
+  template<class Mapping>
+  static auto mapping( const Mapping & m ) noexcept {
+    typedef transpose_extents<typename Mapping::extents_type> transpose_type;
+    return typename type::template mapping<typename transpose_type::type>(
+      transpose_type::apply( m.extents() ), array<ptrdiff_t,2>{ m.stride(1), m.stride(0) } );
+  }
+};
+
+// The padded stride of a matrix is that of its transpose.
+template<ptrdiff_t PaddingValue>
+struct transpose_layout<layout_left_padded<PaddingValue>> {
+  using type = layout_right_padded<PaddingValue> ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept {
+    typedef transpose_extents<typename Mapping::extents_type> transpose_type;
+    return typename type::template mapping<typename transpose_type::type>( transpose_type::apply( m.extents() ), m.stride(1) );
+  }
+};
+
+template<ptrdiff_t PaddingValue>
+struct transpose_layout<layout_right_padded<PaddingValue>> {
+  using type = layout_left_padded<PaddingValue> ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept {
+    typedef transpose_extents<typename Mapping::extents_type> transpose_type;
+    return typename type::template mapping<typename transpose_type::type>( transpose_type::apply( m.extents() ), m.stride(0) );
+  }
+};
+
+// The packed storage of a triangle, read in the other order, is the
+// storage of the opposite triangle.
+template<class Triangle, class StorageOrder>
+struct transpose_layout<layout_blas_packed<Triangle,StorageOrder>> {
+  using type = layout_blas_packed<
+    conditional_t<is_same<Triangle,upper_triangle_t>::value,lower_triangle_t,upper_triangle_t>,
+    conditional_t<is_same<StorageOrder,column_major_t>::value,row_major_t,column_major_t>> ;
+
+  template<class Mapping>
+  static constexpr auto mapping( const Mapping & m ) noexcept {
+    typedef transpose_extents<typename Mapping::extents_type> transpose_type;
+    return typename type::template mapping<typename transpose_type::type>( transpose_type::apply( m.extents() ) );
+  }
+};
+
+} // namespace detail
+
+template<class ElementType, class Extents, class Layout, class Accessor>
+auto transposed( const basic_mdspan<ElementType,Extents,Layout,Accessor> & a ) {
+  typedef detail::transpose_layout<Layout> transpose_type;
+  return basic_mdspan<ElementType,detail::transpose_extents_t<Extents>,typename transpose_type::type,Accessor>(
+    a.data(), transpose_type::mapping( a.mapping() ), a.accessor() );
+}
+
+template<class ElementType, class Extents, class Layout, class Accessor>
+auto conjugate_transposed( const basic_mdspan<ElementType,Extents,Layout,Accessor> & a ) {
+  return conjugated( transposed( a ) );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
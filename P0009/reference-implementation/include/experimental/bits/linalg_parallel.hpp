@@ -0,0 +1,261 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <execution>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Implementation-specific execution policy: run a linalg algorithm on
+// num_threads threads of the linalg thread pool.  std::execution::par
+// and par_unseq use every hardware thread; seq runs on the caller.
+class thread_pool_policy {
+public:
+  explicit thread_pool_policy( size_t num_threads ) noexcept
+    : m_num_threads( num_threads < 1 ? 1 : num_threads ) {}
+
+  size_t num_threads() const noexcept { return m_num_threads ; }
+
+private:
+  size_t m_num_threads ;
+};
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+template<class T>
+struct is_linalg_execution_policy
+  : integral_constant<bool, is_execution_policy_v<T> || is_same_v<T,thread_pool_policy>> {};
+
+template<class T>
+inline constexpr bool is_linalg_execution_policy_v = is_linalg_execution_policy<remove_cv_t<remove_reference_t<T>>>::value;
+
+template<class ExecutionPolicy>
+size_t execution_policy_threads( const ExecutionPolicy & policy ) {
+  if constexpr ( is_same_v<ExecutionPolicy,thread_pool_policy> ) {
+    return policy.num_threads();
+  }
+  else if constexpr ( is_same_v<ExecutionPolicy,std::execution::sequenced_policy> ) {
+    return 1 ;
+  }
+  else {
+    const size_t n = std::thread::hardware_concurrency();
+    return n < 1 ? 1 : n ;
+  }
+}
+
+// Reusable barrier for the members of one thread_pool::run call.
+class team_barrier {
+public:
+  explicit team_barrier( size_t size ) : m_size( size ), m_waiting( 0 ), m_generation( 0 ) {}
+
+  team_barrier( const team_barrier & ) = delete ;
+  team_barrier & operator = ( const team_barrier & ) = delete ;
+
+  void arrive_and_wait() {
+    if ( m_size < 2 ) return ;
+    unique_lock<mutex> lock( m_mutex );
+    const size_t generation = m_generation ;
+    if ( ++m_waiting == m_size ) {
+      m_waiting = 0 ;
+      ++m_generation ;
+      m_cv.notify_all();
+    }
+    else {
+      m_cv.wait( lock, [&]{ return m_generation != generation ; } );
+    }
+  }
+
+private:
+  mutex m_mutex ;
+  condition_variable m_cv ;
+  const size_t m_size ;
+  size_t m_waiting ;
+  size_t m_generation ;
+};
+
+// Process-wide pool of worker threads, grown on demand.  run() calls
+// f(rank,size,barrier) on size threads, the calling thread being rank 0,
+// and returns when all of them have finished.  Calls from inside a
+// worker run serially on that worker, so algorithms may nest.
+class thread_pool {
+public:
+  static thread_pool & instance() {
+    static thread_pool pool ;
+    return pool ;
+  }
+
+  thread_pool( const thread_pool & ) = delete ;
+  thread_pool & operator = ( const thread_pool & ) = delete ;
+
+  ~thread_pool() {
+    {
+      lock_guard<mutex> lock( m_mutex );
+      m_stop = true ;
+    }
+    m_start.notify_all();
+    for ( thread & t : m_workers ) t.join();
+  }
+
+  template<class F>
+  void run( size_t size, F && f ) {
+    if ( size < 2 || in_worker() ) {
+      team_barrier barrier( 1 );
+      f( size_t(0), size_t(1), barrier );
+      return ;
+    }
+
+    lock_guard<mutex> run_lock( m_run_mutex );
+    team_barrier barrier( size );
+    function<void(size_t)> job = [&]( size_t rank ) { f( rank, size, barrier ); };
+    {
+      unique_lock<mutex> lock( m_mutex );
+      while ( m_workers.size() < size-1 ) {
+        const size_t rank = m_workers.size() + 1 ;
+        m_workers.emplace_back( [this,rank]{ worker_loop( rank ); } );
+      }
+      m_job = & job ;
+      m_team_size = size ;
+      m_running = size - 1 ;
+      m_error = nullptr ;
+      ++m_generation ;
+    }
+    m_start.notify_all();
+
+    exception_ptr error ;
+    try {
+      // Rank 0 is a team member too: a run() from inside it runs serially.
+      worker_scope scope ;
+      job( 0 );
+    }
+    catch ( ... ) { error = current_exception(); }
+
+    unique_lock<mutex> lock( m_mutex );
+    m_done.wait( lock, [&]{ return m_running == 0 ; } );
+    m_job = nullptr ;
+    if ( ! error ) error = m_error ;
+    if ( error ) rethrow_exception( error );
+  }
+
+private:
+  thread_pool() = default ;
+
+  static bool & in_worker() {
+    static thread_local bool flag = false ;
+    return flag ;
+  }
+
+  // Marks the calling thread as running a job for its lifetime.
+  struct worker_scope {
+    worker_scope() noexcept { in_worker() = true ; }
+    ~worker_scope() { in_worker() = false ; }
+  };
+
+  void worker_loop( const size_t rank ) {
+    in_worker() = true ;
+    size_t seen = 0 ;
+    unique_lock<mutex> lock( m_mutex );
+    for (;;) {
+      m_start.wait( lock, [&]{ return m_stop || m_generation != seen ; } );
+      if ( m_stop ) return ;
+      seen = m_generation ;
+      if ( m_team_size <= rank ) continue ;
+
+      function<void(size_t)> * job = m_job ;
+      lock.unlock();
+      exception_ptr error ;
+      try { (*job)( rank ); }
+      catch ( ... ) { error = current_exception(); }
+      lock.lock();
+
+      if ( error && ! m_error ) m_error = error ;
+      if ( --m_running == 0 ) m_done.notify_one();
+    }
+  }
+
+  mutex m_run_mutex ;
+  mutex m_mutex ;
+  condition_variable m_start ;
+  condition_variable m_done ;
+  vector<thread> m_workers ;
+  function<void(size_t)> * m_job = nullptr ;
+  size_t m_team_size = 0 ;
+  size_t m_running = 0 ;
+  size_t m_generation = 0 ;
+  exception_ptr m_error ;
+  bool m_stop = false ;
+};
+
+// Split [0,n) in units of `grain` into `parts` nearly equal ranges and
+// return the begin of range `part`.
+inline ptrdiff_t partition_begin( const ptrdiff_t n, const ptrdiff_t grain,
+                                  const ptrdiff_t parts, const ptrdiff_t part ) {
+  const ptrdiff_t units = ( n + grain - 1 ) / grain ;
+  const ptrdiff_t begin = grain * ( ( units / parts ) * part + ( part < units % parts ? part : units % parts ) );
+  return begin < n ? begin : n ;
+}
+
+} // namespace detail
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,221 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// Kernels for matrices and vectors whose extents are all static and at
+// most small_static_max_extent.  The sizes are template constants, so
+// every loop has a constant trip count, operands are staged in local
+// arrays that the compiler keeps in registers, and the triangular solves
+// expand their outer loop at compile time so that the inner bounds are
+// constants too.  There is no blocking, packing, workspace or runtime
+// dispatch left to pay for.
+
+inline constexpr ptrdiff_t small_static_max_extent = 16 ;
+
+template<class MDSpan>
+constexpr bool has_small_static_extents() noexcept {
+  if ( MDSpan::extents_type::rank_dynamic() != 0 ) return false ;
+  for ( size_t r = 0 ; r < MDSpan::extents_type::rank() ; ++r )
+    if ( MDSpan::static_extent(r) > small_static_max_extent ) return false ;
+  return true ;
+}
+
+// Layouts whose operator() is defined for every index in the extents.
+template<class Layout>
+struct is_dense_layout
+  : integral_constant<bool, is_same<Layout,layout_left>::value ||
+                            is_same<Layout,layout_right>::value ||
+                            is_same<Layout,layout_stride>::value ||
+                            experimental::detail::is_layout_left_padded<Layout>::value ||
+                            experimental::detail::is_layout_right_padded<Layout>::value> {};
+
+template<class Layout>
+struct is_dense_layout<layout_transpose<Layout>> : is_dense_layout<Layout> {};
+
+// True if all arguments are small, fully static and dense.
+template<class ... MDSpans>
+struct is_small_static
+  : integral_constant<bool, ( ( has_small_static_extents<MDSpans>() &&
+                                is_dense_layout<typename MDSpans::layout_type>::value ) && ... )> {};
+
+// A triangular solve reads only the triangle of A, which may be packed.
+template<class InMat, class InOutObj>
+struct is_small_static_solve
+  : integral_constant<bool, has_small_static_extents<InMat>() && is_small_static<InOutObj>::value &&
+                            ( is_dense_layout<typename InMat::layout_type>::value ||
+                              is_layout_blas_packed<typename InMat::layout_type>::value )> {};
+
+// f(integral_constant<ptrdiff_t,I>()) for I = 0, ..., N-1, expanded at
+// compile time.
+template<class F, ptrdiff_t ... I>
+inline void static_for_impl( F && f, integer_sequence<ptrdiff_t,I...> ) {
+  ( f( integral_constant<ptrdiff_t,I>() ), ... );
+}
+
+template<ptrdiff_t N, class F>
+inline void static_for( F && f ) {
+  static_for_impl( f, make_integer_sequence<ptrdiff_t,N>() );
+}
+
+// Local arrays may not be empty.
+constexpr ptrdiff_t small_array_extent( const ptrdiff_t n ) noexcept { return n > 0 ? n : 1 ; }
+
+// C = A B, or C += A B if accumulate.  B is staged in registers and each
+// row of C is accumulated there, one rank-1 update per column of A.
+template<class Accum, class InMat1, class InMat2, class OutMat>
+void small_matrix_product( const InMat1 & A, const InMat2 & B, const OutMat & C, const bool accumulate ) {
+  constexpr ptrdiff_t M = OutMat::static_extent(0);
+  constexpr ptrdiff_t N = OutMat::static_extent(1);
+  constexpr ptrdiff_t K = InMat1::static_extent(1);
+  Accum b[small_array_extent(K)][small_array_extent(N)];
+  Accum c[small_array_extent(N)];
+
+  for ( ptrdiff_t k = 0 ; k < K ; ++k )
+    for ( ptrdiff_t j = 0 ; j < N ; ++j ) b[k][j] = Accum( B(k,j) );
+
+  for ( ptrdiff_t i = 0 ; i < M ; ++i ) {
+    for ( ptrdiff_t j = 0 ; j < N ; ++j ) c[j] = accumulate ? Accum( C(i,j) ) : Accum{};
+    for ( ptrdiff_t k = 0 ; k < K ; ++k ) {
+      const Accum aik = Accum( A(i,k) );
+      for ( ptrdiff_t j = 0 ; j < N ; ++j ) c[j] += aik * b[k][j];
+    }
+    for ( ptrdiff_t j = 0 ; j < N ; ++j ) C(i,j) = c[j];
+  }
+}
+
+// y += A x.
+template<class InMat, class InVec, class OutVec>
+void small_matrix_vector_update( const InMat & A, const InVec & x, const OutVec & y ) {
+  typedef typename OutVec::value_type sum_type;
+  constexpr ptrdiff_t M = InMat::static_extent(0);
+  constexpr ptrdiff_t N = InMat::static_extent(1);
+  sum_type xs[small_array_extent(N)];
+
+  for ( ptrdiff_t j = 0 ; j < N ; ++j ) xs[j] = sum_type( x(j) );
+  for ( ptrdiff_t i = 0 ; i < M ; ++i ) {
+    sum_type sum{};
+    for ( ptrdiff_t j = 0 ; j < N ; ++j ) sum += sum_type( A(i,j) ) * xs[j];
+    y(i) = sum_type( y(i) ) + sum ;
+  }
+}
+
+// Solve T x = x in place, T being the Triangle of A.
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+void small_triangular_solve_in_place( const InMat & A, Triangle, DiagonalStorage,
+                                      const InOutVec & x, BinaryDivideOp divide ) {
+  typedef typename InOutVec::value_type value_type;
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+  constexpr bool explicit_diag = is_same<DiagonalStorage,explicit_diagonal_t>::value;
+  constexpr ptrdiff_t N = InMat::static_extent(0);
+  value_type xs[small_array_extent(N)];
+
+  for ( ptrdiff_t i = 0 ; i < N ; ++i ) xs[i] = x(i);
+  static_for<N>( [&]( auto step ) {
+    constexpr ptrdiff_t i = lower ? decltype(step)::value : N-1-decltype(step)::value ;
+    value_type sum = xs[i];
+    for ( ptrdiff_t j = lower ? 0 : i+1 ; j < ( lower ? i : N ) ; ++j ) sum -= A(i,j) * xs[j];
+    if constexpr ( explicit_diag ) xs[i] = divide( sum, A(i,i) );
+    else xs[i] = sum;
+  });
+  for ( ptrdiff_t i = 0 ; i < N ; ++i ) x(i) = xs[i];
+}
+
+// Solve A X = B (Left) or X A = B (!Left) in place in B, B staged in
+// registers.  A left solve finishes a row of B per step, a right solve a
+// column.
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+void small_triangular_matrix_matrix_solve( const InMat & A, Triangle, DiagonalStorage,
+                                           const InOutMat & B, BinaryDivideOp divide ) {
+  typedef typename InOutMat::value_type value_type;
+  constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+  constexpr bool explicit_diag = is_same<DiagonalStorage,explicit_diagonal_t>::value;
+  constexpr ptrdiff_t M = InOutMat::static_extent(0);
+  constexpr ptrdiff_t N = InOutMat::static_extent(1);
+  value_type b[small_array_extent(M)][small_array_extent(N)];
+
+  for ( ptrdiff_t i = 0 ; i < M ; ++i )
+    for ( ptrdiff_t j = 0 ; j < N ; ++j ) b[i][j] = B(i,j);
+
+  if constexpr ( Left ) {
+    static_for<M>( [&]( auto step ) {
+      constexpr ptrdiff_t i = lower ? decltype(step)::value : M-1-decltype(step)::value ;
+      for ( ptrdiff_t k = lower ? 0 : i+1 ; k < ( lower ? i : M ) ; ++k ) {
+        const auto aik = A(i,k);
+        for ( ptrdiff_t j = 0 ; j < N ; ++j ) b[i][j] -= aik * b[k][j];
+      }
+      if constexpr ( explicit_diag ) {
+        const auto aii = A(i,i);
+        for ( ptrdiff_t j = 0 ; j < N ; ++j ) b[i][j] = divide( b[i][j], aii );
+      }
+    });
+  }
+  else {
+    static_for<N>( [&]( auto step ) {
+      constexpr ptrdiff_t j = lower ? N-1-decltype(step)::value : decltype(step)::value ;
+      for ( ptrdiff_t k = lower ? j+1 : 0 ; k < ( lower ? N : j ) ; ++k ) {
+        const auto akj = A(k,j);
+        for ( ptrdiff_t i = 0 ; i < M ; ++i ) b[i][j] -= b[i][k] * akj;
+      }
+      if constexpr ( explicit_diag ) {
+        const auto ajj = A(j,j);
+        for ( ptrdiff_t i = 0 ; i < M ; ++i ) b[i][j] = divide( b[i][j], ajj );
+      }
+    });
+  }
+
+  for ( ptrdiff_t i = 0 ; i < M ; ++i )
+    for ( ptrdiff_t j = 0 ; j < N ; ++j ) B(i,j) = b[i][j];
+}
+
+} // namespace detail
+
+}}}} // experimental::fundamentals_v3::linalg
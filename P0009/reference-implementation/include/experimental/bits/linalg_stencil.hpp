@@ -0,0 +1,372 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// Not part of P1673: stencils on grids of rank one to three.  A stencil
+// is a list of points, each an offset and a weight, and applying it is
+//
+//   out(i...) = sum over the points p of p.weight * in(i+p.offset...)
+//
+// for every index of out, summed in the order of the points.  in is read
+// up to radius() beyond out's extents, where a grid in layout_halo with
+// a halo of at least radius() holds its boundary values; a view of the
+// interior of a larger layout_right grid works as well.  The grids must
+// be strided and accessed through plain pointers.
+template<class T, size_t Rank>
+struct stencil_point {
+  array<ptrdiff_t,Rank> offset ;
+  T weight ;
+};
+
+template<class T, size_t Rank, size_t Points>
+struct stencil {
+  static_assert( 1 <= Rank && Rank <= 3, "stencils are of rank one to three" );
+
+  using value_type = T ;
+  static constexpr size_t rank() noexcept { return Rank ; }
+  static constexpr size_t size() noexcept { return Points ; }
+
+  array<stencil_point<T,Rank>,Points> points ;
+
+  // The largest offset along any extent.
+  constexpr ptrdiff_t radius() const noexcept
+    {
+      ptrdiff_t r = 0 ;
+      for ( const stencil_point<T,Rank> & p : points )
+        for ( const ptrdiff_t d : p.offset ) r = d < -r ? -d : ( r < d ? d : r );
+      return r ;
+    }
+};
+
+// center * u(i,j,k) + neighbor * (sum of the six face neighbors)
+template<class T>
+constexpr stencil<T,3,7> seven_point_stencil( const T center, const T neighbor ) noexcept ;
+
+// center, face, edge and corner weight the 1, 6, 12 and 8 points of the
+// 3x3x3 cube that are 0, 1, 2 and 3 steps from its center.
+template<class T>
+constexpr stencil<T,3,27> twenty_seven_point_stencil( const T center, const T face, const T edge, const T corner ) noexcept ;
+
+// out = S in.  out must not overlap in.
+template<class Stencil, class InGrid, class OutGrid>
+void stencil_apply( const Stencil & s, InGrid in, OutGrid out );
+
+template<class ExecutionPolicy, class Stencil, class InGrid, class OutGrid>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+stencil_apply( ExecutionPolicy && exec, const Stencil & s, InGrid in, OutGrid out );
+
+// u = S^steps u, using tmp, a grid with u's extents whose
+// ghost cells hold the same boundary values as u's, for the steps in
+// between; the interior of tmp is overwritten.  Steps are applied
+// several at a time in a wavefront over the grid (temporal blocking), so
+// that a block of the grid is brought into cache once for all of them.
+// An odd number of steps ends with a copy from tmp to u.
+template<class Stencil, class InOutGrid, class Grid>
+void stencil_sweep( const Stencil & s, const ptrdiff_t steps, InOutGrid u, Grid tmp );
+
+template<class ExecutionPolicy, class Stencil, class InOutGrid, class Grid>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+stencil_sweep( ExecutionPolicy && exec, const Stencil & s, const ptrdiff_t steps, InOutGrid u, Grid tmp );
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// The engine sees every grid as rank three, a grid of lower rank having
+// leading extents of one, and computes one row (the last extent) at a
+// time.  A pass applies up to time_steps steps to the grid: it cuts the
+// second extent into tiles of rows, and each tile sweeps a wavefront
+// along the first extent, at position w computing plane w - t r of step
+// t for every step t of the pass, where r is the radius.  Step t of a
+// tile covers the tile's rows shifted back by t r, so that everything it
+// reads from step t-1 has been computed by this tile or the ones before
+// it.  With the shifts, step t of any tile only overwrites values of step
+// t-2 that no step t-1 still has to read, and two buffers suffice.
+//
+// Tiles are handed to the threads round robin; a tile at wavefront
+// position w waits until the tile before it has finished position w.
+struct stencil_blocking {
+  // Steps per pass.
+  static constexpr ptrdiff_t time_steps = 4 ;
+  // Bytes of the planes of one tile that a pass keeps in flight.
+  static constexpr ptrdiff_t tile_bytes = 1024 * 1024 ;
+};
+
+// A grid as the engine sees it: its first interior element and the
+// strides of its three extents.
+template<class T>
+struct stencil_grid {
+  T * p ;
+  ptrdiff_t stride[3] ;
+};
+
+template<class Grid>
+stencil_grid<typename Grid::element_type> make_stencil_grid( const Grid & x ) noexcept {
+  static_assert( Grid::is_always_strided(), "stencils require strided grids" );
+  static_assert( is_same<typename Grid::pointer,typename Grid::element_type *>::value,
+                 "stencils read and write grids through plain pointers" );
+  constexpr size_t rank = Grid::rank();
+  static_assert( 1 <= rank && rank <= 3, "stencils are of rank one to three" );
+  stencil_grid<typename Grid::element_type> g = { x.data(), { 0 , 0 , 0 } };
+  if constexpr ( rank == 1 ) g.p += x.mapping()( 0 );
+  else if constexpr ( rank == 2 ) g.p += x.mapping()( 0, 0 );
+  else g.p += x.mapping()( 0, 0, 0 );
+  for ( size_t r = 0 ; r < rank ; ++r ) g.stride[ 3 - rank + r ] = x.stride( r );
+  return g ;
+}
+
+// The extents of a grid as rank three.
+template<class Grid>
+array<ptrdiff_t,3> stencil_extents( const Grid & x ) noexcept {
+  constexpr size_t rank = Grid::rank();
+  array<ptrdiff_t,3> n = { 1 , 1 , 1 };
+  for ( size_t r = 0 ; r < rank ; ++r ) n[ 3 - rank + r ] = x.extent( r );
+  return n ;
+}
+
+// A stencil with its offsets into one grid folded into single offsets.
+template<class T, size_t Points>
+struct stencil_offsets {
+  T weight[Points] ;
+  ptrdiff_t offset[Points] ;
+};
+
+template<class T, size_t Rank, size_t Points, class U>
+stencil_offsets<T,Points> make_stencil_offsets( const stencil<T,Rank,Points> & s, const stencil_grid<U> & g ) noexcept {
+  stencil_offsets<T,Points> o ;
+  for ( size_t p = 0 ; p < Points ; ++p ) {
+    o.weight[p] = s.points[p].weight ;
+    o.offset[p] = 0 ;
+    for ( size_t r = 0 ; r < Rank ; ++r ) o.offset[p] += s.points[p].offset[r] * g.stride[ 3 - Rank + r ] ;
+  }
+  return o ;
+}
+
+// weight[0] * x[offset[0]] + weight[1] * x[offset[1]] + ..., unrolled.
+template<class T, size_t Points, class In, size_t ... P>
+auto stencil_point_sum( const stencil_offsets<T,Points> & s, const In * x, index_sequence<P...> ) noexcept {
+  return ( ... + ( s.weight[P] * x[ s.offset[P] ] ) );
+}
+
+// One row of n points: out[j] = sum over p of weight[p] * in[j+offset[p]].
+// The points are unrolled so that the loop over the row vectorizes.  The
+// compiler must then check at run time that out does not overlap any of
+// the points of in, and gives up beyond a handful of them (GCC stops at
+// ten checks), so larger stencils write a chunk of the row to a local
+// buffer first, which cannot overlap in.
+template<class T, size_t Points, class In, class Out>
+void stencil_row( const stencil_offsets<T,Points> s, const In * in, const ptrdiff_t in_stride,
+                  Out * out, const ptrdiff_t out_stride, const ptrdiff_t n ) noexcept {
+  if constexpr ( Points <= 8 ) {
+    if ( in_stride == 1 && out_stride == 1 ) {
+      for ( ptrdiff_t j = 0 ; j < n ; ++j ) out[j] = stencil_point_sum( s, in + j, make_index_sequence<Points>() );
+      return ;
+    }
+  }
+  typedef decltype( stencil_point_sum( s, in, make_index_sequence<Points>() ) ) sum_type ;
+  constexpr ptrdiff_t chunk = 64 ;
+  sum_type sum[chunk] ;
+  for ( ptrdiff_t j0 = 0 ; j0 < n ; j0 += chunk ) {
+    const ptrdiff_t m = chunk < n - j0 ? chunk : n - j0 ;
+    if ( in_stride == 1 ) {
+      for ( ptrdiff_t j = 0 ; j < m ; ++j ) sum[j] = stencil_point_sum( s, in + j0 + j, make_index_sequence<Points>() );
+    }
+    else {
+      for ( ptrdiff_t j = 0 ; j < m ; ++j )
+        sum[j] = stencil_point_sum( s, in + ( j0 + j ) * in_stride, make_index_sequence<Points>() );
+    }
+    for ( ptrdiff_t j = 0 ; j < m ; ++j ) out[ ( j0 + j ) * out_stride ] = sum[j] ;
+  }
+}
+
+// One pass of steps [first,first+steps) over the grid of extents n.
+// Step t reads in[t%2] and writes out[(t+1)%2].
+template<class T, size_t Rank, size_t Points, class In, class Out>
+void stencil_pass( const stencil<T,Rank,Points> & s, const array<ptrdiff_t,3> & n,
+                   const stencil_grid<In> in[2], const stencil_grid<Out> out[2],
+                   const ptrdiff_t first, const ptrdiff_t steps, const size_t num_threads ) {
+  const ptrdiff_t r = s.radius();
+  const stencil_offsets<T,Points> offsets[2] = { make_stencil_offsets( s, in[0] ), make_stencil_offsets( s, in[1] ) };
+
+  // Rows per tile: the planes of a tile in flight, about (steps+2) r + 1
+  // of both buffers, should fit in tile_bytes.
+  const ptrdiff_t planes = 2 * ( ( steps + 2 ) * r + 1 );
+  const ptrdiff_t row_bytes = n[2] * ptrdiff_t( sizeof( Out ) );
+  ptrdiff_t rows = stencil_blocking::tile_bytes / ( planes * row_bytes ) - steps * r ;
+  // At least two tiles per thread, to keep the pipeline busy.
+  if ( 1 < num_threads ) {
+    const ptrdiff_t share = n[1] / ptrdiff_t( 2 * num_threads );
+    if ( share < rows ) rows = share ;
+  }
+  if ( rows < 1 ) rows = 1 ;
+
+  const ptrdiff_t skew = ( steps - 1 ) * r ;
+  const ptrdiff_t tiles = ( n[1] + skew + rows - 1 ) / rows ;
+  const ptrdiff_t waves = n[0] + skew ;
+  unique_ptr<atomic<ptrdiff_t>[]> done( new atomic<ptrdiff_t>[ tiles ] );
+  for ( ptrdiff_t J = 0 ; J < tiles ; ++J ) done[J].store( 0, memory_order_relaxed );
+
+  thread_pool::instance().run( num_threads, [&]( const size_t rank, const size_t size, team_barrier & ) {
+    for ( ptrdiff_t J = ptrdiff_t( rank ) ; J < tiles ; J += ptrdiff_t( size ) ) {
+      for ( ptrdiff_t w = 0 ; w < waves ; ++w ) {
+        if ( 1 < size && 0 < J ) {
+          while ( done[J-1].load( memory_order_acquire ) <= w ) this_thread::yield();
+        }
+        for ( ptrdiff_t t = 0 ; t < steps ; ++t ) {
+          const ptrdiff_t i = w - t * r ;
+          if ( i < 0 ) break ;
+          if ( n[0] <= i ) continue ;
+          const ptrdiff_t j_begin = J * rows - t * r < 0 ? 0 : J * rows - t * r ;
+          const ptrdiff_t j_end = n[1] < ( J + 1 ) * rows - t * r ? n[1] : ( J + 1 ) * rows - t * r ;
+          const int b = int( ( first + t ) % 2 );
+          const stencil_grid<In> & src = in[b] ;
+          const stencil_grid<Out> & dst = out[1-b] ;
+          for ( ptrdiff_t j = j_begin ; j < j_end ; ++j ) {
+            stencil_row( offsets[b], src.p + i * src.stride[0] + j * src.stride[1], src.stride[2],
+                         dst.p + i * dst.stride[0] + j * dst.stride[1], dst.stride[2], n[2] );
+          }
+        }
+        if ( 1 < size ) done[J].store( w + 1, memory_order_release );
+      }
+    }
+  });
+}
+
+template<class Stencil, class InGrid, class OutGrid>
+void stencil_apply_dispatch( const Stencil & s, const InGrid & in, const OutGrid & out, const size_t num_threads ) {
+  static_assert( InGrid::rank() == Stencil::rank() && OutGrid::rank() == Stencil::rank(),
+                 "the grids must have the rank of the stencil" );
+  const array<ptrdiff_t,3> n = stencil_extents( out );
+  if ( n[0] == 0 || n[1] == 0 || n[2] == 0 ) return ;
+  const stencil_grid<typename InGrid::element_type> src[2] = { make_stencil_grid( in ), make_stencil_grid( in ) };
+  const stencil_grid<typename OutGrid::element_type> dst[2] = { make_stencil_grid( out ), make_stencil_grid( out ) };
+  stencil_pass( s, n, src, dst, 0, 1, num_threads );
+}
+
+template<class Stencil, class InOutGrid, class Grid>
+void stencil_sweep_dispatch( const Stencil & s, const ptrdiff_t steps, const InOutGrid & u, const Grid & tmp,
+                             const size_t num_threads ) {
+  static_assert( InOutGrid::rank() == Stencil::rank() && Grid::rank() == Stencil::rank(),
+                 "the grids must have the rank of the stencil" );
+  static_assert( is_same<typename InOutGrid::element_type,typename Grid::element_type>::value, "" );
+  typedef typename Grid::element_type element_type ;
+  const array<ptrdiff_t,3> n = stencil_extents( u );
+  if ( n[0] == 0 || n[1] == 0 || n[2] == 0 || steps < 1 ) return ;
+  const stencil_grid<element_type> g[2] = { make_stencil_grid( u ), make_stencil_grid( tmp ) };
+  const stencil_grid<const element_type> src[2] = { { g[0].p, { g[0].stride[0], g[0].stride[1], g[0].stride[2] } },
+                                                    { g[1].p, { g[1].stride[0], g[1].stride[1], g[1].stride[2] } } };
+  for ( ptrdiff_t t = 0 ; t < steps ; t += stencil_blocking::time_steps ) {
+    const ptrdiff_t pass = steps - t < stencil_blocking::time_steps ? steps - t : stencil_blocking::time_steps ;
+    stencil_pass( s, n, src, g, t, pass, num_threads );
+  }
+  if ( steps % 2 ) copy( tmp, u );
+}
+
+} // namespace detail
+
+template<class T>
+constexpr stencil<T,3,7> seven_point_stencil( const T center, const T neighbor ) noexcept {
+  return { { { { { 0 , 0 , 0 } , center },
+               { { -1 , 0 , 0 } , neighbor }, { { 1 , 0 , 0 } , neighbor },
+               { { 0 , -1 , 0 } , neighbor }, { { 0 , 1 , 0 } , neighbor },
+               { { 0 , 0 , -1 } , neighbor }, { { 0 , 0 , 1 } , neighbor } } } };
+}
+
+template<class T>
+constexpr stencil<T,3,27> twenty_seven_point_stencil( const T center, const T face, const T edge, const T corner ) noexcept {
+  stencil<T,3,27> s = {};
+  const T weight[4] = { center , face , edge , corner };
+  size_t p = 0 ;
+  for ( ptrdiff_t i = -1 ; i <= 1 ; ++i )
+  for ( ptrdiff_t j = -1 ; j <= 1 ; ++j )
+  for ( ptrdiff_t k = -1 ; k <= 1 ; ++k ) {
+    s.points[p].offset = { i , j , k };
+    s.points[p].weight = weight[ ( i != 0 ) + ( j != 0 ) + ( k != 0 ) ];
+    ++p ;
+  }
+  return s ;
+}
+
+template<class Stencil, class InGrid, class OutGrid>
+void stencil_apply( const Stencil & s, InGrid in, OutGrid out ) {
+  detail::stencil_apply_dispatch( s, in, out, 1 );
+}
+
+template<class ExecutionPolicy, class Stencil, class InGrid, class OutGrid>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+stencil_apply( ExecutionPolicy && exec, const Stencil & s, InGrid in, OutGrid out ) {
+  detail::stencil_apply_dispatch( s, in, out, detail::execution_policy_threads( exec ) );
+}
+
+template<class Stencil, class InOutGrid, class Grid>
+void stencil_sweep( const Stencil & s, const ptrdiff_t steps, InOutGrid u, Grid tmp ) {
+  detail::stencil_sweep_dispatch( s, steps, u, tmp, 1 );
+}
+
+template<class ExecutionPolicy, class Stencil, class InOutGrid, class Grid>
+enable_if_t<detail::is_linalg_execution_policy_v<ExecutionPolicy>>
+stencil_sweep( ExecutionPolicy && exec, const Stencil & s, const ptrdiff_t steps, InOutGrid u, Grid tmp ) {
+  detail::stencil_sweep_dispatch( s, steps, u, tmp, detail::execution_policy_threads( exec ) );
+}
+
+}}}} // experimental::fundamentals_v3::linalg
@@ -0,0 +1,149 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <complex>
+#include <type_traits>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+
+// [linalg.tags.order]
+struct column_major_t { explicit column_major_t() = default; };
+inline constexpr column_major_t column_major{};
+struct row_major_t { explicit row_major_t() = default; };
+inline constexpr row_major_t row_major{};
+
+// [linalg.tags.triangle]
+struct upper_triangle_t { explicit upper_triangle_t() = default; };
+inline constexpr upper_triangle_t upper_triangle{};
+struct lower_triangle_t { explicit lower_triangle_t() = default; };
+inline constexpr lower_triangle_t lower_triangle{};
+
+// [linalg.tags.diagonal]
+struct implicit_unit_diagonal_t { explicit implicit_unit_diagonal_t() = default; };
+inline constexpr implicit_unit_diagonal_t implicit_unit_diagonal{};
+struct explicit_diagonal_t { explicit explicit_diagonal_t() = default; };
+inline constexpr explicit_diagonal_t explicit_diagonal{};
+
+// [linalg.tags.side]
+struct left_side_t { explicit left_side_t() = default; };
+inline constexpr left_side_t left_side{};
+struct right_side_t { explicit right_side_t() = default; };
+inline constexpr right_side_t right_side{};
+
+// Not part of P1673: promise that no intermediate result can over- or
+// underflow, which lets algorithms such as vector_two_norm skip scaling.
+struct bounded_values_t { explicit bounded_values_t() = default; };
+inline constexpr bounded_values_t bounded_values{};
+
+// Not part of P1673: the type T in which matrix_product sums its
+// products, when it should be wider than the output's value type (for
+// example float matrices summed in double).  dot takes it from init.
+template<class T>
+struct accumulator_t { explicit accumulator_t() = default; };
+template<class T>
+inline constexpr accumulator_t<T> accumulator{};
+
+}}}} // experimental::fundamentals_v3::linalg
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+// [linalg.helpers]
+
+template<class T>
+struct is_mdspan : false_type {};
+
+template<class ElementType, class Extents, class LayoutPolicy, class AccessorPolicy>
+struct is_mdspan<basic_mdspan<ElementType,Extents,LayoutPolicy,AccessorPolicy>> : true_type {};
+
+template<class T>
+struct is_complex : false_type {};
+
+template<class T>
+struct is_complex<complex<T>> : true_type {};
+
+template<class T>
+constexpr auto conj_if_needed( const T & t ) {
+  if constexpr ( is_complex<T>::value ) return conj(t);
+  else return t;
+}
+
+template<class T>
+constexpr auto real_if_needed( const T & t ) {
+  if constexpr ( is_complex<T>::value ) return T(real(t));
+  else return t;
+}
+
+template<class T>
+constexpr auto abs_if_needed( const T & t ) {
+  if constexpr ( is_unsigned<T>::value ) return t;
+  else { using std::abs; return abs(t); }
+}
+
+// a * b as an Accum.  If Accum is wider than the product's own type, a
+// and b are converted first, so that the product is not rounded to the
+// narrower type before it is summed.
+template<class Accum, class A, class B>
+constexpr Accum product_as( const A & a, const B & b ) {
+  typedef decltype( a * b ) product_type;
+  if constexpr ( ! is_same<product_type,Accum>::value &&
+                 is_same<common_type_t<product_type,Accum>,Accum>::value &&
+                 is_constructible<Accum,A>::value && is_constructible<Accum,B>::value )
+    return Accum( a ) * Accum( b );
+  else return Accum( a * b );
+}
+
+} // namespace detail
+}}}} // experimental::fundamentals_v3::linalg
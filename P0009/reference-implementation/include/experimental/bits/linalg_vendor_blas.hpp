@@ -0,0 +1,438 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include <complex>
+#include <functional>
+#include <limits>
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+// Not part of P1673: when MDSPAN_LINALG_USE_BLAS is defined (CMake's
+// MDSPAN_ENABLE_BLAS option does so if it finds a BLAS), the algorithms
+// hand float, double, complex<float> and complex<double> operands with
+// BLAS-compatible layouts to the Fortran 77 BLAS.  The routines are
+// declared here rather than through a vendor header; LP64 integers and
+// the gfortran calling convention are assumed.
+
+#ifdef MDSPAN_LINALG_USE_BLAS
+
+extern "C" {
+
+void sgemm_( const char * transa, const char * transb, const int * m, const int * n, const int * k,
+             const float * alpha, const float * a, const int * lda, const float * b, const int * ldb,
+             const float * beta, float * c, const int * ldc );
+void dgemm_( const char * transa, const char * transb, const int * m, const int * n, const int * k,
+             const double * alpha, const double * a, const int * lda, const double * b, const int * ldb,
+             const double * beta, double * c, const int * ldc );
+void cgemm_( const char * transa, const char * transb, const int * m, const int * n, const int * k,
+             const std::complex<float> * alpha, const std::complex<float> * a, const int * lda,
+             const std::complex<float> * b, const int * ldb,
+             const std::complex<float> * beta, std::complex<float> * c, const int * ldc );
+void zgemm_( const char * transa, const char * transb, const int * m, const int * n, const int * k,
+             const std::complex<double> * alpha, const std::complex<double> * a, const int * lda,
+             const std::complex<double> * b, const int * ldb,
+             const std::complex<double> * beta, std::complex<double> * c, const int * ldc );
+
+void sgemv_( const char * trans, const int * m, const int * n,
+             const float * alpha, const float * a, const int * lda, const float * x, const int * incx,
+             const float * beta, float * y, const int * incy );
+void dgemv_( const char * trans, const int * m, const int * n,
+             const double * alpha, const double * a, const int * lda, const double * x, const int * incx,
+             const double * beta, double * y, const int * incy );
+void cgemv_( const char * trans, const int * m, const int * n,
+             const std::complex<float> * alpha, const std::complex<float> * a, const int * lda,
+             const std::complex<float> * x, const int * incx,
+             const std::complex<float> * beta, std::complex<float> * y, const int * incy );
+void zgemv_( const char * trans, const int * m, const int * n,
+             const std::complex<double> * alpha, const std::complex<double> * a, const int * lda,
+             const std::complex<double> * x, const int * incx,
+             const std::complex<double> * beta, std::complex<double> * y, const int * incy );
+
+void strsm_( const char * side, const char * uplo, const char * transa, const char * diag,
+             const int * m, const int * n, const float * alpha,
+             const float * a, const int * lda, float * b, const int * ldb );
+void dtrsm_( const char * side, const char * uplo, const char * transa, const char * diag,
+             const int * m, const int * n, const double * alpha,
+             const double * a, const int * lda, double * b, const int * ldb );
+void ctrsm_( const char * side, const char * uplo, const char * transa, const char * diag,
+             const int * m, const int * n, const std::complex<float> * alpha,
+             const std::complex<float> * a, const int * lda, std::complex<float> * b, const int * ldb );
+void ztrsm_( const char * side, const char * uplo, const char * transa, const char * diag,
+             const int * m, const int * n, const std::complex<double> * alpha,
+             const std::complex<double> * a, const int * lda, std::complex<double> * b, const int * ldb );
+
+void strsv_( const char * uplo, const char * trans, const char * diag, const int * n,
+             const float * a, const int * lda, float * x, const int * incx );
+void dtrsv_( const char * uplo, const char * trans, const char * diag, const int * n,
+             const double * a, const int * lda, double * x, const int * incx );
+void ctrsv_( const char * uplo, const char * trans, const char * diag, const int * n,
+             const std::complex<float> * a, const int * lda, std::complex<float> * x, const int * incx );
+void ztrsv_( const char * uplo, const char * trans, const char * diag, const int * n,
+             const std::complex<double> * a, const int * lda, std::complex<double> * x, const int * incx );
+
+float  sdot_( const int * n, const float * x, const int * incx, const float * y, const int * incy );
+double ddot_( const int * n, const double * x, const int * incx, const double * y, const int * incy );
+double dsdot_( const int * n, const float * x, const int * incx, const float * y, const int * incy );
+
+} // extern "C"
+
+#endif
+
+//--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+namespace linalg {
+namespace detail {
+
+#ifdef MDSPAN_LINALG_USE_BLAS
+inline constexpr bool vendor_blas_enabled = true ;
+#else
+inline constexpr bool vendor_blas_enabled = false ;
+#endif
+
+template<class T>
+struct is_blas_value_type
+  : integral_constant<bool, vendor_blas_enabled &&
+                            ( is_same<T,float>::value || is_same<T,double>::value ||
+                              is_same<T,complex<float>>::value || is_same<T,complex<double>>::value )> {};
+
+template<class Layout>
+struct is_blas_layout
+  : integral_constant<bool, is_same<Layout,layout_left>::value || is_same<Layout,layout_right>::value ||
+                            is_same<Layout,layout_stride>::value ||
+                            experimental::detail::is_layout_left_padded<Layout>::value ||
+                            experimental::detail::is_layout_right_padded<Layout>::value> {};
+
+template<class Accessor>
+struct is_conjugated_accessor : false_type {};
+
+template<class NestedAccessor>
+struct is_conjugated_accessor<conjugated_accessor<NestedAccessor>> : true_type {};
+
+// True if the BLAS can read the matrix or vector M, possibly conjugated,
+// in place as an array of T.
+template<class T, class M, size_t Rank = 2>
+struct is_blas_input
+  : integral_constant<bool, is_mdspan<M>::value && M::rank() == Rank &&
+                            is_blas_value_type<T>::value && is_blas_layout<typename M::layout_type>::value &&
+                            is_same<typename M::value_type,T>::value &&
+                            ( is_same<typename M::accessor_type,accessor_basic<typename M::element_type>>::value ||
+                              is_same<typename M::accessor_type,conjugated_accessor<accessor_basic<const T>>>::value ||
+                              is_same<typename M::accessor_type,conjugated_accessor<accessor_basic<T>>>::value )> {};
+
+// True if the BLAS can overwrite M in place as an array of T.
+template<class T, class M, size_t Rank = 2>
+struct is_blas_output
+  : integral_constant<bool, is_blas_input<T,M,Rank>::value &&
+                            is_same<typename M::accessor_type,accessor_basic<T>>::value> {};
+
+// A rows x cols matrix with the given strides, described to the BLAS as
+// op(M) for a column-major M with leading dimension ld: op is 'N' if the
+// matrix is stored by columns, 'T' (or 'C' if it is to be conjugated) if
+// it is stored by rows.  A conjugated matrix stored by columns has no
+// such description.
+struct blas_matrix_operand {
+  bool ok ;
+  char trans ;
+  int  ld ;
+};
+
+inline blas_matrix_operand make_blas_matrix_operand( const ptrdiff_t rows, const ptrdiff_t cols,
+                                                     const ptrdiff_t row_stride, const ptrdiff_t col_stride,
+                                                     const bool conj ) noexcept {
+  constexpr ptrdiff_t max_int = numeric_limits<int>::max();
+  const ptrdiff_t min_rows = rows > 1 ? rows : 1 ;
+  const ptrdiff_t min_cols = cols > 1 ? cols : 1 ;
+  if ( rows <= max_int && cols <= max_int ) {
+    if ( ! conj && row_stride == 1 ) {
+      const ptrdiff_t ld = cols > 1 ? col_stride : min_rows ;
+      if ( min_rows <= ld && ld <= max_int ) return { true, 'N', int( ld ) };
+    }
+    if ( col_stride == 1 ) {
+      const ptrdiff_t ld = rows > 1 ? row_stride : min_cols ;
+      if ( min_cols <= ld && ld <= max_int ) return { true, conj ? 'C' : 'T', int( ld ) };
+    }
+  }
+  return { false, 'N', 0 };
+}
+
+// Increment of a vector of length n with the given stride, or 0 if the
+// BLAS cannot take it.
+inline int blas_increment( const ptrdiff_t n, const ptrdiff_t stride ) noexcept {
+  if ( n > numeric_limits<int>::max() ) return 0 ;
+  if ( n <= 1 ) return 1 ;
+  return 1 <= stride && stride <= numeric_limits<int>::max() ? int( stride ) : 0 ;
+}
+
+template<class T, class Scale>
+constexpr T blas_scalar( const Scale & alpha ) {
+  if constexpr ( is_same<Scale,no_scaling>::value ) return T( 1 );
+  else return T( alpha );
+}
+
+template<class T, class Scale>
+struct is_blas_scalar
+  : integral_constant<bool, is_same<Scale,no_scaling>::value || is_convertible<Scale,T>::value> {};
+
+#ifdef MDSPAN_LINALG_USE_BLAS
+
+inline void blas_gemm( char ta, char tb, int m, int n, int k, float alpha, const float * a, int lda,
+                       const float * b, int ldb, float beta, float * c, int ldc )
+  { sgemm_( &ta, &tb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc ); }
+inline void blas_gemm( char ta, char tb, int m, int n, int k, double alpha, const double * a, int lda,
+                       const double * b, int ldb, double beta, double * c, int ldc )
+  { dgemm_( &ta, &tb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc ); }
+inline void blas_gemm( char ta, char tb, int m, int n, int k, complex<float> alpha, const complex<float> * a, int lda,
+                       const complex<float> * b, int ldb, complex<float> beta, complex<float> * c, int ldc )
+  { cgemm_( &ta, &tb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc ); }
+inline void blas_gemm( char ta, char tb, int m, int n, int k, complex<double> alpha, const complex<double> * a, int lda,
+                       const complex<double> * b, int ldb, complex<double> beta, complex<double> * c, int ldc )
+  { zgemm_( &ta, &tb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c, &ldc ); }
+
+inline void blas_gemv( char t, int m, int n, float alpha, const float * a, int lda,
+                       const float * x, int incx, float beta, float * y, int incy )
+  { sgemv_( &t, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy ); }
+inline void blas_gemv( char t, int m, int n, double alpha, const double * a, int lda,
+                       const double * x, int incx, double beta, double * y, int incy )
+  { dgemv_( &t, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy ); }
+inline void blas_gemv( char t, int m, int n, complex<float> alpha, const complex<float> * a, int lda,
+                       const complex<float> * x, int incx, complex<float> beta, complex<float> * y, int incy )
+  { cgemv_( &t, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy ); }
+inline void blas_gemv( char t, int m, int n, complex<double> alpha, const complex<double> * a, int lda,
+                       const complex<double> * x, int incx, complex<double> beta, complex<double> * y, int incy )
+  { zgemv_( &t, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy ); }
+
+inline void blas_trsm( char side, char uplo, char ta, char diag, int m, int n,
+                       const float * a, int lda, float * b, int ldb )
+  { const float one = 1 ; strsm_( &side, &uplo, &ta, &diag, &m, &n, &one, a, &lda, b, &ldb ); }
+inline void blas_trsm( char side, char uplo, char ta, char diag, int m, int n,
+                       const double * a, int lda, double * b, int ldb )
+  { const double one = 1 ; dtrsm_( &side, &uplo, &ta, &diag, &m, &n, &one, a, &lda, b, &ldb ); }
+inline void blas_trsm( char side, char uplo, char ta, char diag, int m, int n,
+                       const complex<float> * a, int lda, complex<float> * b, int ldb )
+  { const complex<float> one = 1 ; ctrsm_( &side, &uplo, &ta, &diag, &m, &n, &one, a, &lda, b, &ldb ); }
+inline void blas_trsm( char side, char uplo, char ta, char diag, int m, int n,
+                       const complex<double> * a, int lda, complex<double> * b, int ldb )
+  { const complex<double> one = 1 ; ztrsm_( &side, &uplo, &ta, &diag, &m, &n, &one, a, &lda, b, &ldb ); }
+
+inline void blas_trsv( char uplo, char t, char diag, int n, const float * a, int lda, float * x, int incx )
+  { strsv_( &uplo, &t, &diag, &n, a, &lda, x, &incx ); }
+inline void blas_trsv( char uplo, char t, char diag, int n, const double * a, int lda, double * x, int incx )
+  { dtrsv_( &uplo, &t, &diag, &n, a, &lda, x, &incx ); }
+inline void blas_trsv( char uplo, char t, char diag, int n, const complex<float> * a, int lda, complex<float> * x, int incx )
+  { ctrsv_( &uplo, &t, &diag, &n, a, &lda, x, &incx ); }
+inline void blas_trsv( char uplo, char t, char diag, int n, const complex<double> * a, int lda, complex<double> * x, int incx )
+  { ztrsv_( &uplo, &t, &diag, &n, a, &lda, x, &incx ); }
+
+inline float blas_dot( int n, const float * x, int incx, const float * y, int incy )
+  { return sdot_( &n, x, &incx, y, &incy ); }
+inline double blas_dot( int n, const double * x, int incx, const double * y, int incy )
+  { return ddot_( &n, x, &incx, y, &incy ); }
+// Float vectors, summed in double.
+inline double blas_dsdot( int n, const float * x, int incx, const float * y, int incy )
+  { return dsdot_( &n, x, &incx, y, &incy ); }
+
+// C = alpha A B, or C += alpha A B if accumulate, through xGEMM.  Returns
+// false, doing nothing, unless the BLAS can take all three operands.
+// A C stored by rows is computed as C^T = B^T A^T.
+template<class InMat1, class InMat2, class OutMat, class Scale>
+bool vendor_matrix_product( const InMat1 & A, const InMat2 & B, const OutMat & C,
+                            const bool accumulate, const Scale alpha ) {
+  typedef typename OutMat::value_type T;
+  if constexpr ( is_blas_input<T,InMat1>::value && is_blas_input<T,InMat2>::value &&
+                 is_blas_output<T,OutMat>::value && is_blas_scalar<T,Scale>::value ) {
+    constexpr bool conj_a = is_conjugated_accessor<typename InMat1::accessor_type>::value;
+    constexpr bool conj_b = is_conjugated_accessor<typename InMat2::accessor_type>::value;
+    const ptrdiff_t m = C.extent(0);
+    const ptrdiff_t n = C.extent(1);
+    const ptrdiff_t k = A.extent(1);
+    if ( k > numeric_limits<int>::max() ) return false ;
+    const T a = blas_scalar<T>( alpha );
+    const T beta = accumulate ? T( 1 ) : T( 0 );
+
+    const blas_matrix_operand c = make_blas_matrix_operand( m, n, C.stride(0), C.stride(1), false );
+    if ( ! c.ok ) return false ;
+    if ( c.trans == 'N' ) {
+      const blas_matrix_operand opa = make_blas_matrix_operand( m, k, A.stride(0), A.stride(1), conj_a );
+      const blas_matrix_operand opb = make_blas_matrix_operand( k, n, B.stride(0), B.stride(1), conj_b );
+      if ( ! opa.ok || ! opb.ok ) return false ;
+      blas_gemm( opa.trans, opb.trans, int( m ), int( n ), int( k ), a, A.data(), opa.ld,
+                 B.data(), opb.ld, beta, C.data(), c.ld );
+    }
+    else {
+      const blas_matrix_operand opb = make_blas_matrix_operand( n, k, B.stride(1), B.stride(0), conj_b );
+      const blas_matrix_operand opa = make_blas_matrix_operand( k, m, A.stride(1), A.stride(0), conj_a );
+      if ( ! opa.ok || ! opb.ok ) return false ;
+      blas_gemm( opb.trans, opa.trans, int( n ), int( m ), int( k ), a, B.data(), opb.ld,
+                 A.data(), opa.ld, beta, C.data(), c.ld );
+    }
+    return true ;
+  }
+  return false ;
+}
+
+// y += alpha A x through xGEMV.
+template<class InMat, class InVec, class OutVec, class Scale>
+bool vendor_matrix_vector_update( const InMat & A, const InVec & x, const OutVec & y, const Scale alpha ) {
+  typedef typename OutVec::value_type T;
+  if constexpr ( is_blas_input<T,InMat>::value && is_blas_input<T,InVec,1>::value &&
+                 ! is_conjugated_accessor<typename InVec::accessor_type>::value &&
+                 is_blas_output<T,OutVec,1>::value && is_blas_scalar<T,Scale>::value ) {
+    constexpr bool conj_a = is_conjugated_accessor<typename InMat::accessor_type>::value;
+    const ptrdiff_t m = A.extent(0);
+    const ptrdiff_t n = A.extent(1);
+    const blas_matrix_operand opa = make_blas_matrix_operand( m, n, A.stride(0), A.stride(1), conj_a );
+    const int incx = blas_increment( n, x.stride(0) );
+    const int incy = blas_increment( m, y.stride(0) );
+    if ( ! opa.ok || ! incx || ! incy ) return false ;
+    // xGEMV's m x n is the stored matrix, which is A^T for 'T' and 'C'.
+    const bool stored = opa.trans == 'N' ;
+    blas_gemv( opa.trans, int( stored ? m : n ), int( stored ? n : m ), blas_scalar<T>( alpha ),
+               A.data(), opa.ld, x.data(), incx, T( 1 ), y.data(), incy );
+    return true ;
+  }
+  return false ;
+}
+
+// Solves A X = B (Left) or X A = B in place in B through xTRSM.  A B
+// stored by rows is solved as the transposed system in B^T.
+template<bool Left, class InMat, class Triangle, class DiagonalStorage, class InOutMat, class BinaryDivideOp>
+bool vendor_triangular_matrix_matrix_solve( const InMat & A, Triangle, DiagonalStorage,
+                                            const InOutMat & B, BinaryDivideOp ) {
+  typedef typename InOutMat::value_type T;
+  if constexpr ( is_blas_input<T,InMat>::value && is_blas_output<T,InOutMat>::value &&
+                 is_same<BinaryDivideOp,divides<>>::value ) {
+    constexpr bool conj_a = is_conjugated_accessor<typename InMat::accessor_type>::value;
+    constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+    const char diag = is_same<DiagonalStorage,explicit_diagonal_t>::value ? 'N' : 'U' ;
+    const ptrdiff_t n = A.extent(0);
+    const blas_matrix_operand b = make_blas_matrix_operand( B.extent(0), B.extent(1), B.stride(0), B.stride(1), false );
+    if ( ! b.ok ) return false ;
+    // op(A) is A itself, or A^T when B is stored by rows.
+    const bool by_columns = b.trans == 'N' ;
+    const blas_matrix_operand opa = by_columns
+      ? make_blas_matrix_operand( n, n, A.stride(0), A.stride(1), conj_a )
+      : make_blas_matrix_operand( n, n, A.stride(1), A.stride(0), conj_a );
+    if ( ! opa.ok ) return false ;
+    const bool op_lower = by_columns == lower ;
+    // The stored matrix of a 'T' or 'C' operand holds the other triangle.
+    const char uplo = ( opa.trans == 'N' ) == op_lower ? 'L' : 'U' ;
+    const char side = Left == by_columns ? 'L' : 'R' ;
+    const ptrdiff_t rows = by_columns ? B.extent(0) : B.extent(1);
+    const ptrdiff_t cols = by_columns ? B.extent(1) : B.extent(0);
+    blas_trsm( side, uplo, opa.trans, diag, int( rows ), int( cols ), A.data(), opa.ld, B.data(), b.ld );
+    return true ;
+  }
+  return false ;
+}
+
+// Overwrites x with the solution of T x = x through xTRSV.
+template<class InMat, class Triangle, class DiagonalStorage, class InOutVec, class BinaryDivideOp>
+bool vendor_triangular_solve_in_place( const InMat & A, Triangle, DiagonalStorage,
+                                       const InOutVec & x, BinaryDivideOp ) {
+  typedef typename InOutVec::value_type T;
+  if constexpr ( is_blas_input<T,InMat>::value && is_blas_output<T,InOutVec,1>::value &&
+                 is_same<BinaryDivideOp,divides<>>::value ) {
+    constexpr bool conj_a = is_conjugated_accessor<typename InMat::accessor_type>::value;
+    constexpr bool lower = is_same<Triangle,lower_triangle_t>::value;
+    const char diag = is_same<DiagonalStorage,explicit_diagonal_t>::value ? 'N' : 'U' ;
+    const ptrdiff_t n = A.extent(0);
+    const blas_matrix_operand opa = make_blas_matrix_operand( n, n, A.stride(0), A.stride(1), conj_a );
+    const int incx = blas_increment( n, x.stride(0) );
+    if ( ! opa.ok || ! incx ) return false ;
+    const char uplo = ( opa.trans == 'N' ) == lower ? 'L' : 'U' ;
+    blas_trsv( uplo, opa.trans, diag, int( n ), A.data(), opa.ld, x.data(), incx );
+    return true ;
+  }
+  return false ;
+}
+
+// result = init + alpha dot( x, y ) through xDOT, or DSDOT for float
+// vectors summed in double, for real vectors only: returning complex
+// results from Fortran is not portable.
+template<class InVec1, class InVec2, class Scale, class Scalar>
+bool vendor_dot( const InVec1 & x, const InVec2 & y, const Scale alpha, Scalar & result ) {
+  constexpr bool same = ( is_same<Scalar,float>::value || is_same<Scalar,double>::value ) &&
+                        is_blas_input<Scalar,InVec1,1>::value && is_blas_input<Scalar,InVec2,1>::value ;
+  constexpr bool widened = is_same<Scalar,double>::value &&
+                           is_blas_input<float,InVec1,1>::value && is_blas_input<float,InVec2,1>::value ;
+  if constexpr ( ( same || widened ) && is_blas_scalar<Scalar,Scale>::value ) {
+    const ptrdiff_t n = x.extent(0);
+    const int incx = blas_increment( n, x.stride(0) );
+    const int incy = blas_increment( n, y.stride(0) );
+    if ( ! incx || ! incy ) return false ;
+    if constexpr ( widened )
+      result += blas_scalar<Scalar>( alpha ) * blas_dsdot( int( n ), x.data(), incx, y.data(), incy );
+    else
+      result += blas_scalar<Scalar>( alpha ) * blas_dot( int( n ), x.data(), incx, y.data(), incy );
+    return true ;
+  }
+  return false ;
+}
+
+#else
+
+template<class... Args>
+constexpr bool vendor_matrix_product( const Args & ... ) noexcept { return false ; }
+
+template<class... Args>
+constexpr bool vendor_matrix_vector_update( const Args & ... ) noexcept { return false ; }
+
+template<bool Left, class... Args>
+constexpr bool vendor_triangular_matrix_matrix_solve( const Args & ... ) noexcept { return false ; }
+
+template<class... Args>
+constexpr bool vendor_triangular_solve_in_place( const Args & ... ) noexcept { return false ; }
+
+template<class... Args>
+constexpr bool vendor_dot( const Args & ... ) noexcept { return false ; }
+
+#endif
+
+} // namespace detail
+}}}} // experimental::fundamentals_v3::linalg
@@ -44,11 +44,80 @@
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
+namespace std {
+namespace experimental {
+inline namespace fundamentals_v3 {
+
+// [mdspan.submdspan.strided_slice]
+
+// Selects the indices offset, offset+stride, ... in [offset, offset+extent).
+// Each member may be an integer or an integral_constant.
+template<class OffsetType, class ExtentType, class StrideType>
+struct strided_slice {
+  using offset_type = OffsetType;
+  using extent_type = ExtentType;
+  using stride_type = StrideType;
+
+  OffsetType offset{};
+  ExtentType extent{};
+  StrideType stride{};
+};
+
+template<class OffsetType, class ExtentType, class StrideType>
+strided_slice(OffsetType, ExtentType, StrideType) -> strided_slice<OffsetType, ExtentType, StrideType>;
+
+// [mdspan.submdspan.submdspan_mapping_result]
+
+// Returned by submdspan_mapping: the sub mapping and the offset of
+// its first element in the codomain of the source mapping.
+template<class LayoutMapping>
+struct submdspan_mapping_result {
+  LayoutMapping mapping = LayoutMapping();
+  size_t offset{};
+};
+
+}}} // experimental::fundamentals_v3
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
 namespace std {
 namespace experimental {
 inline namespace fundamentals_v3 {
 namespace detail {
 
+template<class T>
+struct is_integral_constant : false_type {};
+
+template<class T, T Value>
+struct is_integral_constant<integral_constant<T,Value>> : true_type {};
+
+// Strip integral_constant down to its value
+template<class T>
+constexpr ptrdiff_t de_ice(const T val) { return ptrdiff_t(val); }
+
+template<class T, T Value>
+constexpr ptrdiff_t de_ice(integral_constant<T,Value>) { return ptrdiff_t(Value); }
+
+// Number of indices selected by a strided_slice
+constexpr ptrdiff_t strided_slice_extent(const ptrdiff_t extent, const ptrdiff_t stride) {
+  return extent == 0 ? 0 : 1 + (extent - 1) / stride;
+}
+
+// The sub extent is static if the slice's extent is a static zero,
+// or if both its extent and its stride are static.
+template<class ExtentType, class StrideType>
+struct strided_slice_static_extent {
+  static constexpr ptrdiff_t value = dynamic_extent;
+};
+
+template<class T, T Extent, class StrideType>
+struct strided_slice_static_extent<integral_constant<T,Extent>,StrideType> {
+  static constexpr ptrdiff_t value = Extent == 0 ? ptrdiff_t(0) :
+    is_integral_constant<StrideType>::value ? strided_slice_extent(Extent,de_ice(StrideType())) :
+    ptrdiff_t(dynamic_extent);
+};
+
 template<class ExtentsNew, class ExtentsOld, class ... SliceSpecifiers>
 struct compose_new_extents;
 
@@ -93,6 +162,29 @@ struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,pair
   }
 };
 
+template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class OT, class ET, class ST, class ... SliceSpecifiers>
+struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,strided_slice<OT,ET,ST>,SliceSpecifiers...> {
+  static constexpr ptrdiff_t sub_static_extent = strided_slice_static_extent<ET,ST>::value;
+  typedef compose_new_extents<extents<ExtentsNew...,sub_static_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+  typedef typename next_compose_new_extents::extents_type extents_type;
+
+  template<class OrgExtents, class ... DynamicExtents>
+  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
+                                                   strided_slice<OT,ET,ST> p, SliceSpecifiers ... s, DynamicExtents...de) {
+    const ptrdiff_t org_stride = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+    const ptrdiff_t slice_extent = de_ice(p.extent);
+    const ptrdiff_t slice_stride = de_ice(p.stride);
+    // A stride not smaller than the extent selects at most one index,
+    // so keep the original stride in that case.
+    strides[sizeof...(ExtentsNew)] = slice_stride < slice_extent ? org_stride*slice_stride : org_stride;
+    offset += de_ice(p.offset)*org_stride;
+    if constexpr (sub_static_extent == dynamic_extent)
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,strided_slice_extent(slice_extent,slice_stride));
+    else
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
+  }
+};
+
 template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
 struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,IT,SliceSpecifiers...> {
   typedef compose_new_extents<extents<ExtentsNew...>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
@@ -130,30 +222,237 @@ struct subspan_deduce_extents {
   }
 };
 
+
+template<class T>
+struct is_full_slice : is_convertible<T,all_type> {};
+
+template<class T>
+struct is_index_slice : is_convertible<T,ptrdiff_t> {};
+
+// Slices selecting a contiguous index range: pairs, and strided_slices
+// whose stride is statically one.
+template<class T>
+struct is_range_slice : false_type {};
+
+template<class IT>
+struct is_range_slice<pair<IT,IT>> : true_type {};
+
+template<class OT, class ET, class T>
+struct is_range_slice<strided_slice<OT,ET,integral_constant<T,1>>> : true_type {};
+
+template<class ... SliceSpecifiers>
+constexpr size_t sub_rank() {
+  return ( size_t(0) + ... + size_t(is_index_slice<SliceSpecifiers>::value ? 0 : 1) );
+}
+
+// layout_left is preserved if the leading sub_rank-1 slices are full,
+// the next one is full or a range, and the rest are indices.
+template<class ... SliceSpecifiers>
+constexpr bool preserves_layout_left() {
+  constexpr size_t R = sizeof...(SliceSpecifiers);
+  constexpr size_t sub_R = sub_rank<SliceSpecifiers...>();
+  constexpr bool full[R+1] = { is_full_slice<SliceSpecifiers>::value..., false };
+  constexpr bool range[R+1] = { is_range_slice<SliceSpecifiers>::value..., false };
+  if(sub_R == 0) return true;
+  for(size_t k = 0; k+1 < sub_R; k++)
+    if(!full[k]) return false;
+  return full[sub_R-1] || range[sub_R-1];
+}
+
+// layout_right is preserved if the trailing sub_rank-1 slices are full,
+// the one before them is full or a range, and the rest are indices.
+template<class ... SliceSpecifiers>
+constexpr bool preserves_layout_right() {
+  constexpr size_t R = sizeof...(SliceSpecifiers);
+  constexpr size_t sub_R = sub_rank<SliceSpecifiers...>();
+  constexpr bool full[R+1] = { is_full_slice<SliceSpecifiers>::value..., false };
+  constexpr bool range[R+1] = { is_range_slice<SliceSpecifiers>::value..., false };
+  if(sub_R == 0) return true;
+  for(size_t k = R-sub_R+1; k < R; k++)
+    if(!full[k]) return false;
+  return full[R-sub_R] || range[R-sub_R];
+}
+
+// For a source whose last dimension has unit stride and whose other
+// strides are products of the extents to their right, as in layout_right
+// and layout_right_padded: the dimension whose stride becomes the padded
+// stride of a layout_right_padded result, or -1 if there is none.  The
+// last slice must be full or a range, so that the result keeps unit
+// stride there.  With two dimensions kept the outer one may be any
+// slice, its stride becoming the padding.  With more, the kept ones up
+// to the padded one must be adjacent and full, but for the first, which
+// may also be a range, so that their strides stay products of extents.
+constexpr ptrdiff_t right_padded_dimension( const size_t R, const bool * full, const bool * range,
+                                            const bool * index ) {
+  size_t sub_R = 0;
+  for(size_t r = 0; r < R; r++)
+    if(!index[r]) sub_R++;
+  if(sub_R < 2 || !(full[R-1] || range[R-1])) return -1;
+  ptrdiff_t pad = ptrdiff_t(R) - 2;
+  while(index[pad]) pad--;
+  if(sub_R == 2) return pad;
+  const ptrdiff_t first = pad - ptrdiff_t(sub_R) + 2;
+  for(ptrdiff_t r = first+1; r <= pad; r++)
+    if(!full[r]) return -1;
+  return full[first] || range[first] ? pad : -1;
+}
+
+// right_padded_dimension for a layout_right (Right) or, with the slices
+// reversed, a layout_left source.
+template<bool Right, class ... SliceSpecifiers>
+constexpr ptrdiff_t padded_dimension() {
+  constexpr size_t R = sizeof...(SliceSpecifiers);
+  constexpr bool full[R+1] = { is_full_slice<SliceSpecifiers>::value..., false };
+  constexpr bool range[R+1] = { is_range_slice<SliceSpecifiers>::value..., false };
+  constexpr bool index[R+1] = { is_index_slice<SliceSpecifiers>::value..., false };
+  bool f[R+1] = {}, g[R+1] = {}, x[R+1] = {};
+  for(size_t r = 0; r < R; r++) {
+    const size_t q = Right ? r : R-1-r;
+    f[r] = full[q]; g[r] = range[q]; x[r] = index[q];
+  }
+  const ptrdiff_t d = right_padded_dimension(R,f,g,x);
+  return d < 0 || Right ? d : ptrdiff_t(R)-1-d;
+}
+
+// Stride of dimension r of Layout's mappings of Extents if it is known
+// at compile time, else dynamic_extent.
+template<class Layout, class Extents>
+constexpr ptrdiff_t static_stride( const size_t r ) {
+  constexpr size_t R = Extents::rank();
+  ptrdiff_t stride = 1;
+  size_t begin = 0, end = 0;
+  if constexpr (is_same<Layout,layout_left>::value) { end = r; }
+  else if constexpr (is_same<Layout,layout_right>::value) { begin = r+1; end = R; }
+  else if constexpr (is_layout_left_padded<Layout>::value) {
+    if(r == 0) return 1;
+    stride = Layout::template mapping<Extents>::static_padding_stride;
+    begin = 1; end = r;
+  }
+  else if constexpr (is_layout_right_padded<Layout>::value) {
+    if(r == R-1) return 1;
+    stride = Layout::template mapping<Extents>::static_padding_stride;
+    begin = r+1; end = R-1;
+  }
+  else return dynamic_extent;
+  for(size_t q = begin; q < end; q++) {
+    if(stride == dynamic_extent || Extents::static_extent(q) == dynamic_extent) return dynamic_extent;
+    stride *= Extents::static_extent(q);
+  }
+  return stride;
+}
+
+// Factor by which a slice multiplies the stride of its dimension, if
+// it is known at compile time, else dynamic_extent.
+template<class T>
+struct static_slice_stride {
+  static constexpr ptrdiff_t value = 1;
+};
+
+template<class OT, class ET, class ST>
+struct static_slice_stride<strided_slice<OT,ET,ST>> {
+  static constexpr ptrdiff_t value = is_integral_constant<ST>::value ? de_ice(ST()) : ptrdiff_t(dynamic_extent);
+};
+
+template<size_t D, class ... SliceSpecifiers>
+constexpr ptrdiff_t static_slice_stride_of() {
+  constexpr ptrdiff_t stride[] = { static_slice_stride<SliceSpecifiers>::value..., 0 };
+  return stride[D];
 }
 
-template<class ElementType, class Extents, class LayoutPolicy,
-           class AccessorPolicy, class... SliceSpecifiers>
-    basic_mdspan<ElementType, typename detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::extents_type,
-                 layout_stride, typename AccessorPolicy::offset_policy >
-      subspan(const basic_mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src, SliceSpecifiers ... slices) noexcept {
-    typedef typename detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::extents_type sub_extents_type;
-    typedef typename AccessorPolicy::offset_policy sub_accessor_policy;
-    typedef basic_mdspan<ElementType,sub_extents_type,layout_stride,sub_accessor_policy> sub_mdspan_type;
+// Shared implementation of submdspan_mapping for strided layouts.
+// Layout is the layout of the source mapping.  layout_left and
+// layout_right are kept whenever the slices allow it.  Otherwise, if the
+// innermost dimension keeps unit stride, the result is
+// layout_left_padded or layout_right_padded, with a static padding value
+// when the padded stride is known at compile time, as in every other row
+// of a static matrix.  Any other result is layout_stride.
+template<class Layout, class Mapping, class ... SliceSpecifiers>
+constexpr auto submdspan_mapping_impl( const Mapping & src, SliceSpecifiers ... slices ) {
+  typedef typename Mapping::extents_type org_extents_type;
+  typedef subspan_deduce_extents<org_extents_type,SliceSpecifiers...> deduce_type;
+  typedef typename deduce_type::extents_type sub_extents_type;
+  constexpr bool left_source = is_same<Layout,layout_left>::value || is_layout_left_padded<Layout>::value;
+  constexpr bool right_source = is_same<Layout,layout_right>::value || is_layout_right_padded<Layout>::value;
+  // A padded source stays padded unless at most one dimension is left.
+  constexpr bool contiguous_source = ! is_layout_left_padded<Layout>::value && ! is_layout_right_padded<Layout>::value;
+  constexpr size_t sub_R = sub_extents_type::rank();
 
-    array<ptrdiff_t,Extents::rank()> strides;
-    for(size_t r = 0; r<Extents::rank(); r++)
+  if constexpr (org_extents_type::rank() == 0) {
+    return submdspan_mapping_result<Mapping>{src,0};
+  }
+  else {
+    array<ptrdiff_t,org_extents_type::rank()> strides;
+    for(size_t r = 0; r<org_extents_type::rank(); r++)
       strides[r] = src.stride(r);
 
     ptrdiff_t offset = 0;
-    sub_extents_type sub_extents = detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::create_sub_extents(src.extents(),strides,offset,slices...);
+    sub_extents_type sub_extents = deduce_type::create_sub_extents(src.extents(),strides,offset,slices...);
+
+    if constexpr (left_source && (contiguous_source || sub_R < 2) && preserves_layout_left<SliceSpecifiers...>()) {
+      typedef layout_left::mapping<sub_extents_type> sub_mapping_type;
+      return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents),size_t(offset)};
+    }
+    else if constexpr (right_source && (contiguous_source || sub_R < 2) && preserves_layout_right<SliceSpecifiers...>()) {
+      typedef layout_right::mapping<sub_extents_type> sub_mapping_type;
+      return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents),size_t(offset)};
+    }
+    else if constexpr ((left_source || right_source) && padded_dimension<right_source,SliceSpecifiers...>() >= 0) {
+      constexpr ptrdiff_t d = padded_dimension<right_source,SliceSpecifiers...>();
+      constexpr ptrdiff_t org_stride = static_stride<Layout,org_extents_type>(d);
+      constexpr ptrdiff_t slice_stride = static_slice_stride_of<d,SliceSpecifiers...>();
+      constexpr ptrdiff_t padding = org_stride == dynamic_extent || slice_stride == dynamic_extent ?
+                                    ptrdiff_t(dynamic_extent) : org_stride*slice_stride;
+      typedef conditional_t<right_source,layout_right_padded<padding>,layout_left_padded<padding>> sub_layout_type;
+      typedef typename sub_layout_type::template mapping<sub_extents_type> sub_mapping_type;
+      if constexpr (padding == dynamic_extent)
+        return submdspan_mapping_result<sub_mapping_type>{
+          sub_mapping_type(sub_extents,strides[right_source ? sub_R-2 : 1]),size_t(offset)};
+      else
+        return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents),size_t(offset)};
+    }
+    else {
+      typedef layout_stride::mapping<sub_extents_type> sub_mapping_type;
+      array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
+      for(size_t r = 0; r<sub_extents_type::rank(); r++)
+        sub_strides[r] = strides[r];
+      return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents,sub_strides),size_t(offset)};
+    }
+  }
+}
 
-    array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
-    for(size_t r = 0; r<sub_extents_type::rank(); r++)
-      sub_strides[r] = strides[r];
+// Call submdspan_mapping found by argument dependent lookup; mappings
+// without one fall back to a layout_stride result computed from stride().
+template<class Mapping, class ... SliceSpecifiers>
+constexpr auto invoke_submdspan_mapping( int, const Mapping & src, SliceSpecifiers ... slices )
+  -> decltype( submdspan_mapping( src, slices... ) )
+  { return submdspan_mapping( src, slices... ); }
+
+template<class Mapping, class ... SliceSpecifiers>
+constexpr auto invoke_submdspan_mapping( long, const Mapping & src, SliceSpecifiers ... slices )
+  {
+    static_assert( Mapping::is_always_strided(),
+                   "subspan of a layout that is not always strided needs a submdspan_mapping overload" );
+    return submdspan_mapping_impl<layout_stride>( src, slices... );
+  }
+
+}
+
+// The layout of the result is the layout_type of the mapping returned by
+// submdspan_mapping.  Custom layouts customize subspan by providing
+// submdspan_mapping as a hidden friend of their mapping.
+template<class ElementType, class Extents, class LayoutPolicy,
+           class AccessorPolicy, class... SliceSpecifiers>
+    auto subspan(const basic_mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src, SliceSpecifiers ... slices) noexcept {
+    auto sub_map_offset = detail::invoke_submdspan_mapping(0,src.mapping(),slices...);
+
+    typedef decltype(sub_map_offset.mapping) sub_mapping_type;
+    typedef typename sub_mapping_type::extents_type sub_extents_type;
+    typedef typename sub_mapping_type::layout_type sub_layout_type;
+    typedef typename AccessorPolicy::offset_policy sub_accessor_policy;
+    typedef basic_mdspan<ElementType,sub_extents_type,sub_layout_type,sub_accessor_policy> sub_mdspan_type;
 
-    typename AccessorPolicy::offset_policy::pointer ptr = src.accessor().offset(src.data(),offset);    
-    return sub_mdspan_type(ptr,typename sub_mdspan_type::mapping_type(sub_extents,sub_strides));
+    typename sub_accessor_policy::pointer ptr = src.accessor().offset(src.data(),sub_map_offset.offset);
+    return sub_mdspan_type(ptr,sub_map_offset.mapping,sub_accessor_policy(src.accessor()));
   }
 
 }}}
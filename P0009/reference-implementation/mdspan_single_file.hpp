@@ -661,584 +661,1284 @@ class layout_stride ;
 #line 55 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#55"
 
 #line 56 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#56"
-}}}
+namespace detail {
 #line 57 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#57"
-
+  // [mdspan.submdspan.mapping], defined in subspan.hpp
 #line 58 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#58"
-//--------------------------------------------------------------------------
+  template<class Layout, class Mapping, class ... SliceSpecifiers>
 #line 59 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#59"
-//--------------------------------------------------------------------------
+  constexpr auto submdspan_mapping_impl( const Mapping & src, SliceSpecifiers ... slices );
 #line 60 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#60"
-
+}
 #line 61 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#61"
 
 #line 62 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#62"
-namespace std {
+}}}
 #line 63 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#63"
-namespace experimental {
+
 #line 64 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#64"
-inline namespace fundamentals_v3 {
+//--------------------------------------------------------------------------
 #line 65 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#65"
-
+//--------------------------------------------------------------------------
 #line 66 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#66"
-class layout_right {
+
 #line 67 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#67"
 
 #line 68 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#68"
-public:
+namespace std {
 #line 69 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#69"
-  template<class Extents>
+namespace experimental {
 #line 70 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#70"
-  class mapping {
+inline namespace fundamentals_v3 {
 #line 71 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#71"
-  private:
-#line 72 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#72"
 
+#line 72 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#72"
+class layout_right {
 #line 73 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#73"
-    Extents m_extents ;
-#line 74 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#74"
 
+#line 74 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#74"
+public:
 #line 75 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#75"
-  public:
+  template<class Extents>
 #line 76 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#76"
-
+  class mapping {
 #line 77 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#77"
-    using index_type = ptrdiff_t ;
+  private:
 #line 78 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#78"
-    using extents_type = Extents ;
-#line 79 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#79"
 
+#line 79 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#79"
+    Extents m_extents ;
 #line 80 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#80"
-    constexpr mapping() noexcept = default ;
-#line 81 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#81"
 
+#line 81 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#81"
+  public:
 #line 82 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#82"
-    constexpr mapping( mapping && ) noexcept = default ;
-#line 83 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#83"
 
+#line 83 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#83"
+    using index_type = ptrdiff_t ;
 #line 84 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#84"
-    constexpr mapping( const mapping & ) noexcept = default ;
+    using extents_type = Extents ;
 #line 85 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#85"
-
+    using layout_type = layout_right ;
 #line 86 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#86"
-    mapping & operator = ( mapping && ) noexcept = default ;
-#line 87 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#87"
 
+#line 87 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#87"
+    constexpr mapping() noexcept = default ;
 #line 88 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#88"
-    mapping & operator = ( const mapping & ) noexcept = default ;
-#line 89 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#89"
 
+#line 89 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#89"
+    constexpr mapping( mapping && ) noexcept = default ;
 #line 90 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#90"
-    constexpr mapping( const Extents & ext ) noexcept
+
 #line 91 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#91"
-      : m_extents( ext ) {}
+    constexpr mapping( const mapping & ) noexcept = default ;
 #line 92 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#92"
 
 #line 93 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#93"
-    constexpr const Extents & extents() const noexcept { return m_extents ; }
+    mapping & operator = ( mapping && ) noexcept = default ;
 #line 94 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#94"
 
 #line 95 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#95"
-  private:
+    mapping & operator = ( const mapping & ) noexcept = default ;
 #line 96 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#96"
 
 #line 97 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#97"
-    // ( ( ( ( i0 ) * N1 + i1 ) * N2 + i2 ) * N3 + i3 ) ...
+    constexpr mapping( const Extents & ext ) noexcept
 #line 98 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#98"
-
+      : m_extents( ext ) {}
 #line 99 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#99"
-    static constexpr index_type
+
 #line 100 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#100"
-    offset( const size_t , const ptrdiff_t sum)
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
 #line 101 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#101"
-      { return sum; }
-#line 102 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#102"
 
+#line 102 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#102"
+  private:
 #line 103 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#103"
-    template<class ... Indices >
+
 #line 104 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#104"
-    inline constexpr index_type
+    // ( ( ( ( i0 ) * N1 + i1 ) * N2 + i2 ) * N3 + i3 ) ...
 #line 105 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#105"
-    offset( const size_t r, ptrdiff_t sum, const index_type i, Indices... indices) const noexcept
+
 #line 106 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#106"
-      {
+    static constexpr index_type
 #line 107 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#107"
-        return offset( r+1 , sum * m_extents.extent(r) + i, indices...);
+    offset( const size_t , const ptrdiff_t sum)
 #line 108 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#108"
-      }
+      { return sum; }
 #line 109 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#109"
 
 #line 110 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#110"
-  public:
+    template<class ... Indices >
 #line 111 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#111"
-
+    inline constexpr index_type
 #line 112 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#112"
-    constexpr index_type required_span_size() const noexcept { 
+    offset( const size_t r, ptrdiff_t sum, const index_type i, Indices... indices) const noexcept
 #line 113 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#113"
-      index_type size = 1;
+      {
 #line 114 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#114"
-      for(size_t r=0; r<m_extents.rank(); r++)
+        return offset( r+1 , sum * m_extents.extent(r) + i, indices...);
 #line 115 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#115"
-        size *= m_extents.extent(r);
+      }
 #line 116 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#116"
-      return size;
+
 #line 117 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#117"
-    } 
+  public:
 #line 118 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#118"
 
 #line 119 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#119"
-    template<class ... Indices >
+    constexpr index_type required_span_size() const noexcept { 
 #line 120 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#120"
-    constexpr
+      index_type size = 1;
 #line 121 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#121"
-    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+      for(size_t r=0; r<m_extents.rank(); r++)
 #line 122 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#122"
-    operator()( Indices ... indices ) const noexcept 
+        size *= m_extents.extent(r);
 #line 123 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#123"
-      { return offset( 0, 0, indices... ); }
+      return size;
 #line 124 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#124"
-
+    } 
 #line 125 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#125"
-    static constexpr bool is_always_unique()     noexcept { return true ; }
+
 #line 126 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#126"
-    static constexpr bool is_always_contiguous() noexcept { return true ; }
+    template<class ... Indices >
 #line 127 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#127"
-    static constexpr bool is_always_strided()    noexcept { return true ; }
+    constexpr
 #line 128 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#128"
-
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
 #line 129 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#129"
-    constexpr bool is_unique()     const noexcept { return true ; }
+    operator()( Indices ... indices ) const noexcept 
 #line 130 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#130"
-    constexpr bool is_contiguous() const noexcept { return true ; }
+      { return offset( 0, 0, indices... ); }
 #line 131 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#131"
-    constexpr bool is_strided()    const noexcept { return true ; }
-#line 132 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#132"
 
+#line 132 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#132"
+    static constexpr bool is_always_unique()     noexcept { return true ; }
 #line 133 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#133"
-    constexpr index_type stride(const size_t R) const noexcept { 
+    static constexpr bool is_always_contiguous() noexcept { return true ; }
 #line 134 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#134"
-      ptrdiff_t stride_ = 1;
+    static constexpr bool is_always_strided()    noexcept { return true ; }
 #line 135 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#135"
-      for(size_t r = m_extents.rank()-1; r>R; r--)
+
 #line 136 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#136"
-        stride_ *= m_extents.extent(r);
+    constexpr bool is_unique()     const noexcept { return true ; }
 #line 137 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#137"
-      return stride_;
+    constexpr bool is_contiguous() const noexcept { return true ; }
 #line 138 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#138"
-    }
+    constexpr bool is_strided()    const noexcept { return true ; }
 #line 139 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#139"
 
 #line 140 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#140"
-  }; // class mapping
+    constexpr index_type stride(const size_t R) const noexcept { 
 #line 141 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#141"
-
+      ptrdiff_t stride_ = 1;
 #line 142 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#142"
-}; // class layout_right
+      for(size_t r = m_extents.rank()-1; r>R; r--)
 #line 143 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#143"
-
+        stride_ *= m_extents.extent(r);
 #line 144 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#144"
-}}} // experimental::fundamentals_v3
+      return stride_;
 #line 145 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#145"
-
+    }
 #line 146 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#146"
-//----------------------------------------------------------------------------
-#line 147 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#147"
 
+#line 147 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#147"
+    // [mdspan.submdspan.mapping]
 #line 148 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#148"
-namespace std {
+
 #line 149 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#149"
-namespace experimental {
+    template<class ... SliceSpecifiers>
 #line 150 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#150"
-inline namespace fundamentals_v3 {
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
 #line 151 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#151"
-
+      { return detail::submdspan_mapping_impl<layout_right>( src, slices... ); }
 #line 152 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#152"
-class layout_left {
+
 #line 153 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#153"
-public:
+  }; // class mapping
 #line 154 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#154"
-  template<class Extents>
+
 #line 155 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#155"
-  class mapping {
+}; // class layout_right
 #line 156 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#156"
-  private:
-#line 157 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#157"
 
+#line 157 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#157"
+}}} // experimental::fundamentals_v3
 #line 158 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#158"
-    Extents m_extents ;
-#line 159 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#159"
 
+#line 159 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#159"
+//----------------------------------------------------------------------------
 #line 160 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#160"
-  public:
-#line 161 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#161"
 
+#line 161 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#161"
+namespace std {
 #line 162 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#162"
-    using index_type = ptrdiff_t ;
+namespace experimental {
 #line 163 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#163"
-    using extents_type = Extents ;
+inline namespace fundamentals_v3 {
 #line 164 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#164"
 
 #line 165 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#165"
-    constexpr mapping() noexcept = default ;
+class layout_left {
 #line 166 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#166"
-
+public:
 #line 167 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#167"
-    constexpr mapping( mapping && ) noexcept = default ;
+  template<class Extents>
 #line 168 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#168"
-
+  class mapping {
 #line 169 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#169"
-    constexpr mapping( const mapping & ) noexcept = default ;
+  private:
 #line 170 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#170"
 
 #line 171 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#171"
-    mapping & operator = ( mapping && ) noexcept = default ;
+    Extents m_extents ;
 #line 172 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#172"
 
 #line 173 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#173"
-    mapping & operator = ( const mapping & ) noexcept = default ;
+  public:
 #line 174 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#174"
 
 #line 175 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#175"
-    constexpr mapping( const Extents & ext ) noexcept
+    using index_type = ptrdiff_t ;
 #line 176 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#176"
-      : m_extents( ext ) {}
+    using extents_type = Extents ;
 #line 177 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#177"
-
+    using layout_type = layout_left ;
 #line 178 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#178"
-    constexpr const Extents & extents() const noexcept { return m_extents ; }
-#line 179 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#179"
 
+#line 179 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#179"
+    constexpr mapping() noexcept = default ;
 #line 180 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#180"
-  private:
-#line 181 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#181"
 
+#line 181 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#181"
+    constexpr mapping( mapping && ) noexcept = default ;
 #line 182 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#182"
-    // ( i0 + N0 * ( i1 + N1 * ( i2 + N2 * ( ... ) ) ) )
-#line 183 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#183"
 
+#line 183 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#183"
+    constexpr mapping( const mapping & ) noexcept = default ;
 #line 184 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#184"
-    static constexpr index_type
+
 #line 185 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#185"
-    offset( size_t ) noexcept
+    mapping & operator = ( mapping && ) noexcept = default ;
 #line 186 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#186"
-      { return 0 ; }
-#line 187 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#187"
 
+#line 187 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#187"
+    mapping & operator = ( const mapping & ) noexcept = default ;
 #line 188 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#188"
-    template<class ... IndexType >
+
 #line 189 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#189"
-    constexpr index_type
+    constexpr mapping( const Extents & ext ) noexcept
 #line 190 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#190"
-    offset( const size_t r, index_type i, IndexType... indices ) const noexcept
+      : m_extents( ext ) {}
 #line 191 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#191"
-      { return i + m_extents.extent(r) * offset( r+1, indices... ); }
-#line 192 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#192"
 
+#line 192 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#192"
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
 #line 193 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#193"
-  public:
-#line 194 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#194"
 
+#line 194 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#194"
+  private:
 #line 195 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#195"
-    constexpr index_type required_span_size() const noexcept {
+
 #line 196 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#196"
-      ptrdiff_t size = 1;
+    // ( i0 + N0 * ( i1 + N1 * ( i2 + N2 * ( ... ) ) ) )
 #line 197 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#197"
-      for(size_t r = 0; r<m_extents.rank(); r++)
+
 #line 198 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#198"
-        size *= m_extents.extent(r);
+    static constexpr index_type
 #line 199 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#199"
-      return size;
+    offset( size_t ) noexcept
 #line 200 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#200"
-    }
+      { return 0 ; }
 #line 201 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#201"
 
 #line 202 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#202"
-    template<class ... Indices >
+    template<class ... IndexType >
 #line 203 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#203"
-    constexpr
+    constexpr index_type
 #line 204 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#204"
-    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    offset( const size_t r, index_type i, IndexType... indices ) const noexcept
 #line 205 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#205"
-    operator()( Indices ... indices ) const noexcept
+      { return i + m_extents.extent(r) * offset( r+1, indices... ); }
 #line 206 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#206"
-      { return offset( 0, indices... ); }
-#line 207 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#207"
 
+#line 207 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#207"
+  public:
 #line 208 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#208"
-    static constexpr bool is_always_unique()     noexcept { return true ; }
+
 #line 209 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#209"
-    static constexpr bool is_always_contiguous() noexcept { return true ; }
+    constexpr index_type required_span_size() const noexcept {
 #line 210 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#210"
-    static constexpr bool is_always_strided()    noexcept { return true ; }
+      ptrdiff_t size = 1;
 #line 211 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#211"
-
+      for(size_t r = 0; r<m_extents.rank(); r++)
 #line 212 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#212"
-    constexpr bool is_unique()     const noexcept { return true ; }
+        size *= m_extents.extent(r);
 #line 213 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#213"
-    constexpr bool is_contiguous() const noexcept { return true ; }
+      return size;
 #line 214 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#214"
-    constexpr bool is_strided()    const noexcept { return true ; }
+    }
 #line 215 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#215"
 
 #line 216 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#216"
-    constexpr index_type stride(const size_t R) const noexcept {
+    template<class ... Indices >
 #line 217 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#217"
-      ptrdiff_t stride_ = 1;
+    constexpr
 #line 218 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#218"
-      for(size_t r = 0; r<R; r++)
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
 #line 219 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#219"
-        stride_ *= m_extents.extent(r);
+    operator()( Indices ... indices ) const noexcept
 #line 220 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#220"
-      return stride_;
+      { return offset( 0, indices... ); }
 #line 221 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#221"
-    }
-#line 222 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#222"
 
+#line 222 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#222"
+    static constexpr bool is_always_unique()     noexcept { return true ; }
 #line 223 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#223"
-  }; // class mapping
+    static constexpr bool is_always_contiguous() noexcept { return true ; }
 #line 224 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#224"
-
+    static constexpr bool is_always_strided()    noexcept { return true ; }
 #line 225 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#225"
-}; // class layout_left
-#line 226 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#226"
 
+#line 226 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#226"
+    constexpr bool is_unique()     const noexcept { return true ; }
 #line 227 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#227"
-}}} // experimental::fundamentals_v3
+    constexpr bool is_contiguous() const noexcept { return true ; }
 #line 228 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#228"
-
+    constexpr bool is_strided()    const noexcept { return true ; }
 #line 229 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#229"
-//----------------------------------------------------------------------------
+
 #line 230 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#230"
-//----------------------------------------------------------------------------
+    constexpr index_type stride(const size_t R) const noexcept {
 #line 231 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#231"
-
+      ptrdiff_t stride_ = 1;
 #line 232 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#232"
-namespace std {
+      for(size_t r = 0; r<R; r++)
 #line 233 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#233"
-namespace experimental {
+        stride_ *= m_extents.extent(r);
 #line 234 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#234"
-inline namespace fundamentals_v3 {
+      return stride_;
 #line 235 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#235"
-
+    }
 #line 236 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#236"
-class layout_stride {
+
 #line 237 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#237"
-public:
+    // [mdspan.submdspan.mapping]
 #line 238 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#238"
 
 #line 239 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#239"
-  template<class Extents>
+    template<class ... SliceSpecifiers>
 #line 240 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#240"
-  class mapping {
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
 #line 241 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#241"
-  private:
+      { return detail::submdspan_mapping_impl<layout_left>( src, slices... ); }
 #line 242 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#242"
 
 #line 243 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#243"
-    using stride_t = array<ptrdiff_t,Extents::rank()> ;
+  }; // class mapping
 #line 244 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#244"
 
 #line 245 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#245"
-    Extents   m_extents ;
+}; // class layout_left
 #line 246 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#246"
-    stride_t  m_stride ;
+
 #line 247 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#247"
-    int       m_contig ;
+}}} // experimental::fundamentals_v3
 #line 248 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#248"
 
 #line 249 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#249"
-  public:
+//----------------------------------------------------------------------------
 #line 250 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#250"
-
+//----------------------------------------------------------------------------
 #line 251 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#251"
-    using index_type = ptrdiff_t ;
+
 #line 252 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#252"
-    using extents_type = Extents ;
+namespace std {
 #line 253 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#253"
-
+namespace experimental {
 #line 254 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#254"
-    constexpr mapping() noexcept = default ;
+inline namespace fundamentals_v3 {
 #line 255 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#255"
 
 #line 256 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#256"
-    constexpr mapping( mapping && ) noexcept = default ;
+class layout_stride {
 #line 257 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#257"
-
+public:
 #line 258 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#258"
-    constexpr mapping( const mapping & ) noexcept = default ;
-#line 259 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#259"
 
+#line 259 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#259"
+  template<class Extents>
 #line 260 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#260"
-    mapping & operator = ( mapping && ) noexcept = default ;
+  class mapping {
 #line 261 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#261"
-
+  private:
 #line 262 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#262"
-    mapping & operator = ( const mapping & ) noexcept = default ;
-#line 263 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#263"
 
+#line 263 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#263"
+    using stride_t = array<ptrdiff_t,Extents::rank()> ;
 #line 264 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#264"
-    mapping( const Extents & ext, const stride_t & str ) noexcept
+
 #line 265 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#265"
-      : m_extents(ext), m_stride(str), m_contig(1)
+    Extents   m_extents ;
 #line 266 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#266"
-      {
+    stride_t  m_stride ;
 #line 267 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#267"
-        int p[ Extents::rank() ? Extents::rank() : 1 ];
+    int       m_contig ;
 #line 268 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#268"
 
 #line 269 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#269"
-        // Fill permutation such that
+  public:
 #line 270 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#270"
-        //   m_stride[ p[i] ] <= m_stride[ p[i+1] ]
+
 #line 271 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#271"
-        //
+    using index_type = ptrdiff_t ;
 #line 272 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#272"
-        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
+    using extents_type = Extents ;
 #line 273 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#273"
-
+    using layout_type = layout_stride ;
 #line 274 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#274"
-          int j = i ;
-#line 275 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#275"
 
+#line 275 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#275"
+    constexpr mapping() noexcept = default ;
 #line 276 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#276"
-          while ( j && m_stride[i] < m_stride[ p[j-1] ] )
+
 #line 277 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#277"
-           { p[j] = p[j-1] ; --j ; }
+    constexpr mapping( mapping && ) noexcept = default ;
 #line 278 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#278"
 
 #line 279 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#279"
-          p[j] = i ;
+    constexpr mapping( const mapping & ) noexcept = default ;
 #line 280 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#280"
-        }
-#line 281 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#281"
 
+#line 281 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#281"
+    mapping & operator = ( mapping && ) noexcept = default ;
 #line 282 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#282"
-        for ( size_t i = 1 ; i < Extents::rank() ; ++i ) {
+
 #line 283 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#283"
-          const int j = p[i-1];
+    mapping & operator = ( const mapping & ) noexcept = default ;
 #line 284 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#284"
-          const int k = p[i];
+
 #line 285 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#285"
-          const index_type prev = m_stride[j] * m_extents.extent(j);
+    mapping( const Extents & ext, const stride_t & str ) noexcept
 #line 286 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#286"
-          if ( m_stride[k] != prev ) { m_contig = 0 ; }
+      : m_extents(ext), m_stride(str), m_contig(1)
 #line 287 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#287"
-        }
+      {
 #line 288 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#288"
-      }
+        int p[ Extents::rank() ? Extents::rank() : 1 ];
 #line 289 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#289"
 
 #line 290 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#290"
-    constexpr const Extents & extents() const noexcept { return m_extents ; }
+        // Fill permutation such that
 #line 291 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#291"
-
+        //   m_stride[ p[i] ] <= m_stride[ p[i+1] ]
 #line 292 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#292"
-  private:
+        //
 #line 293 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#293"
-
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
 #line 294 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#294"
-    // i0 * N0 + i1 * N1 + i2 * N2 + ...
-#line 295 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#295"
 
+#line 295 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#295"
+          int j = i ;
 #line 296 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#296"
-    constexpr index_type
+
 #line 297 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#297"
-    offset(size_t) const noexcept
+          while ( j && m_stride[i] < m_stride[ p[j-1] ] )
 #line 298 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#298"
-      { return 0 ; }
+           { p[j] = p[j-1] ; --j ; }
 #line 299 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#299"
 
 #line 300 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#300"
-    template<class... IndexType >
+          p[j] = i ;
 #line 301 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#301"
-    constexpr index_type
+        }
 #line 302 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#302"
-    offset( const size_t K, const index_type i, IndexType... indices ) const noexcept
+
 #line 303 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#303"
-      { return i * m_stride[K] + offset(K+1,indices...); }
+        for ( size_t i = 1 ; i < Extents::rank() ; ++i ) {
 #line 304 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#304"
-
+          const int j = p[i-1];
 #line 305 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#305"
-  public:
+          const int k = p[i];
 #line 306 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#306"
-
+          const index_type prev = m_stride[j] * m_extents.extent(j);
 #line 307 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#307"
-    index_type required_span_size() const noexcept
+          if ( m_stride[k] != prev ) { m_contig = 0 ; }
 #line 308 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#308"
-      {
+        }
 #line 309 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#309"
-        index_type max = 0 ;
+      }
 #line 310 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#310"
-        for ( size_t i = 0 ; i < Extents::rank() ; ++i )
+
 #line 311 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#311"
-          max += m_stride[i] * ( m_extents.extent(i) - 1 );
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
 #line 312 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#312"
-        return max ;
+
 #line 313 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#313"
-      }
+  private:
 #line 314 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#314"
 
 #line 315 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#315"
-    template<class ... Indices >
+    // i0 * N0 + i1 * N1 + i2 * N2 + ...
 #line 316 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#316"
-    constexpr
+
 #line 317 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#317"
-    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+    constexpr index_type
 #line 318 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#318"
-    operator()( Indices ... indices ) const noexcept
+    offset(size_t) const noexcept
 #line 319 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#319"
-      { return offset(0, indices... ); }
+      { return 0 ; }
 #line 320 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#320"
 
 #line 321 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#321"
-
+    template<class... IndexType >
 #line 322 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#322"
-    static constexpr bool is_always_unique()     noexcept { return true ; }
+    constexpr index_type
 #line 323 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#323"
-    static constexpr bool is_always_contiguous() noexcept { return false ; }
+    offset( const size_t K, const index_type i, IndexType... indices ) const noexcept
 #line 324 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#324"
-    static constexpr bool is_always_strided()    noexcept { return true ; }
+      { return i * m_stride[K] + offset(K+1,indices...); }
 #line 325 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#325"
 
 #line 326 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#326"
-    constexpr bool is_unique()     const noexcept { return true ; }
+  public:
 #line 327 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#327"
-    constexpr bool is_contiguous() const noexcept { return m_contig ; }
+
 #line 328 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#328"
-    constexpr bool is_strided()    const noexcept { return true ; }
+    index_type required_span_size() const noexcept
 #line 329 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#329"
-
+      {
 #line 330 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#330"
-    constexpr index_type stride(size_t r) const noexcept
+        index_type max = 0 ;
 #line 331 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#331"
-      { return m_stride[r]; }
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i )
 #line 332 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#332"
-
+          max += m_stride[i] * ( m_extents.extent(i) - 1 );
 #line 333 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#333"
-  }; // class mapping
+        return max ;
 #line 334 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#334"
-
+      }
 #line 335 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#335"
-}; // class layout_stride
-#line 336 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#336"
 
+#line 336 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#336"
+    template<class ... Indices >
 #line 337 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#337"
-}}} // experimental::fundamentals_v3
-#line 1 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#1"
-//@HEADER
-#line 2 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#2"
-// ************************************************************************
-#line 3 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#3"
-//
-#line 4 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#4"
-//                        Kokkos v. 2.0
-#line 5 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#5"
-//              Copyright (2014) Sandia Corporation
-#line 6 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#6"
-//
-#line 7 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#7"
-// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
-#line 8 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#8"
+    constexpr
+#line 338 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#338"
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+#line 339 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#339"
+    operator()( Indices ... indices ) const noexcept
+#line 340 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#340"
+      { return offset(0, indices... ); }
+#line 341 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#341"
+
+#line 342 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#342"
+
+#line 343 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#343"
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+#line 344 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#344"
+    static constexpr bool is_always_contiguous() noexcept { return false ; }
+#line 345 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#345"
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+#line 346 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#346"
+
+#line 347 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#347"
+    constexpr bool is_unique()     const noexcept { return true ; }
+#line 348 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#348"
+    constexpr bool is_contiguous() const noexcept { return m_contig ; }
+#line 349 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#349"
+    constexpr bool is_strided()    const noexcept { return true ; }
+#line 350 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#350"
+
+#line 351 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#351"
+    constexpr index_type stride(size_t r) const noexcept
+#line 352 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#352"
+      { return m_stride[r]; }
+#line 353 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#353"
+
+#line 354 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#354"
+    // [mdspan.submdspan.mapping]
+#line 355 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#355"
+
+#line 356 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#356"
+    template<class ... SliceSpecifiers>
+#line 357 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#357"
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+#line 358 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#358"
+      { return detail::submdspan_mapping_impl<layout_stride>( src, slices... ); }
+#line 359 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#359"
+
+#line 360 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#360"
+  }; // class mapping
+#line 361 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#361"
+
+#line 362 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#362"
+}; // class layout_stride
+#line 363 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#363"
+
+#line 364 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layouts.hpp#364"
+}}} // experimental::fundamentals_v3
+#line 1 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#1"
+//@HEADER
+#line 2 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#2"
+// ************************************************************************
+#line 3 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#3"
+//
+#line 4 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#4"
+//                        Kokkos v. 2.0
+#line 5 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#5"
+//              Copyright (2014) Sandia Corporation
+#line 6 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#6"
+//
+#line 7 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#7"
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+#line 8 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#8"
+// the U.S. Government retains certain rights in this software.
+#line 9 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#9"
+//
+#line 10 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#10"
+// Kokkos is licensed under 3-clause BSD terms of use:
+#line 11 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#11"
+//
+#line 12 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#12"
+// Redistribution and use in source and binary forms, with or without
+#line 13 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#13"
+// modification, are permitted provided that the following conditions are
+#line 14 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#14"
+// met:
+#line 15 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#15"
+//
+#line 16 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#16"
+// 1. Redistributions of source code must retain the above copyright
+#line 17 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#17"
+// notice, this list of conditions and the following disclaimer.
+#line 18 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#18"
+//
+#line 19 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#19"
+// 2. Redistributions in binary form must reproduce the above copyright
+#line 20 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#20"
+// notice, this list of conditions and the following disclaimer in the
+#line 21 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#21"
+// documentation and/or other materials provided with the distribution.
+#line 22 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#22"
+//
+#line 23 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#23"
+// 3. Neither the name of the Corporation nor the names of the
+#line 24 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#24"
+// contributors may be used to endorse or promote products derived from
+#line 25 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#25"
+// this software without specific prior written permission.
+#line 26 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#26"
+//
+#line 27 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#27"
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+#line 28 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#28"
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#line 29 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#29"
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#line 30 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#30"
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+#line 31 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#31"
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#line 32 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#32"
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#line 33 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#33"
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#line 34 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#34"
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#line 35 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#35"
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#line 36 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#36"
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#line 37 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#37"
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#line 38 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#38"
+//
+#line 39 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#39"
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+#line 40 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#40"
+//
+#line 41 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#41"
+// ************************************************************************
+#line 42 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#42"
+//@HEADER
+#line 43 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#43"
+
+#line 44 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#44"
+
+#line 45 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#45"
+//--------------------------------------------------------------------------
+#line 46 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#46"
+//--------------------------------------------------------------------------
+#line 47 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#47"
+
+#line 48 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#48"
+namespace std {
+#line 49 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#49"
+namespace experimental {
+#line 50 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#50"
+inline namespace fundamentals_v3 {
+#line 51 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#51"
+
+#line 52 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#52"
+// [mdspan.layout.leftpadded], [mdspan.layout.rightpadded] of P2642:
+#line 53 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#53"
+// layout_left (layout_right) whose stride of the second (second to last)
+#line 54 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#54"
+// dimension is padded to a multiple of PaddingValue, which may be
+#line 55 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#55"
+// dynamic_extent.  The innermost dimension always has unit stride, so
+#line 56 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#56"
+// submatrices of layout_left or layout_right views are in these layouts.
+#line 57 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#57"
+template<ptrdiff_t PaddingValue = dynamic_extent>
+#line 58 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#58"
+class layout_left_padded ;
+#line 59 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#59"
+
+#line 60 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#60"
+template<ptrdiff_t PaddingValue = dynamic_extent>
+#line 61 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#61"
+class layout_right_padded ;
+#line 62 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#62"
+
+#line 63 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#63"
+namespace detail {
+#line 64 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#64"
+
+#line 65 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#65"
+// The least multiple of x not smaller than y, or y if x is zero.
+#line 66 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#66"
+constexpr ptrdiff_t least_multiple_at_least( const ptrdiff_t x, const ptrdiff_t y ) noexcept {
+#line 67 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#67"
+  return x == 0 ? y : x * ( ( y + x - 1 ) / x );
+#line 68 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#68"
+}
+#line 69 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#69"
+
+#line 70 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#70"
+// The padded stride if PaddingValue and the static extent of the
+#line 71 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#71"
+// innermost dimension are both known, else dynamic_extent.
+#line 72 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#72"
+constexpr ptrdiff_t static_padding_stride( const ptrdiff_t padding_value, const ptrdiff_t static_extent ) noexcept {
+#line 73 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#73"
+  return padding_value == dynamic_extent || static_extent == dynamic_extent ? ptrdiff_t( dynamic_extent )
+#line 74 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#74"
+                                                                             : least_multiple_at_least( padding_value, static_extent );
+#line 75 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#75"
+}
+#line 76 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#76"
+
+#line 77 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#77"
+template<class Layout>
+#line 78 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#78"
+struct is_layout_left_padded : false_type {};
+#line 79 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#79"
+
+#line 80 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#80"
+template<ptrdiff_t PaddingValue>
+#line 81 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#81"
+struct is_layout_left_padded<layout_left_padded<PaddingValue>> : true_type {};
+#line 82 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#82"
+
+#line 83 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#83"
+template<class Layout>
+#line 84 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#84"
+struct is_layout_right_padded : false_type {};
+#line 85 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#85"
+
+#line 86 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#86"
+template<ptrdiff_t PaddingValue>
+#line 87 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#87"
+struct is_layout_right_padded<layout_right_padded<PaddingValue>> : true_type {};
+#line 88 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#88"
+
+#line 89 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#89"
+}
+#line 90 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#90"
+
+#line 91 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#91"
+}}}
+#line 92 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#92"
+
+#line 93 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#93"
+//--------------------------------------------------------------------------
+#line 94 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#94"
+//--------------------------------------------------------------------------
+#line 95 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#95"
+
+#line 96 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#96"
+namespace std {
+#line 97 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#97"
+namespace experimental {
+#line 98 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#98"
+inline namespace fundamentals_v3 {
+#line 99 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#99"
+
+#line 100 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#100"
+template<ptrdiff_t PaddingValue>
+#line 101 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#101"
+class layout_left_padded {
+#line 102 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#102"
+public:
+#line 103 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#103"
+
+#line 104 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#104"
+  static_assert( PaddingValue == dynamic_extent || PaddingValue > 0, "" );
+#line 105 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#105"
+
+#line 106 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#106"
+  template<class Extents>
+#line 107 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#107"
+  class mapping {
+#line 108 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#108"
+  private:
+#line 109 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#109"
+
+#line 110 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#110"
+    // Dimension 0 has unit stride, dimension 1 the padded stride.
+#line 111 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#111"
+    static constexpr size_t padded_rank = Extents::rank() > 1 ? 1 : 0 ;
+#line 112 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#112"
+
+#line 113 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#113"
+    Extents   m_extents {} ;
+#line 114 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#114"
+    ptrdiff_t m_padded_stride = 0 ;
+#line 115 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#115"
+
+#line 116 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#116"
+  public:
+#line 117 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#117"
+
+#line 118 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#118"
+    using index_type = ptrdiff_t ;
+#line 119 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#119"
+    using extents_type = Extents ;
+#line 120 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#120"
+    using layout_type = layout_left_padded ;
+#line 121 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#121"
+
+#line 122 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#122"
+    static constexpr ptrdiff_t padding_value = PaddingValue ;
+#line 123 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#123"
+
+#line 124 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#124"
+    // Stride of dimension 1 if it is known at compile time, else dynamic_extent.
+#line 125 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#125"
+    static constexpr ptrdiff_t static_padding_stride =
+#line 126 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#126"
+      detail::static_padding_stride( PaddingValue, Extents::rank() > 1 ? Extents::static_extent(0) : 1 );
+#line 127 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#127"
+
+#line 128 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#128"
+    constexpr mapping() noexcept = default ;
+#line 129 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#129"
+
+#line 130 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#130"
+    constexpr mapping( mapping && ) noexcept = default ;
+#line 131 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#131"
+
+#line 132 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#132"
+    constexpr mapping( const mapping & ) noexcept = default ;
+#line 133 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#133"
+
+#line 134 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#134"
+    mapping & operator = ( mapping && ) noexcept = default ;
+#line 135 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#135"
+
+#line 136 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#136"
+    mapping & operator = ( const mapping & ) noexcept = default ;
+#line 137 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#137"
+
+#line 138 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#138"
+    // Pads to PaddingValue; not at all if it is dynamic_extent.
+#line 139 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#139"
+    constexpr mapping( const Extents & ext ) noexcept
+#line 140 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#140"
+      : m_extents( ext )
+#line 141 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#141"
+      , m_padded_stride( Extents::rank() < 2 ? 0 : PaddingValue == dynamic_extent ? ext.extent(0)
+#line 142 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#142"
+                         : detail::least_multiple_at_least( PaddingValue, ext.extent(0) ) )
+#line 143 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#143"
+      {}
+#line 144 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#144"
+
+#line 145 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#145"
+    // Requires padding == PaddingValue unless PaddingValue is dynamic_extent.
+#line 146 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#146"
+    constexpr mapping( const Extents & ext, const index_type padding ) noexcept
+#line 147 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#147"
+      : m_extents( ext )
+#line 148 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#148"
+      , m_padded_stride( Extents::rank() > 1 ? detail::least_multiple_at_least( padding, ext.extent(0) ) : 0 )
+#line 149 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#149"
+      {}
+#line 150 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#150"
+
+#line 151 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#151"
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+#line 152 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#152"
+
+#line 153 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#153"
+  private:
+#line 154 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#154"
+
+#line 155 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#155"
+    // i0 + S1 * ( i1 + N1 * ( i2 + N2 * ( ... ) ) )
+#line 156 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#156"
+
+#line 157 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#157"
+    static constexpr index_type
+#line 158 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#158"
+    offset( size_t ) noexcept
+#line 159 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#159"
+      { return 0 ; }
+#line 160 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#160"
+
+#line 161 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#161"
+    template<class ... IndexType >
+#line 162 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#162"
+    constexpr index_type
+#line 163 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#163"
+    offset( const size_t r, index_type i, IndexType... indices ) const noexcept
+#line 164 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#164"
+      { return i + ( r == 0 ? m_padded_stride : m_extents.extent(r) ) * offset( r+1, indices... ); }
+#line 165 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#165"
+
+#line 166 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#166"
+  public:
+#line 167 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#167"
+
+#line 168 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#168"
+    constexpr index_type required_span_size() const noexcept {
+#line 169 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#169"
+      if constexpr ( Extents::rank() < 2 ) return Extents::rank() == 0 ? 1 : m_extents.extent(0) ;
+#line 170 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#170"
+      else {
+#line 171 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#171"
+        index_type size = m_padded_stride ;
+#line 172 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#172"
+        for ( size_t r = 1 ; r < Extents::rank() ; ++r ) size *= m_extents.extent(r);
+#line 173 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#173"
+        return size ;
+#line 174 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#174"
+      }
+#line 175 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#175"
+    }
+#line 176 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#176"
+
+#line 177 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#177"
+    template<class ... Indices >
+#line 178 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#178"
+    constexpr
+#line 179 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#179"
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+#line 180 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#180"
+    operator()( Indices ... indices ) const noexcept
+#line 181 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#181"
+      { return offset( 0, indices... ); }
+#line 182 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#182"
+
+#line 183 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#183"
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+#line 184 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#184"
+    static constexpr bool is_always_contiguous() noexcept
+#line 185 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#185"
+      { return Extents::rank() < 2 || ( static_padding_stride != dynamic_extent &&
+#line 186 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#186"
+                                        static_padding_stride == Extents::static_extent(0) ); }
+#line 187 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#187"
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+#line 188 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#188"
+
+#line 189 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#189"
+    constexpr bool is_unique()     const noexcept { return true ; }
+#line 190 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#190"
+    constexpr bool is_contiguous() const noexcept
+#line 191 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#191"
+      { return Extents::rank() < 2 || m_padded_stride == m_extents.extent(0) ; }
+#line 192 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#192"
+    constexpr bool is_strided()    const noexcept { return true ; }
+#line 193 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#193"
+
+#line 194 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#194"
+    constexpr index_type stride( const size_t R ) const noexcept {
+#line 195 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#195"
+      if ( R == 0 ) return 1 ;
+#line 196 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#196"
+      index_type stride_ = m_padded_stride ;
+#line 197 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#197"
+      for ( size_t r = padded_rank ; r < R ; ++r ) stride_ *= m_extents.extent(r);
+#line 198 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#198"
+      return stride_ ;
+#line 199 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#199"
+    }
+#line 200 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#200"
+
+#line 201 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#201"
+    // [mdspan.submdspan.mapping]
+#line 202 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#202"
+
+#line 203 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#203"
+    template<class ... SliceSpecifiers>
+#line 204 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#204"
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+#line 205 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#205"
+      { return detail::submdspan_mapping_impl<layout_left_padded>( src, slices... ); }
+#line 206 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#206"
+
+#line 207 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#207"
+  }; // class mapping
+#line 208 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#208"
+
+#line 209 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#209"
+}; // class layout_left_padded
+#line 210 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#210"
+
+#line 211 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#211"
+template<ptrdiff_t PaddingValue>
+#line 212 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#212"
+class layout_right_padded {
+#line 213 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#213"
+public:
+#line 214 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#214"
+
+#line 215 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#215"
+  static_assert( PaddingValue == dynamic_extent || PaddingValue > 0, "" );
+#line 216 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#216"
+
+#line 217 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#217"
+  template<class Extents>
+#line 218 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#218"
+  class mapping {
+#line 219 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#219"
+  private:
+#line 220 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#220"
+
+#line 221 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#221"
+    // Dimension rank-1 has unit stride, dimension rank-2 the padded stride.
+#line 222 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#222"
+    static constexpr size_t last = Extents::rank() > 0 ? Extents::rank() - 1 : 0 ;
+#line 223 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#223"
+    static constexpr size_t padded_rank = last > 0 ? last - 1 : 0 ;
+#line 224 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#224"
+
+#line 225 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#225"
+    Extents   m_extents {} ;
+#line 226 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#226"
+    ptrdiff_t m_padded_stride = 0 ;
+#line 227 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#227"
+
+#line 228 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#228"
+  public:
+#line 229 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#229"
+
+#line 230 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#230"
+    using index_type = ptrdiff_t ;
+#line 231 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#231"
+    using extents_type = Extents ;
+#line 232 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#232"
+    using layout_type = layout_right_padded ;
+#line 233 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#233"
+
+#line 234 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#234"
+    static constexpr ptrdiff_t padding_value = PaddingValue ;
+#line 235 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#235"
+
+#line 236 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#236"
+    // Stride of dimension rank-2 if it is known at compile time, else dynamic_extent.
+#line 237 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#237"
+    static constexpr ptrdiff_t static_padding_stride =
+#line 238 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#238"
+      detail::static_padding_stride( PaddingValue, Extents::rank() > 1 ? Extents::static_extent(last) : 1 );
+#line 239 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#239"
+
+#line 240 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#240"
+    constexpr mapping() noexcept = default ;
+#line 241 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#241"
+
+#line 242 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#242"
+    constexpr mapping( mapping && ) noexcept = default ;
+#line 243 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#243"
+
+#line 244 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#244"
+    constexpr mapping( const mapping & ) noexcept = default ;
+#line 245 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#245"
+
+#line 246 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#246"
+    mapping & operator = ( mapping && ) noexcept = default ;
+#line 247 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#247"
+
+#line 248 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#248"
+    mapping & operator = ( const mapping & ) noexcept = default ;
+#line 249 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#249"
+
+#line 250 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#250"
+    // Pads to PaddingValue; not at all if it is dynamic_extent.
+#line 251 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#251"
+    constexpr mapping( const Extents & ext ) noexcept
+#line 252 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#252"
+      : m_extents( ext )
+#line 253 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#253"
+      , m_padded_stride( Extents::rank() < 2 ? 0 : PaddingValue == dynamic_extent ? ext.extent(last)
+#line 254 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#254"
+                         : detail::least_multiple_at_least( PaddingValue, ext.extent(last) ) )
+#line 255 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#255"
+      {}
+#line 256 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#256"
+
+#line 257 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#257"
+    // Requires padding == PaddingValue unless PaddingValue is dynamic_extent.
+#line 258 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#258"
+    constexpr mapping( const Extents & ext, const index_type padding ) noexcept
+#line 259 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#259"
+      : m_extents( ext )
+#line 260 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#260"
+      , m_padded_stride( Extents::rank() > 1 ? detail::least_multiple_at_least( padding, ext.extent(last) ) : 0 )
+#line 261 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#261"
+      {}
+#line 262 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#262"
+
+#line 263 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#263"
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+#line 264 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#264"
+
+#line 265 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#265"
+  private:
+#line 266 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#266"
+
+#line 267 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#267"
+    // ( ( i0 * N1 + i1 ) * ... + i_{rank-2} ) * S_{rank-2} + i_{rank-1}
+#line 268 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#268"
+
+#line 269 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#269"
+    static constexpr index_type
+#line 270 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#270"
+    offset( const size_t , const ptrdiff_t sum )
+#line 271 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#271"
+      { return sum; }
+#line 272 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#272"
+
+#line 273 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#273"
+    template<class ... Indices >
+#line 274 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#274"
+    constexpr index_type
+#line 275 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#275"
+    offset( const size_t r, ptrdiff_t sum, const index_type i, Indices... indices ) const noexcept
+#line 276 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#276"
+      { return offset( r+1, sum * ( r == last ? m_padded_stride : m_extents.extent(r) ) + i, indices... ); }
+#line 277 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#277"
+
+#line 278 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#278"
+  public:
+#line 279 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#279"
+
+#line 280 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#280"
+    constexpr index_type required_span_size() const noexcept {
+#line 281 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#281"
+      if constexpr ( Extents::rank() < 2 ) return Extents::rank() == 0 ? 1 : m_extents.extent(0) ;
+#line 282 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#282"
+      else {
+#line 283 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#283"
+        index_type size = m_padded_stride ;
+#line 284 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#284"
+        for ( size_t r = 0 ; r < last ; ++r ) size *= m_extents.extent(r);
+#line 285 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#285"
+        return size ;
+#line 286 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#286"
+      }
+#line 287 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#287"
+    }
+#line 288 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#288"
+
+#line 289 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#289"
+    template<class ... Indices >
+#line 290 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#290"
+    constexpr
+#line 291 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#291"
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+#line 292 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#292"
+    operator()( Indices ... indices ) const noexcept
+#line 293 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#293"
+      { return offset( 0, 0, indices... ); }
+#line 294 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#294"
+
+#line 295 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#295"
+    static constexpr bool is_always_unique()     noexcept { return true ; }
+#line 296 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#296"
+    static constexpr bool is_always_contiguous() noexcept
+#line 297 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#297"
+      { return Extents::rank() < 2 || ( static_padding_stride != dynamic_extent &&
+#line 298 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#298"
+                                        static_padding_stride == Extents::static_extent(last) ); }
+#line 299 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#299"
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+#line 300 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#300"
+
+#line 301 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#301"
+    constexpr bool is_unique()     const noexcept { return true ; }
+#line 302 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#302"
+    constexpr bool is_contiguous() const noexcept
+#line 303 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#303"
+      { return Extents::rank() < 2 || m_padded_stride == m_extents.extent(last) ; }
+#line 304 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#304"
+    constexpr bool is_strided()    const noexcept { return true ; }
+#line 305 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#305"
+
+#line 306 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#306"
+    constexpr index_type stride( const size_t R ) const noexcept {
+#line 307 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#307"
+      if ( R == last ) return 1 ;
+#line 308 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#308"
+      index_type stride_ = m_padded_stride ;
+#line 309 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#309"
+      for ( size_t r = padded_rank ; r > R ; --r ) stride_ *= m_extents.extent(r);
+#line 310 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#310"
+      return stride_ ;
+#line 311 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#311"
+    }
+#line 312 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#312"
+
+#line 313 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#313"
+    // [mdspan.submdspan.mapping]
+#line 314 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#314"
+
+#line 315 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#315"
+    template<class ... SliceSpecifiers>
+#line 316 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#316"
+    friend constexpr auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+#line 317 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#317"
+      { return detail::submdspan_mapping_impl<layout_right_padded>( src, slices... ); }
+#line 318 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#318"
+
+#line 319 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#319"
+  }; // class mapping
+#line 320 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#320"
+
+#line 321 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#321"
+}; // class layout_right_padded
+#line 322 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#322"
+
+#line 323 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_padded.hpp#323"
+}}} // experimental::fundamentals_v3
+#line 1 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#1"
+//@HEADER
+#line 2 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#2"
+// ************************************************************************
+#line 3 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#3"
+//
+#line 4 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#4"
+//                        Kokkos v. 2.0
+#line 5 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#5"
+//              Copyright (2014) Sandia Corporation
+#line 6 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#6"
+//
+#line 7 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#7"
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+#line 8 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#8"
 // the U.S. Government retains certain rights in this software.
 #line 9 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/accessor_policy.hpp#9"
 //
@@ -1713,9 +2413,9 @@ public:
 #line 169 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/mdspan.hpp#169"
 
 #line 170 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/mdspan.hpp#170"
-  constexpr index_type static_extent( size_t k ) const noexcept
+  static constexpr index_type static_extent( size_t k ) noexcept
 #line 171 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/mdspan.hpp#171"
-    { return map_.extents().static_extent( k ); }
+    { return extents_type::static_extent( k ); }
 #line 172 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/mdspan.hpp#172"
 
 #line 173 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/mdspan.hpp#173"
@@ -1913,225 +2613,1279 @@ namespace experimental {
 #line 49 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#49"
 inline namespace fundamentals_v3 {
 #line 50 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#50"
-namespace detail {
-#line 51 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#51"
 
+#line 51 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#51"
+// [mdspan.submdspan.strided_slice]
 #line 52 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#52"
-template<class ExtentsNew, class ExtentsOld, class ... SliceSpecifiers>
+
 #line 53 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#53"
-struct compose_new_extents;
+// Selects the indices offset, offset+stride, ... in [offset, offset+extent).
 #line 54 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#54"
-
+// Each member may be an integer or an integral_constant.
 #line 55 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#55"
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
+template<class OffsetType, class ExtentType, class StrideType>
 #line 56 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#56"
-struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,all_type,SliceSpecifiers...> {
+struct strided_slice {
 #line 57 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#57"
-  typedef compose_new_extents<extents<ExtentsNew...,E0>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+  using offset_type = OffsetType;
 #line 58 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#58"
-  typedef typename next_compose_new_extents::extents_type extents_type; 
+  using extent_type = ExtentType;
 #line 59 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#59"
-
+  using stride_type = StrideType;
 #line 60 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#60"
-  template<class OrgExtents, class ... DynamicExtents>
+
 #line 61 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#61"
-  static constexpr extents_type create_sub_extents(const OrgExtents e,  
+  OffsetType offset{};
 #line 62 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#62"
-                        array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
+  ExtentType extent{};
 #line 63 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#63"
-                                                   all_type, SliceSpecifiers...s, DynamicExtents...de) {
+  StrideType stride{};
 #line 64 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#64"
-    strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+};
 #line 65 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#65"
-    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
+
 #line 66 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#66"
-  }
+template<class OffsetType, class ExtentType, class StrideType>
 #line 67 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#67"
-};
+strided_slice(OffsetType, ExtentType, StrideType) -> strided_slice<OffsetType, ExtentType, StrideType>;
 #line 68 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#68"
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
+
 #line 69 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#69"
-struct compose_new_extents<extents<ExtentsNew...>,extents<dynamic_extent,ExtentsOld...>,all_type,SliceSpecifiers...> {
+// [mdspan.submdspan.submdspan_mapping_result]
 #line 70 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#70"
-  typedef compose_new_extents<extents<ExtentsNew...,dynamic_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+
 #line 71 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#71"
-  typedef typename next_compose_new_extents::extents_type extents_type; 
+// Returned by submdspan_mapping: the sub mapping and the offset of
 #line 72 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#72"
-
+// its first element in the codomain of the source mapping.
 #line 73 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#73"
-  template<class OrgExtents, class ... DynamicExtents>
+template<class LayoutMapping>
 #line 74 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#74"
-  static constexpr extents_type create_sub_extents(const OrgExtents e,  
+struct submdspan_mapping_result {
 #line 75 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#75"
-                        array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
+  LayoutMapping mapping = LayoutMapping();
 #line 76 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#76"
-                                                   all_type, SliceSpecifiers...s, DynamicExtents...de) {
+  size_t offset{};
 #line 77 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#77"
-    strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+};
 #line 78 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#78"
-    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,e.extent(OrgExtents::rank()-sizeof...(SliceSpecifiers)-1));
+
 #line 79 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#79"
-  }
+}}} // experimental::fundamentals_v3
 #line 80 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#80"
-};
-#line 81 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#81"
 
+#line 81 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#81"
+//----------------------------------------------------------------------------
 #line 82 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#82"
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
+//----------------------------------------------------------------------------
 #line 83 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#83"
-struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,pair<IT,IT>,SliceSpecifiers...> {
+
 #line 84 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#84"
-  typedef compose_new_extents<extents<ExtentsNew...,dynamic_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents; 
+namespace std {
 #line 85 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#85"
-  typedef typename next_compose_new_extents::extents_type extents_type; 
+namespace experimental {
 #line 86 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#86"
-
+inline namespace fundamentals_v3 {
 #line 87 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#87"
-  template<class OrgExtents, class ... DynamicExtents>
+namespace detail {
 #line 88 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#88"
-  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
+
 #line 89 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#89"
-                                                   pair<IT,IT> p, SliceSpecifiers ... s, DynamicExtents...de) {
+template<class T>
 #line 90 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#90"
-    strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+struct is_integral_constant : false_type {};
 #line 91 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#91"
-    offset += p.first*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+
 #line 92 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#92"
-    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,ptrdiff_t(p.second-p.first));
+template<class T, T Value>
 #line 93 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#93"
-  }
+struct is_integral_constant<integral_constant<T,Value>> : true_type {};
 #line 94 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#94"
-};
-#line 95 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#95"
 
+#line 95 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#95"
+// Strip integral_constant down to its value
 #line 96 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#96"
-template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
+template<class T>
 #line 97 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#97"
-struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,IT,SliceSpecifiers...> {
+constexpr ptrdiff_t de_ice(const T val) { return ptrdiff_t(val); }
 #line 98 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#98"
-  typedef compose_new_extents<extents<ExtentsNew...>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+
 #line 99 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#99"
-  typedef typename next_compose_new_extents::extents_type extents_type; 
+template<class T, T Value>
 #line 100 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#100"
-
+constexpr ptrdiff_t de_ice(integral_constant<T,Value>) { return ptrdiff_t(Value); }
 #line 101 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#101"
-  template<class OrgExtents, class ... DynamicExtents>
+
 #line 102 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#102"
-  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset, 
+// Number of indices selected by a strided_slice
 #line 103 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#103"
-                                                   const ptrdiff_t v, SliceSpecifiers...s,DynamicExtents...de) {
+constexpr ptrdiff_t strided_slice_extent(const ptrdiff_t extent, const ptrdiff_t stride) {
 #line 104 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#104"
-    offset += v*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+  return extent == 0 ? 0 : 1 + (extent - 1) / stride;
 #line 105 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#105"
-    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
+}
 #line 106 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#106"
-  }
+
 #line 107 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#107"
-};
+// The sub extent is static if the slice's extent is a static zero,
 #line 108 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#108"
-
+// or if both its extent and its stride are static.
 #line 109 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#109"
-template<ptrdiff_t ... ExtentsNew>
+template<class ExtentType, class StrideType>
 #line 110 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#110"
-struct compose_new_extents<extents<ExtentsNew...>,extents<>> {
+struct strided_slice_static_extent {
 #line 111 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#111"
-  typedef extents<ExtentsNew...> extents_type; 
+  static constexpr ptrdiff_t value = dynamic_extent;
 #line 112 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#112"
-
+};
 #line 113 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#113"
-  template<class OrgExtents, class ... DynamicExtents>
+
 #line 114 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#114"
-  static constexpr extents_type create_sub_extents(const OrgExtents, array<ptrdiff_t,OrgExtents::rank()>, ptrdiff_t, DynamicExtents...de) {
+template<class T, T Extent, class StrideType>
 #line 115 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#115"
-    return extents_type(de...);
+struct strided_slice_static_extent<integral_constant<T,Extent>,StrideType> {
 #line 116 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#116"
-  }
+  static constexpr ptrdiff_t value = Extent == 0 ? ptrdiff_t(0) :
 #line 117 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#117"
-  template<class OrgExtents>
+    is_integral_constant<StrideType>::value ? strided_slice_extent(Extent,de_ice(StrideType())) :
 #line 118 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#118"
-  static constexpr extents_type create_sub_extents(const OrgExtents, array<ptrdiff_t,OrgExtents::rank()>, ptrdiff_t) {
+    ptrdiff_t(dynamic_extent);
 #line 119 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#119"
-    return extents_type();
+};
 #line 120 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#120"
-  }
+
 #line 121 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#121"
-};
+template<class ExtentsNew, class ExtentsOld, class ... SliceSpecifiers>
 #line 122 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#122"
-
+struct compose_new_extents;
 #line 123 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#123"
 
 #line 124 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#124"
-template<class Extents, class...SliceSpecifiers>
+template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
 #line 125 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#125"
-struct subspan_deduce_extents {
+struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,all_type,SliceSpecifiers...> {
 #line 126 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#126"
-  typedef typename compose_new_extents<extents<>,Extents,SliceSpecifiers...>::extents_type extents_type;
+  typedef compose_new_extents<extents<ExtentsNew...,E0>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
 #line 127 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#127"
-  typedef array<ptrdiff_t,Extents::rank()> stride_type;
+  typedef typename next_compose_new_extents::extents_type extents_type; 
 #line 128 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#128"
-  static constexpr extents_type create_sub_extents(const Extents e,stride_type& strides, ptrdiff_t& offset, SliceSpecifiers...s) {
+
 #line 129 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#129"
-    return compose_new_extents<extents<>,Extents,SliceSpecifiers...>::create_sub_extents(e,strides,offset,s...);
+  template<class OrgExtents, class ... DynamicExtents>
 #line 130 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#130"
-  }
+  static constexpr extents_type create_sub_extents(const OrgExtents e,  
 #line 131 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#131"
-};
+                        array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
 #line 132 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#132"
-
+                                                   all_type, SliceSpecifiers...s, DynamicExtents...de) {
 #line 133 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#133"
-}
+    strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
 #line 134 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#134"
-
+    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
 #line 135 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#135"
-template<class ElementType, class Extents, class LayoutPolicy,
+  }
 #line 136 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#136"
-           class AccessorPolicy, class... SliceSpecifiers>
+};
 #line 137 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#137"
-    basic_mdspan<ElementType, typename detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::extents_type,
+template<ptrdiff_t ... ExtentsNew, ptrdiff_t ... ExtentsOld, class ... SliceSpecifiers>
 #line 138 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#138"
-                 layout_stride, typename AccessorPolicy::offset_policy >
+struct compose_new_extents<extents<ExtentsNew...>,extents<dynamic_extent,ExtentsOld...>,all_type,SliceSpecifiers...> {
 #line 139 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#139"
-      subspan(const basic_mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src, SliceSpecifiers ... slices) noexcept {
+  typedef compose_new_extents<extents<ExtentsNew...,dynamic_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
 #line 140 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#140"
-    typedef typename detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::extents_type sub_extents_type;
+  typedef typename next_compose_new_extents::extents_type extents_type; 
 #line 141 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#141"
-    typedef typename AccessorPolicy::offset_policy sub_accessor_policy;
+
 #line 142 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#142"
-    typedef basic_mdspan<ElementType,sub_extents_type,layout_stride,sub_accessor_policy> sub_mdspan_type;
+  template<class OrgExtents, class ... DynamicExtents>
 #line 143 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#143"
-
+  static constexpr extents_type create_sub_extents(const OrgExtents e,  
 #line 144 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#144"
-    array<ptrdiff_t,Extents::rank()> strides;
+                        array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
 #line 145 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#145"
-    for(size_t r = 0; r<Extents::rank(); r++)
+                                                   all_type, SliceSpecifiers...s, DynamicExtents...de) {
 #line 146 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#146"
-      strides[r] = src.stride(r);
+    strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
 #line 147 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#147"
-
+    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,e.extent(OrgExtents::rank()-sizeof...(SliceSpecifiers)-1));
 #line 148 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#148"
-    ptrdiff_t offset = 0;
+  }
 #line 149 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#149"
-    sub_extents_type sub_extents = detail::subspan_deduce_extents<Extents,SliceSpecifiers...>::create_sub_extents(src.extents(),strides,offset,slices...);
+};
 #line 150 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#150"
 
 #line 151 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#151"
-    array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
+template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
 #line 152 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#152"
-    for(size_t r = 0; r<sub_extents_type::rank(); r++)
+struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,pair<IT,IT>,SliceSpecifiers...> {
 #line 153 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#153"
-      sub_strides[r] = strides[r];
+  typedef compose_new_extents<extents<ExtentsNew...,dynamic_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents; 
 #line 154 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#154"
-
+  typedef typename next_compose_new_extents::extents_type extents_type; 
 #line 155 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#155"
-    typename AccessorPolicy::offset_policy::pointer ptr = src.accessor().offset(src.data(),offset);    
+
 #line 156 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#156"
-    return sub_mdspan_type(ptr,typename sub_mdspan_type::mapping_type(sub_extents,sub_strides));
+  template<class OrgExtents, class ... DynamicExtents>
 #line 157 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#157"
-  }
+  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
 #line 158 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#158"
-
+                                                   pair<IT,IT> p, SliceSpecifiers ... s, DynamicExtents...de) {
 #line 159 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#159"
+    strides[sizeof...(ExtentsNew)] = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+#line 160 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#160"
+    offset += p.first*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+#line 161 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#161"
+    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,ptrdiff_t(p.second-p.first));
+#line 162 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#162"
+  }
+#line 163 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#163"
+};
+#line 164 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#164"
+
+#line 165 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#165"
+template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class OT, class ET, class ST, class ... SliceSpecifiers>
+#line 166 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#166"
+struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,strided_slice<OT,ET,ST>,SliceSpecifiers...> {
+#line 167 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#167"
+  static constexpr ptrdiff_t sub_static_extent = strided_slice_static_extent<ET,ST>::value;
+#line 168 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#168"
+  typedef compose_new_extents<extents<ExtentsNew...,sub_static_extent>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+#line 169 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#169"
+  typedef typename next_compose_new_extents::extents_type extents_type;
+#line 170 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#170"
+
+#line 171 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#171"
+  template<class OrgExtents, class ... DynamicExtents>
+#line 172 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#172"
+  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset,
+#line 173 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#173"
+                                                   strided_slice<OT,ET,ST> p, SliceSpecifiers ... s, DynamicExtents...de) {
+#line 174 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#174"
+    const ptrdiff_t org_stride = strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+#line 175 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#175"
+    const ptrdiff_t slice_extent = de_ice(p.extent);
+#line 176 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#176"
+    const ptrdiff_t slice_stride = de_ice(p.stride);
+#line 177 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#177"
+    // A stride not smaller than the extent selects at most one index,
+#line 178 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#178"
+    // so keep the original stride in that case.
+#line 179 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#179"
+    strides[sizeof...(ExtentsNew)] = slice_stride < slice_extent ? org_stride*slice_stride : org_stride;
+#line 180 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#180"
+    offset += de_ice(p.offset)*org_stride;
+#line 181 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#181"
+    if constexpr (sub_static_extent == dynamic_extent)
+#line 182 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#182"
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...,strided_slice_extent(slice_extent,slice_stride));
+#line 183 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#183"
+    else
+#line 184 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#184"
+      return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
+#line 185 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#185"
+  }
+#line 186 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#186"
+};
+#line 187 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#187"
+
+#line 188 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#188"
+template<ptrdiff_t ... ExtentsNew, ptrdiff_t E0, ptrdiff_t ... ExtentsOld, class IT, class ... SliceSpecifiers>
+#line 189 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#189"
+struct compose_new_extents<extents<ExtentsNew...>,extents<E0,ExtentsOld...>,IT,SliceSpecifiers...> {
+#line 190 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#190"
+  typedef compose_new_extents<extents<ExtentsNew...>,extents<ExtentsOld...>,SliceSpecifiers...> next_compose_new_extents;
+#line 191 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#191"
+  typedef typename next_compose_new_extents::extents_type extents_type; 
+#line 192 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#192"
+
+#line 193 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#193"
+  template<class OrgExtents, class ... DynamicExtents>
+#line 194 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#194"
+  static constexpr extents_type create_sub_extents(const OrgExtents e, array<ptrdiff_t,OrgExtents::rank()>& strides, ptrdiff_t& offset, 
+#line 195 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#195"
+                                                   const ptrdiff_t v, SliceSpecifiers...s,DynamicExtents...de) {
+#line 196 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#196"
+    offset += v*strides[OrgExtents::rank()-sizeof...(SliceSpecifiers)-1];
+#line 197 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#197"
+    return next_compose_new_extents::create_sub_extents(e,strides,offset,s...,de...);
+#line 198 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#198"
+  }
+#line 199 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#199"
+};
+#line 200 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#200"
+
+#line 201 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#201"
+template<ptrdiff_t ... ExtentsNew>
+#line 202 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#202"
+struct compose_new_extents<extents<ExtentsNew...>,extents<>> {
+#line 203 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#203"
+  typedef extents<ExtentsNew...> extents_type; 
+#line 204 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#204"
+
+#line 205 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#205"
+  template<class OrgExtents, class ... DynamicExtents>
+#line 206 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#206"
+  static constexpr extents_type create_sub_extents(const OrgExtents, array<ptrdiff_t,OrgExtents::rank()>, ptrdiff_t, DynamicExtents...de) {
+#line 207 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#207"
+    return extents_type(de...);
+#line 208 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#208"
+  }
+#line 209 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#209"
+  template<class OrgExtents>
+#line 210 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#210"
+  static constexpr extents_type create_sub_extents(const OrgExtents, array<ptrdiff_t,OrgExtents::rank()>, ptrdiff_t) {
+#line 211 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#211"
+    return extents_type();
+#line 212 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#212"
+  }
+#line 213 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#213"
+};
+#line 214 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#214"
+
+#line 215 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#215"
+
+#line 216 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#216"
+template<class Extents, class...SliceSpecifiers>
+#line 217 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#217"
+struct subspan_deduce_extents {
+#line 218 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#218"
+  typedef typename compose_new_extents<extents<>,Extents,SliceSpecifiers...>::extents_type extents_type;
+#line 219 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#219"
+  typedef array<ptrdiff_t,Extents::rank()> stride_type;
+#line 220 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#220"
+  static constexpr extents_type create_sub_extents(const Extents e,stride_type& strides, ptrdiff_t& offset, SliceSpecifiers...s) {
+#line 221 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#221"
+    return compose_new_extents<extents<>,Extents,SliceSpecifiers...>::create_sub_extents(e,strides,offset,s...);
+#line 222 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#222"
+  }
+#line 223 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#223"
+};
+#line 224 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#224"
+
+#line 225 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#225"
+
+#line 226 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#226"
+template<class T>
+#line 227 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#227"
+struct is_full_slice : is_convertible<T,all_type> {};
+#line 228 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#228"
+
+#line 229 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#229"
+template<class T>
+#line 230 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#230"
+struct is_index_slice : is_convertible<T,ptrdiff_t> {};
+#line 231 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#231"
+
+#line 232 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#232"
+// Slices selecting a contiguous index range: pairs, and strided_slices
+#line 233 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#233"
+// whose stride is statically one.
+#line 234 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#234"
+template<class T>
+#line 235 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#235"
+struct is_range_slice : false_type {};
+#line 236 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#236"
+
+#line 237 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#237"
+template<class IT>
+#line 238 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#238"
+struct is_range_slice<pair<IT,IT>> : true_type {};
+#line 239 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#239"
+
+#line 240 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#240"
+template<class OT, class ET, class T>
+#line 241 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#241"
+struct is_range_slice<strided_slice<OT,ET,integral_constant<T,1>>> : true_type {};
+#line 242 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#242"
+
+#line 243 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#243"
+template<class ... SliceSpecifiers>
+#line 244 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#244"
+constexpr size_t sub_rank() {
+#line 245 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#245"
+  return ( size_t(0) + ... + size_t(is_index_slice<SliceSpecifiers>::value ? 0 : 1) );
+#line 246 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#246"
+}
+#line 247 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#247"
+
+#line 248 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#248"
+// layout_left is preserved if the leading sub_rank-1 slices are full,
+#line 249 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#249"
+// the next one is full or a range, and the rest are indices.
+#line 250 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#250"
+template<class ... SliceSpecifiers>
+#line 251 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#251"
+constexpr bool preserves_layout_left() {
+#line 252 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#252"
+  constexpr size_t R = sizeof...(SliceSpecifiers);
+#line 253 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#253"
+  constexpr size_t sub_R = sub_rank<SliceSpecifiers...>();
+#line 254 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#254"
+  constexpr bool full[R+1] = { is_full_slice<SliceSpecifiers>::value..., false };
+#line 255 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#255"
+  constexpr bool range[R+1] = { is_range_slice<SliceSpecifiers>::value..., false };
+#line 256 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#256"
+  if(sub_R == 0) return true;
+#line 257 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#257"
+  for(size_t k = 0; k+1 < sub_R; k++)
+#line 258 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#258"
+    if(!full[k]) return false;
+#line 259 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#259"
+  return full[sub_R-1] || range[sub_R-1];
+#line 260 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#260"
+}
+#line 261 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#261"
+
+#line 262 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#262"
+// layout_right is preserved if the trailing sub_rank-1 slices are full,
+#line 263 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#263"
+// the one before them is full or a range, and the rest are indices.
+#line 264 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#264"
+template<class ... SliceSpecifiers>
+#line 265 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#265"
+constexpr bool preserves_layout_right() {
+#line 266 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#266"
+  constexpr size_t R = sizeof...(SliceSpecifiers);
+#line 267 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#267"
+  constexpr size_t sub_R = sub_rank<SliceSpecifiers...>();
+#line 268 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#268"
+  constexpr bool full[R+1] = { is_full_slice<SliceSpecifiers>::value..., false };
+#line 269 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#269"
+  constexpr bool range[R+1] = { is_range_slice<SliceSpecifiers>::value..., false };
+#line 270 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#270"
+  if(sub_R == 0) return true;
+#line 271 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#271"
+  for(size_t k = R-sub_R+1; k < R; k++)
+#line 272 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#272"
+    if(!full[k]) return false;
+#line 273 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#273"
+  return full[R-sub_R] || range[R-sub_R];
+#line 274 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#274"
+}
+#line 275 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#275"
+
+#line 276 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#276"
+// For a source whose last dimension has unit stride and whose other
+#line 277 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#277"
+// strides are products of the extents to their right, as in layout_right
+#line 278 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#278"
+// and layout_right_padded: the dimension whose stride becomes the padded
+#line 279 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#279"
+// stride of a layout_right_padded result, or -1 if there is none.  The
+#line 280 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#280"
+// last slice must be full or a range, so that the result keeps unit
+#line 281 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#281"
+// stride there.  With two dimensions kept the outer one may be any
+#line 282 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#282"
+// slice, its stride becoming the padding.  With more, the kept ones up
+#line 283 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#283"
+// to the padded one must be adjacent and full, but for the first, which
+#line 284 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#284"
+// may also be a range, so that their strides stay products of extents.
+#line 285 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#285"
+constexpr ptrdiff_t right_padded_dimension( const size_t R, const bool * full, const bool * range,
+#line 286 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#286"
+                                            const bool * index ) {
+#line 287 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#287"
+  size_t sub_R = 0;
+#line 288 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#288"
+  for(size_t r = 0; r < R; r++)
+#line 289 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#289"
+    if(!index[r]) sub_R++;
+#line 290 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#290"
+  if(sub_R < 2 || !(full[R-1] || range[R-1])) return -1;
+#line 291 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#291"
+  ptrdiff_t pad = ptrdiff_t(R) - 2;
+#line 292 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#292"
+  while(index[pad]) pad--;
+#line 293 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#293"
+  if(sub_R == 2) return pad;
+#line 294 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#294"
+  const ptrdiff_t first = pad - ptrdiff_t(sub_R) + 2;
+#line 295 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#295"
+  for(ptrdiff_t r = first+1; r <= pad; r++)
+#line 296 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#296"
+    if(!full[r]) return -1;
+#line 297 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#297"
+  return full[first] || range[first] ? pad : -1;
+#line 298 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#298"
+}
+#line 299 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#299"
+
+#line 300 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#300"
+// right_padded_dimension for a layout_right (Right) or, with the slices
+#line 301 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#301"
+// reversed, a layout_left source.
+#line 302 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#302"
+template<bool Right, class ... SliceSpecifiers>
+#line 303 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#303"
+constexpr ptrdiff_t padded_dimension() {
+#line 304 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#304"
+  constexpr size_t R = sizeof...(SliceSpecifiers);
+#line 305 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#305"
+  constexpr bool full[R+1] = { is_full_slice<SliceSpecifiers>::value..., false };
+#line 306 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#306"
+  constexpr bool range[R+1] = { is_range_slice<SliceSpecifiers>::value..., false };
+#line 307 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#307"
+  constexpr bool index[R+1] = { is_index_slice<SliceSpecifiers>::value..., false };
+#line 308 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#308"
+  bool f[R+1] = {}, g[R+1] = {}, x[R+1] = {};
+#line 309 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#309"
+  for(size_t r = 0; r < R; r++) {
+#line 310 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#310"
+    const size_t q = Right ? r : R-1-r;
+#line 311 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#311"
+    f[r] = full[q]; g[r] = range[q]; x[r] = index[q];
+#line 312 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#312"
+  }
+#line 313 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#313"
+  const ptrdiff_t d = right_padded_dimension(R,f,g,x);
+#line 314 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#314"
+  return d < 0 || Right ? d : ptrdiff_t(R)-1-d;
+#line 315 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#315"
+}
+#line 316 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#316"
+
+#line 317 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#317"
+// Stride of dimension r of Layout's mappings of Extents if it is known
+#line 318 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#318"
+// at compile time, else dynamic_extent.
+#line 319 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#319"
+template<class Layout, class Extents>
+#line 320 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#320"
+constexpr ptrdiff_t static_stride( const size_t r ) {
+#line 321 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#321"
+  constexpr size_t R = Extents::rank();
+#line 322 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#322"
+  ptrdiff_t stride = 1;
+#line 323 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#323"
+  size_t begin = 0, end = 0;
+#line 324 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#324"
+  if constexpr (is_same<Layout,layout_left>::value) { end = r; }
+#line 325 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#325"
+  else if constexpr (is_same<Layout,layout_right>::value) { begin = r+1; end = R; }
+#line 326 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#326"
+  else if constexpr (is_layout_left_padded<Layout>::value) {
+#line 327 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#327"
+    if(r == 0) return 1;
+#line 328 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#328"
+    stride = Layout::template mapping<Extents>::static_padding_stride;
+#line 329 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#329"
+    begin = 1; end = r;
+#line 330 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#330"
+  }
+#line 331 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#331"
+  else if constexpr (is_layout_right_padded<Layout>::value) {
+#line 332 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#332"
+    if(r == R-1) return 1;
+#line 333 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#333"
+    stride = Layout::template mapping<Extents>::static_padding_stride;
+#line 334 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#334"
+    begin = r+1; end = R-1;
+#line 335 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#335"
+  }
+#line 336 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#336"
+  else return dynamic_extent;
+#line 337 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#337"
+  for(size_t q = begin; q < end; q++) {
+#line 338 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#338"
+    if(stride == dynamic_extent || Extents::static_extent(q) == dynamic_extent) return dynamic_extent;
+#line 339 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#339"
+    stride *= Extents::static_extent(q);
+#line 340 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#340"
+  }
+#line 341 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#341"
+  return stride;
+#line 342 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#342"
+}
+#line 343 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#343"
+
+#line 344 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#344"
+// Factor by which a slice multiplies the stride of its dimension, if
+#line 345 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#345"
+// it is known at compile time, else dynamic_extent.
+#line 346 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#346"
+template<class T>
+#line 347 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#347"
+struct static_slice_stride {
+#line 348 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#348"
+  static constexpr ptrdiff_t value = 1;
+#line 349 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#349"
+};
+#line 350 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#350"
+
+#line 351 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#351"
+template<class OT, class ET, class ST>
+#line 352 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#352"
+struct static_slice_stride<strided_slice<OT,ET,ST>> {
+#line 353 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#353"
+  static constexpr ptrdiff_t value = is_integral_constant<ST>::value ? de_ice(ST()) : ptrdiff_t(dynamic_extent);
+#line 354 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#354"
+};
+#line 355 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#355"
+
+#line 356 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#356"
+template<size_t D, class ... SliceSpecifiers>
+#line 357 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#357"
+constexpr ptrdiff_t static_slice_stride_of() {
+#line 358 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#358"
+  constexpr ptrdiff_t stride[] = { static_slice_stride<SliceSpecifiers>::value..., 0 };
+#line 359 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#359"
+  return stride[D];
+#line 360 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#360"
+}
+#line 361 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#361"
+
+#line 362 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#362"
+// Shared implementation of submdspan_mapping for strided layouts.
+#line 363 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#363"
+// Layout is the layout of the source mapping.  layout_left and
+#line 364 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#364"
+// layout_right are kept whenever the slices allow it.  Otherwise, if the
+#line 365 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#365"
+// innermost dimension keeps unit stride, the result is
+#line 366 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#366"
+// layout_left_padded or layout_right_padded, with a static padding value
+#line 367 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#367"
+// when the padded stride is known at compile time, as in every other row
+#line 368 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#368"
+// of a static matrix.  Any other result is layout_stride.
+#line 369 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#369"
+template<class Layout, class Mapping, class ... SliceSpecifiers>
+#line 370 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#370"
+constexpr auto submdspan_mapping_impl( const Mapping & src, SliceSpecifiers ... slices ) {
+#line 371 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#371"
+  typedef typename Mapping::extents_type org_extents_type;
+#line 372 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#372"
+  typedef subspan_deduce_extents<org_extents_type,SliceSpecifiers...> deduce_type;
+#line 373 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#373"
+  typedef typename deduce_type::extents_type sub_extents_type;
+#line 374 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#374"
+  constexpr bool left_source = is_same<Layout,layout_left>::value || is_layout_left_padded<Layout>::value;
+#line 375 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#375"
+  constexpr bool right_source = is_same<Layout,layout_right>::value || is_layout_right_padded<Layout>::value;
+#line 376 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#376"
+  // A padded source stays padded unless at most one dimension is left.
+#line 377 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#377"
+  constexpr bool contiguous_source = ! is_layout_left_padded<Layout>::value && ! is_layout_right_padded<Layout>::value;
+#line 378 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#378"
+  constexpr size_t sub_R = sub_extents_type::rank();
+#line 379 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#379"
+
+#line 380 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#380"
+  if constexpr (org_extents_type::rank() == 0) {
+#line 381 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#381"
+    return submdspan_mapping_result<Mapping>{src,0};
+#line 382 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#382"
+  }
+#line 383 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#383"
+  else {
+#line 384 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#384"
+    array<ptrdiff_t,org_extents_type::rank()> strides;
+#line 385 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#385"
+    for(size_t r = 0; r<org_extents_type::rank(); r++)
+#line 386 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#386"
+      strides[r] = src.stride(r);
+#line 387 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#387"
+
+#line 388 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#388"
+    ptrdiff_t offset = 0;
+#line 389 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#389"
+    sub_extents_type sub_extents = deduce_type::create_sub_extents(src.extents(),strides,offset,slices...);
+#line 390 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#390"
+
+#line 391 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#391"
+    if constexpr (left_source && (contiguous_source || sub_R < 2) && preserves_layout_left<SliceSpecifiers...>()) {
+#line 392 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#392"
+      typedef layout_left::mapping<sub_extents_type> sub_mapping_type;
+#line 393 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#393"
+      return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents),size_t(offset)};
+#line 394 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#394"
+    }
+#line 395 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#395"
+    else if constexpr (right_source && (contiguous_source || sub_R < 2) && preserves_layout_right<SliceSpecifiers...>()) {
+#line 396 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#396"
+      typedef layout_right::mapping<sub_extents_type> sub_mapping_type;
+#line 397 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#397"
+      return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents),size_t(offset)};
+#line 398 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#398"
+    }
+#line 399 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#399"
+    else if constexpr ((left_source || right_source) && padded_dimension<right_source,SliceSpecifiers...>() >= 0) {
+#line 400 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#400"
+      constexpr ptrdiff_t d = padded_dimension<right_source,SliceSpecifiers...>();
+#line 401 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#401"
+      constexpr ptrdiff_t org_stride = static_stride<Layout,org_extents_type>(d);
+#line 402 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#402"
+      constexpr ptrdiff_t slice_stride = static_slice_stride_of<d,SliceSpecifiers...>();
+#line 403 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#403"
+      constexpr ptrdiff_t padding = org_stride == dynamic_extent || slice_stride == dynamic_extent ?
+#line 404 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#404"
+                                    ptrdiff_t(dynamic_extent) : org_stride*slice_stride;
+#line 405 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#405"
+      typedef conditional_t<right_source,layout_right_padded<padding>,layout_left_padded<padding>> sub_layout_type;
+#line 406 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#406"
+      typedef typename sub_layout_type::template mapping<sub_extents_type> sub_mapping_type;
+#line 407 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#407"
+      if constexpr (padding == dynamic_extent)
+#line 408 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#408"
+        return submdspan_mapping_result<sub_mapping_type>{
+#line 409 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#409"
+          sub_mapping_type(sub_extents,strides[right_source ? sub_R-2 : 1]),size_t(offset)};
+#line 410 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#410"
+      else
+#line 411 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#411"
+        return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents),size_t(offset)};
+#line 412 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#412"
+    }
+#line 413 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#413"
+    else {
+#line 414 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#414"
+      typedef layout_stride::mapping<sub_extents_type> sub_mapping_type;
+#line 415 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#415"
+      array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
+#line 416 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#416"
+      for(size_t r = 0; r<sub_extents_type::rank(); r++)
+#line 417 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#417"
+        sub_strides[r] = strides[r];
+#line 418 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#418"
+      return submdspan_mapping_result<sub_mapping_type>{sub_mapping_type(sub_extents,sub_strides),size_t(offset)};
+#line 419 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#419"
+    }
+#line 420 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#420"
+  }
+#line 421 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#421"
+}
+#line 422 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#422"
+
+#line 423 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#423"
+// Call submdspan_mapping found by argument dependent lookup; mappings
+#line 424 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#424"
+// without one fall back to a layout_stride result computed from stride().
+#line 425 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#425"
+template<class Mapping, class ... SliceSpecifiers>
+#line 426 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#426"
+constexpr auto invoke_submdspan_mapping( int, const Mapping & src, SliceSpecifiers ... slices )
+#line 427 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#427"
+  -> decltype( submdspan_mapping( src, slices... ) )
+#line 428 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#428"
+  { return submdspan_mapping( src, slices... ); }
+#line 429 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#429"
+
+#line 430 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#430"
+template<class Mapping, class ... SliceSpecifiers>
+#line 431 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#431"
+constexpr auto invoke_submdspan_mapping( long, const Mapping & src, SliceSpecifiers ... slices )
+#line 432 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#432"
+  {
+#line 433 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#433"
+    static_assert( Mapping::is_always_strided(),
+#line 434 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#434"
+                   "subspan of a layout that is not always strided needs a submdspan_mapping overload" );
+#line 435 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#435"
+    return submdspan_mapping_impl<layout_stride>( src, slices... );
+#line 436 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#436"
+  }
+#line 437 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#437"
+
+#line 438 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#438"
+}
+#line 439 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#439"
+
+#line 440 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#440"
+// The layout of the result is the layout_type of the mapping returned by
+#line 441 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#441"
+// submdspan_mapping.  Custom layouts customize subspan by providing
+#line 442 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#442"
+// submdspan_mapping as a hidden friend of their mapping.
+#line 443 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#443"
+template<class ElementType, class Extents, class LayoutPolicy,
+#line 444 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#444"
+           class AccessorPolicy, class... SliceSpecifiers>
+#line 445 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#445"
+    auto subspan(const basic_mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& src, SliceSpecifiers ... slices) noexcept {
+#line 446 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#446"
+    auto sub_map_offset = detail::invoke_submdspan_mapping(0,src.mapping(),slices...);
+#line 447 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#447"
+
+#line 448 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#448"
+    typedef decltype(sub_map_offset.mapping) sub_mapping_type;
+#line 449 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#449"
+    typedef typename sub_mapping_type::extents_type sub_extents_type;
+#line 450 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#450"
+    typedef typename sub_mapping_type::layout_type sub_layout_type;
+#line 451 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#451"
+    typedef typename AccessorPolicy::offset_policy sub_accessor_policy;
+#line 452 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#452"
+    typedef basic_mdspan<ElementType,sub_extents_type,sub_layout_type,sub_accessor_policy> sub_mdspan_type;
+#line 453 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#453"
+
+#line 454 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#454"
+    typename sub_accessor_policy::pointer ptr = src.accessor().offset(src.data(),sub_map_offset.offset);
+#line 455 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#455"
+    return sub_mdspan_type(ptr,sub_map_offset.mapping,sub_accessor_policy(src.accessor()));
+#line 456 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#456"
+  }
+#line 457 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#457"
+
+#line 458 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/subspan.hpp#458"
+}}}
+#line 1 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#1"
+//@HEADER
+#line 2 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#2"
+// ************************************************************************
+#line 3 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#3"
+//
+#line 4 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#4"
+//                        Kokkos v. 2.0
+#line 5 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#5"
+//              Copyright (2014) Sandia Corporation
+#line 6 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#6"
+//
+#line 7 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#7"
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+#line 8 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#8"
+// the U.S. Government retains certain rights in this software.
+#line 9 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#9"
+//
+#line 10 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#10"
+// Kokkos is licensed under 3-clause BSD terms of use:
+#line 11 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#11"
+//
+#line 12 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#12"
+// Redistribution and use in source and binary forms, with or without
+#line 13 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#13"
+// modification, are permitted provided that the following conditions are
+#line 14 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#14"
+// met:
+#line 15 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#15"
+//
+#line 16 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#16"
+// 1. Redistributions of source code must retain the above copyright
+#line 17 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#17"
+// notice, this list of conditions and the following disclaimer.
+#line 18 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#18"
+//
+#line 19 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#19"
+// 2. Redistributions in binary form must reproduce the above copyright
+#line 20 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#20"
+// notice, this list of conditions and the following disclaimer in the
+#line 21 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#21"
+// documentation and/or other materials provided with the distribution.
+#line 22 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#22"
+//
+#line 23 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#23"
+// 3. Neither the name of the Corporation nor the names of the
+#line 24 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#24"
+// contributors may be used to endorse or promote products derived from
+#line 25 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#25"
+// this software without specific prior written permission.
+#line 26 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#26"
+//
+#line 27 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#27"
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+#line 28 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#28"
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#line 29 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#29"
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#line 30 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#30"
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+#line 31 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#31"
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#line 32 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#32"
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#line 33 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#33"
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#line 34 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#34"
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#line 35 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#35"
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#line 36 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#36"
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#line 37 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#37"
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#line 38 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#38"
+//
+#line 39 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#39"
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+#line 40 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#40"
+//
+#line 41 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#41"
+// ************************************************************************
+#line 42 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#42"
+//@HEADER
+#line 43 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#43"
+
+#line 44 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#44"
+//--------------------------------------------------------------------------
+#line 45 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#45"
+//--------------------------------------------------------------------------
+#line 46 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#46"
+
+#line 47 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#47"
+namespace std {
+#line 48 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#48"
+namespace experimental {
+#line 49 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#49"
+inline namespace fundamentals_v3 {
+#line 50 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#50"
+
+#line 51 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#51"
+// Strided layout which permits zero strides.  A dimension with stride zero
+#line 52 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#52"
+// is a broadcast dimension: all of its indices map to the same offsets,
+#line 53 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#53"
+// so the mapping is not unique.
+#line 54 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#54"
+class layout_broadcast ;
+#line 55 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#55"
+
+#line 56 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#56"
 }}}
+#line 57 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#57"
+
+#line 58 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#58"
+//--------------------------------------------------------------------------
+#line 59 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#59"
+//--------------------------------------------------------------------------
+#line 60 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#60"
+
+#line 61 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#61"
+namespace std {
+#line 62 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#62"
+namespace experimental {
+#line 63 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#63"
+inline namespace fundamentals_v3 {
+#line 64 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#64"
+
+#line 65 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#65"
+class layout_broadcast {
+#line 66 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#66"
+public:
+#line 67 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#67"
+
+#line 68 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#68"
+  template<class Extents>
+#line 69 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#69"
+  class mapping {
+#line 70 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#70"
+  private:
+#line 71 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#71"
+
+#line 72 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#72"
+    using stride_t = array<ptrdiff_t,Extents::rank()> ;
+#line 73 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#73"
+
+#line 74 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#74"
+    Extents   m_extents ;
+#line 75 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#75"
+    stride_t  m_stride ;
+#line 76 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#76"
+    int       m_contig ;
+#line 77 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#77"
+    int       m_unique ;
+#line 78 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#78"
+
+#line 79 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#79"
+  public:
+#line 80 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#80"
+
+#line 81 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#81"
+    using index_type = ptrdiff_t ;
+#line 82 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#82"
+    using extents_type = Extents ;
+#line 83 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#83"
+    using layout_type = layout_broadcast ;
+#line 84 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#84"
+
+#line 85 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#85"
+    constexpr mapping() noexcept = default ;
+#line 86 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#86"
+
+#line 87 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#87"
+    constexpr mapping( mapping && ) noexcept = default ;
+#line 88 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#88"
+
+#line 89 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#89"
+    constexpr mapping( const mapping & ) noexcept = default ;
+#line 90 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#90"
+
+#line 91 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#91"
+    mapping & operator = ( mapping && ) noexcept = default ;
+#line 92 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#92"
+
+#line 93 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#93"
+    mapping & operator = ( const mapping & ) noexcept = default ;
+#line 94 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#94"
+
+#line 95 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#95"
+    mapping( const Extents & ext, const stride_t & str ) noexcept
+#line 96 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#96"
+      : m_extents(ext), m_stride(str), m_contig(1), m_unique(1)
+#line 97 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#97"
+      {
+#line 98 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#98"
+        // Broadcast dimensions neither add to the span nor leave holes
+#line 99 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#99"
+        // in it, so contiguity is decided by the remaining dimensions.
+#line 100 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#100"
+        int p[ Extents::rank() ? Extents::rank() : 1 ];
+#line 101 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#101"
+        size_t n = 0 ;
+#line 102 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#102"
+
+#line 103 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#103"
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
+#line 104 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#104"
+
+#line 105 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#105"
+          if ( m_stride[i] == 0 ) {
+#line 106 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#106"
+            if ( m_extents.extent(i) > 1 ) { m_unique = 0 ; }
+#line 107 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#107"
+            continue ;
+#line 108 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#108"
+          }
+#line 109 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#109"
+
+#line 110 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#110"
+          int j = n ;
+#line 111 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#111"
+
+#line 112 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#112"
+          while ( j && m_stride[i] < m_stride[ p[j-1] ] )
+#line 113 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#113"
+           { p[j] = p[j-1] ; --j ; }
+#line 114 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#114"
+
+#line 115 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#115"
+          p[j] = i ;
+#line 116 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#116"
+          ++n ;
+#line 117 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#117"
+        }
+#line 118 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#118"
+
+#line 119 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#119"
+        if ( n && m_stride[ p[0] ] != 1 ) { m_contig = 0 ; }
+#line 120 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#120"
+
+#line 121 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#121"
+        for ( size_t i = 1 ; i < n ; ++i ) {
+#line 122 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#122"
+          const int j = p[i-1];
+#line 123 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#123"
+          const int k = p[i];
+#line 124 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#124"
+          const index_type prev = m_stride[j] * m_extents.extent(j);
+#line 125 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#125"
+          if ( m_stride[k] != prev ) { m_contig = 0 ; }
+#line 126 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#126"
+        }
+#line 127 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#127"
+      }
+#line 128 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#128"
+
+#line 129 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#129"
+    constexpr const Extents & extents() const noexcept { return m_extents ; }
+#line 130 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#130"
+
+#line 131 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#131"
+  private:
+#line 132 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#132"
+
+#line 133 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#133"
+    // i0 * S0 + i1 * S1 + i2 * S2 + ...
+#line 134 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#134"
+
+#line 135 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#135"
+    constexpr index_type
+#line 136 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#136"
+    offset(size_t) const noexcept
+#line 137 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#137"
+      { return 0 ; }
+#line 138 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#138"
+
+#line 139 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#139"
+    template<class... IndexType >
+#line 140 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#140"
+    constexpr index_type
+#line 141 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#141"
+    offset( const size_t K, const index_type i, IndexType... indices ) const noexcept
+#line 142 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#142"
+      { return i * m_stride[K] + offset(K+1,indices...); }
+#line 143 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#143"
+
+#line 144 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#144"
+  public:
+#line 145 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#145"
+
+#line 146 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#146"
+    index_type required_span_size() const noexcept
+#line 147 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#147"
+      {
+#line 148 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#148"
+        index_type size = 1 ;
+#line 149 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#149"
+        for ( size_t i = 0 ; i < Extents::rank() ; ++i ) {
+#line 150 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#150"
+          if ( m_extents.extent(i) == 0 ) return 0 ;
+#line 151 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#151"
+          size += m_stride[i] * ( m_extents.extent(i) - 1 );
+#line 152 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#152"
+        }
+#line 153 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#153"
+        return size ;
+#line 154 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#154"
+      }
+#line 155 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#155"
+
+#line 156 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#156"
+    template<class ... Indices >
+#line 157 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#157"
+    constexpr
+#line 158 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#158"
+    typename enable_if<sizeof...(Indices) == Extents::rank(),index_type>::type
+#line 159 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#159"
+    operator()( Indices ... indices ) const noexcept
+#line 160 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#160"
+      { return offset(0, indices... ); }
+#line 161 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#161"
+
+#line 162 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#162"
+    static constexpr bool is_always_unique()     noexcept { return false ; }
+#line 163 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#163"
+    static constexpr bool is_always_contiguous() noexcept { return false ; }
+#line 164 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#164"
+    static constexpr bool is_always_strided()    noexcept { return true ; }
+#line 165 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#165"
+
+#line 166 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#166"
+    constexpr bool is_unique()     const noexcept { return m_unique ; }
+#line 167 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#167"
+    constexpr bool is_contiguous() const noexcept { return m_contig ; }
+#line 168 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#168"
+    constexpr bool is_strided()    const noexcept { return true ; }
+#line 169 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#169"
+
+#line 170 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#170"
+    constexpr index_type stride(size_t r) const noexcept
+#line 171 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#171"
+      { return m_stride[r]; }
+#line 172 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#172"
+
+#line 173 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#173"
+    // [mdspan.submdspan.mapping]
+#line 174 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#174"
+
+#line 175 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#175"
+    // Slicing never creates new broadcast dimensions, but must keep
+#line 176 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#176"
+    // the existing ones, so the result stays a layout_broadcast.
+#line 177 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#177"
+    template<class ... SliceSpecifiers>
+#line 178 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#178"
+    friend auto submdspan_mapping( const mapping & src, SliceSpecifiers ... slices )
+#line 179 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#179"
+      {
+#line 180 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#180"
+        auto sub = detail::submdspan_mapping_impl<layout_stride>( src, slices... );
+#line 181 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#181"
+        typedef typename decltype(sub.mapping)::extents_type sub_extents_type;
+#line 182 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#182"
+        typedef layout_broadcast::mapping<sub_extents_type> sub_mapping_type;
+#line 183 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#183"
+
+#line 184 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#184"
+        array<ptrdiff_t,sub_extents_type::rank()> sub_strides;
+#line 185 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#185"
+        for ( size_t r = 0 ; r < sub_extents_type::rank() ; ++r )
+#line 186 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#186"
+          sub_strides[r] = sub.mapping.stride(r);
+#line 187 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#187"
+
+#line 188 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#188"
+        return submdspan_mapping_result<sub_mapping_type>{
+#line 189 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#189"
+          sub_mapping_type(sub.mapping.extents(),sub_strides), sub.offset };
+#line 190 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#190"
+      }
+#line 191 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#191"
+
+#line 192 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#192"
+  }; // class mapping
+#line 193 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#193"
+
+#line 194 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#194"
+}; // class layout_broadcast
+#line 195 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#195"
+
+#line 196 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#196"
+//--------------------------------------------------------------------------
+#line 197 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#197"
+
+#line 198 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#198"
+// View the rank-1 x as a num_rows by x.extent(0) matrix, every row of which is x.
+#line 199 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#199"
+template<class ElementType, ptrdiff_t E0, class LayoutPolicy, class AccessorPolicy>
+#line 200 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#200"
+basic_mdspan<ElementType, extents<dynamic_extent,E0>, layout_broadcast, AccessorPolicy>
+#line 201 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#201"
+  broadcast_rows( const basic_mdspan<ElementType, extents<E0>, LayoutPolicy, AccessorPolicy>& x,
+#line 202 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#202"
+                  const ptrdiff_t num_rows ) noexcept
+#line 203 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#203"
+  {
+#line 204 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#204"
+    typedef extents<dynamic_extent,E0> sub_extents_type;
+#line 205 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#205"
+    typedef layout_broadcast::mapping<sub_extents_type> mapping_type;
+#line 206 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#206"
+    sub_extents_type ext;
+#line 207 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#207"
+    if constexpr ( E0 == dynamic_extent ) ext = sub_extents_type( num_rows, x.extent(0) );
+#line 208 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#208"
+    else ext = sub_extents_type( num_rows );
+#line 209 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#209"
+    const mapping_type map( ext, array<ptrdiff_t,2>{{ 0, x.stride(0) }} );
+#line 210 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#210"
+    return basic_mdspan<ElementType,sub_extents_type,layout_broadcast,AccessorPolicy>( x.data(), map, x.accessor() );
+#line 211 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#211"
+  }
+#line 212 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#212"
+
+#line 213 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#213"
+// View the rank-1 x as a x.extent(0) by num_cols matrix, every column of which is x.
+#line 214 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#214"
+template<class ElementType, ptrdiff_t E0, class LayoutPolicy, class AccessorPolicy>
+#line 215 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#215"
+basic_mdspan<ElementType, extents<E0,dynamic_extent>, layout_broadcast, AccessorPolicy>
+#line 216 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#216"
+  broadcast_columns( const basic_mdspan<ElementType, extents<E0>, LayoutPolicy, AccessorPolicy>& x,
+#line 217 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#217"
+                     const ptrdiff_t num_cols ) noexcept
+#line 218 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#218"
+  {
+#line 219 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#219"
+    typedef extents<E0,dynamic_extent> sub_extents_type;
+#line 220 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#220"
+    typedef layout_broadcast::mapping<sub_extents_type> mapping_type;
+#line 221 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#221"
+    sub_extents_type ext;
+#line 222 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#222"
+    if constexpr ( E0 == dynamic_extent ) ext = sub_extents_type( x.extent(0), num_cols );
+#line 223 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#223"
+    else ext = sub_extents_type( num_cols );
+#line 224 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#224"
+    const mapping_type map( ext, array<ptrdiff_t,2>{{ x.stride(0), 0 }} );
+#line 225 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#225"
+    return basic_mdspan<ElementType,sub_extents_type,layout_broadcast,AccessorPolicy>( x.data(), map, x.accessor() );
+#line 226 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#226"
+  }
+#line 227 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#227"
+
+#line 228 "https://github.com/ORNL/cpp-proposals-pub/blob/master/P0009/reference-implementation/include/experimental/bits/layout_broadcast.hpp#228"
+}}} // experimental::fundamentals_v3
 
 #include <cassert>
 #include <type_traits>
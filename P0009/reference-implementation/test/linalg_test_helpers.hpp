@@ -0,0 +1,96 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+// Fixtures shared by the linalg tests, which all build into test_all.
+
+#ifndef LINALG_TEST_HELPERS_HPP
+#define LINALG_TEST_HELPERS_HPP
+
+#include<experimental/linalg>
+#include<type_traits>
+#include<vector>
+#include"gtest/gtest.h"
+
+namespace {
+
+typedef std::experimental::extents<std::experimental::dynamic_extent,
+                                   std::experimental::dynamic_extent> matrix_extents;
+
+// An m x n matrix of small integers, exact in any floating point type,
+// with an imaginary part as well when T is complex.  A diagonally
+// dominant one has 20 added to its diagonal (and, when complex, an
+// imaginary part of 1 there), so that its triangles are well
+// conditioned.
+template<class T, class Layout>
+struct test_matrix {
+  std::vector<T> data;
+  std::experimental::basic_mdspan<T,matrix_extents,Layout> view;
+
+  test_matrix(ptrdiff_t m, ptrdiff_t n, int seed, bool diagonally_dominant = false) : data(m*n) {
+    view = std::experimental::basic_mdspan<T,matrix_extents,Layout>(data.data(),m,n);
+    for(ptrdiff_t i=0; i<m; i++)
+    for(ptrdiff_t j=0; j<n; j++) {
+      const bool boost = diagonally_dominant && i==j;
+      const double v = double((i*7+j*3+seed)%11) - 5.0 + (boost ? 20.0 : 0.0);
+      if constexpr (std::is_floating_point<T>::value) view(i,j) = T(v);
+      else view(i,j) = T(v, boost ? 1.0 : double((i+j*5+seed)%7) - 3.0);
+    }
+  }
+};
+
+// C == init + A B, summed in C's value type in the order of k.
+template<class MatA, class MatB, class MatC>
+void check_product(const MatA& A, const MatB& B, const MatC& C,
+                   typename MatC::value_type init = {}) {
+  for(ptrdiff_t i=0; i<C.extent(0); i++)
+  for(ptrdiff_t j=0; j<C.extent(1); j++) {
+    typename MatC::value_type expected = init;
+    for(ptrdiff_t k=0; k<A.extent(1); k++) expected += A(i,k)*B(k,j);
+    ASSERT_EQ(C(i,j),expected);
+  }
+}
+
+}
+
+#endif
@@ -49,6 +49,7 @@ using std::experimental::fundamentals_v3::extents;
 using std::experimental::fundamentals_v3::dynamic_extent;
 using std::experimental::fundamentals_v3::layout_right;
 using std::experimental::fundamentals_v3::layout_left;
+using std::experimental::fundamentals_v3::layout_broadcast;
 
 class layouts_ : public ::testing::Test {
 protected:
@@ -172,4 +173,30 @@ TEST_F(layouts_,operator_left) {
   test.check_operator(0,0,0,0,0,0);
 }
 
-
+TEST_F(layouts_,broadcast) {
+  typedef extents<dynamic_extent,4> extents_type;
+  typedef layout_broadcast::mapping<extents_type> mapping_type;
+
+  // every row is the same contiguous row
+  mapping_type rows(extents_type(3),std::array<ptrdiff_t,2>{{0,1}});
+  ASSERT_EQ(rows.required_span_size(),4);
+  ASSERT_EQ(rows(2,3),3);
+  ASSERT_EQ(rows(0,3),3);
+  ASSERT_EQ(rows.is_always_unique()?1:0,0);
+  ASSERT_EQ(rows.is_unique()?1:0,0);
+  ASSERT_EQ(rows.is_contiguous()?1:0,1);
+  ASSERT_EQ(rows.is_strided()?1:0,1);
+
+  // every column is the same strided column
+  mapping_type cols(extents_type(3),std::array<ptrdiff_t,2>{{2,0}});
+  ASSERT_EQ(cols.required_span_size(),5);
+  ASSERT_EQ(cols(2,1),4);
+  ASSERT_EQ(cols.is_unique()?1:0,0);
+  ASSERT_EQ(cols.is_contiguous()?1:0,0);
+
+  // no zero strides: an ordinary unique strided mapping
+  mapping_type plain(extents_type(3),std::array<ptrdiff_t,2>{{4,1}});
+  ASSERT_EQ(plain.required_span_size(),12);
+  ASSERT_EQ(plain.is_unique()?1:0,1);
+  ASSERT_EQ(plain.is_contiguous()?1:0,1);
+}
@@ -0,0 +1,600 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include<experimental/linalg>
+#include<complex>
+#include<list>
+#include<tuple>
+#include<vector>
+#include"gtest/gtest.h"
+#include"linalg_test_helpers.hpp"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_batched_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> batch_extents;
+
+template<class Layout>
+struct test_batch {
+  std::vector<double> data;
+  basic_mdspan<double,batch_extents,Layout> view;
+
+  test_batch(ptrdiff_t batch, ptrdiff_t m, ptrdiff_t n, int seed) : data(batch*m*n) {
+    view = basic_mdspan<double,batch_extents,Layout>(data.data(),batch,m,n);
+    for(ptrdiff_t b=0; b<batch; b++)
+    for(ptrdiff_t i=0; i<m; i++)
+    for(ptrdiff_t j=0; j<n; j++)
+      view(b,i,j) = double((b*5+i*7+j*3+seed)%11) - 5.0;
+  }
+};
+
+// Element (b,i,j) of a batched argument, broadcasting a rank-2 one.
+template<class MDSpan>
+double batch_element(const MDSpan& x, ptrdiff_t b, ptrdiff_t i, ptrdiff_t j) {
+  if constexpr (MDSpan::rank() == 3) return x(b,i,j);
+  else return x(i,j);
+}
+
+// C(b,:,:) == alpha * A(b,:,:) * B(b,:,:) + E(b,:,:), E being zero if e is null.
+template<class MatA, class MatB, class MatC, class MatE = MatC>
+void check_batched_product(const MatA& A, const MatB& B, const MatC& C,
+                           double alpha = 1.0, const MatE* e = nullptr) {
+  for(ptrdiff_t b=0; b<C.extent(0); b++)
+  for(ptrdiff_t i=0; i<C.extent(1); i++)
+  for(ptrdiff_t j=0; j<C.extent(2); j++) {
+    double expected = 0.0;
+    for(ptrdiff_t k=0; k<A.extent(MatA::rank()-1); k++)
+      expected += batch_element(A,b,i,k)*batch_element(B,b,k,j);
+    expected *= alpha;
+    if(e) expected += batch_element(*e,b,i,j);
+    ASSERT_EQ(C(b,i,j),expected);
+  }
+}
+
+template<class LayoutA, class LayoutB, class LayoutC>
+void test_batched_matrix_product(ptrdiff_t batch, ptrdiff_t m, ptrdiff_t n, ptrdiff_t k) {
+  test_batch<LayoutA> A(batch,m,k,1);
+  test_batch<LayoutB> B(batch,k,n,2);
+  test_batch<LayoutC> C(batch,m,n,3);
+  linalg::matrix_product(A.view,B.view,C.view);
+  check_batched_product(A.view,B.view,C.view);
+
+  // C = E + A B, with E aliasing C
+  test_batch<LayoutC> E(batch,m,n,4);
+  C.data = E.data;
+  linalg::matrix_product(A.view,B.view,C.view,C.view);
+  check_batched_product(A.view,B.view,C.view,1.0,&E.view);
+}
+
+template<class LayoutA, class LayoutB, class LayoutC>
+void test_batched_matrix_product_sizes() {
+  test_batched_matrix_product<LayoutA,LayoutB,LayoutC>(1,1,1,1);
+  test_batched_matrix_product<LayoutA,LayoutB,LayoutC>(7,8,8,8);
+  test_batched_matrix_product<LayoutA,LayoutB,LayoutC>(5,13,9,7);
+  test_batched_matrix_product<LayoutA,LayoutB,LayoutC>(3,4,5,0);
+  test_batched_matrix_product<LayoutA,LayoutB,LayoutC>(0,4,5,6);
+  // larger than one cache block
+  test_batched_matrix_product<LayoutA,LayoutB,LayoutC>(2,100,10,300);
+}
+
+}
+
+TEST_F(linalg_batched_,matrix_product_right) {
+  test_batched_matrix_product_sizes<layout_right,layout_right,layout_right>();
+}
+
+TEST_F(linalg_batched_,matrix_product_left) {
+  test_batched_matrix_product_sizes<layout_left,layout_left,layout_left>();
+}
+
+TEST_F(linalg_batched_,matrix_product_mixed) {
+  test_batched_matrix_product_sizes<layout_left,layout_right,layout_left>();
+}
+
+TEST_F(linalg_batched_,matrix_product_broadcast) {
+  const ptrdiff_t batch = 9, m = 12, n = 10, k = 11;
+  test_matrix<double,layout_right> A2(m,k,1);
+  test_matrix<double,layout_left> B2(k,n,2);
+  test_batch<layout_right> A3(batch,m,k,3);
+  test_batch<layout_right> B3(batch,k,n,4);
+  test_batch<layout_right> C(batch,m,n,5);
+
+  linalg::matrix_product(A2.view,B3.view,C.view);
+  check_batched_product(A2.view,B3.view,C.view);
+  linalg::matrix_product(A3.view,B2.view,C.view);
+  check_batched_product(A3.view,B2.view,C.view);
+  linalg::matrix_product(A2.view,B2.view,C.view);
+  check_batched_product(A2.view,B2.view,C.view);
+
+  // rank-2 E, and a rank-3 A with a zero batch stride
+  layout_broadcast::mapping<batch_extents> map(batch_extents(batch,m,k),
+                                               std::array<ptrdiff_t,3>{{0,k,1}});
+  basic_mdspan<double,batch_extents,layout_broadcast> A0(A2.data.data(),map);
+  test_matrix<double,layout_left> E(m,n,6);
+  linalg::matrix_product(A0,B3.view,E.view,C.view);
+  check_batched_product(A2.view,B3.view,C.view,1.0,&E.view);
+}
+
+TEST_F(linalg_batched_,matrix_product_scaled) {
+  test_batch<layout_right> A(6,9,7,1);
+  test_matrix<double,layout_left> B(7,5,2);
+  test_batch<layout_left> C(6,9,5,3);
+  linalg::matrix_product(linalg::scaled(2.0,A.view),linalg::scaled(-3.0,B.view),C.view);
+  check_batched_product(A.view,B.view,C.view,-6.0);
+}
+
+TEST_F(linalg_batched_,matrix_product_parallel) {
+  for(size_t num_threads : {1, 2, 3, 4, 6}) {
+    linalg::thread_pool_policy exec(num_threads);
+    test_batch<layout_right> A(101,16,24,1);
+    test_matrix<double,layout_right> B(24,20,2);
+    test_batch<layout_left> C(101,16,20,3);
+    linalg::matrix_product(exec,A.view,B.view,C.view);
+    check_batched_product(A.view,B.view,C.view);
+
+    test_batch<layout_left> E(101,16,20,4);
+    C.data = E.data;
+    linalg::matrix_product(exec,A.view,B.view,C.view,C.view);
+    check_batched_product(A.view,B.view,C.view,1.0,&E.view);
+  }
+}
+
+namespace {
+
+typedef basic_mdspan<double,matrix_extents,layout_right> right_matrix;
+typedef basic_mdspan<double,matrix_extents,layout_left> left_matrix;
+
+// A variable-size batch: groups of tiny problems of a few shapes, mixed
+// with larger and empty ones, in no particular order.
+struct test_variable_batch {
+  std::vector<test_matrix<double,layout_right>> A;
+  std::vector<test_matrix<double,layout_left>> B;
+  std::vector<test_matrix<double,layout_left>> C;
+
+  test_variable_batch() {
+    const ptrdiff_t shapes[][3] = { {3,4,5}, {2,2,2}, {16,16,16}, {17,5,3}, {4,5,0}, {0,3,4}, {1,1,1}, {90,70,300} };
+    const int counts[] = { 21, 5, 9, 2, 1, 1, 3, 1 };
+    const size_t size = 43;
+    A.reserve(size); B.reserve(size); C.reserve(size);
+    for(int r=0; A.size()<size; r++)
+    for(int s=0; s<8; s++)
+      if(r<counts[s]) {
+        const ptrdiff_t m = shapes[s][0], n = shapes[s][1], k = shapes[s][2];
+        A.emplace_back(m,k,int(A.size()));
+        B.emplace_back(k,n,int(A.size())+1);
+        C.emplace_back(m,n,int(A.size())+2);
+      }
+  }
+
+  template<class MatA>
+  void check(const std::vector<MatA>& a, double alpha = 1.0) const {
+    for(size_t q=0; q<C.size(); q++)
+    for(ptrdiff_t i=0; i<C[q].view.extent(0); i++)
+    for(ptrdiff_t j=0; j<C[q].view.extent(1); j++) {
+      double expected = 0.0;
+      for(ptrdiff_t k=0; k<a[q].extent(1); k++) expected += a[q](i,k)*B[q].view(k,j);
+      ASSERT_EQ(C[q].view(i,j),alpha*expected);
+    }
+  }
+};
+
+}
+
+TEST_F(linalg_batched_,variable_batch_matrix_product) {
+  for(size_t num_threads : {1, 2, 3, 8}) {
+    test_variable_batch batch;
+    std::vector<std::tuple<right_matrix,left_matrix,left_matrix>> problems;
+    std::vector<right_matrix> a;
+    for(size_t q=0; q<batch.C.size(); q++) {
+      problems.emplace_back(batch.A[q].view,batch.B[q].view,batch.C[q].view);
+      a.push_back(batch.A[q].view);
+    }
+    if(num_threads == 1) linalg::variable_batch_matrix_product(problems);
+    else linalg::variable_batch_matrix_product(linalg::thread_pool_policy(num_threads),problems);
+    batch.check(a);
+  }
+}
+
+TEST_F(linalg_batched_,variable_batch_matrix_product_scaled) {
+  test_variable_batch batch;
+  typedef decltype(linalg::scaled(2.0,std::declval<right_matrix>())) scaled_matrix;
+  std::vector<std::tuple<scaled_matrix,left_matrix,left_matrix>> problems;
+  std::vector<right_matrix> a;
+  for(size_t q=0; q<batch.C.size(); q++) {
+    problems.emplace_back(linalg::scaled(2.0,batch.A[q].view),batch.B[q].view,batch.C[q].view);
+    a.push_back(batch.A[q].view);
+  }
+  linalg::variable_batch_matrix_product(linalg::thread_pool_policy(4),problems);
+  batch.check(a,2.0);
+
+  // a range that is not random access
+  std::list<std::tuple<right_matrix,left_matrix,left_matrix>> list;
+  for(size_t q=0; q<batch.C.size(); q++) list.emplace_back(batch.A[q].view,batch.B[q].view,batch.C[q].view);
+  linalg::variable_batch_matrix_product(list);
+  batch.check(a);
+}
+
+namespace {
+
+template<ptrdiff_t W>
+using interleaved = linalg::layout_batch_interleaved<W>;
+
+// Copy of the batch x into a new layout, through linalg::copy.
+template<class Layout, class MDSpan>
+struct converted_batch {
+  std::vector<double> data;
+  basic_mdspan<double,typename MDSpan::extents_type,Layout> view;
+
+  converted_batch(const MDSpan& x) {
+    typename Layout::template mapping<typename MDSpan::extents_type> map(x.extents());
+    data.resize(map.required_span_size(), 0.0);
+    view = basic_mdspan<double,typename MDSpan::extents_type,Layout>(data.data(),map);
+    linalg::copy(x,view);
+  }
+};
+
+template<class MDSpan1, class MDSpan2>
+void check_same_batch(const MDSpan1& x, const MDSpan2& y) {
+  for(ptrdiff_t b=0; b<x.extent(0); b++)
+  for(ptrdiff_t i=0; i<x.extent(1); i++)
+  for(ptrdiff_t j=0; j<x.extent(2); j++)
+    ASSERT_EQ(x(b,i,j),y(b,i,j));
+}
+
+template<ptrdiff_t W>
+void test_interleaved_matrix_product(ptrdiff_t batch, ptrdiff_t m, ptrdiff_t n, ptrdiff_t k) {
+  test_batch<layout_right> A(batch,m,k,1);
+  test_batch<layout_right> B(batch,k,n,2);
+  test_batch<layout_right> C(batch,m,n,3);
+  converted_batch<interleaved<W>,decltype(A.view)> Ai(A.view);
+  converted_batch<interleaved<W>,decltype(B.view)> Bi(B.view);
+  converted_batch<interleaved<W>,decltype(C.view)> Ci(C.view);
+
+  linalg::matrix_product(Ai.view,Bi.view,Ci.view);
+  check_batched_product(A.view,B.view,Ci.view);
+  linalg::matrix_product(linalg::scaled(2.0,Ai.view),Bi.view,Ci.view,Ci.view);
+  check_batched_product(A.view,B.view,Ci.view,3.0);
+
+  // back to layout_right
+  linalg::matrix_product(A.view,B.view,C.view);
+  converted_batch<layout_right,decltype(Ci.view)> Cr(Ci.view);
+  for(ptrdiff_t i=0; i<batch*m*n; i++) ASSERT_EQ(Cr.data[i],3.0*C.data[i]);
+}
+
+// A(b,i,j) = B(b,i,:) . x(b,:) for every problem, on the generic layouts.
+template<class MatA, class VecX, class VecY>
+void check_batched_matrix_vector(const MatA& A, const VecX& x, const VecY& y, double y_seed) {
+  for(ptrdiff_t b=0; b<y.extent(0); b++)
+  for(ptrdiff_t i=0; i<y.extent(1); i++) {
+    double expected = y_seed;
+    for(ptrdiff_t j=0; j<x.extent(1); j++) expected += A(b,i,j)*x(b,j);
+    ASSERT_EQ(y(b,i),expected);
+  }
+}
+
+// B(b,:,:) == A(b,:,:) X(b,:,:) (Left) or X(b,:,:) A(b,:,:), for the Triangle
+// of A with DiagonalStorage.
+template<bool Left, class Triangle, class DiagonalStorage, class MatA, class MatX, class MatB>
+void check_batched_solve(const MatA& A, const MatX& X, const MatB& B) {
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  const bool implicit = std::is_same<DiagonalStorage,linalg::implicit_unit_diagonal_t>::value;
+  auto a = [&](ptrdiff_t b, ptrdiff_t i, ptrdiff_t j) {
+    if(i == j) return implicit ? 1.0 : A(b,i,j);
+    return (lower ? i > j : i < j) ? A(b,i,j) : 0.0;
+  };
+  for(ptrdiff_t b=0; b<B.extent(0); b++)
+  for(ptrdiff_t i=0; i<B.extent(1); i++)
+  for(ptrdiff_t j=0; j<B.extent(2); j++) {
+    double sum = 0.0;
+    if(Left) for(ptrdiff_t k=0; k<B.extent(1); k++) sum += a(b,i,k)*X(b,k,j);
+    else for(ptrdiff_t k=0; k<B.extent(2); k++) sum += X(b,i,k)*a(b,k,j);
+    ASSERT_NEAR(sum,B(b,i,j),1e-10*(1.0+std::abs(B(b,i,j))));
+  }
+}
+
+template<bool Left, class Triangle, class DiagonalStorage>
+void test_batched_solve(ptrdiff_t batch, ptrdiff_t m, ptrdiff_t n) {
+  const ptrdiff_t na = Left ? m : n;
+  test_batch<layout_right> A(batch,na,na,1);
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t i=0; i<na; i++) A.view(b,i,i) = double(na+3+b%3);
+  test_batch<layout_right> B(batch,m,n,2);
+  test_batch<layout_right> X(batch,m,n,3);
+
+  auto solve = [](auto A, auto B, auto X) {
+    if constexpr (Left) linalg::triangular_matrix_matrix_left_solve(A,Triangle(),DiagonalStorage(),B,X);
+    else linalg::triangular_matrix_matrix_right_solve(A,Triangle(),DiagonalStorage(),B,X);
+  };
+
+  solve(A.view,B.view,X.view);
+  check_batched_solve<Left,Triangle,DiagonalStorage>(A.view,X.view,B.view);
+
+  converted_batch<interleaved<4>,decltype(A.view)> Ai(A.view);
+  converted_batch<interleaved<4>,decltype(B.view)> Bi(B.view);
+  converted_batch<interleaved<4>,decltype(X.view)> Xi(X.view);
+  solve(Ai.view,Bi.view,Xi.view);
+  check_batched_solve<Left,Triangle,DiagonalStorage>(A.view,Xi.view,B.view);
+}
+
+template<bool Left>
+void test_batched_solves(ptrdiff_t batch, ptrdiff_t m, ptrdiff_t n) {
+  test_batched_solve<Left,linalg::lower_triangle_t,linalg::explicit_diagonal_t>(batch,m,n);
+  test_batched_solve<Left,linalg::lower_triangle_t,linalg::implicit_unit_diagonal_t>(batch,m,n);
+  test_batched_solve<Left,linalg::upper_triangle_t,linalg::explicit_diagonal_t>(batch,m,n);
+  test_batched_solve<Left,linalg::upper_triangle_t,linalg::implicit_unit_diagonal_t>(batch,m,n);
+}
+
+}
+
+TEST_F(linalg_batched_,layout_batch_interleaved) {
+  typedef interleaved<4>::mapping<batch_extents> mapping_type;
+  const mapping_type map(batch_extents(6,2,3));
+  ASSERT_EQ(map.required_span_size(),2*4*2*3);
+  ASSERT_EQ(map(0,0,0),0);
+  ASSERT_EQ(map(3,0,0),3);
+  ASSERT_EQ(map(1,0,1),4+1);
+  ASSERT_EQ(map(2,1,0),3*4+2);
+  ASSERT_EQ(map(5,1,2),(6+5)*4+1);
+  ASSERT_FALSE(map.is_contiguous());
+  ASSERT_TRUE(interleaved<4>::mapping<batch_extents>(batch_extents(8,2,3)).is_contiguous());
+
+  test_batch<layout_right> X(11,3,5,1);
+  converted_batch<interleaved<4>,decltype(X.view)> Xi(X.view);
+  check_same_batch(X.view,Xi.view);
+  for(ptrdiff_t b=0; b<11; b++) {
+    auto x = subspan(Xi.view,b,all,all);
+    static_assert(std::is_same<decltype(x)::layout_type,layout_stride>::value,"");
+    for(ptrdiff_t i=0; i<3; i++)
+    for(ptrdiff_t j=0; j<5; j++) ASSERT_EQ(x(i,j),X.view(b,i,j));
+    auto row = subspan(Xi.view,b,2,all);
+    for(ptrdiff_t j=0; j<5; j++) ASSERT_EQ(row(j),X.view(b,2,j));
+  }
+
+  converted_batch<layout_right,decltype(Xi.view)> Xr(Xi.view);
+  ASSERT_EQ(Xr.data,X.data);
+  converted_batch<layout_left,decltype(Xi.view)> Xl(Xi.view);
+  check_same_batch(X.view,Xl.view);
+}
+
+TEST_F(linalg_batched_,matrix_product_interleaved) {
+  test_interleaved_matrix_product<4>(13,4,4,4);
+  test_interleaved_matrix_product<8>(16,8,8,8);
+  test_interleaved_matrix_product<8>(5,5,3,7);
+  test_interleaved_matrix_product<2>(7,1,1,0);
+
+  // mixed with other layouts goes through the per-problem kernels
+  test_batch<layout_right> A(9,6,5,1);
+  test_batch<layout_left> B(9,5,4,2);
+  test_batch<layout_right> C(9,6,4,3);
+  converted_batch<interleaved<4>,decltype(C.view)> Ci(C.view);
+  linalg::matrix_product(A.view,B.view,Ci.view);
+  check_batched_product(A.view,B.view,Ci.view);
+
+  for(size_t num_threads : {2, 3}) {
+    test_batch<layout_right> P(203,8,8,1);
+    test_batch<layout_right> Q(203,8,8,2);
+    converted_batch<interleaved<8>,decltype(P.view)> Pi(P.view);
+    converted_batch<interleaved<8>,decltype(Q.view)> Qi(Q.view);
+    converted_batch<interleaved<8>,decltype(Q.view)> Ri(Q.view);
+    linalg::matrix_product(linalg::thread_pool_policy(num_threads),Pi.view,Qi.view,Ri.view);
+    check_batched_product(P.view,Q.view,Ri.view);
+  }
+}
+
+TEST_F(linalg_batched_,matrix_vector_product) {
+  typedef extents<dynamic_extent,dynamic_extent> vector_batch_extents;
+  const ptrdiff_t batch = 10, m = 7, n = 5;
+  test_batch<layout_right> A(batch,m,n,1);
+  std::vector<double> x_data(batch*n), y_data(batch*m);
+  mdspan<double,dynamic_extent,dynamic_extent> x(x_data.data(),batch,n), y(y_data.data(),batch,m);
+  for(ptrdiff_t b=0; b<batch; b++) for(ptrdiff_t j=0; j<n; j++) x(b,j) = double((b+2*j)%5) - 2.0;
+
+  linalg::matrix_vector_product(A.view,x,y);
+  check_batched_matrix_vector(A.view,x,y,0.0);
+
+  // broadcast x, and z = y + A x with a broadcast y
+  std::vector<double> x0_data(n,1.0), y0_data(m,2.0);
+  mdspan<double,dynamic_extent> x0(x0_data.data(),n), y0(y0_data.data(),m);
+  linalg::matrix_vector_product(A.view,x0,y0,y);
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t i=0; i<m; i++) {
+    double expected = 2.0;
+    for(ptrdiff_t j=0; j<n; j++) expected += A.view(b,i,j);
+    ASSERT_EQ(y(b,i),expected);
+  }
+
+  // interleaved
+  typedef interleaved<4>::mapping<vector_batch_extents> vector_mapping;
+  const vector_mapping x_map(vector_batch_extents(batch,n)), y_map(vector_batch_extents(batch,m));
+  std::vector<double> xi_data(x_map.required_span_size()), yi_data(y_map.required_span_size());
+  basic_mdspan<double,vector_batch_extents,interleaved<4>> xi(xi_data.data(),x_map), yi(yi_data.data(),y_map);
+  linalg::copy(x,xi);
+  converted_batch<interleaved<4>,decltype(A.view)> Ai(A.view);
+  linalg::matrix_vector_product(linalg::thread_pool_policy(2),Ai.view,xi,yi);
+  check_batched_matrix_vector(A.view,x,yi,0.0);
+  linalg::matrix_vector_product(Ai.view,linalg::scaled(2.0,xi),yi,yi);
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t i=0; i<m; i++) {
+    double expected = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) expected += A.view(b,i,j)*x(b,j);
+    ASSERT_EQ(yi(b,i),3.0*expected);
+  }
+}
+
+TEST_F(linalg_batched_,triangular_matrix_matrix_solve) {
+  test_batched_solves<true>(6,4,3);
+  test_batched_solves<true>(9,8,8);
+  test_batched_solves<false>(6,3,4);
+  test_batched_solves<false>(9,8,8);
+}
+
+namespace {
+
+// Batch of vectors with the given layout, filled like test_batch.
+template<class Layout>
+struct test_vector_batch {
+  std::vector<double> data;
+  basic_mdspan<double,matrix_extents,Layout> view;
+
+  test_vector_batch(ptrdiff_t batch, ptrdiff_t n, int seed) {
+    typename Layout::template mapping<matrix_extents> map(matrix_extents(batch,n));
+    data.resize(map.required_span_size(), 0.0);
+    view = basic_mdspan<double,matrix_extents,Layout>(data.data(),map);
+    for(ptrdiff_t b=0; b<batch; b++)
+    for(ptrdiff_t k=0; k<n; k++)
+      view(b,k) = double((b*5+k*3+seed)%11) - 5.0;
+  }
+};
+
+// Problem b of a batch of vectors, or the broadcast vector itself.
+template<class MDSpan>
+auto batch_vector(const MDSpan& x, ptrdiff_t b) {
+  if constexpr (MDSpan::rank() == 1) return x;
+  else return subspan(x,b,all);
+}
+
+// The batched reductions of x (and y) against the unbatched ones.
+template<class VecX, class VecY>
+void check_batched_reductions(const VecX& x, const VecY& y) {
+  const ptrdiff_t batch = x.extent(0);
+  std::vector<double> out_data(batch+1);
+  mdspan<double,dynamic_extent> out(out_data.data(),batch);
+
+  linalg::dot(x,y,out);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),linalg::dot(batch_vector(x,b),batch_vector(y,b)));
+  linalg::dotc(x,linalg::scaled(3.0,y),out);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),3.0*linalg::dot(batch_vector(x,b),batch_vector(y,b)));
+  linalg::vector_two_norm(x,out);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),linalg::vector_two_norm(batch_vector(x,b)));
+  linalg::vector_two_norm(linalg::bounded_values,x,out);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),linalg::vector_two_norm(batch_vector(x,b)));
+  linalg::vector_abs_sum(linalg::scaled(-2.0,x),out);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),2.0*linalg::vector_abs_sum(batch_vector(x,b)));
+  ASSERT_EQ(out_data[batch],0.0);
+}
+
+template<class LayoutX, class LayoutY>
+void test_batched_reductions(ptrdiff_t batch, ptrdiff_t n) {
+  test_vector_batch<LayoutX> x(batch,n,1);
+  test_vector_batch<LayoutY> y(batch,n,2);
+  check_batched_reductions(x.view,y.view);
+
+  std::vector<double> y0_data(n);
+  for(ptrdiff_t k=0; k<n; k++) y0_data[k] = 1.0 + k%3;
+  mdspan<double,dynamic_extent> y0(y0_data.data(),n);
+  check_batched_reductions(x.view,y0);
+}
+
+template<class LayoutX, class LayoutY>
+void test_batched_reduction_sizes() {
+  // short vectors reduce across the batch, long ones one at a time
+  test_batched_reductions<LayoutX,LayoutY>(0,3);
+  test_batched_reductions<LayoutX,LayoutY>(1,3);
+  test_batched_reductions<LayoutX,LayoutY>(13,3);
+  test_batched_reductions<LayoutX,LayoutY>(16,0);
+  test_batched_reductions<LayoutX,LayoutY>(21,40);
+  test_batched_reductions<LayoutX,LayoutY>(5,200);
+}
+
+}
+
+TEST_F(linalg_batched_,dot_and_norms) {
+  test_batched_reduction_sizes<layout_right,layout_right>();
+  test_batched_reduction_sizes<layout_left,layout_left>();
+  test_batched_reduction_sizes<layout_right,layout_left>();
+  test_batched_reduction_sizes<interleaved<4>,interleaved<4>>();
+  test_batched_reduction_sizes<interleaved<8>,layout_right>();
+  test_batched_reduction_sizes<interleaved<4>,interleaved<8>>();
+}
+
+TEST_F(linalg_batched_,vector_two_norm_extreme_values) {
+  // problems whose squares overflow or underflow, among ordinary ones
+  const ptrdiff_t batch = 10, n = 4;
+  for(double big : {1.0e300, 1.0e-300, 1.0e-160, 1.0}) {
+    test_vector_batch<layout_left> x(batch,n,1);
+    x.view(3,0) = big; x.view(3,1) = big; x.view(3,2) = 0.0; x.view(3,3) = 0.0;
+    x.view(7,2) = -big;
+    std::vector<double> out_data(batch);
+    mdspan<double,dynamic_extent> out(out_data.data(),batch);
+    linalg::vector_two_norm(x.view,out);
+    for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),linalg::vector_two_norm(subspan(x.view,b,all)));
+    ASSERT_NEAR(out(3),std::sqrt(2.0)*big,1e-15*big);
+    ASSERT_TRUE(std::isfinite(out(7)) && out(7) >= big);
+  }
+}
+
+TEST_F(linalg_batched_,dotc_complex) {
+  typedef std::complex<double> complex_t;
+  const ptrdiff_t batch = 11, n = 5;
+  std::vector<complex_t> x_data(batch*n), y_data(batch*n), out_data(batch);
+  mdspan<complex_t,dynamic_extent,dynamic_extent> x(x_data.data(),batch,n), y(y_data.data(),batch,n);
+  mdspan<complex_t,dynamic_extent> out(out_data.data(),batch);
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t k=0; k<n; k++) {
+    x(b,k) = complex_t(double(b+k), double(b-2*k));
+    y(b,k) = complex_t(double(k%3), 1.0);
+  }
+  linalg::dotc(linalg::scaled(complex_t(0.0,2.0),x),y,out);
+  for(ptrdiff_t b=0; b<batch; b++)
+    ASSERT_EQ(out(b),std::conj(complex_t(0.0,2.0))*linalg::dotc(subspan(x,b,all),subspan(y,b,all)));
+  linalg::dot(x,y,out);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(out(b),linalg::dot(subspan(x,b,all),subspan(y,b,all)));
+
+  std::vector<double> norm_data(batch);
+  mdspan<double,dynamic_extent> norm(norm_data.data(),batch);
+  linalg::vector_two_norm(x,norm);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_NEAR(norm(b),linalg::vector_two_norm(subspan(x,b,all)),1e-14*norm(b));
+  linalg::vector_abs_sum(x,norm);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(norm(b),linalg::vector_abs_sum(subspan(x,b,all)).real());
+}
@@ -0,0 +1,373 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include<experimental/linalg>
+#include<cmath>
+#include<complex>
+#include<vector>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_blas1_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+TEST_F(linalg_blas1_,copy_add_vector) {
+  std::vector<double> x_data{1,2,3,4,5};
+  std::vector<double> y_data{10,20,30,40,50};
+  std::vector<double> z_data(5);
+  mdspan<double,dynamic_extent> x(x_data.data(),5);
+  mdspan<double,dynamic_extent> y(y_data.data(),5);
+  mdspan<double,dynamic_extent> z(z_data.data(),5);
+
+  linalg::copy(x,z);
+  for(int i=0; i<5; i++) ASSERT_EQ(z(i),x(i));
+  linalg::add(x,y,z);
+  for(int i=0; i<5; i++) ASSERT_EQ(z(i),x(i)+y(i));
+  linalg::elementwise_multiply(x,y,z);
+  for(int i=0; i<5; i++) ASSERT_EQ(z(i),x(i)*y(i));
+}
+
+template<class Layout>
+void test_broadcast_matrix() {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  typedef basic_mdspan<double,extents_type,Layout> matrix_type;
+  const ptrdiff_t m = 3, n = 4;
+  std::vector<double> a_data(m*n), c_data(m*n);
+  std::vector<double> r_data{1,2,3,4};
+  std::vector<double> s_data{-1,-2,-3};
+  matrix_type A(a_data.data(),m,n);
+  matrix_type C(c_data.data(),m,n);
+  mdspan<double,dynamic_extent> r(r_data.data(),n);
+  mdspan<double,dynamic_extent> s(s_data.data(),m);
+
+  for(int i=0; i<m; i++)
+  for(int j=0; j<n; j++)
+    A(i,j) = 10*i+j;
+
+  auto R = broadcast_rows(r,m);
+  auto S = broadcast_columns(s,n);
+  ASSERT_EQ(R.extent(0),m);
+  ASSERT_EQ(R.extent(1),n);
+  ASSERT_EQ(S.extent(0),m);
+  ASSERT_EQ(S.extent(1),n);
+  ASSERT_EQ(R.is_unique()?1:0,0);
+
+  linalg::copy(R,C);
+  for(int i=0; i<m; i++)
+  for(int j=0; j<n; j++)
+    ASSERT_EQ(C(i,j),r(j));
+
+  linalg::add(A,R,C);
+  for(int i=0; i<m; i++)
+  for(int j=0; j<n; j++)
+    ASSERT_EQ(C(i,j),A(i,j)+r(j));
+
+  linalg::add(S,A,C);
+  for(int i=0; i<m; i++)
+  for(int j=0; j<n; j++)
+    ASSERT_EQ(C(i,j),A(i,j)+s(i));
+
+  linalg::elementwise_multiply(S,R,C);
+  for(int i=0; i<m; i++)
+  for(int j=0; j<n; j++)
+    ASSERT_EQ(C(i,j),s(i)*r(j));
+
+  // slicing a broadcast view keeps it a broadcast view
+  auto R_sub = subspan(R,std::pair<int,int>(1,3),all);
+  static_assert(std::is_same<decltype(R_sub)::layout_type,layout_broadcast>::value,"");
+  ASSERT_EQ(R_sub.stride(0),0);
+  ASSERT_EQ(R_sub(1,2),r(2));
+}
+
+TEST_F(linalg_blas1_,broadcast_layout_right) {
+  test_broadcast_matrix<layout_right>();
+}
+
+TEST_F(linalg_blas1_,broadcast_layout_left) {
+  test_broadcast_matrix<layout_left>();
+}
+
+TEST_F(linalg_blas1_,reductions_contiguous_and_strided) {
+  // lengths around the unrolled block size, with and without unit stride
+  for(ptrdiff_t n : {0, 1, 5, 16, 17, 100, 1001}) {
+    std::vector<double> x_data(2*n), y_data(2*n);
+    for(ptrdiff_t k=0; k<2*n; k++) {
+      x_data[k] = double((k*7)%13) - 6.0;
+      y_data[k] = double((k*5)%11) - 5.0;
+    }
+    mdspan<double,dynamic_extent> x_full(x_data.data(),2*n), y_full(y_data.data(),2*n);
+    auto x = subspan(x_full,std::pair<ptrdiff_t,ptrdiff_t>(0,n));
+    auto y = subspan(y_full,std::pair<ptrdiff_t,ptrdiff_t>(n,2*n));
+    auto xs = subspan(x_full,strided_slice{ptrdiff_t(0),2*n,ptrdiff_t(2)});
+    ASSERT_EQ(xs.extent(0),n);
+
+    double dot_xy = 0.0, sum_sq = 0.0, abs_sum = 0.0, strided_dot = 0.0;
+    ptrdiff_t idx = n == 0 ? -1 : 0;
+    for(ptrdiff_t k=0; k<n; k++) {
+      dot_xy += x(k)*y(k);
+      sum_sq += x(k)*x(k);
+      abs_sum += std::abs(x(k));
+      strided_dot += xs(k)*y(k);
+      if(std::abs(x(k)) > std::abs(x(idx))) idx = k;
+    }
+    // All values are small integers, so every summation order is exact.
+    ASSERT_EQ(linalg::dot(x,y),dot_xy);
+    ASSERT_EQ(linalg::dot(x,y,1.0),dot_xy+1.0);
+    ASSERT_EQ(linalg::dot(xs,y),strided_dot);
+    ASSERT_EQ(linalg::vector_abs_sum(x),abs_sum);
+    ASSERT_EQ(linalg::vector_two_norm(x),std::sqrt(sum_sq));
+    ASSERT_EQ(linalg::vector_two_norm(x,3.0),std::sqrt(sum_sq+9.0));
+    if(n == 0) {
+      ASSERT_EQ(linalg::vector_idx_abs_max(x),std::numeric_limits<ptrdiff_t>::max());
+    }
+    else {
+      ASSERT_EQ(linalg::vector_idx_abs_max(x),idx);
+    }
+  }
+}
+
+TEST_F(linalg_blas1_,dot_wider_accumulator) {
+  // (1 + 2^-12)^2 = 1 + 2^-11 + 2^-24 has more bits than a float holds, so
+  // the sum is exact in double only if the products are widened first.
+  const float x_k = 1.0f + std::ldexp(1.0f,-12);
+  const double product = 1.0 + std::ldexp(1.0,-11) + std::ldexp(1.0,-24);
+  for(ptrdiff_t n : {1, 7, 100}) {
+    std::vector<float> x_data(2*n,x_k), y_data(n,x_k);
+    mdspan<float,dynamic_extent> x_full(x_data.data(),2*n), y(y_data.data(),n);
+    auto x = subspan(x_full,std::pair<ptrdiff_t,ptrdiff_t>(0,n));
+    auto xs = subspan(x_full,strided_slice{ptrdiff_t(0),2*n,ptrdiff_t(2)});
+    ASSERT_EQ(linalg::dot(x,y,0.0),double(n)*product);
+    ASSERT_EQ(linalg::dot(xs,y,0.0),double(n)*product);
+    ASSERT_EQ(linalg::dotc(x,y,1.0),double(n)*product+1.0);
+
+    std::vector<std::complex<float>> z_data(n,std::complex<float>(x_k,1.0f));
+    mdspan<std::complex<float>,dynamic_extent> z(z_data.data(),n);
+    ASSERT_EQ(linalg::dot(z,y,std::complex<double>()),std::complex<double>(double(n)*product,double(n)*double(x_k)));
+  }
+}
+
+TEST_F(linalg_blas1_,idx_abs_max_first_of_ties) {
+  std::vector<double> x_data(1000, 1.0);
+  mdspan<double,dynamic_extent> x(x_data.data(),1000);
+  ASSERT_EQ(linalg::vector_idx_abs_max(x),0);
+  x(700) = -4.0;
+  x(900) = 4.0;
+  ASSERT_EQ(linalg::vector_idx_abs_max(x),700);
+  x(3) = 5.0;
+  ASSERT_EQ(linalg::vector_idx_abs_max(x),3);
+}
+
+TEST_F(linalg_blas1_,complex_reductions) {
+  typedef std::complex<double> cd;
+  std::vector<cd> x_data{cd(1,2),cd(-3,1),cd(0,-4)};
+  std::vector<cd> y_data{cd(2,0),cd(1,1),cd(-1,2)};
+  mdspan<cd,dynamic_extent> x(x_data.data(),3), y(y_data.data(),3);
+  cd dotu(0,0), dotc(0,0);
+  for(int k=0; k<3; k++) {
+    dotu += x(k)*y(k);
+    dotc += std::conj(x(k))*y(k);
+  }
+  ASSERT_EQ(linalg::dot(x,y),dotu);
+  ASSERT_EQ(linalg::dotc(x,y),dotc);
+  ASSERT_EQ(linalg::vector_abs_sum(x),cd(11,0));
+  ASSERT_EQ(linalg::vector_idx_abs_max(x),1);
+  ASSERT_EQ(linalg::vector_two_norm(x),std::sqrt(31.0));
+}
+
+TEST_F(linalg_blas1_,scale_add) {
+  const ptrdiff_t n = 37;
+  std::vector<double> x_data(2*n), z_data(n);
+  for(ptrdiff_t k=0; k<2*n; k++) x_data[k] = double(k);
+  mdspan<double,dynamic_extent> x(x_data.data(),2*n), z(z_data.data(),n);
+  auto xs = subspan(x,strided_slice{ptrdiff_t(1),2*n-1,ptrdiff_t(2)});
+  auto xc = subspan(x,std::pair<ptrdiff_t,ptrdiff_t>(0,n));
+
+  linalg::add(xs,xc,z);
+  for(ptrdiff_t k=0; k<n; k++) ASSERT_EQ(z(k),double(2*k+1)+double(k));
+  linalg::add(xc,xc,z);
+  for(ptrdiff_t k=0; k<n; k++) ASSERT_EQ(z(k),double(2*k));
+
+  linalg::scale(0.5,z);
+  for(ptrdiff_t k=0; k<n; k++) ASSERT_EQ(z(k),double(k));
+  linalg::scale(2.0,xs);
+  for(ptrdiff_t k=0; k<2*n; k++) ASSERT_EQ(x(k),k%2 ? double(2*k) : double(k));
+
+  std::vector<double> a_data(6, 3.0);
+  mdspan<double,dynamic_extent,dynamic_extent> A(a_data.data(),2,3);
+  linalg::scale(-1.0,A);
+  for(double a : a_data) ASSERT_EQ(a,-3.0);
+}
+
+TEST_F(linalg_blas1_,two_norm_over_and_underflow) {
+  typedef std::numeric_limits<double> limits;
+  const ptrdiff_t n = 100;
+  std::vector<double> x_data(n);
+  mdspan<double,dynamic_extent> x(x_data.data(),n);
+
+  // Squares overflow: the exact norm is 1e300 * sqrt(n).
+  for(double& v : x_data) v = 1e300;
+  EXPECT_DOUBLE_EQ(linalg::vector_two_norm(x),1e301);
+  // Squares underflow to zero.
+  for(double& v : x_data) v = 1e-300;
+  EXPECT_DOUBLE_EQ(linalg::vector_two_norm(x),1e-299);
+  // Subnormal values.
+  for(double& v : x_data) v = 4*limits::denorm_min();
+  EXPECT_DOUBLE_EQ(linalg::vector_two_norm(x),40*limits::denorm_min());
+  // One large value hides the rest; init takes part in the scaling.
+  for(double& v : x_data) v = 1e-200;
+  x(17) = -3e200;
+  EXPECT_DOUBLE_EQ(linalg::vector_two_norm(x,4e200),5e200);
+  // The answer itself overflows.
+  for(double& v : x_data) v = limits::max();
+  ASSERT_EQ(linalg::vector_two_norm(x),limits::infinity());
+  x(3) = limits::quiet_NaN();
+  ASSERT_TRUE(std::isnan(linalg::vector_two_norm(x)));
+  for(double& v : x_data) v = 0.0;
+  ASSERT_EQ(linalg::vector_two_norm(x),0.0);
+
+  typedef std::complex<double> cd;
+  std::vector<cd> z_data(n, cd(3e300,-4e300));
+  mdspan<cd,dynamic_extent> z(z_data.data(),n);
+  EXPECT_DOUBLE_EQ(linalg::vector_two_norm(z),5e301);
+}
+
+TEST_F(linalg_blas1_,two_norm_bounded_and_sum_of_squares) {
+  std::vector<double> x_data{3,-4,12};
+  mdspan<double,dynamic_extent> x(x_data.data(),3);
+  ASSERT_EQ(linalg::vector_two_norm(linalg::bounded_values,x),13.0);
+  ASSERT_EQ(linalg::vector_two_norm(linalg::bounded_values,x,84.0),85.0);
+
+  linalg::sum_of_squares_result<double> init{2.0,1.0};
+  auto result = linalg::vector_sum_of_squares(x,init);
+  ASSERT_EQ(result.scaling_factor,12.0);
+  EXPECT_DOUBLE_EQ(result.scaling_factor*result.scaling_factor*result.scaled_sum_of_squares,4.0+169.0);
+
+  for(double& v : x_data) v *= 1e300;
+  result = linalg::vector_sum_of_squares(x,linalg::sum_of_squares_result<double>{0.0,0.0});
+  ASSERT_EQ(result.scaling_factor,12e300);
+  EXPECT_DOUBLE_EQ(std::sqrt(result.scaled_sum_of_squares)*result.scaling_factor,13e300);
+}
+
+TEST_F(linalg_blas1_,givens_rotation_setup_real) {
+  double c, s, r;
+  linalg::givens_rotation_setup(3.0,4.0,c,s,r);
+  EXPECT_DOUBLE_EQ(c,0.6); EXPECT_DOUBLE_EQ(s,0.8); EXPECT_DOUBLE_EQ(r,5.0);
+  linalg::givens_rotation_setup(-3.0,4.0,c,s,r);
+  EXPECT_DOUBLE_EQ(c,0.6); EXPECT_DOUBLE_EQ(s,-0.8); EXPECT_DOUBLE_EQ(r,-5.0);
+  linalg::givens_rotation_setup(2.0,0.0,c,s,r);
+  ASSERT_EQ(c,1.0); ASSERT_EQ(s,0.0); ASSERT_EQ(r,2.0);
+  linalg::givens_rotation_setup(0.0,-2.0,c,s,r);
+  ASSERT_EQ(c,0.0); ASSERT_EQ(s,-1.0); ASSERT_EQ(r,2.0);
+
+  // Neither a*a + b*b nor its square root is formed.
+  for(double scale : {1e300, 1e-300}) {
+    const double a = 3*scale, b = -4*scale;
+    linalg::givens_rotation_setup(a,b,c,s,r);
+    EXPECT_DOUBLE_EQ(r,5*scale);
+    EXPECT_DOUBLE_EQ(c*c+s*s,1.0);
+    EXPECT_NEAR(c*a+s*b,r,1e-15*std::abs(r));
+    EXPECT_NEAR(-s*a+c*b,0.0,1e-15*std::abs(r));
+  }
+}
+
+TEST_F(linalg_blas1_,givens_rotation_setup_complex) {
+  typedef std::complex<double> cd;
+  double c;
+  cd s, r;
+  for(double scale : {1.0, 1e300, 1e-300}) {
+    const cd a(3*scale,-1*scale), b(-2*scale,5*scale);
+    linalg::givens_rotation_setup(a,b,c,s,r);
+    EXPECT_DOUBLE_EQ(c*c+std::norm(s),1.0);
+    EXPECT_NEAR(std::abs(c*a+s*b-r),0.0,1e-15*std::abs(r));
+    EXPECT_NEAR(std::abs(-std::conj(s)*a+c*b),0.0,1e-15*std::abs(r));
+    EXPECT_DOUBLE_EQ(std::abs(r),std::sqrt(39.0)*scale);
+  }
+  linalg::givens_rotation_setup(cd(0,0),cd(0,2),c,s,r);
+  ASSERT_EQ(c,0.0); ASSERT_EQ(s,cd(0,-1)); ASSERT_EQ(r,cd(2,0));
+  linalg::givens_rotation_setup(cd(1,1),cd(0,0),c,s,r);
+  ASSERT_EQ(c,1.0); ASSERT_EQ(s,cd(0,0)); ASSERT_EQ(r,cd(1,1));
+}
+
+TEST_F(linalg_blas1_,givens_rotation_apply) {
+  std::vector<double> x_data{1,2,3,4,5,6};
+  std::vector<double> y_data{6,5,4,3,2,1};
+  mdspan<double,dynamic_extent> x(x_data.data(),6);
+  mdspan<double,dynamic_extent> y(y_data.data(),6);
+  // y through a stride of two.
+  std::vector<double> w_data{0,-1,0,1,0,2,0,-2,0,3,0,-3};
+  basic_mdspan<double,extents<dynamic_extent>,layout_stride> w(w_data.data()+1,
+    layout_stride::mapping<extents<dynamic_extent>>(extents<dynamic_extent>(6),std::array<ptrdiff_t,1>{2}));
+
+  linalg::givens_rotation_apply(x,y,0.6,0.8);
+  for(int i=0; i<6; i++) {
+    EXPECT_DOUBLE_EQ(x(i),0.6*(i+1)+0.8*(6-i));
+    EXPECT_DOUBLE_EQ(y(i),0.6*(6-i)-0.8*(i+1));
+  }
+  // A rotation by a quarter turn swaps x and w, negating one.
+  std::vector<double> x_old(x_data), w_old{-1,1,2,-2,3,-3};
+  linalg::givens_rotation_apply(x,w,0.0,1.0);
+  for(int i=0; i<6; i++) {
+    EXPECT_EQ(x(i),w_old[i]);
+    EXPECT_EQ(w(i),-x_old[i]);
+  }
+
+  typedef std::complex<double> cd;
+  std::vector<cd> u_data{cd(1,2),cd(-3,1)};
+  std::vector<cd> z_data{cd(0,1),cd(2,-2)};
+  mdspan<cd,dynamic_extent> u(u_data.data(),2);
+  mdspan<cd,dynamic_extent> z(z_data.data(),2);
+  const cd s(0.48,0.64);
+  linalg::givens_rotation_apply(u,z,0.6,s);
+  const cd u0[] = {cd(1,2),cd(-3,1)}, z0[] = {cd(0,1),cd(2,-2)};
+  for(int i=0; i<2; i++) {
+    EXPECT_NEAR(std::abs(u(i)-(0.6*u0[i]+s*z0[i])),0.0,1e-15);
+    EXPECT_NEAR(std::abs(z(i)-(0.6*z0[i]-std::conj(s)*u0[i])),0.0,1e-15);
+  }
+}
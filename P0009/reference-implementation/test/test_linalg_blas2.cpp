@@ -0,0 +1,456 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include<experimental/linalg>
+#include<cmath>
+#include<complex>
+#include<vector>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_blas2_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+template<class Triangle, class StorageOrder>
+void test_packed_mapping(const ptrdiff_t n) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  typedef typename linalg::layout_blas_packed<Triangle,StorageOrder>::template mapping<extents_type> mapping_type;
+  mapping_type map(extents_type(n,n));
+
+  ASSERT_EQ(map.required_span_size(),n*(n+1)/2);
+  ASSERT_EQ(map.is_always_unique()?1:0,0);
+  ASSERT_EQ(map.is_unique()?1:0,n<2?1:0);
+  ASSERT_EQ(map.is_contiguous()?1:0,1);
+
+  // Walk the stored triangle in storage order: offsets must be 0,1,2,...
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  const bool col = std::is_same<StorageOrder,linalg::column_major_t>::value;
+  ptrdiff_t expected = 0;
+  for(ptrdiff_t p=0; p<n; p++) {
+    const ptrdiff_t q_begin = (col == lower) ? p : 0;
+    const ptrdiff_t q_end = (col == lower) ? n : p+1;
+    for(ptrdiff_t q=q_begin; q<q_end; q++) {
+      const ptrdiff_t i = col ? q : p;
+      const ptrdiff_t j = col ? p : q;
+      ASSERT_EQ(map(i,j),expected);
+      ASSERT_EQ(map(j,i),expected);
+      expected++;
+    }
+  }
+}
+
+template<class Triangle, class StorageOrder, class T>
+void test_packed_product(const bool hermitian) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  typedef linalg::layout_blas_packed<Triangle,StorageOrder> layout_type;
+  const ptrdiff_t n = 7;
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+
+  // full dense reference and the packed copy of its stored triangle
+  std::vector<T> full(n*n);
+  std::vector<T> packed(n*(n+1)/2);
+  basic_mdspan<T,extents_type,layout_type> A(packed.data(),n,n);
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++) {
+    const bool stored = lower ? i >= j : i <= j;
+    if(!stored) continue;
+    T a = T(1+i+2*j);
+    if constexpr (linalg::detail::is_complex<T>::value) {
+      if(i != j) a += T(0,i-j);
+      else if(!hermitian) a += T(0,1);
+    }
+    A(i,j) = a;
+    full[i*n+j] = a;
+    full[j*n+i] = hermitian ? linalg::detail::conj_if_needed(a) : a;
+  }
+
+  std::vector<T> x_data(n), y_data(n), z_data(n);
+  for(ptrdiff_t i=0; i<n; i++) { x_data[i] = T(i-3); y_data[i] = T(2*i); }
+  mdspan<T,dynamic_extent> x(x_data.data(),n), y(y_data.data(),n), z(z_data.data(),n);
+
+  if(hermitian) linalg::hermitian_matrix_vector_product(A,Triangle(),x,z);
+  else linalg::symmetric_matrix_vector_product(A,Triangle(),x,z);
+  for(ptrdiff_t i=0; i<n; i++) {
+    T expected{};
+    for(ptrdiff_t j=0; j<n; j++) expected += full[i*n+j]*x(j);
+    ASSERT_EQ(z(i),expected);
+  }
+
+  if(hermitian) linalg::hermitian_matrix_vector_product(A,Triangle(),x,y,z);
+  else linalg::symmetric_matrix_vector_product(A,Triangle(),x,y,z);
+  for(ptrdiff_t i=0; i<n; i++) {
+    T expected = y(i);
+    for(ptrdiff_t j=0; j<n; j++) expected += full[i*n+j]*x(j);
+    ASSERT_EQ(z(i),expected);
+  }
+}
+
+template<class Layout, class Triangle>
+void test_dense_triangle_product() {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  const ptrdiff_t n = 6;
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  std::vector<double> a_data(n*n,-1000.0);
+  basic_mdspan<double,extents_type,Layout> A(a_data.data(),n,n);
+  // only the stored triangle holds meaningful values
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++)
+    if(lower ? i >= j : i <= j) A(i,j) = 1.0 + i + 3*j;
+
+  std::vector<double> x_data(n), y_data(n);
+  for(ptrdiff_t i=0; i<n; i++) x_data[i] = 1.0 + i;
+  mdspan<double,dynamic_extent> x(x_data.data(),n), y(y_data.data(),n);
+
+  linalg::symmetric_matrix_vector_product(A,Triangle(),x,y);
+  for(ptrdiff_t i=0; i<n; i++) {
+    double expected = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) {
+      const bool stored = lower ? i >= j : i <= j;
+      expected += (stored ? A(i,j) : A(j,i))*x(j);
+    }
+    ASSERT_EQ(y(i),expected);
+  }
+}
+
+// Fill the band of A (and a dense copy) with distinct values
+template<class MatA>
+std::vector<double> fill_band(const MatA& A, ptrdiff_t kl, ptrdiff_t ku) {
+  const ptrdiff_t m = A.extent(0), n = A.extent(1);
+  std::vector<double> dense(m*n,0.0);
+  for(ptrdiff_t i=0; i<m; i++)
+  for(ptrdiff_t j=0; j<n; j++)
+    if(i-j <= kl && j-i <= ku) {
+      const double a = (i == j) ? 4.0+i : 1.0/(1+i+2*j);
+      A(i,j) = a;
+      dense[i*n+j] = a;
+    }
+  return dense;
+}
+
+template<class Layout, class Triangle, class DiagonalStorage>
+void test_triangular_solve(const ptrdiff_t kl, const ptrdiff_t ku, const ptrdiff_t span) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  const ptrdiff_t n = 9;
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  const bool unit = std::is_same<DiagonalStorage,linalg::implicit_unit_diagonal_t>::value;
+  std::vector<double> a_data(span,0.0);
+  basic_mdspan<double,extents_type,Layout> A(a_data.data(),n,n);
+  std::vector<double> dense = fill_band(A,kl,ku);
+  // packed layouts keep whichever of A(i,j) and A(j,i) was written last
+  if(kl >= n-1 && ku >= n-1)
+    for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<n; j++) dense[i*n+j] = A(i,j);
+
+  // b = T x_exact for the Triangle T of A
+  std::vector<double> x_exact(n), b_data(n), x_data(n);
+  for(ptrdiff_t i=0; i<n; i++) x_exact[i] = 1.0 + 0.5*i;
+  for(ptrdiff_t i=0; i<n; i++) {
+    double sum = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) {
+      if(lower ? j > i : j < i) continue;
+      sum += (i == j && unit ? 1.0 : dense[i*n+j]) * x_exact[j];
+    }
+    b_data[i] = sum;
+  }
+  mdspan<double,dynamic_extent> b(b_data.data(),n), x(x_data.data(),n);
+
+  linalg::triangular_matrix_vector_solve(A,Triangle(),DiagonalStorage(),b,x);
+  for(ptrdiff_t i=0; i<n; i++)
+    ASSERT_NEAR(x(i),x_exact[i],1e-12);
+
+  linalg::triangular_matrix_vector_solve(A,Triangle(),DiagonalStorage(),b);
+  for(ptrdiff_t i=0; i<n; i++)
+    ASSERT_NEAR(b(i),x_exact[i],1e-12);
+}
+
+template<class Triangle, class DiagonalStorage>
+void test_triangular_solve_all_layouts() {
+  const ptrdiff_t n = 9;
+  test_triangular_solve<layout_left,Triangle,DiagonalStorage>(n-1,n-1,n*n);
+  test_triangular_solve<layout_right,Triangle,DiagonalStorage>(n-1,n-1,n*n);
+  test_triangular_solve<linalg::layout_banded<2,1>,Triangle,DiagonalStorage>(2,1,4*n);
+  test_triangular_solve<linalg::layout_blas_packed<Triangle,linalg::column_major_t>,Triangle,DiagonalStorage>(n-1,n-1,n*(n+1)/2);
+  test_triangular_solve<linalg::layout_blas_packed<Triangle,linalg::row_major_t>,Triangle,DiagonalStorage>(n-1,n-1,n*(n+1)/2);
+}
+
+}
+
+TEST_F(linalg_blas2_,layout_banded_mapping) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  typedef linalg::layout_banded<2,1>::mapping<extents_type> mapping_type;
+  mapping_type map(extents_type(6,5));
+  ASSERT_EQ(map.leading_dimension(),4);
+  ASSERT_EQ(map.required_span_size(),20);
+  // AB(ku+i-j,j) in a column-major LDAB x N array
+  for(ptrdiff_t j=0; j<5; j++)
+  for(ptrdiff_t i=0; i<6; i++)
+    if(i-j <= 2 && j-i <= 1) {
+      ASSERT_EQ(map(i,j),(1+i-j)+j*4);
+    }
+}
+
+TEST_F(linalg_blas2_,matrix_vector_product) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  const ptrdiff_t m = 7, n = 5;
+  std::vector<double> x_data(n), y_data(m), z_data(m);
+  for(ptrdiff_t j=0; j<n; j++) x_data[j] = 1.0 + j;
+  for(ptrdiff_t i=0; i<m; i++) y_data[i] = -1.0*i;
+  mdspan<double,dynamic_extent> x(x_data.data(),n), y(y_data.data(),m), z(z_data.data(),m);
+
+  auto check = [&](const std::vector<double>& dense, bool update) {
+    for(ptrdiff_t i=0; i<m; i++) {
+      double expected = update ? y(i) : 0.0;
+      for(ptrdiff_t j=0; j<n; j++) expected += dense[i*n+j]*x(j);
+      ASSERT_NEAR(z(i),expected,1e-12);
+    }
+  };
+
+  {
+    std::vector<double> a_data(m*n);
+    basic_mdspan<double,extents_type,layout_left> A(a_data.data(),m,n);
+    std::vector<double> dense = fill_band(A,m,n);
+    linalg::matrix_vector_product(A,x,z);
+    check(dense,false);
+    linalg::matrix_vector_product(A,x,y,z);
+    check(dense,true);
+  }
+  {
+    std::vector<double> a_data(m*n);
+    basic_mdspan<double,extents_type,layout_right> A(a_data.data(),m,n);
+    std::vector<double> dense = fill_band(A,m,n);
+    linalg::matrix_vector_product(A,x,z);
+    check(dense,false);
+  }
+  {
+    // poison the unused corners of the band storage
+    std::vector<double> a_data(4*n,1e300);
+    basic_mdspan<double,extents_type,linalg::layout_banded<2,1>> A(a_data.data(),m,n);
+    std::vector<double> dense = fill_band(A,2,1);
+    linalg::matrix_vector_product(A,x,z);
+    check(dense,false);
+    linalg::matrix_vector_product(A,x,y,z);
+    check(dense,true);
+  }
+}
+
+namespace {
+
+template<class Layout>
+void test_parallel_matrix_vector_product(const ptrdiff_t m, const ptrdiff_t n, const ptrdiff_t kl, const ptrdiff_t ku) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  std::vector<double> a_data(m*n), x_data(n), y_data(m), z_data(m);
+  basic_mdspan<double,extents_type,Layout> A(a_data.data(),m,n);
+  std::vector<double> dense = fill_band(A,kl,ku);
+  for(ptrdiff_t j=0; j<n; j++) x_data[j] = 1.0 + j%7;
+  for(ptrdiff_t i=0; i<m; i++) y_data[i] = -1.0*(i%5);
+  mdspan<double,dynamic_extent> x(x_data.data(),n), y(y_data.data(),m), z(z_data.data(),m);
+
+  for(size_t num_threads : {2, 3, 8}) {
+    linalg::matrix_vector_product(linalg::thread_pool_policy(num_threads),A,x,y,z);
+    for(ptrdiff_t i=0; i<m; i++) {
+      double expected = y(i);
+      for(ptrdiff_t j=0; j<n; j++) expected += dense[i*n+j]*x(j);
+      ASSERT_NEAR(z(i),expected,1e-10*(1.0+std::abs(expected)));
+    }
+  }
+  linalg::matrix_vector_product(std::execution::par,A,x,z);
+  for(ptrdiff_t i=0; i<m; i++) {
+    double expected = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) expected += dense[i*n+j]*x(j);
+    ASSERT_NEAR(z(i),expected,1e-10*(1.0+std::abs(expected)));
+  }
+}
+
+}
+
+TEST_F(linalg_blas2_,matrix_vector_product_parallel) {
+  // tall and skinny, short and wide, square: rows or columns per thread
+  test_parallel_matrix_vector_product<layout_right>(20000,5,20000,5);
+  test_parallel_matrix_vector_product<layout_left>(20000,5,20000,5);
+  test_parallel_matrix_vector_product<layout_right>(5,20000,5,20000);
+  test_parallel_matrix_vector_product<layout_left>(5,20000,5,20000);
+  test_parallel_matrix_vector_product<layout_right>(300,301,300,301);
+  test_parallel_matrix_vector_product<layout_left>(301,300,301,300);
+}
+
+TEST_F(linalg_blas2_,matrix_vector_product_parallel_banded) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  const ptrdiff_t m = 3000, n = 2500;
+  std::vector<double> a_data(6*n,1e300), x_data(n), z_data(m);
+  basic_mdspan<double,extents_type,linalg::layout_banded<3,2>> A(a_data.data(),m,n);
+  std::vector<double> dense = fill_band(A,3,2);
+  for(ptrdiff_t j=0; j<n; j++) x_data[j] = 1.0 + j%3;
+  mdspan<double,dynamic_extent> x(x_data.data(),n), z(z_data.data(),m);
+  linalg::matrix_vector_product(linalg::thread_pool_policy(4),A,x,z);
+  for(ptrdiff_t i=0; i<m; i++) {
+    double expected = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) expected += dense[i*n+j]*x(j);
+    ASSERT_NEAR(z(i),expected,1e-12*(1.0+std::abs(expected)));
+  }
+}
+
+TEST_F(linalg_blas2_,triangular_matrix_vector_solve) {
+  test_triangular_solve_all_layouts<linalg::lower_triangle_t,linalg::explicit_diagonal_t>();
+  test_triangular_solve_all_layouts<linalg::upper_triangle_t,linalg::explicit_diagonal_t>();
+  test_triangular_solve_all_layouts<linalg::lower_triangle_t,linalg::implicit_unit_diagonal_t>();
+  test_triangular_solve_all_layouts<linalg::upper_triangle_t,linalg::implicit_unit_diagonal_t>();
+}
+
+TEST_F(linalg_blas2_,layout_blas_packed_mapping) {
+  for(ptrdiff_t n : {0,1,2,5}) {
+    test_packed_mapping<linalg::upper_triangle_t,linalg::column_major_t>(n);
+    test_packed_mapping<linalg::upper_triangle_t,linalg::row_major_t>(n);
+    test_packed_mapping<linalg::lower_triangle_t,linalg::column_major_t>(n);
+    test_packed_mapping<linalg::lower_triangle_t,linalg::row_major_t>(n);
+  }
+}
+
+TEST_F(linalg_blas2_,symmetric_matrix_vector_product_packed) {
+  test_packed_product<linalg::upper_triangle_t,linalg::column_major_t,double>(false);
+  test_packed_product<linalg::upper_triangle_t,linalg::row_major_t,double>(false);
+  test_packed_product<linalg::lower_triangle_t,linalg::column_major_t,double>(false);
+  test_packed_product<linalg::lower_triangle_t,linalg::row_major_t,double>(false);
+  test_packed_product<linalg::lower_triangle_t,linalg::column_major_t,std::complex<double>>(false);
+}
+
+TEST_F(linalg_blas2_,hermitian_matrix_vector_product_packed) {
+  typedef std::complex<double> complex_type;
+  test_packed_product<linalg::upper_triangle_t,linalg::column_major_t,complex_type>(true);
+  test_packed_product<linalg::upper_triangle_t,linalg::row_major_t,complex_type>(true);
+  test_packed_product<linalg::lower_triangle_t,linalg::column_major_t,complex_type>(true);
+  test_packed_product<linalg::lower_triangle_t,linalg::row_major_t,complex_type>(true);
+}
+
+TEST_F(linalg_blas2_,symmetric_matrix_vector_product_dense) {
+  test_dense_triangle_product<layout_left,linalg::lower_triangle_t>();
+  test_dense_triangle_product<layout_left,linalg::upper_triangle_t>();
+  test_dense_triangle_product<layout_right,linalg::lower_triangle_t>();
+  test_dense_triangle_product<layout_right,linalg::upper_triangle_t>();
+}
+
+namespace {
+
+// matrix_vector_product and triangular_matrix_vector_solve on fully
+// static operands, which take the unrolled small-matrix kernels.
+template<ptrdiff_t M, ptrdiff_t N, class LayoutA>
+void test_static_matrix_vector_product() {
+  std::vector<double> a_data(M*N+1), x_data(N+1), y_data(M+1), z_data(M+1);
+  basic_mdspan<double,extents<M,N>,LayoutA> A(a_data.data());
+  mdspan<double,N> x(x_data.data());
+  mdspan<double,M> y(y_data.data()), z(z_data.data());
+  for(ptrdiff_t i=0; i<M; i++) for(ptrdiff_t j=0; j<N; j++) A(i,j) = double((i*7+j*3)%11) - 5.0;
+  for(ptrdiff_t j=0; j<N; j++) x(j) = 1.0 + j;
+  for(ptrdiff_t i=0; i<M; i++) y(i) = -1.0*i;
+
+  linalg::matrix_vector_product(A,x,z);
+  for(ptrdiff_t i=0; i<M; i++) {
+    double expected = 0.0;
+    for(ptrdiff_t j=0; j<N; j++) expected += A(i,j)*x(j);
+    ASSERT_EQ(z(i),expected);
+  }
+  linalg::matrix_vector_product(linalg::scaled(2.0,A),x,y,z);
+  for(ptrdiff_t i=0; i<M; i++) {
+    double expected = y(i);
+    for(ptrdiff_t j=0; j<N; j++) expected += 2.0*A(i,j)*x(j);
+    ASSERT_EQ(z(i),expected);
+  }
+}
+
+template<ptrdiff_t N, class Layout, class Triangle, class DiagonalStorage>
+void test_static_triangular_solve() {
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  const bool unit = std::is_same<DiagonalStorage,linalg::implicit_unit_diagonal_t>::value;
+  std::vector<double> a_data(N*N);
+  basic_mdspan<double,extents<N,N>,Layout> A(a_data.data());
+  for(ptrdiff_t i=0; i<N; i++)
+  for(ptrdiff_t j=0; j<N; j++)
+    if(lower ? j <= i : i <= j) A(i,j) = (i == j) ? 4.0+i : 1.0/(1+i+2*j);
+
+  std::vector<double> x_exact(N), b_data(N), x_data(N);
+  for(ptrdiff_t i=0; i<N; i++) x_exact[i] = 1.0 + 0.5*i;
+  for(ptrdiff_t i=0; i<N; i++) {
+    double sum = 0.0;
+    for(ptrdiff_t j=(lower ? 0 : i); j<=(lower ? i : N-1); j++)
+      sum += (i == j && unit ? 1.0 : A(i,j)) * x_exact[j];
+    b_data[i] = sum;
+  }
+  mdspan<double,N> b(b_data.data()), x(x_data.data());
+
+  linalg::triangular_matrix_vector_solve(A,Triangle(),DiagonalStorage(),b,x);
+  for(ptrdiff_t i=0; i<N; i++) ASSERT_NEAR(x(i),x_exact[i],1e-12);
+  linalg::triangular_matrix_vector_solve(A,Triangle(),DiagonalStorage(),b);
+  for(ptrdiff_t i=0; i<N; i++) ASSERT_NEAR(b(i),x_exact[i],1e-12);
+}
+
+template<ptrdiff_t N, class Triangle, class DiagonalStorage>
+void test_static_triangular_solve_layouts() {
+  test_static_triangular_solve<N,layout_left,Triangle,DiagonalStorage>();
+  test_static_triangular_solve<N,layout_right,Triangle,DiagonalStorage>();
+  test_static_triangular_solve<N,linalg::layout_blas_packed<Triangle,linalg::column_major_t>,Triangle,DiagonalStorage>();
+}
+
+}
+
+TEST_F(linalg_blas2_,matrix_vector_product_static) {
+  test_static_matrix_vector_product<4,4,layout_left>();
+  test_static_matrix_vector_product<7,5,layout_right>();
+  test_static_matrix_vector_product<16,16,layout_left>();
+  test_static_matrix_vector_product<3,0,layout_right>();
+  test_static_matrix_vector_product<20,3,layout_right>();
+}
+
+TEST_F(linalg_blas2_,triangular_matrix_vector_solve_static) {
+  test_static_triangular_solve_layouts<1,linalg::lower_triangle_t,linalg::explicit_diagonal_t>();
+  test_static_triangular_solve_layouts<4,linalg::lower_triangle_t,linalg::explicit_diagonal_t>();
+  test_static_triangular_solve_layouts<9,linalg::upper_triangle_t,linalg::explicit_diagonal_t>();
+  test_static_triangular_solve_layouts<16,linalg::lower_triangle_t,linalg::implicit_unit_diagonal_t>();
+  test_static_triangular_solve_layouts<7,linalg::upper_triangle_t,linalg::implicit_unit_diagonal_t>();
+}
@@ -0,0 +1,493 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include<experimental/linalg>
+#include<cmath>
+#include<vector>
+#include"gtest/gtest.h"
+#include"linalg_test_helpers.hpp"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_blas3_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+template<class LayoutA, class LayoutB, class LayoutC>
+void test_matrix_product(ptrdiff_t m, ptrdiff_t n, ptrdiff_t k) {
+  test_matrix<double,LayoutA> A(m,k,1);
+  test_matrix<double,LayoutB> B(k,n,2);
+  test_matrix<double,LayoutC> C(m,n,3);
+  linalg::matrix_product(A.view,B.view,C.view);
+  check_product(A.view,B.view,C.view,0.0);
+
+  // C = E + A B, with E aliasing C
+  for(double& c : C.data) c = 1.0;
+  linalg::matrix_product(A.view,B.view,C.view,C.view);
+  check_product(A.view,B.view,C.view,1.0);
+}
+
+template<class LayoutA, class LayoutB, class LayoutC>
+void test_matrix_product_sizes() {
+  test_matrix_product<LayoutA,LayoutB,LayoutC>(1,1,1);
+  test_matrix_product<LayoutA,LayoutB,LayoutC>(13,9,7);
+  test_matrix_product<LayoutA,LayoutB,LayoutC>(4,5,0);
+  // crosses the mc and kc block boundaries of the double blocking
+  test_matrix_product<LayoutA,LayoutB,LayoutC>(100,10,300);
+  // crosses the nc block boundary
+  test_matrix_product<LayoutA,LayoutB,LayoutC>(3,2100,3);
+}
+
+}
+
+TEST_F(linalg_blas3_,matrix_product_right) {
+  test_matrix_product_sizes<layout_right,layout_right,layout_right>();
+}
+
+TEST_F(linalg_blas3_,matrix_product_left) {
+  test_matrix_product_sizes<layout_left,layout_left,layout_left>();
+}
+
+TEST_F(linalg_blas3_,matrix_product_mixed) {
+  test_matrix_product_sizes<layout_left,layout_right,layout_left>();
+  test_matrix_product_sizes<layout_right,layout_left,layout_right>();
+}
+
+TEST_F(linalg_blas3_,matrix_product_strided) {
+  const ptrdiff_t m = 21, n = 17, k = 19;
+  test_matrix<double,layout_right> A_full(2*m,k,1);
+  test_matrix<double,layout_left> B_full(k,2*n,2);
+  test_matrix<double,layout_right> C(m,n,3);
+  auto A = subspan(A_full.view,strided_slice{1,2*m-1,2},all);
+  auto B = subspan(B_full.view,all,std::pair<int,int>(n,2*n));
+  linalg::matrix_product(A,B,C.view);
+  check_product(A,B,C.view,0.0);
+}
+
+TEST_F(linalg_blas3_,matrix_product_float) {
+  const ptrdiff_t m = 37, n = 29, k = 400;
+  std::vector<float> a(m*k), b(k*n), c(m*n);
+  mdspan<float,dynamic_extent,dynamic_extent> A(a.data(),m,k), B(b.data(),k,n), C(c.data(),m,n);
+  for(ptrdiff_t i=0; i<m; i++) for(ptrdiff_t j=0; j<k; j++) A(i,j) = float((i+j)%3) - 1.0f;
+  for(ptrdiff_t i=0; i<k; i++) for(ptrdiff_t j=0; j<n; j++) B(i,j) = float((i*j)%5) - 2.0f;
+  linalg::matrix_product(A,B,C);
+  for(ptrdiff_t i=0; i<m; i++)
+  for(ptrdiff_t j=0; j<n; j++) {
+    float expected = 0.0f;
+    for(ptrdiff_t p=0; p<k; p++) expected += A(i,p)*B(p,j);
+    ASSERT_EQ(C(i,j),expected);
+  }
+}
+
+TEST_F(linalg_blas3_,matrix_product_wider_accumulator) {
+  // Each entry of A B is 2^24 + 1 + ... + 1 - 2^24.  Summed in float the
+  // ones vanish; summed in double, across kc steps and over several
+  // block rows of C too, they do not.
+  for(ptrdiff_t m : {37, 203})
+  for(ptrdiff_t k : {40, 301, 700}) {
+    const ptrdiff_t n = 29;
+    std::vector<float> a(m*k), b(k*n,1.0f), c(m*n), e(m*n,2.0f);
+    mdspan<float,dynamic_extent,dynamic_extent> A(a.data(),m,k), B(b.data(),k,n), C(c.data(),m,n), E(e.data(),m,n);
+    for(ptrdiff_t i=0; i<m; i++)
+    for(ptrdiff_t p=0; p<k; p++) A(i,p) = p == 0 ? 16777216.0f : p == k-1 ? -16777216.0f : 1.0f;
+
+    for(size_t num_threads : {1, 3}) {
+      linalg::matrix_product(linalg::thread_pool_policy(num_threads),linalg::accumulator<double>,A,B,C);
+      for(float c_ij : c) ASSERT_EQ(c_ij,float(k-2));
+      linalg::matrix_product(linalg::thread_pool_policy(num_threads),linalg::accumulator<double>,A,B,E,C);
+      for(float c_ij : c) ASSERT_EQ(c_ij,float(k));
+    }
+    linalg::matrix_product(linalg::accumulator<double>,A,B,C);
+    for(float c_ij : c) ASSERT_EQ(c_ij,float(k-2));
+    linalg::matrix_product(linalg::accumulator<double>,A,B,C,C);
+    for(float c_ij : c) ASSERT_EQ(c_ij,float(2*(k-2)));
+  }
+}
+
+TEST_F(linalg_blas3_,matrix_product_parallel) {
+  for(size_t num_threads : {1, 2, 3, 4, 6}) {
+    linalg::thread_pool_policy exec(num_threads);
+    test_matrix<double,layout_left> A(203,301,1);
+    test_matrix<double,layout_right> B(301,150,2);
+    test_matrix<double,layout_left> C(203,150,3);
+    linalg::matrix_product(exec,A.view,B.view,C.view);
+    check_product(A.view,B.view,C.view,0.0);
+
+    for(double& c : C.data) c = 1.0;
+    linalg::matrix_product(exec,A.view,B.view,C.view,C.view);
+    check_product(A.view,B.view,C.view,1.0);
+  }
+}
+
+TEST_F(linalg_blas3_,matrix_product_parallel_wide) {
+  // several nc blocks and a row count smaller than the thread count
+  test_matrix<double,layout_right> A(5,70,1);
+  test_matrix<double,layout_right> B(70,4200,2);
+  test_matrix<double,layout_right> C(5,4200,3);
+  linalg::matrix_product(linalg::thread_pool_policy(4),A.view,B.view,C.view);
+  check_product(A.view,B.view,C.view,0.0);
+}
+
+// A parallel product from inside every member of a team, rank 0
+// included, runs serially on that member.
+TEST_F(linalg_blas3_,matrix_product_parallel_nested) {
+  test_matrix<double,layout_left> A(203,301,1);
+  test_matrix<double,layout_right> B(301,150,2);
+  test_matrix<double,layout_left> C[3] = {{203,150,3},{203,150,3},{203,150,3}};
+  linalg::detail::thread_pool::instance().run(3, [&](size_t rank, size_t, linalg::detail::team_barrier&) {
+    linalg::matrix_product(linalg::thread_pool_policy(2),A.view,B.view,C[rank].view);
+  });
+  for(int r=0; r<3; r++) check_product(A.view,B.view,C[r].view,0.0);
+}
+
+TEST_F(linalg_blas3_,matrix_product_std_policies) {
+  test_matrix<double,layout_left> A(64,100,1);
+  test_matrix<double,layout_left> B(100,72,2);
+  test_matrix<double,layout_left> C(64,72,3);
+  linalg::matrix_product(std::execution::seq,A.view,B.view,C.view);
+  check_product(A.view,B.view,C.view,0.0);
+  linalg::matrix_product(std::execution::par,A.view,B.view,C.view);
+  check_product(A.view,B.view,C.view,0.0);
+}
+
+namespace {
+
+// matrix_product on fully static operands, which takes the unrolled
+// small-matrix kernels.
+template<ptrdiff_t M, ptrdiff_t N, ptrdiff_t K>
+void test_static_matrix_product() {
+  std::vector<double> a(M*K+1), b(K*N+1), bt(K*N+1), c(M*N+1), c0(M*N+1);
+  basic_mdspan<double,extents<M,K>,layout_right> A(a.data());
+  basic_mdspan<double,extents<K,N>,layout_left> B(b.data());
+  basic_mdspan<double,extents<N,K>,layout_right> Bt(bt.data());
+  basic_mdspan<double,extents<M,N>,layout_right> C(c.data());
+  for(ptrdiff_t i=0; i<M; i++) for(ptrdiff_t k=0; k<K; k++) A(i,k) = double((i*7+k*3+1)%11) - 5.0;
+  for(ptrdiff_t k=0; k<K; k++) for(ptrdiff_t j=0; j<N; j++) Bt(j,k) = B(k,j) = double((k*7+j*3+2)%11) - 5.0;
+  for(double& x : c) x = 3.0;
+
+  linalg::matrix_product(A,B,C);
+  check_product(A,B,C,0.0);
+  c0 = c;
+
+  for(double& x : c) x = 1.0;
+  linalg::matrix_product(A,B,C,C);
+  check_product(A,B,C,1.0);
+
+  linalg::matrix_product(linalg::scaled(2.0,A),linalg::transposed(Bt),C);
+  for(ptrdiff_t i=0; i<M*N; i++) ASSERT_EQ(c[i],2.0*c0[i]);
+}
+
+}
+
+TEST_F(linalg_blas3_,matrix_product_static) {
+  test_static_matrix_product<4,4,4>();
+  test_static_matrix_product<8,8,8>();
+  test_static_matrix_product<3,5,2>();
+  test_static_matrix_product<16,16,16>();
+  test_static_matrix_product<2,3,0>();
+  // beyond the small-matrix limit
+  test_static_matrix_product<17,2,3>();
+}
+
+namespace {
+
+// Dense copy of the triangle of A as the solver sees it.
+template<class Triangle, class DiagonalStorage, class MatA>
+std::vector<double> triangle_of(const MatA& A, const ptrdiff_t kl, const ptrdiff_t ku) {
+  const ptrdiff_t n = A.extent(0);
+  constexpr bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  std::vector<double> T(n*n,0.0);
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++) {
+    if(lower ? (j > i || i-j > kl) : (i > j || j-i > ku)) continue;
+    if(i == j && std::is_same<DiagonalStorage,linalg::implicit_unit_diagonal_t>::value) T[i*n+j] = 1.0;
+    else T[i*n+j] = A(i,j);
+  }
+  return T;
+}
+
+template<class MatA>
+void fill_triangular(const MatA& A) {
+  const ptrdiff_t n = A.extent(0);
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++)
+    A(i,j) = i == j ? 2.0 + i%3 : double((i*5+j*3)%7 - 3)/double(2*n);
+}
+
+// Check op(T) X == B, with X m x n for a right solve and n x m for a left one.
+template<bool Left, class MatX>
+void check_solve(const std::vector<double>& T, const MatX& X, const std::vector<double>& B) {
+  const ptrdiff_t rows = X.extent(0), cols = X.extent(1);
+  const ptrdiff_t n = Left ? rows : cols;
+  for(ptrdiff_t i=0; i<rows; i++)
+  for(ptrdiff_t j=0; j<cols; j++) {
+    double sum = 0.0;
+    for(ptrdiff_t k=0; k<n; k++)
+      sum += Left ? T[i*n+k]*X(k,j) : X(i,k)*T[k*n+j];
+    ASSERT_NEAR(sum,B[i*cols+j],1e-10) << "(" << i << "," << j << ")";
+  }
+}
+
+template<class LayoutA, class LayoutB, class Triangle, class DiagonalStorage>
+void test_trsm(const ptrdiff_t n, const ptrdiff_t m) {
+  test_matrix<double,LayoutA> A(n,n,0);
+  fill_triangular(A.view);
+  const std::vector<double> T = triangle_of<Triangle,DiagonalStorage>(A.view,n,n);
+
+  // left: T X = B with B n x m
+  {
+    test_matrix<double,LayoutB> B(n,m,4);
+    test_matrix<double,LayoutB> X(n,m,0);
+    std::vector<double> B0(n*m);
+    for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<m; j++) B0[i*m+j] = B.view(i,j);
+    linalg::triangular_matrix_matrix_left_solve(A.view,Triangle(),DiagonalStorage(),B.view,X.view);
+    check_solve<true>(T,X.view,B0);
+    linalg::triangular_matrix_matrix_left_solve(A.view,Triangle(),DiagonalStorage(),B.view);
+    check_solve<true>(T,B.view,B0);
+  }
+  // right: X T = B with B m x n
+  {
+    test_matrix<double,LayoutB> B(m,n,5);
+    test_matrix<double,LayoutB> X(m,n,0);
+    std::vector<double> B0(m*n);
+    for(ptrdiff_t i=0; i<m; i++) for(ptrdiff_t j=0; j<n; j++) B0[i*n+j] = B.view(i,j);
+    linalg::triangular_matrix_matrix_right_solve(A.view,Triangle(),DiagonalStorage(),B.view,X.view);
+    check_solve<false>(T,X.view,B0);
+    linalg::triangular_matrix_matrix_right_solve(A.view,Triangle(),DiagonalStorage(),B.view);
+    check_solve<false>(T,B.view,B0);
+  }
+}
+
+template<class LayoutA, class LayoutB>
+void test_trsm_all_triangles(const ptrdiff_t n, const ptrdiff_t m) {
+  test_trsm<LayoutA,LayoutB,linalg::lower_triangle_t,linalg::explicit_diagonal_t>(n,m);
+  test_trsm<LayoutA,LayoutB,linalg::upper_triangle_t,linalg::explicit_diagonal_t>(n,m);
+  test_trsm<LayoutA,LayoutB,linalg::lower_triangle_t,linalg::implicit_unit_diagonal_t>(n,m);
+  test_trsm<LayoutA,LayoutB,linalg::upper_triangle_t,linalg::implicit_unit_diagonal_t>(n,m);
+}
+
+}
+
+TEST_F(linalg_blas3_,triangular_matrix_matrix_solve_small) {
+  test_trsm_all_triangles<layout_left,layout_left>(7,5);
+  test_trsm_all_triangles<layout_right,layout_left>(7,5);
+  test_trsm_all_triangles<layout_left,layout_right>(7,5);
+  test_trsm_all_triangles<layout_right,layout_right>(1,3);
+}
+
+namespace {
+
+template<ptrdiff_t N, ptrdiff_t M, class LayoutA, class Triangle, class DiagonalStorage>
+void test_static_trsm() {
+  std::vector<double> a_data(N*N);
+  basic_mdspan<double,extents<N,N>,LayoutA> A(a_data.data());
+  fill_triangular(A);
+  const std::vector<double> T = triangle_of<Triangle,DiagonalStorage>(A,N,N);
+
+  std::vector<double> b_data(N*M), x_data(N*M), B0(N*M);
+  for(ptrdiff_t i=0; i<N*M; i++) B0[i] = b_data[i] = double((i*5)%9) - 4.0;
+
+  // left: T X = B with B N x M
+  basic_mdspan<double,extents<N,M>,layout_right> B(b_data.data()), X(x_data.data());
+  linalg::triangular_matrix_matrix_left_solve(A,Triangle(),DiagonalStorage(),B,X);
+  check_solve<true>(T,X,B0);
+
+  // right: X T = B with B M x N
+  basic_mdspan<double,extents<M,N>,layout_left> Br(b_data.data()), Xr(x_data.data());
+  for(ptrdiff_t i=0; i<M; i++) for(ptrdiff_t j=0; j<N; j++) Br(i,j) = B0[i*N+j];
+  linalg::triangular_matrix_matrix_right_solve(A,Triangle(),DiagonalStorage(),Br);
+  check_solve<false>(T,Br,B0);
+}
+
+template<ptrdiff_t N, ptrdiff_t M, class Triangle, class DiagonalStorage>
+void test_static_trsm_layouts() {
+  test_static_trsm<N,M,layout_left,Triangle,DiagonalStorage>();
+  test_static_trsm<N,M,layout_right,Triangle,DiagonalStorage>();
+  test_static_trsm<N,M,linalg::layout_blas_packed<Triangle,linalg::row_major_t>,Triangle,DiagonalStorage>();
+}
+
+}
+
+TEST_F(linalg_blas3_,triangular_matrix_matrix_solve_static) {
+  test_static_trsm_layouts<4,4,linalg::lower_triangle_t,linalg::explicit_diagonal_t>();
+  test_static_trsm_layouts<8,3,linalg::upper_triangle_t,linalg::explicit_diagonal_t>();
+  test_static_trsm_layouts<5,16,linalg::lower_triangle_t,linalg::implicit_unit_diagonal_t>();
+  test_static_trsm_layouts<16,1,linalg::upper_triangle_t,linalg::implicit_unit_diagonal_t>();
+}
+
+TEST_F(linalg_blas3_,triangular_matrix_matrix_solve_blocked) {
+  // deep enough to recurse twice, with ragged trailing blocks
+  test_trsm_all_triangles<layout_left,layout_left>(203,9);
+  test_trsm_all_triangles<layout_right,layout_right>(150,70);
+  test_trsm_all_triangles<layout_right,layout_left>(129,3);
+}
+
+TEST_F(linalg_blas3_,triangular_matrix_matrix_solve_strided) {
+  const ptrdiff_t n = 140, m = 6;
+  test_matrix<double,layout_left> A_full(2*n,n,0);
+  auto A = subspan(A_full.view,strided_slice{ptrdiff_t(0),2*n,ptrdiff_t(2)},all);
+  for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<n; j++) A(i,j) = i == j ? 3.0 : 1.0/(1+i+j);
+  const std::vector<double> T = triangle_of<linalg::lower_triangle_t,linalg::explicit_diagonal_t>(A,n,n);
+
+  test_matrix<double,layout_right> B_full(n,2*m,1);
+  auto B = subspan(B_full.view,all,strided_slice{ptrdiff_t(1),2*m-1,ptrdiff_t(2)});
+  std::vector<double> B0(n*m);
+  for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<m; j++) B0[i*m+j] = B(i,j);
+  linalg::triangular_matrix_matrix_left_solve(A,linalg::lower_triangle,linalg::explicit_diagonal,B);
+  check_solve<true>(T,B,B0);
+}
+
+TEST_F(linalg_blas3_,triangular_matrix_matrix_solve_packed_and_banded) {
+  const ptrdiff_t n = 90, m = 4;
+  {
+    std::vector<double> a_data(n*(n+1)/2);
+    basic_mdspan<double,matrix_extents,linalg::layout_blas_packed<linalg::upper_triangle_t,linalg::column_major_t>> A(a_data.data(),n,n);
+    for(ptrdiff_t j=0; j<n; j++) for(ptrdiff_t i=0; i<=j; i++) A(i,j) = i == j ? 2.0 : 1.0/(2+i+j);
+    const std::vector<double> T = triangle_of<linalg::upper_triangle_t,linalg::explicit_diagonal_t>(A,n,n);
+    test_matrix<double,layout_left> B(n,m,2);
+    std::vector<double> B0(n*m);
+    for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<m; j++) B0[i*m+j] = B.view(i,j);
+    linalg::triangular_matrix_matrix_left_solve(A,linalg::upper_triangle,linalg::explicit_diagonal,B.view);
+    check_solve<true>(T,B.view,B0);
+  }
+  {
+    // poison the unused corners of the band storage
+    std::vector<double> a_data(5*n,1e300);
+    basic_mdspan<double,matrix_extents,linalg::layout_banded<2,2>> A(a_data.data(),n,n);
+    for(ptrdiff_t j=0; j<n; j++)
+      for(ptrdiff_t i=(j>2 ? j-2 : 0); i<n && i<=j+2; i++) A(i,j) = i == j ? 4.0 : 0.5;
+    const std::vector<double> T = triangle_of<linalg::lower_triangle_t,linalg::explicit_diagonal_t>(A,2,2);
+    test_matrix<double,layout_right> B(m,n,3);
+    std::vector<double> B0(m*n);
+    for(ptrdiff_t i=0; i<m; i++) for(ptrdiff_t j=0; j<n; j++) B0[i*n+j] = B.view(i,j);
+    linalg::triangular_matrix_matrix_right_solve(A,linalg::lower_triangle,linalg::explicit_diagonal,B.view);
+    check_solve<false>(T,B.view,B0);
+  }
+}
+
+namespace {
+
+// C += alpha A A^T (or A A^H) on the Triangle of C, the other triangle
+// untouched.  C starts out holding 1 + i - j.
+template<bool Hermitian, class T, class LayoutA, class LayoutC, class Triangle, class Update>
+void test_rank_k_update(const ptrdiff_t n, const ptrdiff_t k, Update update) {
+  constexpr bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  std::vector<T> a(n*k), c(n*n);
+  basic_mdspan<T,matrix_extents,LayoutA> A(a.data(),n,k);
+  basic_mdspan<T,matrix_extents,LayoutC> C(c.data(),n,n);
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t p=0; p<k; p++) {
+    if constexpr (linalg::detail::is_complex<T>::value) A(i,p) = T(double((i*7+p*3)%11) - 5.0, double((i+p)%3) - 1.0);
+    else A(i,p) = T((i*7+p*3)%11) - T(5);
+  }
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++) C(i,j) = T(1+i-j);
+
+  update(A,C);
+
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++) {
+    T expected = T(1+i-j);
+    if(lower ? i >= j : i <= j) {
+      T sum{};
+      for(ptrdiff_t p=0; p<k; p++) sum += A(i,p)*(Hermitian ? linalg::detail::conj_if_needed(A(j,p)) : A(j,p));
+      expected += T(2)*sum;
+    }
+    ASSERT_EQ(C(i,j),expected);
+  }
+}
+
+template<class LayoutA, class LayoutC, class Triangle>
+void test_symmetric_rank_k_update_sizes(const size_t num_threads) {
+  auto update = [num_threads](auto A, auto C) {
+    if(num_threads == 1) linalg::symmetric_matrix_rank_k_update(2.0,A,C,Triangle());
+    else linalg::symmetric_matrix_rank_k_update(linalg::thread_pool_policy(num_threads),2.0,A,C,Triangle());
+  };
+  test_rank_k_update<false,double,LayoutA,LayoutC,Triangle>(1,1,update);
+  test_rank_k_update<false,double,LayoutA,LayoutC,Triangle>(13,7,update);
+  test_rank_k_update<false,double,LayoutA,LayoutC,Triangle>(6,0,update);
+  // crosses the mc and kc block boundaries of the double blocking
+  test_rank_k_update<false,double,LayoutA,LayoutC,Triangle>(203,300,update);
+}
+
+}
+
+TEST_F(linalg_blas3_,symmetric_matrix_rank_k_update) {
+  for(size_t num_threads : {1, 3}) {
+    test_symmetric_rank_k_update_sizes<layout_left,layout_left,linalg::lower_triangle_t>(num_threads);
+    test_symmetric_rank_k_update_sizes<layout_left,layout_left,linalg::upper_triangle_t>(num_threads);
+    test_symmetric_rank_k_update_sizes<layout_right,layout_left,linalg::lower_triangle_t>(num_threads);
+    test_symmetric_rank_k_update_sizes<layout_left,layout_right,linalg::upper_triangle_t>(num_threads);
+  }
+}
+
+TEST_F(linalg_blas3_,symmetric_matrix_rank_k_update_packed) {
+  // Only the stored triangle is compared, through the packed mapping.
+  const ptrdiff_t n = 37, k = 20;
+  test_matrix<double,layout_left> A(n,k,1);
+  std::vector<double> c(n*(n+1)/2, 1.0);
+  basic_mdspan<double,matrix_extents,linalg::layout_blas_packed<linalg::upper_triangle_t,linalg::row_major_t>> C(c.data(),n,n);
+  linalg::symmetric_matrix_rank_k_update(linalg::scaled(0.5,A.view),C,linalg::upper_triangle);
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=i; j<n; j++) {
+    double expected = 1.0;
+    for(ptrdiff_t p=0; p<k; p++) expected += 0.25*A.view(i,p)*A.view(j,p);
+    ASSERT_EQ(C(i,j),expected);
+  }
+}
+
+TEST_F(linalg_blas3_,hermitian_matrix_rank_k_update) {
+  typedef std::complex<double> cplx;
+  auto serial = [](auto A, auto C) { linalg::hermitian_matrix_rank_k_update(2.0,A,C,linalg::lower_triangle); };
+  auto parallel = [](auto A, auto C) { linalg::hermitian_matrix_rank_k_update(std::execution::par,2.0,A,C,linalg::upper_triangle); };
+  test_rank_k_update<true,cplx,layout_left,layout_left,linalg::lower_triangle_t>(13,7,serial);
+  test_rank_k_update<true,cplx,layout_right,layout_left,linalg::lower_triangle_t>(150,270,serial);
+  test_rank_k_update<true,cplx,layout_left,layout_right,linalg::upper_triangle_t>(150,70,parallel);
+}
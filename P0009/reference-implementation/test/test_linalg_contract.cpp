@@ -0,0 +1,241 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+
+#include<experimental/linalg>
+#include<string>
+#include<vector>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_contract_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef extents<dynamic_extent> extents_1;
+typedef extents<dynamic_extent,dynamic_extent> extents_2;
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> extents_3;
+
+// Tensor of small integers, so that every sum is exact.
+template<class Extents, class Layout = layout_right>
+struct tensor {
+  std::vector<double> data;
+  basic_mdspan<double,Extents,Layout> view;
+
+  template<class ... Exts>
+  tensor(int seed, Exts ... exts) {
+    const typename Layout::template mapping<Extents> map(Extents(exts...));
+    data.resize(map.required_span_size());
+    for(size_t i=0; i<data.size(); i++) data[i] = double((i*seed+3)%7) - 3.0;
+    view = basic_mdspan<double,Extents,Layout>(data.data(),map);
+  }
+};
+
+// The labels of A, B and C of spec.
+std::vector<std::string> spec_labels(const std::string & spec) {
+  const size_t comma = spec.find(','), arrow = spec.find("->");
+  return { spec.substr(0,comma), spec.substr(comma+1,arrow-comma-1), spec.substr(arrow+2) };
+}
+
+// Checks C against a loop over every value of every label, with A's
+// entries multiplied by scale.
+template<class TA, class TB, class TC>
+void check_contract(const char * spec, TA A, TB B, TC C, double scale = 1.0) {
+  const std::vector<std::string> labels = spec_labels(spec);
+  std::string all;
+  std::vector<ptrdiff_t> extent, stride[3];
+  auto add = [&](const std::string & l, auto X, int t) {
+    for(size_t r=0; r<l.size(); r++) {
+      size_t i = all.find(l[r]);
+      if(i == std::string::npos) {
+        i = all.size();
+        all += l[r];
+        extent.push_back(X.extent(r));
+        for(auto & s : stride) s.push_back(0);
+      }
+      stride[t][i] = X.stride(r);
+    }
+  };
+  add(labels[0],A,0); add(labels[1],B,1); add(labels[2],C,2);
+
+  ptrdiff_t span = 1;
+  for(size_t i=0; i<all.size(); i++) span += (extent[i]-1)*stride[2][i];
+  std::vector<double> expected(span, 0.0);
+  std::vector<bool> in_c(span, false);
+
+  std::vector<ptrdiff_t> index(all.size(), 0);
+  for(size_t i=0; i<all.size(); i++) if(extent[i] == 0) return;
+  while(true) {
+    ptrdiff_t o[3] = {0, 0, 0};
+    for(size_t i=0; i<all.size(); i++) for(int t=0; t<3; t++) o[t] += index[i]*stride[t][i];
+    expected[o[2]] += scale * A.data()[o[0]] * B.data()[o[1]];
+    in_c[o[2]] = true;
+    size_t i = all.size();
+    while(i > 0 && ++index[i-1] == extent[i-1]) index[--i] = 0;
+    if(i == 0) break;
+  }
+  for(ptrdiff_t o=0; o<span; o++) {
+    if(in_c[o]) { EXPECT_EQ(C.data()[o], expected[o]) << spec << " at " << o; }
+  }
+}
+
+template<class TA, class TB, class TC>
+void test_contract(const char * spec, TA & A, TB & B, TC & C) {
+  for(double & c : C.data) c = 99.0;
+  linalg::contract(spec,A.view,B.view,C.view);
+  check_contract(spec,A.view,B.view,C.view);
+  for(double & c : C.data) c = 99.0;
+  linalg::contract(linalg::thread_pool_policy(3),spec,A.view,B.view,C.view);
+  check_contract(spec,A.view,B.view,C.view);
+}
+
+TEST_F(linalg_contract_,contract_two_modes) {
+  {
+    // k fuses in A but not in B, which is packed.
+    tensor<extents_3> A(3,4,5,6), B(5,6,5,7);
+    tensor<extents_2> C(1,4,7);
+    test_contract("ikl,lkj->ij",A,B,C);
+  }
+  {
+    tensor<extents_3,layout_left> A(3,4,5,6), B(5,6,5,7);
+    tensor<extents_2,layout_left> C(1,4,7);
+    test_contract("ikl,lkj->ij",A,B,C);
+  }
+  {
+    // Several kc steps of the packed kernels.
+    tensor<extents_3> A(3,33,20,30), B(5,20,30,41);
+    tensor<extents_2> C(1,33,41), D(1,41,33);
+    test_contract("ikl,klj->ij",A,B,C);
+    test_contract("ikl,klj->ji",A,B,D);
+  }
+}
+
+TEST_F(linalg_contract_,contract_batch) {
+  tensor<extents_3> A(3,6,5,4), B(5,6,4,7), C(1,6,5,7);
+  test_contract("bij,bjk->bik",A,B,C);
+
+  // Batch mode in the middle of A and C, and C transposed.
+  tensor<extents_3> D(3,5,6,4), E(1,7,6,5);
+  test_contract("ibj,bjk->kbi",D,B,E);
+}
+
+TEST_F(linalg_contract_,contract_packed_output) {
+  // i and a are free modes of A that do not fuse in C.
+  tensor<extents_3> A(3,4,3,5), C(1,4,6,3);
+  tensor<extents_2> B(5,5,6);
+  test_contract("iak,kj->ija",A,B,C);
+}
+
+TEST_F(linalg_contract_,contract_degenerate) {
+  tensor<extents_1> x(3,5), y(5,6);
+  tensor<extents_2> A(3,5,6), C(1,5,6), D(1,5,4);
+  tensor<extents_3> E(1,5,6,3);
+  test_contract("i,j->ij",x,y,C);
+  test_contract("ij,j->i",A,y,x);
+  // j is only in A and summed over; k is in neither A nor B.
+  tensor<extents_1> z(7,4);
+  test_contract("ij,k->ik",A,z,D);
+  test_contract("i,j->ijk",x,y,E);
+  // Extents of one.
+  tensor<extents_3> F(3,5,1,6), G(1,1,6,4);
+  test_contract("iaj,ajb->ij",F,G,C);
+}
+
+TEST_F(linalg_contract_,contract_empty_sum) {
+  tensor<extents_2> A(3,4,0), B(5,0,6), C(1,4,6);
+  test_contract("ik,kj->ij",A,B,C);
+  for(double c : C.data) EXPECT_EQ(c, 0.0);
+}
+
+TEST_F(linalg_contract_,contract_strided_scaled) {
+  // Every other column of A, and A scaled.
+  tensor<extents_2> P(3,6,10), B(5,5,4), C(1,6,4);
+  basic_mdspan<double,extents_2,layout_stride> A(P.data.data(),
+    layout_stride::mapping<extents_2>(extents_2(6,5),std::array<ptrdiff_t,2>{10,2}));
+  linalg::contract("ij,jk->ik",A,B.view,C.view);
+  check_contract("ij,jk->ik",A,B.view,C.view);
+  linalg::contract("ij,jk->ik",linalg::scaled(2.0,A),B.view,C.view);
+  check_contract("ij,jk->ik",A,B.view,C.view,2.0);
+  // Scaled operands packed through the accessor: B, then A.
+  tensor<extents_3> Q(3,4,5,6), R(5,5,6,7);
+  tensor<extents_2> S(1,4,7);
+  linalg::contract("ikl,klj->ij",linalg::scaled(-1.0,Q.view),R.view,S.view);
+  check_contract("ikl,klj->ij",Q.view,R.view,S.view,-1.0);
+  tensor<extents_3> T(5,5,7,6);
+  linalg::contract("ikl,kjl->ij",linalg::scaled(-1.0,Q.view),T.view,S.view);
+  check_contract("ikl,kjl->ij",Q.view,T.view,S.view,-1.0);
+  tensor<extents_3> U(5,4,6,7);
+  tensor<extents_2> V(1,5,7);
+  linalg::contract("kil,klj->ij",linalg::scaled(-1.0,Q.view),U.view,V.view);
+  check_contract("kil,klj->ij",Q.view,U.view,V.view,-1.0);
+}
+
+TEST_F(linalg_contract_,contract_spec_checks) {
+  tensor<extents_2> A(1,3,4), B(2,4,5), C(3,3,5);
+  linalg::detail::contract_labels labels[3];
+  ASSERT_TRUE(linalg::detail::contract_parse("ij,jk->ik",labels));
+  ASSERT_TRUE(linalg::detail::contract_valid(labels,A.view,B.view,C.view));
+
+  // Malformed specs, numpy's implicit output form among them, are
+  // rejected without reading past their end.
+  for(const char * spec : {"ij,jk", "ij", "", "ij,jk-", "ij,jk-ik", "ijjk->ik", "ij,jk->i,k"}) {
+    ASSERT_FALSE(linalg::detail::contract_parse(spec,labels)) << spec;
+  }
+  // Too many or too few labels, a repeated label, and a label whose
+  // extents differ.
+  for(const char * spec : {"ijk,jk->ik", "ij,jk->i", "ii,jk->ik", "ij,kj->ik"}) {
+    ASSERT_TRUE(linalg::detail::contract_parse(spec,labels)) << spec;
+    ASSERT_FALSE(linalg::detail::contract_valid(labels,A.view,B.view,C.view)) << spec;
+  }
+}
+
+}
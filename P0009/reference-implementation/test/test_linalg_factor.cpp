@@ -0,0 +1,303 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include<experimental/linalg>
+#include<cmath>
+#include<complex>
+#include<vector>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_factor_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> batch_extents;
+
+// Batch of n x n matrices in a layout_right batch with extents Extents:
+// symmetric positive definite (M M^T + n I) if spd, else general with
+// zeros on the diagonal (for n > 1), so that the LU factorization must
+// pivot.
+template<class Extents>
+struct factor_batch {
+  std::vector<double> data;
+  basic_mdspan<double,Extents,layout_right> view;
+
+  factor_batch(ptrdiff_t batch, ptrdiff_t n, bool spd) : data(batch*n*n) {
+    if constexpr (Extents::rank_dynamic() == 1) view = basic_mdspan<double,Extents,layout_right>(data.data(),batch);
+    else view = basic_mdspan<double,Extents,layout_right>(data.data(),batch,n,n);
+    for(ptrdiff_t b=0; b<batch; b++)
+    for(ptrdiff_t i=0; i<n; i++)
+    for(ptrdiff_t j=0; j<n; j++) {
+      if(spd) {
+        double sum = i == j ? double(n) : 0.0;
+        for(ptrdiff_t k=0; k<n; k++) sum += entry(b,i,k)*entry(b,j,k);
+        view(b,i,j) = sum;
+      }
+      else {
+        view(b,i,j) = i == j ? (n == 1 ? 2.0 : 0.0) : entry(b,i,j) + (j == (i+1)%n ? 10.0 : 0.0);
+      }
+    }
+  }
+
+  static double entry(ptrdiff_t b, ptrdiff_t i, ptrdiff_t j) {
+    return double((b*5+i*7+j*3)%11)/11.0 - 0.5;
+  }
+};
+
+// Batch of right-hand sides, a vector per problem if nrhs is zero.
+struct rhs_batch {
+  std::vector<double> data;
+  ptrdiff_t nrhs;
+
+  rhs_batch(ptrdiff_t batch, ptrdiff_t n, ptrdiff_t nrhs_) : data(batch*n*(nrhs_ > 0 ? nrhs_ : 1)), nrhs(nrhs_) {
+    for(size_t k=0; k<data.size(); k++) data[k] = double(k%7) - 3.0;
+  }
+
+  mdspan<double,dynamic_extent,dynamic_extent> vectors(ptrdiff_t batch, ptrdiff_t n) {
+    return mdspan<double,dynamic_extent,dynamic_extent>(data.data(),batch,n);
+  }
+
+  mdspan<double,dynamic_extent,dynamic_extent,dynamic_extent> matrices(ptrdiff_t batch, ptrdiff_t n) {
+    return mdspan<double,dynamic_extent,dynamic_extent,dynamic_extent>(data.data(),batch,n,nrhs);
+  }
+};
+
+// max |A(b,:,:) X(b,:,r) - B(b,:,r)| over all problems and columns.
+template<class MatA, class Solution>
+double max_residual(const MatA& A, const std::vector<double>& x, const std::vector<double>& b,
+                    ptrdiff_t nrhs, Solution) {
+  const ptrdiff_t batch = A.extent(0), n = A.extent(1);
+  double worst = 0.0;
+  for(ptrdiff_t p=0; p<batch; p++)
+  for(ptrdiff_t r=0; r<nrhs; r++)
+  for(ptrdiff_t i=0; i<n; i++) {
+    double sum = -b[(p*n+i)*nrhs+r];
+    for(ptrdiff_t j=0; j<n; j++) sum += A(p,i,j)*x[(p*n+j)*nrhs+r];
+    worst = std::fmax(worst,std::fabs(sum));
+  }
+  return worst;
+}
+
+template<class Extents, class Triangle>
+void test_batched_cholesky(ptrdiff_t batch, ptrdiff_t n) {
+  const bool lower = std::is_same<Triangle,linalg::lower_triangle_t>::value;
+  factor_batch<Extents> A(batch,n,true), F(batch,n,true);
+  // the other triangle must not be accessed
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++)
+    if(lower ? j > i : j < i) F.view(b,i,j) = -99.0;
+  std::vector<ptrdiff_t> info_data(batch,-1);
+  mdspan<ptrdiff_t,dynamic_extent> info(info_data.data(),batch);
+
+  linalg::cholesky_factor(F.view,Triangle(),info);
+  for(ptrdiff_t b=0; b<batch; b++) {
+    ASSERT_EQ(info(b),0);
+    for(ptrdiff_t i=0; i<n; i++)
+    for(ptrdiff_t j=0; j<n; j++) {
+      if(lower ? j > i : j < i) { ASSERT_EQ(F.view(b,i,j),-99.0); continue; }
+      // (L L^T)(i,j) or (U^T U)(i,j)
+      double sum = 0.0;
+      for(ptrdiff_t k=0; k<=std::min(i,j); k++)
+        sum += lower ? F.view(b,i,k)*F.view(b,j,k) : F.view(b,k,i)*F.view(b,k,j);
+      ASSERT_NEAR(sum,A.view(b,i,j),1e-12*n);
+    }
+  }
+
+  for(ptrdiff_t nrhs : {0, 3}) {
+    rhs_batch X(batch,n,nrhs);
+    const std::vector<double> B = X.data;
+    if(nrhs == 0) linalg::cholesky_solve(F.view,Triangle(),X.vectors(batch,n));
+    else linalg::cholesky_solve(F.view,Triangle(),X.matrices(batch,n));
+    ASSERT_LT(max_residual(A.view,X.data,B,nrhs > 0 ? nrhs : 1,0),1e-10*n);
+  }
+}
+
+template<class Extents>
+void test_batched_lu(ptrdiff_t batch, ptrdiff_t n) {
+  factor_batch<Extents> A(batch,n,false), F(batch,n,false);
+  std::vector<ptrdiff_t> piv_data(batch*n), info_data(batch,-1);
+  mdspan<ptrdiff_t,dynamic_extent,dynamic_extent> piv(piv_data.data(),batch,n);
+  mdspan<ptrdiff_t,dynamic_extent> info(info_data.data(),batch);
+
+  linalg::lu_factor(F.view,piv,info);
+  for(ptrdiff_t b=0; b<batch; b++) {
+    ASSERT_EQ(info(b),0);
+    // P A = L U: apply the swaps to a copy of A and compare
+    std::vector<double> pa(n*n);
+    for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<n; j++) pa[i*n+j] = A.view(b,i,j);
+    for(ptrdiff_t k=0; k<n; k++) {
+      ASSERT_TRUE(piv(b,k) >= k && piv(b,k) < n);
+      for(ptrdiff_t j=0; j<n; j++) std::swap(pa[k*n+j],pa[piv(b,k)*n+j]);
+    }
+    for(ptrdiff_t i=0; i<n; i++)
+    for(ptrdiff_t j=0; j<n; j++) {
+      double sum = i <= j ? F.view(b,i,j) : 0.0;
+      for(ptrdiff_t k=0; k<std::min(i,j+1); k++) sum += F.view(b,i,k)*F.view(b,k,j);
+      ASSERT_NEAR(sum,pa[i*n+j],1e-12*n);
+    }
+  }
+
+  for(ptrdiff_t nrhs : {0, 2}) {
+    rhs_batch X(batch,n,nrhs);
+    const std::vector<double> B = X.data;
+    if(nrhs == 0) linalg::lu_solve(F.view,piv,X.vectors(batch,n));
+    else linalg::lu_solve(F.view,piv,X.matrices(batch,n));
+    ASSERT_LT(max_residual(A.view,X.data,B,nrhs > 0 ? nrhs : 1,0),1e-10*n);
+  }
+}
+
+}
+
+TEST_F(linalg_factor_,cholesky_batched) {
+  for(ptrdiff_t n : {1, 3, 8, 17})
+  for(ptrdiff_t batch : {0, 1, 13, 20}) {
+    test_batched_cholesky<batch_extents,linalg::lower_triangle_t>(batch,n);
+    test_batched_cholesky<batch_extents,linalg::upper_triangle_t>(batch,n);
+  }
+}
+
+TEST_F(linalg_factor_,cholesky_batched_static) {
+  test_batched_cholesky<extents<dynamic_extent,4,4>,linalg::lower_triangle_t>(21,4);
+  test_batched_cholesky<extents<dynamic_extent,6,6>,linalg::upper_triangle_t>(8,6);
+  test_batched_cholesky<extents<dynamic_extent,20,20>,linalg::lower_triangle_t>(3,20);
+}
+
+TEST_F(linalg_factor_,cholesky_not_positive_definite) {
+  const ptrdiff_t batch = 11, n = 5;
+  factor_batch<batch_extents> A(batch,n,true);
+  A.view(4,2,2) = -1.0;
+  A.view(9,0,0) = 0.0;
+  std::vector<ptrdiff_t> info_data(batch,-1);
+  mdspan<ptrdiff_t,dynamic_extent> info(info_data.data(),batch);
+  linalg::cholesky_factor(A.view,linalg::lower_triangle,info);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(info(b), b == 4 ? 3 : b == 9 ? 1 : 0);
+}
+
+TEST_F(linalg_factor_,lu_batched) {
+  for(ptrdiff_t n : {1, 2, 5, 8, 17})
+  for(ptrdiff_t batch : {0, 1, 9, 16})
+    test_batched_lu<batch_extents>(batch,n);
+  test_batched_lu<extents<dynamic_extent,4,4>>(19,4);
+  test_batched_lu<extents<dynamic_extent,3,3>>(8,3);
+}
+
+TEST_F(linalg_factor_,lu_singular) {
+  const ptrdiff_t batch = 6, n = 4;
+  factor_batch<batch_extents> A(batch,n,false);
+  for(ptrdiff_t i=0; i<n; i++) { A.view(2,i,1) = 0.0; A.view(5,i,n-1) = 0.0; }
+  std::vector<ptrdiff_t> piv_data(batch*n), info_data(batch,-1);
+  mdspan<ptrdiff_t,dynamic_extent,dynamic_extent> piv(piv_data.data(),batch,n);
+  mdspan<ptrdiff_t,dynamic_extent> info(info_data.data(),batch);
+  linalg::lu_factor(A.view,piv,info);
+  for(ptrdiff_t b=0; b<batch; b++) {
+    if(b == 2) ASSERT_GE(info(b),1);
+    else if(b == 5) ASSERT_EQ(info(b),n);
+    else ASSERT_EQ(info(b),0);
+  }
+}
+
+TEST_F(linalg_factor_,single_matrix) {
+  const ptrdiff_t n = 6;
+  factor_batch<batch_extents> S(1,n,true), G(1,n,false);
+  std::vector<double> a_data(n*n), x_data(n);
+  mdspan<double,dynamic_extent,dynamic_extent> A(a_data.data(),n,n);
+  mdspan<double,dynamic_extent> x(x_data.data(),n);
+
+  for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<n; j++) A(i,j) = S.view(0,i,j);
+  ASSERT_EQ(linalg::cholesky_factor(A,linalg::upper_triangle),0);
+  for(ptrdiff_t i=0; i<n; i++) x(i) = 1.0 + i;
+  linalg::cholesky_solve(A,linalg::upper_triangle,x);
+  for(ptrdiff_t i=0; i<n; i++) {
+    double sum = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) sum += S.view(0,i,j)*x(j);
+    ASSERT_NEAR(sum,1.0+i,1e-12);
+  }
+
+  std::vector<ptrdiff_t> piv_data(n);
+  mdspan<ptrdiff_t,dynamic_extent> piv(piv_data.data(),n);
+  for(ptrdiff_t i=0; i<n; i++) for(ptrdiff_t j=0; j<n; j++) A(i,j) = G.view(0,i,j);
+  ASSERT_EQ(linalg::lu_factor(A,piv),0);
+  for(ptrdiff_t i=0; i<n; i++) x(i) = 1.0 - i;
+  linalg::lu_solve(A,piv,x);
+  for(ptrdiff_t i=0; i<n; i++) {
+    double sum = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) sum += G.view(0,i,j)*x(j);
+    ASSERT_NEAR(sum,1.0-i,1e-12);
+  }
+}
+
+TEST_F(linalg_factor_,cholesky_hermitian) {
+  typedef std::complex<double> complex_t;
+  const ptrdiff_t batch = 5, n = 3;
+  std::vector<complex_t> a_data(batch*n*n), f_data(batch*n*n), x_data(batch*n);
+  mdspan<complex_t,dynamic_extent,dynamic_extent,dynamic_extent> A(a_data.data(),batch,n,n), F(f_data.data(),batch,n,n);
+  mdspan<complex_t,dynamic_extent,dynamic_extent> x(x_data.data(),batch,n);
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t i=0; i<n; i++)
+  for(ptrdiff_t j=0; j<n; j++)
+    A(b,i,j) = i == j ? complex_t(4.0+b,0.0) : complex_t(0.5, i < j ? 0.25*b : -0.25*b);
+  f_data = a_data;
+  std::vector<ptrdiff_t> info_data(batch,-1);
+  mdspan<ptrdiff_t,dynamic_extent> info(info_data.data(),batch);
+  linalg::cholesky_factor(F,linalg::upper_triangle,info);
+  for(ptrdiff_t b=0; b<batch; b++) ASSERT_EQ(info(b),0);
+  for(ptrdiff_t b=0; b<batch; b++) for(ptrdiff_t i=0; i<n; i++) x(b,i) = complex_t(1.0,double(i));
+  linalg::cholesky_solve(F,linalg::upper_triangle,x);
+  for(ptrdiff_t b=0; b<batch; b++)
+  for(ptrdiff_t i=0; i<n; i++) {
+    complex_t sum = 0.0;
+    for(ptrdiff_t j=0; j<n; j++) sum += A(b,i,j)*x(b,j);
+    ASSERT_NEAR(std::abs(sum-complex_t(1.0,double(i))),0.0,1e-12);
+  }
+}
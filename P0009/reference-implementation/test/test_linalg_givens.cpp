@@ -0,0 +1,175 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include<experimental/linalg>
+#include<cmath>
+#include<complex>
+#include<vector>
+#include"gtest/gtest.h"
+#include"linalg_test_helpers.hpp"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_givens_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef std::complex<double> cd;
+
+// K sequences of rotations through angles spread over the circle; the
+// sines have a phase when T is complex.
+template<class T>
+void fill_rotations(test_matrix<double,layout_right> & c, test_matrix<T,layout_right> & s) {
+  for(ptrdiff_t k=0; k<c.view.extent(0); k++)
+  for(ptrdiff_t j=0; j<c.view.extent(1); j++) {
+    const double theta = 0.37*double((k*5+j*3)%17) - 3.0;
+    c.view(k,j) = std::cos(theta);
+    if constexpr (std::is_same_v<T,cd>) s.view(k,j) = std::polar(std::sin(theta), 0.5*double(k-j));
+    else s.view(k,j) = std::sin(theta);
+  }
+}
+
+// The rotations one at a time, in the order of the sequences.
+template<class Side, class T, class A>
+void reference_apply(Side, const test_matrix<double,layout_right> & c, const test_matrix<T,layout_right> & s, A a) {
+  constexpr bool left = std::is_same_v<Side,linalg::left_side_t>;
+  const ptrdiff_t n = a.extent(left ? 1 : 0);
+  for(ptrdiff_t k=0; k<c.view.extent(0); k++)
+  for(ptrdiff_t j=0; j<c.view.extent(1); j++) {
+    const T sn = left ? s.view(k,j) : T(linalg::detail::conj_if_needed(s.view(k,j)));
+    const T sc = linalg::detail::conj_if_needed(sn);
+    for(ptrdiff_t q=0; q<n; q++) {
+      T & x = left ? a(j,q) : a(q,j);
+      T & y = left ? a(j+1,q) : a(q,j+1);
+      const T x0 = x, y0 = y;
+      x = c.view(k,j)*x0 + sn*y0;
+      y = c.view(k,j)*y0 - sc*x0;
+    }
+  }
+}
+
+template<class A, class B>
+void expect_near(A a, B b) {
+  for(ptrdiff_t i=0; i<a.extent(0); i++)
+    for(ptrdiff_t j=0; j<a.extent(1); j++)
+      EXPECT_NEAR(std::abs(a(i,j)-b(i,j)),0.0,1e-12) << i << "," << j;
+}
+
+// By default enough lines, entries and sequences for several tiles,
+// panels and groups of sequences.
+template<class T, class Layout, class Side>
+void test_against_reference(Side side, ptrdiff_t lines = 37, ptrdiff_t len = 700, ptrdiff_t K = 40) {
+  constexpr bool left = std::is_same_v<Side,linalg::left_side_t>;
+  test_matrix<double,layout_right> c(K,lines-1,0);
+  test_matrix<T,layout_right> s(K,lines-1,0);
+  fill_rotations(c,s);
+  test_matrix<T,Layout> a(left ? lines : len, left ? len : lines,0);
+  test_matrix<T,Layout> b(left ? lines : len, left ? len : lines,0);
+  linalg::givens_rotation_sequence_apply(side,c.view,s.view,a.view);
+  reference_apply(side,c,s,b.view);
+  expect_near(a.view,b.view);
+}
+
+}
+
+TEST_F(linalg_givens_,left_side) {
+  test_against_reference<double,layout_right>(linalg::left_side);
+  test_against_reference<double,layout_left>(linalg::left_side);
+  test_against_reference<cd,layout_right>(linalg::left_side);
+  // Fewer lines than a tile has.
+  for(ptrdiff_t lines=2; lines<6; lines++) test_against_reference<double,layout_right>(linalg::left_side,lines,45,7);
+}
+
+TEST_F(linalg_givens_,right_side) {
+  test_against_reference<double,layout_left>(linalg::right_side);
+  test_against_reference<double,layout_right>(linalg::right_side);
+  test_against_reference<cd,layout_left>(linalg::right_side);
+}
+
+// The rotations accumulated from the right into the identity are the
+// adjoint of the ones applied from the left, so Q (P A) = A.
+TEST_F(linalg_givens_,right_side_accumulates_adjoint) {
+  const ptrdiff_t m = 20, n = 9, K = 23;
+  test_matrix<double,layout_right> c(K,m-1,0);
+  test_matrix<cd,layout_right> s(K,m-1,0);
+  fill_rotations(c,s);
+  test_matrix<cd,layout_right> a(m,n,0), pa(m,n,0), q(m,m,0), qpa(m,n,0);
+  for(ptrdiff_t i=0; i<m; i++)
+    for(ptrdiff_t j=0; j<m; j++) q.view(i,j) = i == j ? 1.0 : 0.0;
+  linalg::givens_rotation_sequence_apply(linalg::left_side,c.view,s.view,pa.view);
+  linalg::givens_rotation_sequence_apply(linalg::right_side,c.view,s.view,q.view);
+  linalg::matrix_product(q.view,pa.view,qpa.view);
+  expect_near(qpa.view,a.view);
+}
+
+TEST_F(linalg_givens_,threads_and_strided_views) {
+  const ptrdiff_t m = 30, n = 515, K = 18;
+  test_matrix<double,layout_right> c(K,m-1,0);
+  test_matrix<double,layout_right> s(K,m-1,0);
+  fill_rotations(c,s);
+  test_matrix<double,layout_right> a(m+2,n+3,0), b(m+2,n+3,0);
+  // The interior of a larger matrix, and a single sequence.
+  auto a_sub = subspan(a.view,std::pair<ptrdiff_t,ptrdiff_t>{1,m+1},std::pair<ptrdiff_t,ptrdiff_t>{2,n+2});
+  auto b_sub = subspan(b.view,std::pair<ptrdiff_t,ptrdiff_t>{1,m+1},std::pair<ptrdiff_t,ptrdiff_t>{2,n+2});
+  linalg::givens_rotation_sequence_apply(linalg::thread_pool_policy(3),linalg::left_side,c.view,s.view,a_sub);
+  reference_apply(linalg::left_side,c,s,b_sub);
+  expect_near(a.view,b.view);
+
+  auto c1 = subspan(c.view,std::pair<ptrdiff_t,ptrdiff_t>{0,1},all);
+  auto s1 = subspan(s.view,std::pair<ptrdiff_t,ptrdiff_t>{0,1},all);
+  linalg::givens_rotation_sequence_apply(linalg::thread_pool_policy(2),linalg::left_side,c1,s1,a_sub);
+  for(ptrdiff_t j=0; j<m-1; j++) {
+    auto x = subspan(b_sub,j,all);
+    auto y = subspan(b_sub,j+1,all);
+    linalg::givens_rotation_apply(x,y,c.view(0,j),s.view(0,j));
+  }
+  expect_near(a.view,b.view);
+}
@@ -0,0 +1,246 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+
+#include<experimental/linalg>
+#include<vector>
+#include"gtest/gtest.h"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_stencil_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef extents<dynamic_extent> extents_1;
+typedef extents<dynamic_extent,dynamic_extent> extents_2;
+typedef extents<dynamic_extent,dynamic_extent,dynamic_extent> extents_3;
+
+template<ptrdiff_t Halo, class Extents>
+using halo_grid = basic_mdspan<double,Extents,linalg::layout_halo<Halo>>;
+
+// Small integers everywhere, ghost cells included, so that every sum is
+// exact.
+template<class Grid>
+std::vector<double> fill_grid(Grid & x, int seed) {
+  std::vector<double> data(x.mapping().required_span_size());
+  for(size_t i=0; i<data.size(); i++) data[i] = double((i*seed+5)%9) - 4.0;
+  x = Grid(data.data(),x.mapping());
+  return data;
+}
+
+// out = S in, one point at a time, for grids of rank three.
+template<class Stencil, class In, class Out>
+void reference_apply(const Stencil & s, In in, Out out) {
+  for(ptrdiff_t i=0; i<out.extent(0); i++)
+  for(ptrdiff_t j=0; j<out.extent(1); j++)
+  for(ptrdiff_t k=0; k<out.extent(2); k++) {
+    double sum = 0.0;
+    for(size_t p=0; p<Stencil::size(); p++) {
+      const auto & o = s.points[p].offset;
+      sum += s.points[p].weight * in(i+o[0],j+o[1],k+o[2]);
+    }
+    out(i,j,k) = sum;
+  }
+}
+
+template<class Grid>
+void expect_equal_interior(Grid x, Grid y) {
+  for(ptrdiff_t i=0; i<x.extent(0); i++)
+  for(ptrdiff_t j=0; j<x.extent(1); j++)
+  for(ptrdiff_t k=0; k<x.extent(2); k++) EXPECT_EQ(x(i,j,k), y(i,j,k)) << i << "," << j << "," << k;
+}
+
+// stencil_sweep against steps of reference_apply, on n0 x n1 x n2 grids
+// with a halo of Halo.
+template<ptrdiff_t Halo, class Stencil>
+void test_sweep(const Stencil & s, ptrdiff_t n0, ptrdiff_t n1, ptrdiff_t n2, ptrdiff_t steps, size_t num_threads) {
+  halo_grid<Halo,extents_3> u(nullptr,n0,n1,n2);
+  std::vector<double> u_data = fill_grid(u,7);
+  // The ghost cells of tmp hold the boundary values, its interior not.
+  std::vector<double> tmp_data = u_data, v_data = u_data, w_data = u_data;
+  halo_grid<Halo,extents_3> tmp(tmp_data.data(),u.mapping()), v(v_data.data(),u.mapping()), w(w_data.data(),u.mapping());
+  for(ptrdiff_t i=0; i<n0; i++)
+  for(ptrdiff_t j=0; j<n1; j++)
+  for(ptrdiff_t k=0; k<n2; k++) tmp(i,j,k) = -99.0;
+
+  for(ptrdiff_t t=0; t<steps; t++) {
+    reference_apply(s,v,w);
+    std::swap(v,w);
+  }
+  linalg::stencil_sweep(linalg::thread_pool_policy(num_threads),s,steps,u,tmp);
+  expect_equal_interior(u,v);
+}
+
+}
+
+TEST_F(linalg_stencil_,layout_halo) {
+  typedef linalg::layout_halo<2,8>::mapping<extents_3> mapping_3;
+  const mapping_3 map(extents_3(3,4,5));
+  // Rows of 2+5+2 padded from 6+9 to 16, planes of 4+2+2 rows.
+  EXPECT_EQ(map.stride(2), 1);
+  EXPECT_EQ(map.stride(1), 16);
+  EXPECT_EQ(map.stride(0), 16*8);
+  EXPECT_EQ(map.required_span_size(), 16*8*7);
+  EXPECT_EQ(map(0,0,0), 2*16*8 + 2*16 + 8);
+  EXPECT_EQ(map(-2,-2,-2), 6);
+  EXPECT_LT(map(4,5,6), map.required_span_size());
+  for(ptrdiff_t i=0; i<3; i++)
+  for(ptrdiff_t j=0; j<4; j++) EXPECT_EQ(map(i,j,0) % 8, 0);
+
+  const linalg::layout_halo<1,4>::mapping<extents_1> map_1(extents_1(5));
+  EXPECT_EQ(map_1(0), 4);
+  EXPECT_EQ(map_1.required_span_size(), 12);
+
+  // Slices are layout_stride views of the interior.
+  std::vector<double> data(map.required_span_size());
+  basic_mdspan<double,extents_3,linalg::layout_halo<2,8>> x(data.data(),map);
+  auto plane = subspan(x,1,all,std::pair<ptrdiff_t,ptrdiff_t>(1,4));
+  static_assert(std::is_same<decltype(plane)::layout_type,layout_stride>::value,"");
+  EXPECT_EQ(plane.extent(0), 4);
+  EXPECT_EQ(plane.extent(1), 3);
+  EXPECT_EQ(&plane(2,1), &x(1,2,2));
+}
+
+TEST_F(linalg_stencil_,stencil_points) {
+  const auto s7 = linalg::seven_point_stencil(-6.0,1.0);
+  EXPECT_EQ(s7.radius(), 1);
+  double sum = 0.0;
+  for(const auto & p : s7.points) sum += p.weight;
+  EXPECT_EQ(sum, 0.0);
+
+  const auto s27 = linalg::twenty_seven_point_stencil(-68.0,6.0,2.0,1.0);
+  EXPECT_EQ(s27.radius(), 1);
+  sum = 0.0;
+  for(const auto & p : s27.points) sum += p.weight;
+  EXPECT_EQ(sum, 0.0);
+
+  const linalg::stencil<double,2,3> s2 = {{{ {{0,-2}, 1.0}, {{0,0}, -2.0}, {{3,0}, 1.0} }}};
+  EXPECT_EQ(s2.radius(), 3);
+}
+
+TEST_F(linalg_stencil_,stencil_apply) {
+  // In the interior of a layout_right grid, out in layout_right.
+  std::vector<double> in_data(7*8*9), out_data(5*6*7), expected_data(5*6*7);
+  for(size_t i=0; i<in_data.size(); i++) in_data[i] = double((i*3+1)%11) - 5.0;
+  basic_mdspan<double,extents_3,layout_right> in_all(in_data.data(),7,8,9);
+  auto in = subspan(in_all,std::pair<ptrdiff_t,ptrdiff_t>(1,6),std::pair<ptrdiff_t,ptrdiff_t>(1,7),std::pair<ptrdiff_t,ptrdiff_t>(1,8));
+  basic_mdspan<double,extents_3,layout_right> out(out_data.data(),5,6,7), expected(expected_data.data(),5,6,7);
+
+  const auto s27 = linalg::twenty_seven_point_stencil(-26.0,3.0,2.0,1.0);
+  reference_apply(s27,in,expected);
+  linalg::stencil_apply(s27,in,out);
+  expect_equal_interior(out,expected);
+  for(double & x : out_data) x = 0.0;
+  linalg::stencil_apply(linalg::thread_pool_policy(3),s27,in,out);
+  expect_equal_interior(out,expected);
+
+  // Rank two, radius two, and a strided row.
+  const linalg::stencil<double,2,4> s2 = {{{ {{0,-2}, 1.0}, {{0,0}, -2.0}, {{2,1}, 3.0}, {{-1,0}, 1.0} }}};
+  basic_mdspan<double,extents_2,layout_right> in2_all(in_data.data(),20,30);
+  auto in2 = subspan(in2_all,std::pair<ptrdiff_t,ptrdiff_t>(2,18),std::pair<ptrdiff_t,ptrdiff_t>(2,28));
+  std::vector<double> out2_data(16*2*26);
+  basic_mdspan<double,extents_2,layout_stride> out2(out2_data.data(),
+    layout_stride::mapping<extents_2>(extents_2(16,26),std::array<ptrdiff_t,2>{52,2}));
+  linalg::stencil_apply(s2,in2,out2);
+  for(ptrdiff_t i=0; i<16; i++)
+  for(ptrdiff_t j=0; j<26; j++)
+    EXPECT_EQ(out2(i,j), in2(i,j-2) - 2.0*in2(i,j) + 3.0*in2(i+2,j+1) + in2(i-1,j));
+}
+
+TEST_F(linalg_stencil_,stencil_sweep) {
+  const auto s7 = linalg::seven_point_stencil(-2.0,1.0);
+  const auto s27 = linalg::twenty_seven_point_stencil(0.0,1.0,-1.0,1.0);
+  for(size_t num_threads : {1, 3}) {
+    for(ptrdiff_t steps : {1, 2, 3, 4, 5, 9}) {
+      test_sweep<1>(s7,6,7,9,steps,num_threads);
+      test_sweep<1>(s27,5,9,4,steps,num_threads);
+    }
+    // More rows than one tile holds, and a halo wider than the radius.
+    test_sweep<2>(s7,4,200,70,6,num_threads);
+    // Radius two.
+    const linalg::stencil<double,3,3> s2 = {{{ {{-2,0,0}, 1.0}, {{0,1,0}, -1.0}, {{1,-2,2}, 1.0} }}};
+    test_sweep<2>(s2,7,40,13,5,num_threads);
+  }
+  // Nothing to do.
+  test_sweep<1>(s7,0,7,9,3,1);
+  test_sweep<1>(s7,6,7,9,0,1);
+}
+
+TEST_F(linalg_stencil_,stencil_sweep_rank_1_2) {
+  const linalg::stencil<double,1,3> s1 = {{{ {{-1}, 1.0}, {{0}, -1.0}, {{1}, 1.0} }}};
+  halo_grid<1,extents_1> u(nullptr,50), tmp(u);
+  std::vector<double> u_data = fill_grid(u,3), tmp_data = u_data, v_data = u_data, w_data = u_data;
+  tmp = decltype(tmp)(tmp_data.data(),u.mapping());
+  for(int t=0; t<7; t++) {
+    for(ptrdiff_t i=0; i<50; i++) {
+      const ptrdiff_t o = u.mapping()(i);
+      w_data[o] = v_data[o-1] - v_data[o] + v_data[o+1];
+    }
+    std::swap(v_data,w_data);
+  }
+  linalg::stencil_sweep(s1,7,u,tmp);
+  for(ptrdiff_t i=0; i<50; i++) EXPECT_EQ(u(i), v_data[u.mapping()(i)]);
+
+  const linalg::stencil<double,2,5> s2 = {{{ {{0,0}, -3.0}, {{-1,0}, 1.0}, {{1,0}, 1.0}, {{0,-1}, 1.0}, {{0,1}, 1.0} }}};
+  halo_grid<1,extents_2> x(nullptr,30,40), y(x);
+  std::vector<double> x_data = fill_grid(x,5), y_data = x_data, r_data = x_data, q_data = x_data;
+  y = decltype(y)(y_data.data(),x.mapping());
+  halo_grid<1,extents_2> r(r_data.data(),x.mapping()), q(q_data.data(),x.mapping());
+  for(int t=0; t<6; t++) {
+    for(ptrdiff_t i=0; i<30; i++)
+    for(ptrdiff_t j=0; j<40; j++) q(i,j) = -3.0*r(i,j) + r(i-1,j) + r(i+1,j) + r(i,j-1) + r(i,j+1);
+    std::swap(r,q);
+  }
+  linalg::stencil_sweep(linalg::thread_pool_policy(2),s2,6,x,y);
+  for(ptrdiff_t i=0; i<30; i++)
+  for(ptrdiff_t j=0; j<40; j++) EXPECT_EQ(x(i,j), r(i,j));
+}
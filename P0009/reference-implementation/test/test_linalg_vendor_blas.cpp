@@ -0,0 +1,180 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include<experimental/linalg>
+#include<complex>
+#include<functional>
+#include<vector>
+#include"gtest/gtest.h"
+#include"linalg_test_helpers.hpp"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_vendor_blas_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef extents<dynamic_extent> vector_extents;
+typedef std::complex<double> cplx;
+
+// X is the solution of A X = B (Left) or X A = B, with A triangular.
+template<bool Left, class MatA, class MatB, class MatX>
+void check_solve(bool lower, const MatA& A, const MatB& B, const MatX& X) {
+  const ptrdiff_t n = A.extent(0);
+  for(ptrdiff_t i=0; i<B.extent(0); i++)
+  for(ptrdiff_t j=0; j<B.extent(1); j++) {
+    typename MatX::value_type sum{};
+    for(ptrdiff_t k=0; k<n; k++) {
+      const ptrdiff_t r = Left ? i : k, c = Left ? k : j;
+      if(lower ? r >= c : r <= c) sum += Left ? A(i,k)*X(k,j) : X(i,k)*A(k,j);
+    }
+    ASSERT_LT(std::abs(sum-B(i,j)),1e-10);
+  }
+}
+
+template<class LayoutA, class LayoutB>
+void test_solves() {
+  const ptrdiff_t n = 7, m = 5;
+  test_matrix<cplx,LayoutA> A(n,n,1,true);
+  test_matrix<cplx,LayoutB> B(n,m,2), Bt(m,n,3);
+  test_matrix<cplx,LayoutB> X(n,m,0), Xt(m,n,0);
+  linalg::triangular_matrix_matrix_left_solve(A.view,linalg::lower_triangle,linalg::explicit_diagonal,B.view,X.view);
+  check_solve<true>(true,A.view,B.view,X.view);
+  linalg::triangular_matrix_matrix_left_solve(linalg::conjugate_transposed(A.view),linalg::upper_triangle,
+                                              linalg::explicit_diagonal,B.view,X.view);
+  check_solve<true>(false,linalg::conjugate_transposed(A.view),B.view,X.view);
+  linalg::triangular_matrix_matrix_right_solve(A.view,linalg::upper_triangle,linalg::explicit_diagonal,Bt.view,Xt.view);
+  check_solve<false>(false,A.view,Bt.view,Xt.view);
+
+  std::vector<cplx> b_data(n), x_data(n);
+  for(ptrdiff_t i=0; i<n; i++) b_data[i] = cplx(double(i%3),-1.0);
+  basic_mdspan<cplx,vector_extents> b(b_data.data(),n), x(x_data.data(),n);
+  linalg::triangular_matrix_vector_solve(A.view,linalg::upper_triangle,linalg::implicit_unit_diagonal,b,x);
+  for(ptrdiff_t i=0; i<n; i++) {
+    cplx sum = x(i);
+    for(ptrdiff_t k=i+1; k<n; k++) sum += A.view(i,k)*x(k);
+    ASSERT_LT(std::abs(sum-b(i)),1e-10);
+  }
+}
+
+}
+
+TEST_F(linalg_vendor_blas_,matrix_operand_description) {
+  using linalg::detail::make_blas_matrix_operand;
+  // 3 x 4, by columns and by rows
+  auto col = make_blas_matrix_operand(3,4,1,3,false);
+  ASSERT_TRUE(col.ok); ASSERT_EQ(col.trans,'N'); ASSERT_EQ(col.ld,3);
+  auto row = make_blas_matrix_operand(3,4,4,1,false);
+  ASSERT_TRUE(row.ok); ASSERT_EQ(row.trans,'T'); ASSERT_EQ(row.ld,4);
+  ASSERT_EQ(make_blas_matrix_operand(3,4,4,1,true).trans,'C');
+  // no conjugate without transpose, no leading dimension below the rows
+  ASSERT_FALSE(make_blas_matrix_operand(3,4,1,3,true).ok);
+  ASSERT_FALSE(make_blas_matrix_operand(3,4,1,2,false).ok);
+  ASSERT_FALSE(make_blas_matrix_operand(3,4,2,6,false).ok);
+  // a single column's stride does not matter
+  auto vec = make_blas_matrix_operand(5,1,1,1,false);
+  ASSERT_TRUE(vec.ok); ASSERT_EQ(vec.ld,5);
+  ASSERT_TRUE(make_blas_matrix_operand(0,0,1,1,false).ok);
+
+  ASSERT_EQ(linalg::detail::blas_increment(4,2),2);
+  ASSERT_EQ(linalg::detail::blas_increment(1,0),1);
+  ASSERT_EQ(linalg::detail::blas_increment(4,0),0);
+}
+
+TEST_F(linalg_vendor_blas_,matrix_product_layouts) {
+  test_matrix<double,layout_left> A(13,9,1);
+  test_matrix<double,layout_right> B(9,6,2), Bt(6,9,3);
+  test_matrix<double,layout_right> C(13,6,0);
+  linalg::matrix_product(A.view,B.view,C.view);
+  check_product(A.view,B.view,C.view);
+  linalg::matrix_product(linalg::scaled(-2.0,A.view),linalg::transposed(Bt.view),C.view);
+  check_product(linalg::scaled(-2.0,A.view),linalg::transposed(Bt.view),C.view);
+
+  // A strided submatrix of C
+  test_matrix<double,layout_left> D(20,10,0);
+  auto Dsub = subspan(D.view,std::pair<ptrdiff_t,ptrdiff_t>(2,15),std::pair<ptrdiff_t,ptrdiff_t>(1,7));
+  linalg::matrix_product(A.view,B.view,Dsub);
+  check_product(A.view,B.view,Dsub);
+
+  test_matrix<cplx,layout_left> Z(9,13,4);
+  test_matrix<cplx,layout_left> W(9,6,5), V(13,6,0);
+  linalg::matrix_product(linalg::conjugate_transposed(Z.view),linalg::scaled(cplx(0.0,1.0),W.view),V.view);
+  check_product(linalg::conjugate_transposed(Z.view),linalg::scaled(cplx(0.0,1.0),W.view),V.view);
+}
+
+TEST_F(linalg_vendor_blas_,matrix_vector_product_and_dot) {
+  test_matrix<double,layout_right> A(11,8,1);
+  std::vector<double> x_data(16), y_data(11), z_data(11);
+  for(int i=0; i<16; i++) x_data[i] = i%5 - 2.0;
+  for(int i=0; i<11; i++) y_data[i] = i;
+  basic_mdspan<double,extents<dynamic_extent>,layout_stride> x(x_data.data(),
+    layout_stride::mapping<extents<dynamic_extent>>(extents<dynamic_extent>(8),std::array<ptrdiff_t,1>{2}));
+  basic_mdspan<double,vector_extents> y(y_data.data(),11), z(z_data.data(),11);
+  linalg::matrix_vector_product(linalg::scaled(3.0,A.view),x,y,z);
+  for(ptrdiff_t i=0; i<11; i++) {
+    double expected = y(i);
+    for(ptrdiff_t j=0; j<8; j++) expected += 3.0*A.view(i,j)*x(j);
+    ASSERT_EQ(z(i),expected);
+  }
+
+  double expected = 1.0;
+  for(ptrdiff_t j=0; j<8; j++) expected += 0.5*x(j)*y(j);
+  basic_mdspan<double,vector_extents> y8(y_data.data(),8);
+  ASSERT_EQ(linalg::dot(linalg::scaled(0.5,x),y8,1.0),expected);
+  ASSERT_EQ(linalg::dotc(linalg::scaled(0.5,x),y8,1.0),expected);
+}
+
+TEST_F(linalg_vendor_blas_,triangular_solves) {
+  test_solves<layout_left,layout_left>();
+  test_solves<layout_left,layout_right>();
+  test_solves<layout_right,layout_left>();
+  test_solves<layout_right,layout_right>();
+}
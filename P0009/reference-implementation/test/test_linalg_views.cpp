@@ -0,0 +1,211 @@
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 2.0
+//              Copyright (2014) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Kokkos is licensed under 3-clause BSD terms of use:
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+
+#include<experimental/linalg>
+#include<complex>
+#include<execution>
+#include<type_traits>
+#include<vector>
+#include"gtest/gtest.h"
+#include"linalg_test_helpers.hpp"
+
+using namespace std::experimental::fundamentals_v3;
+
+class linalg_views_ : public ::testing::Test {
+protected:
+  static void SetUpTestCase() {
+  }
+
+  static void TearDownTestCase() {
+  }
+};
+
+namespace {
+
+typedef extents<dynamic_extent> vector_extents;
+
+// C = (alpha A) B^T, with B stored as its transpose.
+template<class LayoutA, class LayoutB>
+void test_scaled_transposed_product(ptrdiff_t m, ptrdiff_t n, ptrdiff_t k) {
+  test_matrix<double,LayoutA> A(m,k,1);
+  test_matrix<double,LayoutB> B(n,k,2);
+  test_matrix<double,layout_left> C(m,n,3);
+  linalg::matrix_product(linalg::scaled(0.5,A.view),linalg::transposed(B.view),C.view);
+  check_product(linalg::scaled(0.5,A.view),linalg::transposed(B.view),C.view);
+
+  linalg::matrix_product(linalg::thread_pool_policy(3),linalg::scaled(2.0,linalg::scaled(-1.0,A.view)),
+                         linalg::transposed(B.view),C.view);
+  check_product(linalg::scaled(-2.0,A.view),linalg::transposed(B.view),C.view);
+}
+
+}
+
+TEST_F(linalg_views_,scaled_and_conjugated_accessors) {
+  std::vector<double> x_data = {1.0, -2.0, 3.0, -4.0};
+  basic_mdspan<double,vector_extents> x(x_data.data(),4);
+
+  auto sx = linalg::scaled(2.0,x);
+  static_assert(std::is_same<decltype(sx)::element_type,const double>::value,"");
+  static_assert(std::is_same<decltype(sx)::reference,double>::value,"");
+  for(ptrdiff_t i=0; i<4; i++) ASSERT_EQ(sx(i),2.0*x_data[i]);
+
+  auto ssx = linalg::scaled(3,sx);
+  for(ptrdiff_t i=0; i<4; i++) ASSERT_EQ(ssx(i),6.0*x_data[i]);
+
+  auto tail = subspan(sx,std::pair<ptrdiff_t,ptrdiff_t>(1,4));
+  ASSERT_EQ(tail.extent(0),3);
+  ASSERT_EQ(tail(2),-8.0);
+
+  // Conjugating real elements does not wrap the accessor.
+  static_assert(std::is_same<decltype(linalg::conjugated(x)),decltype(x)>::value,"");
+
+  typedef std::complex<double> cplx;
+  std::vector<cplx> z_data = {cplx(1.0,2.0), cplx(-3.0,0.5)};
+  basic_mdspan<cplx,vector_extents> z(z_data.data(),2);
+  auto cz = linalg::conjugated(z);
+  static_assert(std::is_same<decltype(cz)::accessor_type,linalg::conjugated_accessor<accessor_basic<cplx>>>::value,"");
+  ASSERT_EQ(cz(0),cplx(1.0,-2.0));
+  ASSERT_EQ(cz(1),cplx(-3.0,-0.5));
+  static_assert(std::is_same<decltype(linalg::conjugated(cz)),decltype(z)>::value,"");
+  ASSERT_EQ(linalg::conjugated(cz)(1),z_data[1]);
+}
+
+TEST_F(linalg_views_,transposed_layouts) {
+  test_matrix<double,layout_left> A(3,5,1);
+  auto At = linalg::transposed(A.view);
+  static_assert(std::is_same<decltype(At)::layout_type,layout_right>::value,"");
+  ASSERT_EQ(At.extent(0),5);
+  ASSERT_EQ(At.extent(1),3);
+  for(ptrdiff_t i=0; i<3; i++)
+  for(ptrdiff_t j=0; j<5; j++) ASSERT_EQ(At(j,i),A.view(i,j));
+  static_assert(std::is_same<decltype(linalg::transposed(At)),decltype(A.view)>::value,"");
+
+  // Static extents are swapped too.
+  std::vector<double> s_data(15);
+  basic_mdspan<double,extents<3,dynamic_extent>,layout_right> S(s_data.data(),5);
+  auto St = linalg::transposed(S);
+  static_assert(std::is_same<decltype(St)::extents_type,extents<dynamic_extent,3>>::value,"");
+  ASSERT_EQ(St.extent(0),5);
+
+  auto Ast = linalg::transposed(subspan(A.view,std::pair<ptrdiff_t,ptrdiff_t>(1,3),all));
+  static_assert(std::is_same<decltype(Ast)::layout_type,layout_right_padded<>>::value,"");
+  ASSERT_EQ(Ast.stride(0),3);
+  ASSERT_EQ(Ast.stride(1),1);
+  ASSERT_EQ(Ast(4,1),A.view(2,4));
+
+  // A packed triangle transposes into the opposite one.
+  std::vector<double> p_data(6);
+  basic_mdspan<double,matrix_extents,linalg::layout_blas_packed<linalg::lower_triangle_t,linalg::column_major_t>> P(p_data.data(),3,3);
+  for(int i=0; i<6; i++) p_data[i] = i;
+  auto Pt = linalg::transposed(P);
+  static_assert(std::is_same<decltype(Pt)::layout_type,linalg::layout_blas_packed<linalg::upper_triangle_t,linalg::row_major_t>>::value,"");
+  for(ptrdiff_t i=0; i<3; i++)
+  for(ptrdiff_t j=0; j<=i; j++) ASSERT_EQ(Pt(j,i),P(i,j));
+
+  // Any other layout is wrapped in layout_transpose.
+  std::vector<double> b_data(4*5);
+  basic_mdspan<double,matrix_extents,linalg::layout_banded<1,2>> Bd(b_data.data(),5,5);
+  auto Bt = linalg::transposed(Bd);
+  static_assert(std::is_same<decltype(Bt)::layout_type,linalg::layout_transpose<linalg::layout_banded<1,2>>>::value,"");
+  static_assert(std::is_same<decltype(linalg::transposed(Bt)),decltype(Bd)>::value,"");
+  ASSERT_EQ(linalg::detail::lower_bandwidth(Bt),2);
+  ASSERT_EQ(linalg::detail::upper_bandwidth(Bt),1);
+  ASSERT_FALSE(linalg::detail::is_column_oriented(Bt));
+  Bd(3,2) = 7.0;
+  ASSERT_EQ(Bt(2,3),7.0);
+}
+
+TEST_F(linalg_views_,matrix_product_scaled_transposed) {
+  test_scaled_transposed_product<layout_left,layout_left>(13,9,7);
+  test_scaled_transposed_product<layout_right,layout_left>(100,10,300);
+  test_scaled_transposed_product<layout_left,layout_right>(40,70,20);
+}
+
+TEST_F(linalg_views_,matrix_product_conjugate_transposed) {
+  typedef std::complex<double> cplx;
+  test_matrix<cplx,layout_left> A(11,6,1);
+  test_matrix<cplx,layout_right> B(11,9,2);
+  test_matrix<cplx,layout_left> C(6,9,3);
+  linalg::matrix_product(linalg::conjugate_transposed(A.view),linalg::scaled(cplx(0.0,2.0),B.view),C.view);
+  check_product(linalg::conjugate_transposed(A.view),linalg::scaled(cplx(0.0,2.0),B.view),C.view);
+}
+
+TEST_F(linalg_views_,matrix_vector_product_scaled_transposed) {
+  test_matrix<double,layout_left> A(37,23,1);
+  std::vector<double> x_data(37), y_data(23);
+  for(int i=0; i<37; i++) x_data[i] = i%5 - 2.0;
+  basic_mdspan<double,vector_extents> x(x_data.data(),37), y(y_data.data(),23);
+
+  auto check = [&](double alpha) {
+    for(ptrdiff_t j=0; j<23; j++) {
+      double expected = 0.0;
+      for(ptrdiff_t i=0; i<37; i++) expected += A.view(i,j)*x(i);
+      ASSERT_EQ(y(j),alpha*expected);
+    }
+  };
+  linalg::matrix_vector_product(linalg::scaled(0.5,linalg::transposed(A.view)),x,y);
+  check(0.5);
+  linalg::matrix_vector_product(linalg::transposed(A.view),linalg::scaled(-2.0,x),y);
+  check(-2.0);
+  linalg::matrix_vector_product(std::execution::par,linalg::scaled(4.0,linalg::transposed(A.view)),linalg::scaled(0.25,x),y);
+  check(1.0);
+}
+
+TEST_F(linalg_views_,matrix_vector_product_transposed_banded) {
+  const ptrdiff_t n = 9;
+  std::vector<double> b_data(4*n);
+  basic_mdspan<double,matrix_extents,linalg::layout_banded<1,2>> Bd(b_data.data(),n,n);
+  for(ptrdiff_t j=0; j<n; j++)
+  for(ptrdiff_t i=(j-2>0?j-2:0); i<=j+1 && i<n; i++) Bd(i,j) = double(i*3+j);
+  std::vector<double> x_data(n), y_data(n);
+  for(ptrdiff_t i=0; i<n; i++) x_data[i] = double(i%4) - 1.0;
+  basic_mdspan<double,vector_extents> x(x_data.data(),n), y(y_data.data(),n);
+
+  linalg::matrix_vector_product(linalg::transposed(Bd),x,y);
+  for(ptrdiff_t i=0; i<n; i++) {
+    double expected = 0.0;
+    for(ptrdiff_t j=(i-2>0?i-2:0); j<=i+1 && j<n; j++) expected += Bd(j,i)*x(j);
+    ASSERT_EQ(y(i),expected);
+  }
+}
@@ -228,5 +228,283 @@ TEST_F(subspan_,basic_mdspan_layout_left) {
   delete [] ptr;
 }
 
+TEST_F(subspan_,strided_slice_extent_deduction) {
+  typedef extents<10,dynamic_extent,9> extents_type;
+  typedef std::integral_constant<ptrdiff_t,0> zero_type;
+  typedef std::integral_constant<ptrdiff_t,7> seven_type;
+  typedef std::integral_constant<ptrdiff_t,2> two_type;
+  typedef detail::subspan_deduce_extents<extents_type,
+            strided_slice<ptrdiff_t,seven_type,two_type>,
+            strided_slice<ptrdiff_t,ptrdiff_t,ptrdiff_t>,
+            strided_slice<ptrdiff_t,zero_type,ptrdiff_t> > sub_extent_deduce_type;
+  typedef sub_extent_deduce_type::extents_type new_extents_type;
+
+  ASSERT_EQ(new_extents_type::rank(),3);
+  ASSERT_EQ(new_extents_type::rank_dynamic(),1);
+  ASSERT_EQ(new_extents_type::static_extent(0),4);
+  ASSERT_EQ(new_extents_type::static_extent(1),dynamic_extent);
+  ASSERT_EQ(new_extents_type::static_extent(2),0);
+
+  std::array<ptrdiff_t,extents_type::rank()> strides;
+  ptrdiff_t offset = 0;
+  extents_type e(8);
+  layout_right::mapping<extents_type> map(e);
+  for(size_t r=0; r<e.rank(); r++)
+    strides[r] = map.stride(r);
+
+  new_extents_type sub_extents = sub_extent_deduce_type::create_sub_extents(e,strides,offset,
+    strided_slice<ptrdiff_t,seven_type,two_type>{1,{},{}},
+    strided_slice<ptrdiff_t,ptrdiff_t,ptrdiff_t>{2,5,3},
+    strided_slice<ptrdiff_t,zero_type,ptrdiff_t>{0,{},0});
+  ASSERT_EQ(sub_extents.extent(0),4);
+  ASSERT_EQ(sub_extents.extent(1),2);
+  ASSERT_EQ(sub_extents.extent(2),0);
+  ASSERT_EQ(strides[0],2*map.stride(0));
+  ASSERT_EQ(strides[1],3*map.stride(1));
+  ASSERT_EQ(strides[2],map.stride(2));
+  ASSERT_EQ(offset,map.stride(0)+2*map.stride(1));
+}
+
+TEST_F(subspan_,strided_slice_red_black) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  extents_type e(6,8);
+  layout_right::mapping<extents_type> map(e);
+  int* ptr = new int[map.required_span_size()];
+  typedef basic_mdspan<int,extents_type,layout_right,accessor_basic<int> > mdspan_type;
+
+  mdspan_type a(ptr,e);
+  for(int i0=0; i0<a.extent(0); i0++)
+  for(int i1=0; i1<a.extent(1); i1++)
+    a(i0,i1) = i0*100+i1;
+
+  // every other point of every other row, starting at (1,0)
+  auto sub = subspan(a,strided_slice{1,5,2},strided_slice{0,8,2});
+  ASSERT_EQ(sub.rank(),2);
+  ASSERT_EQ(sub.extent(0),3);
+  ASSERT_EQ(sub.extent(1),4);
+  ASSERT_EQ(sub.stride(0),2*a.stride(0));
+  ASSERT_EQ(sub.stride(1),2);
+  ASSERT_EQ(sub.is_contiguous()?1:0,0);
+
+  for(int i0=0; i0<sub.extent(0); i0++)
+  for(int i1=0; i1<sub.extent(1); i1++)
+    ASSERT_EQ(sub(i0,i1),(2*i0+1)*100+2*i1);
+
+  // strided_slice mixed with the other slice specifiers
+  auto row = subspan(a,ptrdiff_t(3),strided_slice{1,7,3});
+  ASSERT_EQ(row.rank(),1);
+  ASSERT_EQ(row.extent(0),3);
+  for(int i0=0; i0<row.extent(0); i0++)
+    ASSERT_EQ(row(i0),300+1+3*i0);
+  delete [] ptr;
+}
+
+TEST_F(subspan_,submdspan_mapping_preserves_layout_right) {
+  typedef extents<4,dynamic_extent,5> extents_type;
+  extents_type e(6);
+  layout_right::mapping<extents_type> map(e);
+  int* ptr = new int[map.required_span_size()];
+  typedef basic_mdspan<int,extents_type,layout_right,accessor_basic<int> > mdspan_type;
+
+  mdspan_type a(ptr,e);
+  for(int i0=0; i0<a.extent(0); i0++)
+  for(int i1=0; i1<a.extent(1); i1++)
+  for(int i2=0; i2<a.extent(2); i2++)
+    a(i0,i1,i2) = i0*100+i1*10+i2;
+
+  auto sub = subspan(a,ptrdiff_t(2),std::pair<int,int>(1,4),all);
+  static_assert(std::is_same<decltype(sub)::layout_type,layout_right>::value,"");
+  ASSERT_EQ(sub.static_extent(1),5);
+  ASSERT_EQ(sub.extent(0),3);
+  for(int i0=0; i0<sub.extent(0); i0++)
+  for(int i1=0; i1<sub.extent(1); i1++)
+    ASSERT_EQ(sub(i0,i1),200+(i0+1)*10+i1);
+
+  // a statically unit-stride strided_slice is a contiguous range
+  typedef std::integral_constant<ptrdiff_t,1> one_type;
+  auto unit = subspan(a,strided_slice<int,int,one_type>{1,2,{}},all,all);
+  static_assert(std::is_same<decltype(unit)::layout_type,layout_right>::value,"");
+  ASSERT_EQ(unit(1,2,3),a(2,2,3));
+
+  // rows of a plane keep unit stride, so the result is padded
+  auto plane = subspan(a,all,ptrdiff_t(1),all);
+  static_assert(std::is_same<decltype(plane)::layout_type,layout_right_padded<>>::value,"");
+  ASSERT_EQ(plane.stride(0),a.stride(0));
+  ASSERT_EQ(plane(3,4),a(3,1,4));
+
+  auto strided = subspan(a,all,all,ptrdiff_t(1));
+  static_assert(std::is_same<decltype(strided)::layout_type,layout_stride>::value,"");
+  ASSERT_EQ(strided(3,4),a(3,4,1));
+
+  auto scalar = subspan(a,ptrdiff_t(3),ptrdiff_t(5),ptrdiff_t(4));
+  ASSERT_EQ(scalar.rank(),0);
+  ASSERT_EQ(scalar(),354);
+  delete [] ptr;
+}
+
+TEST_F(subspan_,submdspan_mapping_preserves_layout_left) {
+  typedef extents<4,dynamic_extent,5> extents_type;
+  extents_type e(6);
+  typedef basic_mdspan<int,extents_type,layout_left,accessor_basic<int> > mdspan_type;
+  layout_left::mapping<extents_type> map(e);
+  int* ptr = new int[map.required_span_size()];
+
+  mdspan_type a(ptr,e);
+  for(int i0=0; i0<a.extent(0); i0++)
+  for(int i1=0; i1<a.extent(1); i1++)
+  for(int i2=0; i2<a.extent(2); i2++)
+    a(i0,i1,i2) = i0*100+i1*10+i2;
+
+  auto sub = subspan(a,all,std::pair<int,int>(2,5),ptrdiff_t(3));
+  static_assert(std::is_same<decltype(sub)::layout_type,layout_left>::value,"");
+  ASSERT_EQ(sub.static_extent(0),4);
+  ASSERT_EQ(sub.extent(1),3);
+  for(int i0=0; i0<sub.extent(0); i0++)
+  for(int i1=0; i1<sub.extent(1); i1++)
+    ASSERT_EQ(sub(i0,i1),i0*100+(i1+2)*10+3);
+
+  // a submatrix is padded to the static column length of a
+  auto padded = subspan(a,std::pair<int,int>(1,3),all,all);
+  static_assert(std::is_same<decltype(padded)::layout_type,layout_left_padded<4>>::value,"");
+  ASSERT_EQ(padded.stride(1),4);
+  ASSERT_EQ(padded.stride(2),a.stride(2));
+  ASSERT_EQ(padded(1,4,2),a(2,4,2));
+
+  auto strided = subspan(a,ptrdiff_t(1),all,all);
+  static_assert(std::is_same<decltype(strided)::layout_type,layout_stride>::value,"");
+  ASSERT_EQ(strided(4,2),a(1,4,2));
+  delete [] ptr;
+}
+
+TEST_F(subspan_,strided_slice_keeps_unit_stride) {
+  typedef extents<dynamic_extent,dynamic_extent> extents_type;
+  typedef basic_mdspan<int,extents_type,layout_right,accessor_basic<int> > mdspan_type;
+  int data[6*8];
+  mdspan_type a(data,6,8);
+  for(int i0=0; i0<a.extent(0); i0++)
+  for(int i1=0; i1<a.extent(1); i1++)
+    a(i0,i1) = i0*100+i1;
+
+  // every other row: the rows keep unit stride, statically
+  auto red = subspan(a,strided_slice{1,5,2},all);
+  typedef decltype(red)::mapping_type red_mapping_type;
+  static_assert(std::is_same<red_mapping_type::layout_type,layout_right_padded<>>::value,"");
+  static_assert(detail::static_stride<red_mapping_type::layout_type,red_mapping_type::extents_type>(1) == 1,"");
+  static_assert(detail::static_stride<red_mapping_type::layout_type,red_mapping_type::extents_type>(0) == dynamic_extent,"");
+  ASSERT_EQ(red.extent(0),3);
+  ASSERT_EQ(red.stride(0),2*a.stride(0));
+  for(int i0=0; i0<red.extent(0); i0++)
+  for(int i1=0; i1<red.extent(1); i1++)
+    ASSERT_EQ(red(i0,i1),(2*i0+1)*100+i1);
+
+  // slices of a padded view stay padded, and a row of it is layout_right
+  auto inner = subspan(red,std::pair<int,int>(1,3),std::pair<int,int>(2,7));
+  static_assert(std::is_same<decltype(inner)::layout_type,layout_right_padded<>>::value,"");
+  ASSERT_EQ(inner.stride(0),red.stride(0));
+  ASSERT_EQ(inner(1,4),a(5,6));
+  auto row = subspan(red,ptrdiff_t(2),all);
+  static_assert(std::is_same<decltype(row)::layout_type,layout_right>::value,"");
+  ASSERT_EQ(row(3),a(5,3));
+
+  // every other column of a layout_left matrix
+  typedef basic_mdspan<int,extents_type,layout_left,accessor_basic<int> > left_mdspan_type;
+  left_mdspan_type b(data,6,8);
+  auto black = subspan(b,all,strided_slice{0,8,2});
+  static_assert(std::is_same<decltype(black)::layout_type,layout_left_padded<>>::value,"");
+  static_assert(detail::static_stride<decltype(black)::layout_type,decltype(black)::extents_type>(0) == 1,"");
+  ASSERT_EQ(black.stride(1),12);
+  ASSERT_EQ(&black(5,3),&b(5,6));
+
+  // with static extents and stride the padding is static too
+  typedef std::integral_constant<ptrdiff_t,3> three_type;
+  typedef std::integral_constant<ptrdiff_t,2> two_type;
+  basic_mdspan<int,std::experimental::extents<6,8>,layout_right,accessor_basic<int> > s(data);
+  auto coarse = subspan(s,strided_slice<ptrdiff_t,three_type,two_type>{1,{},{}},all);
+  typedef decltype(coarse)::mapping_type coarse_mapping_type;
+  static_assert(std::is_same<coarse_mapping_type::layout_type,layout_right_padded<16>>::value,"");
+  static_assert(coarse_mapping_type::static_padding_stride == 16,"");
+  static_assert(detail::static_stride<coarse_mapping_type::layout_type,coarse_mapping_type::extents_type>(0) == 16,"");
+  static_assert(coarse.static_extent(0) == 2 && coarse.static_extent(1) == 8,"");
+  static_assert(!coarse_mapping_type::is_always_contiguous(),"");
+  ASSERT_EQ(coarse.stride(0),16);
+  ASSERT_EQ(coarse(1,7),a(3,7));
+
+  // strided in more than one dimension: no single padded stride
+  typedef basic_mdspan<int,std::experimental::extents<2,3,8>,layout_right,accessor_basic<int> > grid_type;
+  grid_type g(data);
+  auto planes = subspan(g,ptrdiff_t(1),strided_slice{0,3,2},all);
+  static_assert(std::is_same<decltype(planes)::layout_type,layout_right_padded<>>::value,"");
+  ASSERT_EQ(&planes(1,5),&g(1,2,5));
+  auto both = subspan(g,strided_slice{0,2,2},strided_slice{0,3,2},all);
+  static_assert(std::is_same<decltype(both)::layout_type,layout_stride>::value,"");
+  ASSERT_EQ(&both(0,1,5),&g(0,2,5));
+}
+
+namespace {
+
+// Minimal user layout: a layout_right matrix whose rows start at
+// multiples of a fixed row_stride.  Keeping rows whole keeps the layout.
+struct layout_fixed_rows {
+  template<class Extents>
+  class mapping {
+  public:
+    using index_type = ptrdiff_t;
+    using extents_type = Extents;
+    using layout_type = layout_fixed_rows;
+
+    mapping() = default;
+    mapping(const Extents& e, ptrdiff_t row_stride) : m_extents(e), m_row_stride(row_stride) {}
+
+    const Extents& extents() const { return m_extents; }
+    ptrdiff_t row_stride() const { return m_row_stride; }
+    ptrdiff_t required_span_size() const { return m_extents.extent(0)*m_row_stride; }
+    ptrdiff_t operator()(ptrdiff_t i, ptrdiff_t j) const { return i*m_row_stride+j; }
+    ptrdiff_t stride(size_t r) const { return r==0 ? m_row_stride : 1; }
+
+    static constexpr bool is_always_unique()     { return true; }
+    static constexpr bool is_always_contiguous() { return false; }
+    static constexpr bool is_always_strided()    { return true; }
+    bool is_unique()     const { return true; }
+    bool is_contiguous() const { return false; }
+    bool is_strided()    const { return true; }
+
+    friend auto submdspan_mapping(const mapping& src, std::pair<int,int> rows, all_type) {
+      typedef layout_fixed_rows::mapping<std::experimental::extents<dynamic_extent,Extents::static_extent(1)>> sub_mapping_type;
+      sub_mapping_type sub(typename sub_mapping_type::extents_type(rows.second-rows.first),src.m_row_stride);
+      return submdspan_mapping_result<sub_mapping_type>{sub,size_t(rows.first*src.m_row_stride)};
+    }
+
+  private:
+    Extents m_extents;
+    ptrdiff_t m_row_stride;
+  };
+};
+
+}
+
+TEST_F(subspan_,submdspan_mapping_custom_layout) {
+  typedef extents<dynamic_extent,3> extents_type;
+  int data[5*4];
+  for(int i=0; i<5*4; i++) data[i] = i;
+  typedef basic_mdspan<int,extents_type,layout_fixed_rows,accessor_basic<int> > mdspan_type;
+  mdspan_type a(data,layout_fixed_rows::mapping<extents_type>(extents_type(5),4));
+
+  // customized
+  auto rows = subspan(a,std::pair<int,int>(1,4),all);
+  static_assert(std::is_same<decltype(rows)::layout_type,layout_fixed_rows>::value,"");
+  ASSERT_EQ(rows.extent(0),3);
+  ASSERT_EQ(rows.mapping().row_stride(),4);
+  for(int i0=0; i0<rows.extent(0); i0++)
+  for(int i1=0; i1<rows.extent(1); i1++)
+    ASSERT_EQ(rows(i0,i1),(i0+1)*4+i1);
+
+  // not customized: falls back to layout_stride
+  auto column = subspan(a,all,ptrdiff_t(2));
+  static_assert(std::is_same<decltype(column)::layout_type,layout_stride>::value,"");
+  ASSERT_EQ(column.stride(0),4);
+  for(int i0=0; i0<column.extent(0); i0++)
+    ASSERT_EQ(column(i0),i0*4+2);
+}
+
 //TEST_F(subspan_,reduce_to_rank_0) {
 //}